@@ -20,10 +20,17 @@
 extern "C" {
 #endif
 
+struct motion_accum;
+
 struct wheel_event {
 	struct app_event_header header;
 
 	int16_t wheel;
+
+	/* Accumulator with coalesced wheel rotation, taken by the HID report provider when a HID
+	 * report is created. NULL if the rotation is passed in the wheel field.
+	 */
+	struct motion_accum *accum;
 };
 
 APP_EVENT_TYPE_DECLARE(wheel_event);
@@ -19,6 +19,8 @@
 #include "wheel_event.h"
 #include <caf/events/power_event.h>
 
+#include "motion_accum.h"
+
 #define MODULE wheel
 #include <caf/events/module_state_event.h>
 
@@ -67,6 +69,7 @@ static struct k_spinlock lock;
 static struct k_work_delayable idle_timeout;
 static bool qdec_triggered;
 static enum state state;
+static struct motion_accum wheel_accum;
 
 static int enable_qdec(enum state next_state);
 
@@ -129,8 +132,6 @@ static void data_ready_handler(const struct device *dev, const struct sensor_tri
 		return;
 	}
 
-	struct wheel_event *event = new_wheel_event();
-
 	int32_t wheel = value.val1;
 
 	if (!IS_ENABLED(CONFIG_DESKTOP_WHEEL_INVERT_AXIS)) {
@@ -143,9 +144,30 @@ static void data_ready_handler(const struct device *dev, const struct sensor_tri
 		wheel /= CONFIG_DESKTOP_WHEEL_SENSOR_VALUE_DIVIDER;
 	}
 
-	event->wheel = MAX(MIN(wheel, SCHAR_MAX), SCHAR_MIN);
+	if (IS_ENABLED(CONFIG_DESKTOP_WHEEL_EVENT_COALESCING)) {
+		int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {
+			[MOTION_ACCUM_AXIS_WHEEL] = wheel,
+		};
+
+		/* The rotation is taken by the HID report provider. Submit an event only if
+		 * the provider took all of the previously coalesced samples.
+		 */
+		if (motion_accum_add(&wheel_accum, delta)) {
+			struct wheel_event *event = new_wheel_event();
+
+			event->wheel = 0;
+			event->accum = &wheel_accum;
+
+			APP_EVENT_SUBMIT(event);
+		}
+	} else {
+		struct wheel_event *event = new_wheel_event();
 
-	APP_EVENT_SUBMIT(event);
+		event->wheel = MAX(MIN(wheel, SCHAR_MAX), SCHAR_MIN);
+		event->accum = NULL;
+
+		APP_EVENT_SUBMIT(event);
+	}
 
 	qdec_triggered = true;
 }
@@ -33,6 +33,12 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_FORWARD_LOG_LEVEL);
 
 #define PERIPHERAL_ADDRESSES_STORAGE_NAME "paddr"
 
+#ifdef CONFIG_DESKTOP_HID_FORWARD_LATENCY_STATS
+  #define LATENCY_STATS_INTERVAL	K_SECONDS(CONFIG_DESKTOP_HID_FORWARD_LATENCY_STATS_INTERVAL)
+#else
+  #define LATENCY_STATS_INTERVAL	K_NO_WAIT
+#endif
+
 BUILD_ASSERT(CFG_CHAN_MAX_RSP_POLL_CNT <= UCHAR_MAX);
 
 struct report_data {
@@ -46,9 +52,16 @@ struct subscriber {
 	uint32_t saved_out_reports_bm;
 };
 
+struct latency_stats {
+	uint64_t latency_sum_us;
+	uint32_t latency_max_us;
+	uint32_t report_cnt;
+};
+
 struct hids_peripheral {
 	struct bt_hogp hogp;
 	uint32_t enqueued_out_reports_bm;
+	struct latency_stats latency_stats;
 
 	struct k_work_delayable read_rsp;
 	struct config_event *cfg_chan_rsp;
@@ -63,6 +76,7 @@ static bt_addr_le_t peripheral_address[CONFIG_BT_MAX_PAIRED];
 static struct hids_peripheral peripherals[CONFIG_BT_MAX_CONN];
 static uint8_t peripheral_cache[CONFIG_BT_MAX_CONN];
 static bool suspended;
+static struct k_work_delayable latency_stats_log;
 
 
 static void hogp_out_rep_write_cb(struct bt_hogp *hogp, struct bt_hogp_rep_info *rep, uint8_t err);
@@ -170,6 +184,41 @@ static size_t get_output_report_size(uint8_t report_id)
 	}
 }
 
+static void latency_stats_update(const void *src_id, uint32_t latency_us)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(peripherals); i++) {
+		struct hids_peripheral *per = &peripherals[i];
+
+		if (per == src_id) {
+			struct latency_stats *stats = &per->latency_stats;
+
+			stats->latency_sum_us += latency_us;
+			stats->latency_max_us = MAX(stats->latency_max_us, latency_us);
+			stats->report_cnt++;
+			break;
+		}
+	}
+}
+
+static void latency_stats_log_fn(struct k_work *work)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(peripherals); i++) {
+		struct hids_peripheral *per = &peripherals[i];
+		struct latency_stats *stats = &per->latency_stats;
+
+		if (stats->report_cnt > 0) {
+			LOG_INF("Peripheral %p: %" PRIu32 " reports, latency avg %" PRIu32
+				" us, max %" PRIu32 " us", (void *)per, stats->report_cnt,
+				(uint32_t)(stats->latency_sum_us / stats->report_cnt),
+				stats->latency_max_us);
+		}
+
+		memset(stats, 0, sizeof(*stats));
+	}
+
+	(void)k_work_reschedule(&latency_stats_log, LATENCY_STATS_INTERVAL);
+}
+
 static void forward_hid_report(struct hids_peripheral *per, uint8_t report_id,
 			       const uint8_t *data, size_t size)
 {
@@ -330,6 +379,7 @@ static int register_peripheral(struct bt_gatt_dm *dm, const uint8_t *hwid,
 	}
 
 	per->sub_id = sub_id;
+	memset(&per->latency_stats, 0, sizeof(per->latency_stats));
 
 	__ASSERT_NO_MSG(hwid_len == HWID_LEN);
 	memcpy(per->hwid, hwid, hwid_len);
@@ -898,6 +948,11 @@ static void init(void)
 
 	reset_peripheral_address();
 
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_FORWARD_LATENCY_STATS)) {
+		k_work_init_delayable(&latency_stats_log, latency_stats_log_fn);
+		(void)k_work_schedule(&latency_stats_log, LATENCY_STATS_INTERVAL);
+	}
+
 	for (size_t i = 0; i < ARRAY_SIZE(subscribers); i++) {
 		struct subscriber *sub = &subscribers[i];
 
@@ -1158,7 +1213,13 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		const struct hid_report_sent_event *event = cast_hid_report_sent_event(aeh);
 		struct subscriber *sub = find_subscriber(event->subscriber);
 
-		if (sub) {
+		if (sub && IS_ENABLED(CONFIG_DESKTOP_HID_FORWARD_LATENCY_STATS)) {
+			struct hid_reportq_report_info info;
+
+			hid_reportq_report_sent_info(sub->in_reportq, event->report_id,
+						     event->error, &info);
+			latency_stats_update(info.src_id, info.latency_us);
+		} else if (sub) {
 			hid_reportq_report_sent(sub->in_reportq, event->report_id, event->error);
 		} else {
 			LOG_WRN("Subscriber %p disconnected", event->subscriber);
@@ -19,6 +19,7 @@
 
 #include "hid_keymap.h"
 #include "hid_report_desc.h"
+#include "motion_accum.h"
 
 #define MODULE hid_provider_mouse
 #include <caf/events/module_state_event.h>
@@ -48,6 +49,7 @@ static bool boot_mode;
 
 static const struct hid_state_api *hid_state_api;
 static struct report_data report_data;
+static struct motion_accum *wheel_accum;
 
 
 static void clear_report_data(struct report_data *rd)
@@ -63,6 +65,29 @@ static void clear_report_data(struct report_data *rd)
 	rd->sync_data_wait_bm = 0;
 }
 
+static bool take_wheel_accum(struct report_data *rd)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_WHEEL_EVENT_COALESCING) || !wheel_accum) {
+		return false;
+	}
+
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+	/* Take at most the rotation that fits in a single HID report. */
+	bool remains = motion_accum_take(wheel_accum, res, MOUSE_REPORT_WHEEL_MIN * 2,
+					 MOUSE_REPORT_WHEEL_MAX * 2);
+
+	rd->axes[MOUSE_REPORT_AXIS_WHEEL] += res[MOTION_ACCUM_AXIS_WHEEL];
+
+	return remains;
+}
+
+static void drop_wheel_accum(void)
+{
+	if (IS_ENABLED(CONFIG_DESKTOP_WHEEL_EVENT_COALESCING) && wheel_accum) {
+		motion_accum_reset(wheel_accum);
+	}
+}
+
 static void send_empty_report(uint8_t report_id, const void *subscriber)
 {
 	__ASSERT_NO_MSG((report_id == REPORT_ID_MOUSE) ||
@@ -104,6 +129,9 @@ static bool send_report_mouse(uint8_t report_id, bool force)
 		return false;
 	}
 
+	/* Take the wheel rotation coalesced up to this point. */
+	bool wheel_remains = take_wheel_accum(rd);
+
 	/* X/Y axis */
 	int16_t dx = CLAMP(rd->axes[MOUSE_REPORT_AXIS_X],
 			   MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
@@ -156,7 +184,8 @@ static bool send_report_mouse(uint8_t report_id, bool force)
 	rd->pipeline_cnt++;
 
 	if ((rd->axes[MOUSE_REPORT_AXIS_X] != 0) || (rd->axes[MOUSE_REPORT_AXIS_Y] != 0) ||
-	    (rd->axes[MOUSE_REPORT_AXIS_WHEEL] < -1) || (rd->axes[MOUSE_REPORT_AXIS_WHEEL] > 1)) {
+	    (rd->axes[MOUSE_REPORT_AXIS_WHEEL] < -1) || (rd->axes[MOUSE_REPORT_AXIS_WHEEL] > 1) ||
+	    wheel_remains) {
 		/* If there is some axis data to send, request report update. */
 		rd->update_needed = true;
 	} else {
@@ -187,6 +216,9 @@ static bool send_report_boot_mouse(uint8_t report_id, bool force)
 		return false;
 	}
 
+	/* Boot report has no wheel. */
+	drop_wheel_accum();
+
 	/* X/Y axis */
 	int8_t dx = CLAMP(rd->axes[MOUSE_REPORT_AXIS_X], INT8_MIN, INT8_MAX);
 	int8_t dy = CLAMP(-rd->axes[MOUSE_REPORT_AXIS_Y], INT8_MIN, INT8_MAX);
@@ -254,6 +286,9 @@ static void mouse_report_connection_state_changed(uint8_t report_id,
 
 	struct report_data *rd = &report_data;
 
+	/* Drop the coalesced wheel rotation together with the axes. */
+	drop_wheel_accum();
+
 	if (active_sub) {
 		/* Set HID subscriber's pipeline size. */
 		rd->pipeline_cnt = cs->pipeline_cnt;
@@ -377,7 +412,19 @@ static bool handle_motion_event(const struct motion_event *event)
 
 static bool handle_wheel_event(const struct wheel_event *event)
 {
-	report_data.axes[MOUSE_REPORT_AXIS_WHEEL] += event->wheel;
+	if (IS_ENABLED(CONFIG_DESKTOP_WHEEL_EVENT_COALESCING) && event->accum) {
+		/* The rotation is taken from the accumulator when HID report is created. */
+		__ASSERT_NO_MSG(!wheel_accum || (wheel_accum == event->accum));
+		wheel_accum = event->accum;
+
+		if (!active_sub) {
+			/* The axes are cleared on connection anyway. */
+			drop_wheel_accum();
+			return false;
+		}
+	} else {
+		report_data.axes[MOUSE_REPORT_AXIS_WHEEL] += event->wheel;
+	}
 
 	trigger_report_transmission();
 
@@ -5,7 +5,6 @@
  */
 
 #include <stdint.h>
-#include <zephyr/sys/slist.h>
 #include <zephyr/kernel.h>
 
 #include "hid_reportq.h"
@@ -18,18 +17,36 @@ LOG_MODULE_REGISTER(hid_reportq, CONFIG_DESKTOP_HID_REPORTQ_LOG_LEVEL);
 #define MAX_ENQUEUED_REPORTS	CONFIG_DESKTOP_HID_REPORTQ_MAX_ENQUEUED_REPORTS
 #define REPORT_IDX_UNSUPPORTED	UINT8_MAX
 
-struct enqueued_report {
-	sys_snode_t node;
+#if IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY)
+#define IN_FLIGHT_MAX		CONFIG_DESKTOP_HID_REPORTQ_LATENCY_IN_FLIGHT_MAX
+#else
+#define IN_FLIGHT_MAX		UINT8_MAX
+#endif
+
+/* HID report event together with the time it was added to the queue. */
+struct queued_report {
 	struct hid_report_event *event;
+	uint32_t timestamp;
+};
+
+/* Enqueued reports are kept in a fixed-size ring to avoid allocations on the report path. */
+struct report_ring {
+	struct queued_report reports[MAX_ENQUEUED_REPORTS];
+	uint8_t head;
+	uint8_t count;
 };
 
-struct counted_list {
-	sys_slist_t list;
-	size_t node_count;
+struct in_flight_report {
+	const void *src_id;
+	uint32_t timestamp;
 };
 
 struct hid_reportq {
-	struct counted_list report_lists[ARRAY_SIZE(input_reports)];
+	struct report_ring report_rings[ARRAY_SIZE(input_reports)];
+#if IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY)
+	struct in_flight_report in_flight[IN_FLIGHT_MAX];
+	uint8_t in_flight_head;
+#endif
 	uint16_t enabled_report_idx_bm;
 	uint8_t last_sent_report_idx;
 	uint8_t report_max;
@@ -41,78 +58,112 @@ static struct hid_reportq queues[CONFIG_DESKTOP_HID_REPORTQ_QUEUE_COUNT];
 
 /* Ensure that enabled_report_idx_bm can handle all of the report indexes. */
 BUILD_ASSERT(ARRAY_SIZE(input_reports) <= 16);
+BUILD_ASSERT(MAX_ENQUEUED_REPORTS <= UINT8_MAX);
 
-static struct enqueued_report *get_enqueued_report(struct counted_list *cnt_list)
+static uint32_t timestamp_get(void)
 {
-	sys_snode_t *node = sys_slist_get(&cnt_list->list);
+	return IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY) ? k_cycle_get_32() : 0;
+}
 
-	if (!node) {
-		return NULL;
+static bool get_enqueued_report(struct report_ring *ring, struct queued_report *report)
+{
+	if (ring->count == 0) {
+		return false;
 	}
 
-	__ASSERT_NO_MSG(cnt_list->node_count > 0);
-	cnt_list->node_count--;
+	*report = ring->reports[ring->head];
+	ring->head = (ring->head + 1) % ARRAY_SIZE(ring->reports);
+	ring->count--;
 
-	return CONTAINER_OF(node, struct enqueued_report, node);
+	return true;
 }
 
-static void enqueue_report(struct counted_list *cnt_list, struct enqueued_report *report)
+static void drop_enqueued_events(struct report_ring *ring)
 {
-	__ASSERT_NO_MSG(cnt_list->node_count < MAX_ENQUEUED_REPORTS);
-	cnt_list->node_count++;
+	struct queued_report report;
 
-	sys_slist_append(&cnt_list->list, &report->node);
+	while (get_enqueued_report(ring, &report)) {
+		app_event_manager_free(report.event);
+	}
+
+	__ASSERT_NO_MSG(ring->count == 0);
 }
 
-static struct hid_report_event *get_enqueued_event(struct counted_list *cnt_list)
+static struct hid_report_event *enqueue_event(struct report_ring *ring, size_t size)
 {
-	struct enqueued_report *report = get_enqueued_report(cnt_list);
+	struct hid_report_event *event = NULL;
 
-	if (!report) {
-		return NULL;
+	if (ring->count == ARRAY_SIZE(ring->reports)) {
+		struct queued_report oldest;
+
+		LOG_WRN("Enqueue dropped the oldest report");
+
+		(void)get_enqueued_report(ring, &oldest);
+
+		/* Reuse the event of the dropped report if the new report fits in it. */
+		if (oldest.event->dyndata.size == size) {
+			event = oldest.event;
+		} else {
+			app_event_manager_free(oldest.event);
+		}
 	}
 
-	struct hid_report_event *event = report->event;
+	if (!event) {
+		event = new_hid_report_event(size);
+	}
+
+	struct queued_report *report =
+		&ring->reports[(ring->head + ring->count) % ARRAY_SIZE(ring->reports)];
 
-	k_free(report);
+	report->event = event;
+	report->timestamp = timestamp_get();
+	ring->count++;
 
 	return event;
 }
 
-static void drop_enqueued_events(struct counted_list *cnt_list)
+static void in_flight_add(struct hid_reportq *q, const void *src_id, uint32_t timestamp)
 {
-	struct hid_report_event *event = get_enqueued_event(cnt_list);
+#if IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY)
+	__ASSERT_NO_MSG(q->report_cnt < ARRAY_SIZE(q->in_flight));
 
-	while (event) {
-		app_event_manager_free(event);
-		event = get_enqueued_event(cnt_list);
-	}
+	struct in_flight_report *r =
+		&q->in_flight[(q->in_flight_head + q->report_cnt) % ARRAY_SIZE(q->in_flight)];
 
-	__ASSERT_NO_MSG(cnt_list->node_count == 0);
+	r->src_id = src_id;
+	r->timestamp = timestamp;
+#endif
 }
 
-static void enqueue_event(struct counted_list *cnt_list, struct hid_report_event *event)
+static void in_flight_remove(struct hid_reportq *q, struct hid_reportq_report_info *info)
 {
-	struct enqueued_report *report;
+#if IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY)
+	__ASSERT_NO_MSG(q->report_cnt > 0);
 
-	if (cnt_list->node_count < MAX_ENQUEUED_REPORTS) {
-		report = k_malloc(sizeof(*report));
-	} else {
-		LOG_WRN("Enqueue dropped the oldest report");
+	struct in_flight_report *r = &q->in_flight[q->in_flight_head];
 
-		report = get_enqueued_report(cnt_list);
-		__ASSERT_NO_MSG(report);
-		app_event_manager_free(report->event);
+	q->in_flight_head = (q->in_flight_head + 1) % ARRAY_SIZE(q->in_flight);
+
+	if (info) {
+		info->src_id = r->src_id;
+		info->latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - r->timestamp);
 	}
+#else
+	ARG_UNUSED(q);
 
-	if (!report) {
-		LOG_ERR("Cannot allocate enqueued_report");
-		/* Should never happen. */
-		__ASSERT_NO_MSG(false);
-	} else {
-		report->event = event;
-		enqueue_report(cnt_list, report);
+	if (info) {
+		info->src_id = NULL;
+		info->latency_us = 0;
 	}
+#endif
+}
+
+static void submit_event(struct hid_reportq *q, struct hid_report_event *event,
+			 uint32_t timestamp)
+{
+	in_flight_add(q, event->source, timestamp);
+	APP_EVENT_SUBMIT(event);
+	q->report_cnt++;
 }
 
 static struct hid_reportq *reportq_find_free(void)
@@ -139,9 +190,15 @@ struct hid_reportq *hid_reportq_alloc(const void *sub_id, uint8_t report_max)
 		return NULL;
 	}
 
-	for (size_t i = 0; i < ARRAY_SIZE(q->report_lists); i++) {
-		__ASSERT_NO_MSG(q->report_lists[i].node_count == 0);
-		sys_slist_init(&q->report_lists[i].list);
+	if (report_max > IN_FLIGHT_MAX) {
+		LOG_WRN("Limited reports in flight to %d to track latency (%d)",
+			IN_FLIGHT_MAX, report_max);
+		report_max = IN_FLIGHT_MAX;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(q->report_rings); i++) {
+		__ASSERT_NO_MSG(q->report_rings[i].count == 0);
+		q->report_rings[i].head = 0;
 	}
 
 	__ASSERT_NO_MSG(q->enabled_report_idx_bm == 0);
@@ -160,14 +217,17 @@ void hid_reportq_free(struct hid_reportq *q)
 	/* Make sure that queue was allocated. */
 	__ASSERT_NO_MSG(q->sub_id);
 
-	for (size_t i = 0; i < ARRAY_SIZE(q->report_lists); i++) {
-		drop_enqueued_events(&q->report_lists[i]);
+	for (size_t i = 0; i < ARRAY_SIZE(q->report_rings); i++) {
+		drop_enqueued_events(&q->report_rings[i]);
 	}
 
 	q->enabled_report_idx_bm = 0;
 	q->last_sent_report_idx = 0;
 	q->report_max = 0;
 	q->report_cnt = 0;
+#if IS_ENABLED(CONFIG_DESKTOP_HID_REPORTQ_LATENCY)
+	q->in_flight_head = 0;
+#endif
 	q->sub_id = NULL;
 }
 
@@ -210,45 +270,54 @@ int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t re
 		return -EACCES;
 	}
 
-	struct hid_report_event *event = new_hid_report_event(sizeof(rep_id) + size);
+	struct hid_report_event *event;
+
+	if (q->report_cnt < q->report_max) {
+		event = new_hid_report_event(sizeof(rep_id) + size);
+	} else {
+		event = enqueue_event(&q->report_rings[rep_idx], sizeof(rep_id) + size);
+	}
 
 	event->source = src_id;
 	event->subscriber = q->sub_id;
 
-	/* Forward report as is adding report id on the front. */
+	/* Forward report as is adding report id on the front. This is the only copy of the
+	 * report data, the event is passed to the HID subscriber by reference.
+	 */
 	event->dyndata.data[0] = rep_id;
 	memcpy(&event->dyndata.data[1], data, size);
 
 	if (q->report_cnt < q->report_max) {
-		APP_EVENT_SUBMIT(event);
+		submit_event(q, event, timestamp_get());
 		q->last_sent_report_idx = rep_idx;
-		q->report_cnt++;
-	} else {
-		enqueue_event(&q->report_lists[rep_idx], event);
 	}
 
 	return 0;
 }
 
-static struct hid_report_event *get_next_enqueued_event(struct hid_reportq *q)
+static bool get_next_enqueued_report(struct hid_reportq *q, struct queued_report *report)
 {
 	uint8_t rep_idx = q->last_sent_report_idx;
-	struct hid_report_event *event;
 
 	do {
-		rep_idx = (rep_idx + 1) % ARRAY_SIZE(q->report_lists);
+		rep_idx = (rep_idx + 1) % ARRAY_SIZE(q->report_rings);
 
-		event = get_enqueued_event(&q->report_lists[rep_idx]);
-		if (event) {
+		if (get_enqueued_report(&q->report_rings[rep_idx], report)) {
 			q->last_sent_report_idx = rep_idx;
-			return event;
+			return true;
 		}
 	} while (rep_idx != q->last_sent_report_idx);
 
-	return get_enqueued_event(&q->report_lists[rep_idx]);
+	return false;
 }
 
 void hid_reportq_report_sent(struct hid_reportq *q, uint8_t rep_id, bool err)
+{
+	hid_reportq_report_sent_info(q, rep_id, err, NULL);
+}
+
+void hid_reportq_report_sent_info(struct hid_reportq *q, uint8_t rep_id, bool err,
+				  struct hid_reportq_report_info *info)
 {
 	ARG_UNUSED(rep_id);
 	ARG_UNUSED(err);
@@ -256,12 +325,13 @@ void hid_reportq_report_sent(struct hid_reportq *q, uint8_t rep_id, bool err)
 	/* Make sure that queue was allocated. */
 	__ASSERT_NO_MSG(q->sub_id);
 
-	struct hid_report_event *event = get_next_enqueued_event(q);
+	struct queued_report report;
 
-	if (event) {
-		APP_EVENT_SUBMIT(event);
-	} else {
-		q->report_cnt--;
+	in_flight_remove(q, info);
+	q->report_cnt--;
+
+	if (get_next_enqueued_report(q, &report)) {
+		submit_event(q, report.event, report.timestamp);
 	}
 }
 
@@ -292,7 +362,7 @@ int hid_reportq_subscribe(struct hid_reportq *q, uint8_t rep_id)
 	}
 
 	WRITE_BIT(q->enabled_report_idx_bm, rep_idx, 1);
-	__ASSERT_NO_MSG(q->report_lists[rep_idx].node_count == 0);
+	__ASSERT_NO_MSG(q->report_rings[rep_idx].count == 0);
 
 	return 0;
 }
@@ -309,7 +379,7 @@ int hid_reportq_unsubscribe(struct hid_reportq *q, uint8_t rep_id)
 	}
 
 	WRITE_BIT(q->enabled_report_idx_bm, rep_idx, 0);
-	drop_enqueued_events(&q->report_lists[rep_idx]);
+	drop_enqueued_events(&q->report_rings[rep_idx]);
 
 	return 0;
 }
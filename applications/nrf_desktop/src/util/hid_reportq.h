@@ -25,6 +25,17 @@ extern "C" {
 /** Opaque type representing HID report queue object. */
 struct hid_reportq;
 
+/** Information about a HID report delivered by the HID subscriber. */
+struct hid_reportq_report_info {
+	/** ID of HID report source. */
+	const void *src_id;
+
+	/** Time from adding the HID report to the queue until the HID report was sent.
+	 *  Set to zero if @kconfig{CONFIG_DESKTOP_HID_REPORTQ_LATENCY} is disabled.
+	 */
+	uint32_t latency_us;
+};
+
 /**
  * @brief Allocate a HID report queue object instance.
  *
@@ -60,9 +71,12 @@ const void *hid_reportq_get_sub_id(struct hid_reportq *q);
  *
  * The function returns an error if HID report subscription is not enabled for the added HID report.
  *
+ * The report data is copied once, into the HID report event that is passed to the HID subscriber.
+ * Enqueuing the event does not require any additional memory allocation.
+ *
  * If number of enqueued reports with a given report ID exceeds limit defined by the configuration
  * (@kconfig{CONFIG_DESKTOP_HID_REPORTQ_MAX_ENQUEUED_REPORTS}), the oldest enqueued HID report with
- * the ID is dropped.
+ * the ID is dropped. The HID report event of the dropped report is reused if possible.
  *
  * @param[in] q		Pointer to the queue instance.
  * @param[in] src_id    ID of HID report source.
@@ -84,6 +98,20 @@ int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t re
  */
 void hid_reportq_report_sent(struct hid_reportq *q, uint8_t rep_id, bool err);
 
+/**
+ * @brief Notify HID report queue that HID report was sent and get information about the report.
+ *
+ * The function works as @ref hid_reportq_report_sent, but it also provides information about the
+ * sent HID report. The HID subscriber must deliver HID reports in the order they were submitted.
+ *
+ * @param[in] q		Pointer to the queue instance.
+ * @param[in] rep_id	HID report ID.
+ * @param[in] err	Error occurred on send.
+ * @param[out] info	Information about the sent HID report.
+ */
+void hid_reportq_report_sent_info(struct hid_reportq *q, uint8_t rep_id, bool err,
+				  struct hid_reportq_report_info *info);
+
 /**
  * @brief Check if HID report queue is subscribed for HID report with given ID.
  *
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "motion_accum.h"
+
+#include <string.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+
+static bool motion_remains(const struct motion_accum *ma)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(ma->axes); i++) {
+		if (ma->axes[i] != 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool motion_accum_add(struct motion_accum *ma, const int32_t delta[MOTION_ACCUM_AXIS_COUNT])
+{
+	bool notify = false;
+	k_spinlock_key_t key = k_spin_lock(&ma->lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ma->axes); i++) {
+		/* Saturate instead of overflowing if the motion is not taken for a long time. */
+		int64_t sum = (int64_t)ma->axes[i] + delta[i];
+
+		ma->axes[i] = CLAMP(sum, INT32_MIN, INT32_MAX);
+	}
+
+	if (!ma->pending && motion_remains(ma)) {
+		ma->pending = true;
+		notify = true;
+	}
+
+	k_spin_unlock(&ma->lock, key);
+
+	return notify;
+}
+
+bool motion_accum_take(struct motion_accum *ma, int32_t res[MOTION_ACCUM_AXIS_COUNT],
+		       int32_t min, int32_t max)
+{
+	__ASSERT_NO_MSG((min <= 0) && (max >= 0));
+
+	k_spinlock_key_t key = k_spin_lock(&ma->lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ma->axes); i++) {
+		res[i] = CLAMP(ma->axes[i], min, max);
+		ma->axes[i] -= res[i];
+	}
+
+	bool remains = motion_remains(ma);
+
+	ma->pending = remains;
+
+	k_spin_unlock(&ma->lock, key);
+
+	return remains;
+}
+
+void motion_accum_reset(struct motion_accum *ma)
+{
+	k_spinlock_key_t key = k_spin_lock(&ma->lock);
+
+	memset(ma->axes, 0, sizeof(ma->axes));
+	ma->pending = false;
+
+	k_spin_unlock(&ma->lock, key);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _MOTION_ACCUM_H_
+#define _MOTION_ACCUM_H_
+
+/**
+ * @file
+ * @defgroup motion_accum Motion accumulator
+ * @{
+ * @brief Utility used to pass motion samples to a HID report provider without an event per sample.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/spinlock.h>
+
+/** @brief Motion axes tracked by the accumulator. */
+enum motion_accum_axis {
+	MOTION_ACCUM_AXIS_X, /**< Horizontal motion. */
+	MOTION_ACCUM_AXIS_Y, /**< Vertical motion. */
+	MOTION_ACCUM_AXIS_WHEEL, /**< Wheel rotation. */
+
+	MOTION_ACCUM_AXIS_COUNT /**< Number of axes. */
+};
+
+/**
+ * @brief Motion accumulator structure.
+ *
+ * A zero-initialized structure is a valid, empty accumulator.
+ */
+struct motion_accum {
+	struct k_spinlock lock; /**< Lock protecting the accumulator. */
+	int32_t axes[MOTION_ACCUM_AXIS_COUNT]; /**< Motion that was not yet taken. */
+	bool pending; /**< The consumer was notified about motion that was not yet taken. */
+};
+
+/**
+ * @brief Add a motion sample.
+ *
+ * The producer adds sensor samples to the accumulator. The consumer needs to be notified (for
+ * example, with an application event) only if the function returns true, that is for the first
+ * sample added after all of the motion was taken. Subsequent samples are coalesced until the
+ * consumer takes the motion.
+ *
+ * The function can be called from an interrupt.
+ *
+ * @param[in] ma	A motion accumulator object.
+ * @param[in] delta	Motion sample, one value per axis.
+ *
+ * @return true if the consumer must be notified, false otherwise.
+ */
+bool motion_accum_add(struct motion_accum *ma, const int32_t delta[MOTION_ACCUM_AXIS_COUNT]);
+
+/**
+ * @brief Take the accumulated motion.
+ *
+ * The consumer takes the motion right before it is needed (for example, when a HID report is
+ * created), so that samples added up to that point are not delayed.
+ *
+ * @param[in] ma	A motion accumulator object.
+ * @param[out] res	Motion taken, one value per axis.
+ * @param[in] min	Minimum value of an axis taken at once.
+ * @param[in] max	Maximum value of an axis taken at once.
+ *
+ * @return true if motion remains in the accumulator after clamping, false otherwise. If no motion
+ *	   remains, the next call to @ref motion_accum_add requests a notification.
+ */
+bool motion_accum_take(struct motion_accum *ma, int32_t res[MOTION_ACCUM_AXIS_COUNT],
+		       int32_t min, int32_t max);
+
+/**
+ * @brief Reset the motion accumulator.
+ *
+ * The function drops the accumulated motion. It should be called by the consumer if it drops its
+ * own motion data, for example when the HID report subscription changes.
+ *
+ * @param[in] ma	A motion accumulator object.
+ */
+void motion_accum_reset(struct motion_accum *ma);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /*_MOTION_ACCUM_H_ */
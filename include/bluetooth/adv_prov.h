@@ -11,6 +11,7 @@
 #ifndef BT_ADV_PROV_H_
 #define BT_ADV_PROV_H_
 
+#include <zephyr/sys/atomic.h>
 #include <zephyr/bluetooth/bluetooth.h>
 
 /**
@@ -82,10 +83,49 @@ typedef int (*bt_le_adv_prov_data_get)(struct bt_data *d,
 				       const struct bt_le_adv_prov_adv_state *state,
 				       struct bt_le_adv_prov_feedback *fb);
 
+/** Structure describing cached data of an advertising data provider.
+ *
+ * The structure is internal to the subsystem. It is defined by the registration macros of
+ * providers with cached data.
+ */
+struct bt_le_adv_prov_cache {
+	/** Data provided by the last call of the provider. */
+	struct bt_data d;
+
+	/** Feedback reported by the last call of the provider. */
+	struct bt_le_adv_prov_feedback fb;
+
+	/** Advertising state used by the last call of the provider. */
+	struct bt_le_adv_prov_adv_state state;
+
+	/** Value returned by the last call of the provider. */
+	int err;
+
+	/** Information if the cached data can be used. */
+	bool valid;
+
+	/** Information if the provider's data changed since the last call of the provider. */
+	atomic_t dirty;
+};
+
 /** Structure describing advertising data provider. */
 struct bt_le_adv_prov_provider {
 	/** Function used to get provider's data. */
 	bt_le_adv_prov_data_get get_data;
+
+	/** Cached data of the provider or NULL if the data is not cached. */
+	struct bt_le_adv_prov_cache *cache;
+};
+
+/** Structure describing statistics of the advertising providers subsystem. */
+struct bt_le_adv_prov_stats {
+	/** Number of provider calls skipped, because the cached provider's data was used. */
+	uint32_t provider_cache_hits;
+
+	/** Number of advertising payload updates that did not need to be sent to the
+	 * Bluetooth controller, because the payload did not change.
+	 */
+	uint32_t payload_update_skips;
 };
 
 /** Register advertising data provider.
@@ -114,6 +154,55 @@ struct bt_le_adv_prov_provider {
 		.get_data = get_data_fn,							 \
 	}
 
+/** Register advertising data provider with cached data.
+ *
+ * The macro statically registers an advertising data provider, similarly to
+ * @ref BT_LE_ADV_PROV_AD_PROVIDER_REGISTER. The data returned by the provider is reused without
+ * calling the provider until either the provider calls @ref bt_le_adv_prov_invalidate or the
+ * Bluetooth advertising state changes. The provider is always called if the
+ * @ref bt_le_adv_prov_adv_state.new_adv_session or @ref bt_le_adv_prov_adv_state.rpa_rotated
+ * is set.
+ *
+ * The provided data must depend only on the Bluetooth advertising state and on the data that is
+ * invalidated by the provider. The memory pointed by the provided data must remain valid and
+ * unchanged until the provider is called again.
+ *
+ * @param pname		Provider name.
+ * @param get_data_fn	Function used to get provider's advertising data.
+ */
+#define BT_LE_ADV_PROV_AD_PROVIDER_REGISTER_CACHED(pname, get_data_fn)				 \
+	static struct bt_le_adv_prov_cache _bt_le_adv_prov_ad_cache_##pname;			 \
+	STRUCT_SECTION_ITERABLE_ALTERNATE(bt_le_adv_prov_ad, bt_le_adv_prov_provider, pname) = { \
+		.get_data = get_data_fn,							 \
+		.cache = &_bt_le_adv_prov_ad_cache_##pname,					 \
+	}
+
+/** Register scan response data provider with cached data.
+ *
+ * The macro statically registers a scan response data provider with cached data. See
+ * @ref BT_LE_ADV_PROV_AD_PROVIDER_REGISTER_CACHED for details.
+ *
+ * @param pname		Provider name.
+ * @param get_data_fn	Function used to get provider's scan response data.
+ */
+#define BT_LE_ADV_PROV_SD_PROVIDER_REGISTER_CACHED(pname, get_data_fn)				 \
+	static struct bt_le_adv_prov_cache _bt_le_adv_prov_sd_cache_##pname;			 \
+	STRUCT_SECTION_ITERABLE_ALTERNATE(bt_le_adv_prov_sd, bt_le_adv_prov_provider, pname) = { \
+		.get_data = get_data_fn,							 \
+		.cache = &_bt_le_adv_prov_sd_cache_##pname,					 \
+	}
+
+/** Invalidate the cached data of a provider.
+ *
+ * A provider with cached data must call the function whenever its data changes for reasons
+ * other than the Bluetooth advertising state. The provider is called again on the next
+ * advertising data update.
+ *
+ * @param get_data_fn	Function used to get the provider's data, as passed to the registration
+ *			macro. All providers registered with the function are invalidated.
+ */
+void bt_le_adv_prov_invalidate(bt_le_adv_prov_data_get get_data_fn);
+
 /** Get number of advertising data packet providers.
  *
  * The number of advertising data packet providers defines maximum number of elements in advertising
@@ -167,6 +256,45 @@ int bt_le_adv_prov_get_sd(struct bt_data *sd, size_t *sd_len,
 			  const struct bt_le_adv_prov_adv_state *state,
 			  struct bt_le_adv_prov_feedback *fb);
 
+/** Check if the advertising payload changed.
+ *
+ * The function compares the advertising data and the scan response data with the payload
+ * passed to the previous call of the function for the same advertising set
+ * (@ref bt_le_adv_prov_adv_state.adv_handle). The given payload is then stored as the last
+ * payload of the advertising set. The module that controls Bluetooth advertising can use the
+ * function to avoid sending an unchanged payload to the Bluetooth controller.
+ *
+ * The payload is considered changed if @ref bt_le_adv_prov_adv_state.new_adv_session is set or
+ * if the payload does not fit in @kconfig{CONFIG_BT_ADV_PROV_PAYLOAD_CACHE_SIZE} bytes.
+ *
+ * @param[in] state	Structure describing advertising state.
+ * @param[in] ad	Pointer to array with advertising data.
+ * @param[in] ad_len	Number of elements in the array pointed by ad.
+ * @param[in] sd	Pointer to array with scan response data.
+ * @param[in] sd_len	Number of elements in the array pointed by sd.
+ *
+ * @return true if the payload must be sent to the Bluetooth controller. Otherwise, false.
+ */
+bool bt_le_adv_prov_payload_changed(const struct bt_le_adv_prov_adv_state *state,
+				    const struct bt_data *ad, size_t ad_len,
+				    const struct bt_data *sd, size_t sd_len);
+
+/** Forget the last advertising payload of an advertising set.
+ *
+ * The module that controls Bluetooth advertising must call the function if it failed to send
+ * the payload to the Bluetooth controller after @ref bt_le_adv_prov_payload_changed returned
+ * true. The next payload of the advertising set is then considered changed.
+ *
+ * @param adv_handle	Advertising handle of the advertising set.
+ */
+void bt_le_adv_prov_payload_invalidate(uint8_t adv_handle);
+
+/** Get statistics of the advertising providers subsystem.
+ *
+ * @param[out] stats	Structure filled with the statistics.
+ */
+void bt_le_adv_prov_stats_get(struct bt_le_adv_prov_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
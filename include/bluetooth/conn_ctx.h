@@ -23,11 +23,25 @@ extern "C" {
 #endif
 
 /**@brief Macro for defining a Bluetooth connection context library instance.
+ *
+ * If CONFIG_BT_CONN_CTX_MEM_ARENA is enabled, the context data is allocated
+ * from the Bluetooth memory arena when a client connects.
  *
  * @param  _name	Name of the instance.
  * @param  _max_clients	Maximum number of clients connected at a time.
  * @param  _ctx_sz	Context size in bytes for a single connection.
  */
+#if defined(CONFIG_BT_CONN_CTX_MEM_ARENA)
+#define BT_CONN_CTX_DEF(_name, _max_clients, _ctx_sz)                          \
+	static K_MUTEX_DEFINE(_name##_mutex);                                  \
+	static struct bt_conn_ctx_lib _CONCAT(_name, _ctx_lib) =                \
+	{                                                                      \
+		.mutex = &_name##_mutex,                                       \
+		.block_size = ROUND_UP(_ctx_sz,                                \
+				       CONFIG_BT_CONN_CTX_MEM_BUF_ALIGN),      \
+		.max_ctx = (_max_clients)                                      \
+	}
+#else
 #define BT_CONN_CTX_DEF(_name, _max_clients, _ctx_sz)                          \
 	K_MEM_SLAB_DEFINE_STATIC(_name##_mem_slab,                             \
 			  ROUND_UP(_ctx_sz, CONFIG_BT_CONN_CTX_MEM_BUF_ALIGN), \
@@ -39,6 +53,7 @@ extern "C" {
 		.mem_slab = &_CONCAT(_name, _mem_slab),                         \
 		.mutex = &_name##_mutex                                        \
 	}
+#endif /* defined(CONFIG_BT_CONN_CTX_MEM_ARENA) */
 
 /** @brief Context data for a connection. */
 struct bt_conn_ctx {
@@ -58,8 +73,19 @@ struct bt_conn_ctx_lib {
 	  * manipulated at a time. */
 	struct k_mutex * const mutex;
 
+#if defined(CONFIG_BT_CONN_CTX_MEM_ARENA)
+	/** Size of the context data in bytes. */
+	const size_t block_size;
+
+	/** Maximum number of contexts allocated at a time. */
+	const size_t max_ctx;
+
+	/** Number of allocated contexts. */
+	size_t ctx_cnt;
+#else
 	/** Memory slab instance where the memory is allocated. */
 	struct k_mem_slab * const mem_slab;
+#endif /* defined(CONFIG_BT_CONN_CTX_MEM_ARENA) */
 };
 
 /**
@@ -71,7 +97,11 @@ struct bt_conn_ctx_lib {
  */
 static inline size_t bt_conn_ctx_block_size_get(struct bt_conn_ctx_lib *ctx_lib)
 {
+#if defined(CONFIG_BT_CONN_CTX_MEM_ARENA)
+	return ctx_lib->block_size;
+#else
 	return ctx_lib->mem_slab->info.block_size;
+#endif
 }
 
 /**
@@ -124,7 +154,8 @@ void bt_conn_ctx_free_all(struct bt_conn_ctx_lib *ctx_lib);
  * @brief Get the context data of a connection from the memory pool.
  *
  * This function finds a connection's context data in the memory pool.
- * The link to find is identified by the connection object.
+ * The link to find is identified by the connection object. The context
+ * is found in constant time, as it is indexed by the connection index.
  *
  * This function should be used in conjunction with
  * @ref bt_conn_ctx_release to ensure proper operation.
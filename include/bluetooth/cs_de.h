@@ -124,6 +124,18 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report);
  */
 float cs_de_ifft(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE]);
 
+/**
+ * @brief Calculates a distance estimate based on a zoomed IFFT magnitude of the input IQ values.
+ * The peak is first searched for in a 256-point IFFT. The IFFT magnitude is then calculated with
+ * the resolution of CONFIG_BT_CS_DE_NFFT_SIZE only around that peak, which gives the same
+ * resolution as @ref cs_de_ifft at a fraction of the cycles.
+ * Note! After calling this function, the content of iq_tones_comb is overwritten.
+ * @param[inout] iq_tones_comb combined IQ values from two devices. The first CS_DE_NUM_CHANNELS * 2
+ * elements should match the format described in @ref cs_de_combined_iq_calculate
+ * @return Distance estimate between the two devices in meters
+ */
+float cs_de_ifft_zoom(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE]);
+
 /**
  * @brief Calculate a distance estimate based on the accumulated RTT
  * To do this, average time of flight is calculated and multiplied with the speed of light.
@@ -264,9 +264,15 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
  * This function is asynchronous. Discovery results are passed through
  * the supplied callback.
  *
- * @note Only one discovery procedure can be started simultaneously. To start
- * another one, wait for the result of the previous procedure to finish
- * and call @ref bt_gatt_dm_data_release if it was successful.
+ * @note Up to @kconfig{CONFIG_BT_GATT_DM_MAX_INSTANCES} discovery procedures
+ * can be started simultaneously. To start another one, wait for the result
+ * of a previous procedure to finish and call @ref bt_gatt_dm_data_release
+ * if it was successful.
+ *
+ * @note If @kconfig{CONFIG_BT_GATT_DM_CACHE} is enabled and the peer uses
+ * an identity address, the GATT Database Hash of the peer is read first.
+ * If the hash did not change since the result was stored, the result is
+ * taken from the cache and no discovery is performed.
  *
  * @param[in]     conn Connection object.
  * @param[in]     svc_uuid UUID of target service
@@ -284,6 +290,7 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
  * Call @ref bt_gatt_dm_continue to discover the next service instance.
  *
  * @retval 0 If the operation was successful.
+ * @retval -EALREADY If all discovery instances are in use.
  *           Otherwise, a (negative) error code is returned.
  */
 int bt_gatt_dm_start(struct bt_conn *conn,
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_MEM_ARENA_H_
+#define BT_MEM_ARENA_H_
+
+/**
+ * @file
+ * @defgroup bt_mem_arena Bluetooth memory arena library API
+ * @{
+ * @brief API for the Bluetooth memory arena library.
+ *
+ * The memory arena is a single memory budget shared by the Bluetooth
+ * libraries that allocate memory for connection contexts and GATT
+ * attributes at runtime.
+ */
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Users of the memory arena. */
+enum bt_mem_arena_user {
+	/** Connection context library. */
+	BT_MEM_ARENA_USER_CONN_CTX,
+
+	/** GATT attribute pools library. */
+	BT_MEM_ARENA_USER_GATT_POOL,
+
+	/** Number of the memory arena users. */
+	BT_MEM_ARENA_USER_COUNT
+};
+
+/** @brief Memory arena usage statistics. */
+struct bt_mem_arena_stats {
+	/** Number of bytes that are currently allocated. */
+	size_t used;
+
+	/** Highest number of bytes allocated at the same time. */
+	size_t max_used;
+
+	/** Number of allocations that failed because the arena was full. */
+	uint32_t alloc_failed;
+};
+
+/**
+ * @brief Allocate a memory block from the arena.
+ *
+ * @param user	User of the memory block.
+ * @param size	Size of the memory block in bytes.
+ * @param align	Alignment of the memory block in bytes. It must be a power of 2.
+ *
+ * @return Pointer to the memory block if the operation was successful.
+ *         Otherwise NULL.
+ */
+void *bt_mem_arena_alloc(enum bt_mem_arena_user user, size_t size, size_t align);
+
+/**
+ * @brief Free a memory block allocated from the arena.
+ *
+ * @param user	User of the memory block.
+ * @param block	Pointer to the memory block.
+ * @param size	Size of the memory block in bytes, as given to
+ *		@ref bt_mem_arena_alloc.
+ */
+void bt_mem_arena_free(enum bt_mem_arena_user user, void *block, size_t size);
+
+/**
+ * @brief Get the memory arena usage statistics of a user.
+ *
+ * @param[in]  user	User of the memory arena.
+ * @param[out] stats	Usage statistics.
+ *
+ * @retval 0		If the operation was successful.
+ * @retval -EINVAL	If the user is invalid.
+ */
+int bt_mem_arena_stats_get(enum bt_mem_arena_user user, struct bt_mem_arena_stats *stats);
+
+/**
+ * @brief Get the usage statistics of the whole memory arena.
+ *
+ * The high-water mark of the whole arena can be lower than the sum of the
+ * high-water marks of the users, as the users do not reach them at the
+ * same time.
+ *
+ * @param[out] stats	Usage statistics.
+ */
+void bt_mem_arena_stats_total_get(struct bt_mem_arena_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* BT_MEM_ARENA_H_ */
@@ -15,6 +15,7 @@
  */
 
 #include <zephyr/types.h>
+#include <zephyr/kernel.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
@@ -126,6 +127,31 @@ static inline uint32_t bt_nus_get_mtu(struct bt_conn *conn)
 	return bt_gatt_get_mtu(conn) - 3;
 }
 
+/**@brief Send a byte stream.
+ *
+ * @details The data is copied to the TX ring buffer of the connection and sent in notifications
+ *          of up to @ref bt_nus_get_mtu bytes. Small writes are packed together while the
+ *          previous notifications are in flight. If the ring buffer is full, the function waits
+ *          until notifications free space in it or until the timeout expires.
+ *
+ *          The @ref bt_nus_cb.sent callback is not called for the stream data.
+ *
+ * @note The function is available if CONFIG_BT_NUS_STREAM is enabled. Do not use a timeout
+ *       other than K_NO_WAIT when calling the function from a Bluetooth callback.
+ *
+ * @param[in] conn    Pointer to connection object.
+ * @param[in] data    Pointer to a data buffer.
+ * @param[in] len     Length of the data in the buffer.
+ * @param[in] timeout Time to wait for free space in the TX ring buffer.
+ *
+ * @retval >=0       Number of bytes queued for sending. It can be lower than @p len if the
+ *                   timeout expired.
+ * @retval -EINVAL   Invalid parameters or the peer is not subscribed to notifications.
+ * @retval -ENOTCONN The connection was terminated before any data was queued.
+ */
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len,
+		       k_timeout_t timeout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -347,6 +347,19 @@ typedef void (*bt_ras_rreq_rd_overwritten_cb_t)(struct bt_conn *conn, uint16_t r
 typedef void (*bt_ras_rreq_ranging_data_received_t)(struct bt_conn *conn, uint16_t ranging_counter,
 						    int err);
 
+/** @brief Ranging data segment received callback. Called each time a segment of ranging data has
+ * been received from the peer and appended to the ranging data buffer. Segments received out of
+ * order are appended together with the missing segment, once it is received.
+ *
+ * @param[in] conn            Connection Object.
+ * @param[in] ranging_counter Ranging counter that is being received.
+ * @param[in] ranging_data    Buffer with the ranging data received so far. Data that has already
+ *                            been processed can be removed from the buffer, for example with
+ *                            @ref bt_ras_rreq_rd_parser_feed.
+ */
+typedef void (*bt_ras_rreq_segment_received_t)(struct bt_conn *conn, uint16_t ranging_counter,
+					       struct net_buf_simple *ranging_data);
+
 /** @brief RAS features read callback.
  *
  * @param[in] conn         Connection Object.
@@ -568,6 +581,21 @@ int bt_ras_rreq_realtime_rd_unsubscribe(struct bt_conn *conn);
  */
 int bt_ras_rreq_read_features(struct bt_conn *conn, bt_ras_rreq_features_read_cb_t cb);
 
+/** @brief Register a callback for received ranging data segments.
+ *
+ * The callback allows the ranging data to be processed while it is received, instead of after
+ * the complete ranging data has been received. It is used both for On-demand and Real-time
+ * ranging data.
+ *
+ * @param[in] conn Connection Object, which already has associated RREQ context.
+ * @param[in] cb   Segment received callback, or NULL to unregister the callback.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a negative error code is returned.
+ */
+int bt_ras_rreq_segment_received_cb_register(struct bt_conn *conn,
+					     bt_ras_rreq_segment_received_t cb);
+
 /** @brief Provide ranging header for the ranging data back to the user.
  *
  * @param[in] ranging_header Ranging header data.
@@ -627,6 +655,67 @@ void bt_ras_rreq_rd_subevent_data_parse(struct net_buf_simple *peer_ranging_data
 					bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
 					bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data);
 
+/** @brief Ranging data parser.
+ *
+ * Parser state used to parse peer ranging data and local step data in parts, as it becomes
+ * available. The members are internal to the parser.
+ */
+struct bt_ras_rreq_rd_parser {
+	/** Channel sounding role of local device. */
+	enum bt_conn_le_cs_role cs_role;
+	/** Callback called (once) for the ranging header. */
+	bt_ras_rreq_ranging_header_cb_t ranging_header_cb;
+	/** Callback called with each subevent header. */
+	bt_ras_rreq_subevent_header_cb_t subevent_header_cb;
+	/** Callback called with each peer and local step data. */
+	bt_ras_rreq_step_data_cb_t step_data_cb;
+	/** User data to be passed to the callbacks. */
+	void *user_data;
+	/** Number of steps parsed. */
+	uint16_t steps_parsed;
+	/** Number of steps left to parse in the current subevent. */
+	uint8_t steps_remaining;
+	/** The ranging header has been parsed. */
+	bool ranging_header_parsed;
+	/** Error that stopped the parsing. */
+	int err;
+};
+
+/** @brief Initialize a ranging data parser.
+ *
+ * @param[out] parser             Parser to initialize.
+ * @param[in]  cs_role            Channel sounding role of local device.
+ * @param[in]  ranging_header_cb  Callback called (once) for the ranging header.
+ * @param[in]  subevent_header_cb Callback called with each subevent header.
+ * @param[in]  step_data_cb       Callback called with each peer and local step data.
+ * @param[in]  user_data          User data to be passed to the callbacks.
+ */
+void bt_ras_rreq_rd_parser_init(struct bt_ras_rreq_rd_parser *parser,
+				enum bt_conn_le_cs_role cs_role,
+				bt_ras_rreq_ranging_header_cb_t ranging_header_cb,
+				bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
+				bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data);
+
+/** @brief Parse the available peer ranging data and local step data.
+ *
+ * The function parses all steps for which both the peer and the local step data are available,
+ * and removes the parsed data from the buffers. Incomplete data is left in the buffers and parsed
+ * by a subsequent call, after more data has been added to the buffers. This allows the ranging
+ * data to be parsed segment by segment, as it is received.
+ *
+ * @param[in] parser                Parser initialized with @ref bt_ras_rreq_rd_parser_init.
+ * @param[in] peer_ranging_data_buf Buffer to the peer ranging data to parse.
+ * @param[in] local_step_data_buf   Buffer to the local step data to parse.
+ *
+ * @retval 0 If all of the complete data available in the buffers was parsed.
+ * @retval -ECANCELED If a callback stopped the parsing.
+ * @retval -ECONNABORTED If a peer step was aborted.
+ * @retval -EBADMSG If the data is malformed.
+ */
+int bt_ras_rreq_rd_parser_feed(struct bt_ras_rreq_rd_parser *parser,
+			       struct net_buf_simple *peer_ranging_data_buf,
+			       struct net_buf_simple *local_step_data_buf);
+
 /** @brief Convert CS procedure counter to RAS ranging counter
  *
  * @param[in] procedure_counter Procedure counter
@@ -14,6 +14,7 @@
  * @brief API for the Bluetooth LE GATT Throughput Service.
  */
 
+#include <zephyr/sys/atomic.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/conn.h>
 #include <bluetooth/gatt_dm.h>
@@ -68,6 +69,42 @@ struct bt_throughput_cb {
 	void (*data_send)(const struct bt_throughput_metrics *met);
 };
 
+/** @brief Throughput stream statistics of a connection. */
+struct bt_throughput_stream_stats {
+	/** Number of GATT writes sent. */
+	uint32_t write_count;
+
+	/** Number of bytes sent. */
+	uint32_t write_len;
+
+	/** Goodput in bits per second. */
+	uint32_t goodput;
+
+	/** Number of writes that could not be queued, because no TX buffer was available. */
+	uint32_t tx_starved;
+};
+
+/** @brief Throughput stream report. */
+struct bt_throughput_stream_report {
+	/** Stream duration in milliseconds. */
+	uint32_t duration;
+
+	/** Number of GATT writes sent over all connections. */
+	uint32_t write_count;
+
+	/** Number of bytes sent over all connections. */
+	uint32_t write_len;
+
+	/** Aggregate goodput in bits per second. */
+	uint32_t goodput;
+
+	/** Number of writes that could not be queued over all connections. */
+	uint32_t tx_starved;
+
+	/** CPU load in 0.001% units, or -ENOTSUP if CONFIG_NRF_CPU_LOAD is disabled. */
+	int cpu_load;
+};
+
 /** @brief Throughput structure. */
 struct bt_throughput {
 	/** Throughput Characteristic handle. */
@@ -81,6 +118,17 @@ struct bt_throughput {
 
 	/** Connection object. */
 	struct bt_conn *conn;
+
+#if defined(CONFIG_BT_THROUGHPUT_STREAM) || defined(__DOXYGEN__)
+	/** Statistics of the last throughput stream. */
+	struct bt_throughput_stream_stats stream;
+
+	/** Internal: number of stream writes sent. */
+	atomic_t stream_sent;
+
+	/** Internal: number of stream writes waiting to be sent. */
+	atomic_t stream_in_flight;
+#endif
 };
 
 /** @brief Throughput Characteristic UUID. */
@@ -151,6 +199,31 @@ int bt_throughput_read(struct bt_throughput *throughput);
 int bt_throughput_write(struct bt_throughput *throughput,
 			const uint8_t *data, uint16_t len);
 
+/** @brief Stream data to multiple servers at the same time.
+ *
+ *  The function resets the metrics of the servers and then writes without response to all of
+ *  the servers for the given duration. The connections take turns and each connection has at
+ *  most CONFIG_BT_THROUGHPUT_STREAM_TX_WINDOW writes in flight. The function blocks until the
+ *  stream is finished.
+ *
+ *  The statistics of each connection are stored in the @c stream member of the Throughput
+ *  Service instance.
+ *
+ *  @note The function is available if CONFIG_BT_THROUGHPUT_STREAM is enabled.
+ *
+ *  @param[in,out] throughput Throughput Service instances, one for each connection.
+ *  @param[in] cnt Number of Throughput Service instances.
+ *  @param[in] write_len Length of each write, not larger than the ATT MTU minus 3 bytes.
+ *  @param[in] duration Stream duration in milliseconds.
+ *  @param[out] report Aggregate statistics of the stream.
+ *
+ *  @retval 0 If the operation was successful.
+ *            Otherwise, a negative error code is returned.
+ */
+int bt_throughput_stream_run(struct bt_throughput *throughput[], size_t cnt,
+			     uint16_t write_len, uint32_t duration,
+			     struct bt_throughput_stream_report *report);
+
 #ifdef __cplusplus
 }
 #endif
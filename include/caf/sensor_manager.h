@@ -11,6 +11,7 @@
 extern "C" {
 #endif
 
+#include <errno.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
 #include <caf/events/sensor_event.h>
@@ -32,6 +33,23 @@ struct sm_trigger {
 	struct sm_trigger_activation activation;
 };
 
+/**
+ * @typedef sm_fifo_read_t
+ * @brief Function used to read samples from sensor FIFO.
+ *
+ * Each sample consists of the values of all of the configured channels,
+ * in the order of the channels.
+ *
+ * @param[in]	dev		Sensor device.
+ * @param[out]	data		Buffer for the samples.
+ * @param[in]	sample_cnt	Maximum number of samples to read.
+ *
+ * @return Number of read samples, oldest first. Otherwise, a (negative)
+ *	   error code is returned.
+ */
+typedef int (*sm_fifo_read_t)(const struct device *dev, struct sensor_value *data,
+			      size_t sample_cnt);
+
 /**
  * @brief Sensor configuration
  *
@@ -85,8 +103,72 @@ struct sm_sensor_config {
 	 * @brief Flag to indicate whether sensor should be suspended or not.
 	 */
 	bool suspend;
+	/**
+	 * @brief Number of samples read at each wake up
+	 *
+	 * If set to a value bigger than one, the sensor is read once every
+	 * batch_size sampling periods and all of the samples are delivered
+	 * in a single sensor_event. The samples are read from the sensor FIFO
+	 * with the fifo_read function. A sensor without the function is
+	 * reported in the error state.
+	 * Zero or one disables batching.
+	 */
+	uint8_t batch_size;
+	/**
+	 * @brief Function used to read samples buffered in sensor FIFO
+	 *
+	 * Required if batch_size is bigger than one. The samples are read
+	 * instead of fetching them with the sensor API.
+	 */
+	sm_fifo_read_t fifo_read;
 };
 
+/**
+ * @brief Sensor manager statistics
+ *
+ * The statistics are available if the
+ * :kconfig:option:`CONFIG_CAF_SENSOR_MANAGER_STATS` option is enabled.
+ */
+struct sm_stats {
+	/**
+	 * @brief Number of wake ups
+	 *
+	 * For a sensor, number of times the sensor was read. For the module,
+	 * number of times the sampling thread woke up.
+	 */
+	uint32_t wake_up_cnt;
+	/**
+	 * @brief Number of samples read
+	 */
+	uint32_t sample_cnt;
+	/**
+	 * @brief Number of submitted sensor_events
+	 */
+	uint32_t event_cnt;
+};
+
+/**
+ * @brief Get sensor manager statistics
+ *
+ * @param[in] descr	Event descriptor of the sensor, or NULL to get
+ *			statistics of all of the sensors.
+ * @param[out] stats	Statistics.
+ *
+ * @return 0 on success, -ENOENT if there is no sensor with the given
+ *	   descriptor, -ENOTSUP if the statistics are disabled.
+ */
+#if defined(CONFIG_CAF_SENSOR_MANAGER_STATS)
+int sensor_manager_stats_get(const char *descr, struct sm_stats *stats);
+#else
+static inline int sensor_manager_stats_get(const char *descr, struct sm_stats *stats)
+{
+	ARG_UNUSED(descr);
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+#endif /* defined(CONFIG_CAF_SENSOR_MANAGER_STATS) */
+
 #ifdef __cplusplus
 }
 #endif
@@ -130,6 +130,10 @@ int emds_entry_add(struct emds_dynamic_entry *entry);
  * with MPSL, make sure to uninitialize the MPSL before this function is called.
  * Otherwise, an assertion may be triggered by the exit of the function.
  *
+ * If @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} is enabled, only the entries that changed
+ * since @ref emds_load are stored, unless a snapshot with all entries is needed.
+ * Nothing is written if no entry changed.
+ *
  * @retval 0 Success
  * @retval -ERRNO errno code if error
  */
@@ -186,6 +190,10 @@ int emds_prepare(void);
  * registered in the entries. This value is dependent on the chip used, and
  * should be checked against the chip datasheet.
  *
+ * This is the worst case, where all entries are stored. If
+ * @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} is enabled, it includes the time to check
+ * the entries for changes.
+ *
  * @param store_time_us Pointer to a variable where the estimated time (in microseconds)
  *                      will be stored.
  *
@@ -194,6 +202,24 @@ int emds_prepare(void);
  */
 int emds_store_time_get(uint32_t *store_time_us);
 
+/**
+ * @brief Estimate the time needed to store the data that changed.
+ *
+ * If @kconfig{CONFIG_EMDS_DELTA_SNAPSHOTS} is enabled and an incremental snapshot is
+ * prepared, estimate how much time @ref emds_store takes with the current content of the
+ * entries. Otherwise, this is the same as @ref emds_store_time_get.
+ *
+ * Checking the entries for changes takes time proportional to the total size of the
+ * entries, so this function must not be called from a time-critical context.
+ *
+ * @param store_time_us Pointer to a variable where the estimated time (in microseconds)
+ *                      will be stored.
+ *
+ * @return 0 on success.
+ * @retval -ECANCELED if the function was called before @ref emds_init.
+ */
+int emds_store_time_changed_get(uint32_t *store_time_us);
+
 /**
  * @brief Calculate the size needed to store the registered data.
  *
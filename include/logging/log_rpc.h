@@ -162,6 +162,26 @@ void log_rpc_set_history_usage_threshold(log_rpc_history_threshold_reached_handl
  */
 int log_rpc_fetch_history(log_rpc_history_handler_t handler);
 
+/**
+ * @brief Fetches the filtered log history.
+ *
+ * This function works like @ref log_rpc_fetch_history, but only the log
+ * messages with the level up to @c level and the timestamp not older than
+ * @c since_us are transferred. If the log history is stored in the flash,
+ * the remote device skips whole blocks of log messages that do not match
+ * the filter without reading them, which shortens the transfer.
+ *
+ * @param handler	History handler, see @ref log_rpc_history_handler_t.
+ * @param level		Maximum level of the transferred log messages.
+ * @param since_us	Minimum timestamp of the transferred log messages, in
+ *			microseconds, see @ref log_rpc_set_time.
+ *
+ * @retval 0		On success.
+ * @retval -errno	On failure.
+ */
+int log_rpc_fetch_history_filtered(log_rpc_history_handler_t handler, enum log_rpc_level level,
+				   uint64_t since_us);
+
 /**
  * @brief Stops the log history transfer.
  *
@@ -204,6 +204,18 @@ struct location_data_details_wifi {
 	uint16_t ap_count;
 };
 
+#if defined(CONFIG_LOCATION_CACHE)
+/** Location details for the local location cache. */
+struct location_data_details_cache {
+	/** Whether the result of this request was taken from the cache. */
+	bool hit;
+	/** Number of cache hits since boot. */
+	uint32_t hits;
+	/** Number of cache misses since boot. */
+	uint32_t misses;
+};
+#endif
+
 /**
  * Location details.
  *
@@ -234,6 +246,10 @@ struct location_data_details {
 	/** Location details for Wi-Fi. */
 	struct location_data_details_wifi wifi;
 #endif
+#if defined(CONFIG_LOCATION_CACHE)
+	/** Location details for the local location cache. Filled for cellular and Wi-Fi. */
+	struct location_data_details_cache cache;
+#endif
 };
 #endif
 
@@ -754,6 +770,15 @@ void location_cloud_location_ext_result_set(
 	enum location_ext_result result,
 	struct location_data *location);
 
+/**
+ * @brief Remove all cached cloud locations.
+ *
+ * @details Use this when the device is known to have moved without the radio environment
+ * changing, for example, when a cached location is known to be wrong.
+ * Requires @kconfig{CONFIG_LOCATION_CACHE}.
+ */
+void location_cache_clear(void);
+
 /** @} */
 
 #ifdef __cplusplus
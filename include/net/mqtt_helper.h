@@ -143,10 +143,62 @@ int mqtt_helper_subscribe(struct mqtt_subscription_list *sub_list);
  */
 int mqtt_helper_publish(const struct mqtt_publish_param *param);
 
+/** @brief Publish queue statistics. */
+struct mqtt_helper_publish_queue_stats {
+	/** Number of messages currently queued, including unacknowledged messages. */
+	uint32_t depth;
+	/** Highest number of queued messages seen. */
+	uint32_t depth_max;
+	/** Number of QoS 1 messages sent and not yet acknowledged. */
+	uint32_t in_flight;
+	/** Number of messages completed; QoS 0 when sent, QoS 1 when acknowledged. */
+	uint32_t completed;
+	/** Number of QoS 1 messages re-sent after a reconnect. */
+	uint32_t resent;
+	/** Number of queued messages replaced by a newer message on the same topic. */
+	uint32_t coalesced;
+	/** Number of messages rejected because the queue was full. */
+	uint32_t rejected;
+	/** Average time from enqueue to completion, in milliseconds. */
+	uint32_t latency_avg_ms;
+	/** Longest time from enqueue to completion, in milliseconds. */
+	uint32_t latency_max_ms;
+};
+
+/** @brief Queue an MQTT message for publishing.
+ *
+ *  The topic and payload are copied, so the caller's buffers can be reused once the function
+ *  returns. Messages are sent in order while connected. QoS 1 messages are kept until they are
+ *  acknowledged and re-sent with the DUP flag after a reconnect.
+ *  Requires @kconfig{CONFIG_MQTT_HELPER_PUBLISH_QUEUE}.
+ *
+ *  @param param Publish parameters. If the message ID is 0, one is assigned.
+ *  @param coalesce If true and a message with the same topic is queued but not yet sent,
+ *		    that message is replaced instead of queuing a new one.
+ *  @retval 0 if successful.
+ *  @retval -EMSGSIZE if the topic and payload do not fit in a queue entry.
+ *  @retval -ENOMEM if the queue is full.
+ *  @return Otherwise a negative error code.
+ */
+int mqtt_helper_publish_enqueue(const struct mqtt_publish_param *param, bool coalesce);
+
+/** @brief Get publish queue statistics.
+ *  Requires @kconfig{CONFIG_MQTT_HELPER_PUBLISH_QUEUE}.
+ *  @param stats Statistics since boot or since the last call of
+ *		mqtt_helper_publish_queue_clear().
+ */
+void mqtt_helper_publish_queue_stats_get(struct mqtt_helper_publish_queue_stats *stats);
+
+/** @brief Drop all queued messages, including stored ones, and reset the statistics.
+ *  Requires @kconfig{CONFIG_MQTT_HELPER_PUBLISH_QUEUE}.
+ */
+void mqtt_helper_publish_queue_clear(void);
+
 /** @brief Get a message ID.
  *
  *  @note Will not return 0 as it is reserved for invalid message IDs, see MQTT specification.
- *	  Returned values increment by one for each call.
+ *	  Returned values increment by one for each call. With the publish queue enabled,
+ *	  IDs of the queued and unacknowledged messages are skipped.
  *
  *  @return Message ID, positive non-zero value.
  */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_BATCH_H__
+#define NRF_CLOUD_BATCH_H__
+
+/** @file nrf_cloud_batch.h
+ * @brief Module to batch device messages sent to nRF Cloud.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <net/nrf_cloud_codec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup nrf_cloud_batch nRF Cloud message batching
+ * @{
+ */
+
+/** @brief Reasons for sending a batch. */
+enum nrf_cloud_batch_flush_reason {
+	/** @ref nrf_cloud_batch_flush was called. */
+	NRF_CLOUD_BATCH_FLUSH_REQUESTED,
+	/** The batch reached @kconfig{CONFIG_NRF_CLOUD_BATCH_MAX_MSGS}. */
+	NRF_CLOUD_BATCH_FLUSH_COUNT,
+	/** The batch reached @kconfig{CONFIG_NRF_CLOUD_BATCH_MAX_BYTES}. */
+	NRF_CLOUD_BATCH_FLUSH_SIZE,
+	/** The oldest message reached @kconfig{CONFIG_NRF_CLOUD_BATCH_MAX_AGE}. */
+	NRF_CLOUD_BATCH_FLUSH_AGE,
+	/** The LTE radio became active or is about to leave PSM. */
+	NRF_CLOUD_BATCH_FLUSH_LTE,
+
+	NRF_CLOUD_BATCH_FLUSH__COUNT
+};
+
+/** @brief Batching statistics. */
+struct nrf_cloud_batch_stats {
+	/** Number of messages added. */
+	uint32_t added;
+	/** Number of queued messages replaced by a newer message with the same app ID. */
+	uint32_t coalesced;
+	/** Number of messages dropped because the batch could not be sent. */
+	uint32_t dropped;
+	/** Number of bulk messages sent. */
+	uint32_t flushes;
+	/** Number of bulk messages sent, per @ref nrf_cloud_batch_flush_reason. */
+	uint32_t flush_reasons[NRF_CLOUD_BATCH_FLUSH__COUNT];
+	/** Total size of the encoded bulk messages sent, in bytes. */
+	uint32_t bytes_sent;
+	/** Number of failed send attempts. */
+	uint32_t send_errors;
+};
+
+/**
+ * @brief Add a device message to the batch.
+ *
+ * @details The message is sent to nRF Cloud as part of a bulk message when the batch is full,
+ *          when the oldest message is too old, or when the LTE radio is active anyway.
+ *          If successful, the object belongs to the batch and must not be freed by the caller.
+ *
+ * @param[in,out] obj JSON device message, for example created with
+ *                    @ref nrf_cloud_obj_msg_init.
+ * @param[in] coalesce If true, a queued message with the same app ID is replaced instead of
+ *                     adding a new one, so that only the latest value is sent.
+ *
+ * @retval 0 Success; the message was added.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOTSUP The object is not a JSON object.
+ * @retval -ENOMEM Out of memory.
+ */
+int nrf_cloud_batch_add(struct nrf_cloud_obj *const obj, bool coalesce);
+
+/**
+ * @brief Add a sensor value to the batch.
+ *
+ * @details Creates a "DATA" device message and passes it to @ref nrf_cloud_batch_add.
+ *
+ * @param[in] app_id App ID of the message.
+ * @param[in] value Sensor value.
+ * @param[in] ts_ms UNIX timestamp in milliseconds, or a negative value to omit it.
+ * @param[in] coalesce See @ref nrf_cloud_batch_add.
+ *
+ * @return 0 on success, or a negative error code as for @ref nrf_cloud_batch_add.
+ */
+int nrf_cloud_batch_sensor_add(const char *const app_id, double value, int64_t ts_ms,
+			       bool coalesce);
+
+/**
+ * @brief Send all queued messages as one bulk message.
+ *
+ * @retval 0 Success, or the batch was empty.
+ * @return A negative error code from the transport. The messages are kept and sent with
+ *         the next flush.
+ */
+int nrf_cloud_batch_flush(void);
+
+/**
+ * @brief Get batching statistics.
+ *
+ * @param[out] stats Statistics since boot.
+ */
+void nrf_cloud_batch_stats_get(struct nrf_cloud_batch_stats *stats);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_BATCH_H__ */
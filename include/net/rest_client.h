@@ -57,7 +57,10 @@ struct rest_client_req_context {
 	 */
 	int connect_socket;
 
-	/** Defines whether the connection should remain after API call. Default: false. */
+	/** Defines whether the connection should remain after API call. Default: false.
+	 *  If false and @kconfig{CONFIG_REST_CLIENT_CONN_POOL} is enabled, a connection
+	 *  opened by the library is returned to the connection pool instead of being closed.
+	 */
 	bool keep_alive;
 
 	/** Security tag. Default: SEC_TAG_TLS_INVALID. */
@@ -143,6 +146,29 @@ struct rest_client_resp_context {
 	struct rest_client_req_context *req_ctx;
 };
 
+/** @brief REST client connection pool statistics. */
+struct rest_client_pool_stats {
+	/** Number of new connections opened. For secure connections, each one performs a
+	 *  TLS handshake, which is abbreviated when the TLS session can be resumed.
+	 */
+	uint32_t connects;
+
+	/** Number of requests served on a pooled connection. */
+	uint32_t reuses;
+
+	/** Number of requests retried on a new connection because a pooled one was stale. */
+	uint32_t stale_retries;
+
+	/** Number of idle connections closed to make room in the pool. */
+	uint32_t evictions;
+
+	/** Number of DNS queries performed. */
+	uint32_t dns_queries;
+
+	/** Number of DNS queries avoided by the address cache. */
+	uint32_t dns_cache_hits;
+};
+
 /**
  * @brief REST client request.
  *
@@ -168,6 +194,25 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
  */
 void rest_client_request_defaults_set(struct rest_client_req_context *req_ctx);
 
+/**
+ * @brief Get connection pool statistics.
+ *
+ * @details Requires @kconfig{CONFIG_REST_CLIENT_CONN_POOL}. The ratio of @c reuses to
+ *          @c connects tells how many connection setups and TLS handshakes were avoided.
+ *
+ * @param[out] stats Statistics since boot.
+ */
+void rest_client_pool_stats_get(struct rest_client_pool_stats *stats);
+
+/**
+ * @brief Close all pooled connections and clear the DNS cache.
+ *
+ * @details Requires @kconfig{CONFIG_REST_CLIENT_CONN_POOL}. Call this, for example, when the
+ *          network connection is lost or before entering a low-power state, so that pooled
+ *          sockets do not hold modem resources.
+ */
+void rest_client_pool_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
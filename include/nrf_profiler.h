@@ -48,7 +48,7 @@ extern struct nrf_profiler_event_enabled_bm _nrf_profiler_event_enabled_bm;
 
 /** @brief Number of event types registered in the Profiler.
  */
-extern uint8_t nrf_profiler_num_events;
+extern uint16_t nrf_profiler_num_events;
 
 
 /** @brief Data types for profiling.
@@ -293,6 +293,9 @@ static inline void nrf_profiler_log_add_mem_address(struct log_event_buf *buf,
 /** @brief Send data from the buffer to the host.
  *
  * This function only sends data that is already stored in the buffer.
+ * The data is queued without blocking and the function can be called from
+ * any context. If there is no space for the data, the event is dropped and
+ * the number of dropped events is reported to the host in a separate event.
  * Use @ref nrf_profiler_log_encode_uint32, @ref nrf_profiler_log_encode_int32,
  * @ref nrf_profiler_log_encode_uint16, @ref nrf_profiler_log_encode_int16,
  * @ref nrf_profiler_log_encode_uint8, @ref nrf_profiler_log_encode_int8,
@@ -311,6 +314,35 @@ static inline void nrf_profiler_log_send(struct log_event_buf *buf,
 #endif
 
 
+/** @brief Get the number of events dropped because there was no space for them.
+ *
+ * @return Number of dropped events since the Profiler was initialized.
+ */
+#ifdef CONFIG_NRF_PROFILER_NORDIC
+uint32_t nrf_profiler_dropped_count_get(void);
+#else
+static inline uint32_t nrf_profiler_dropped_count_get(void) {return 0; }
+#endif
+
+
+/** @brief Read the event records from the RAM backend.
+ *
+ * Each record consists of the 16-bit event type ID, the 32-bit timestamp
+ * and the event data, in the format the host tools read from the other
+ * backends. Only whole records are copied, so the buffer must be at least
+ * CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN bytes long. The function must not
+ * be called from multiple contexts at the same time.
+ *
+ * @param buf Buffer for the records.
+ * @param len Size of the buffer.
+ *
+ * @return Number of bytes copied to the buffer.
+ */
+#ifdef CONFIG_NRF_PROFILER_NORDIC_BACKEND_RAM
+size_t nrf_profiler_ram_read(uint8_t *buf, size_t len);
+#endif
+
+
 /**
  * @}
  */
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/location.h>
+#include <modem/lte_lc.h>
+#include <net/wifi_location_common.h>
+#if defined(CONFIG_LOCATION_CACHE_PERSIST)
+#include <zephyr/settings/settings.h>
+#include <date_time.h>
+#endif
+
+#include "location_cache.h"
+
+LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
+
+#define LOCATION_CACHE_SETTINGS_KEY "location/cache"
+
+/* Radio environment an entry was stored for. */
+struct location_cache_key {
+	/* Serving cell, cell_id is LTE_LC_CELL_EUTRAN_ID_INVALID if cellular was not used. */
+	uint32_t cell_id;
+	uint32_t tac;
+	uint16_t mcc;
+	uint16_t mnc;
+	/* Strongest access points, zero count if Wi-Fi was not used. */
+	uint8_t bssid_cnt;
+	uint8_t bssid[CONFIG_LOCATION_CACHE_WIFI_AP_CNT][WIFI_MAC_ADDR_LEN];
+};
+
+struct location_cache_entry {
+	struct location_cache_key key;
+	double latitude;
+	double longitude;
+	float accuracy;
+	/* Unix time in milliseconds if persisted, uptime otherwise. */
+	int64_t timestamp;
+	bool valid;
+};
+
+static struct location_cache_entry cache[CONFIG_LOCATION_CACHE_SIZE];
+static K_MUTEX_DEFINE(cache_lock);
+
+/* Key of the last lookup, used when the cloud result is stored. */
+static struct location_cache_key pending_key;
+static bool pending_valid;
+
+static bool last_hit;
+static uint32_t hits;
+static uint32_t misses;
+
+static bool location_cache_time_get(int64_t *now)
+{
+#if defined(CONFIG_LOCATION_CACHE_PERSIST)
+	/* Uptime cannot be compared across reboots, so use real time for stored entries */
+	return date_time_now(now) == 0;
+#else
+	*now = k_uptime_get();
+	return true;
+#endif
+}
+
+static void location_cache_key_build(const struct lte_lc_cells_info *cell_data,
+				     const struct wifi_scan_info *wifi_data,
+				     struct location_cache_key *key)
+{
+	memset(key, 0, sizeof(*key));
+	key->cell_id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+
+	if (cell_data != NULL) {
+		key->cell_id = cell_data->current_cell.id;
+		key->tac = cell_data->current_cell.tac;
+		key->mcc = cell_data->current_cell.mcc;
+		key->mnc = cell_data->current_cell.mnc;
+	}
+
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+	bool used[CONFIG_LOCATION_METHOD_WIFI_SCANNING_RESULTS_MAX_CNT] = { 0 };
+
+	if (wifi_data == NULL) {
+		return;
+	}
+
+	/* Select the strongest access points as they are the most likely to be seen again */
+	while (key->bssid_cnt < CONFIG_LOCATION_CACHE_WIFI_AP_CNT) {
+		int best = -1;
+
+		for (int i = 0; i < MIN(wifi_data->cnt, ARRAY_SIZE(used)); i++) {
+			if (!used[i] &&
+			    (best < 0 || wifi_data->ap_info[i].rssi > wifi_data->ap_info[best].rssi)) {
+				best = i;
+			}
+		}
+
+		if (best < 0) {
+			break;
+		}
+
+		used[best] = true;
+		memcpy(key->bssid[key->bssid_cnt++], wifi_data->ap_info[best].mac,
+		       WIFI_MAC_ADDR_LEN);
+	}
+#endif
+}
+
+/* Returns the Wi-Fi similarity of the keys in percent, or -1 if they do not match. */
+static int location_cache_key_match(const struct location_cache_key *a,
+				    const struct location_cache_key *b)
+{
+	int common = 0;
+
+	if (a->cell_id != b->cell_id || a->tac != b->tac ||
+	    a->mcc != b->mcc || a->mnc != b->mnc) {
+		return -1;
+	}
+
+	if (a->bssid_cnt == 0 || b->bssid_cnt == 0) {
+		return (a->bssid_cnt == b->bssid_cnt) ? 100 : -1;
+	}
+
+	for (int i = 0; i < a->bssid_cnt; i++) {
+		for (int j = 0; j < b->bssid_cnt; j++) {
+			if (memcmp(a->bssid[i], b->bssid[j], WIFI_MAC_ADDR_LEN) == 0) {
+				common++;
+				break;
+			}
+		}
+	}
+
+	/* Share of the access points seen in either scan that are seen in both */
+	int similarity = common * 100 / (a->bssid_cnt + b->bssid_cnt - common);
+
+	return (similarity >= CONFIG_LOCATION_CACHE_WIFI_MATCH_PERCENT) ? similarity : -1;
+}
+
+static void location_cache_entry_save(int idx)
+{
+#if defined(CONFIG_LOCATION_CACHE_PERSIST)
+	char key[sizeof(LOCATION_CACHE_SETTINGS_KEY "/") + 2];
+	int err;
+
+	snprintk(key, sizeof(key), LOCATION_CACHE_SETTINGS_KEY "/%d", idx);
+
+	if (cache[idx].valid) {
+		err = settings_save_one(key, &cache[idx], sizeof(cache[idx]));
+	} else {
+		err = settings_delete(key);
+	}
+
+	if (err) {
+		LOG_WRN("Failed to store location cache entry, error: %d", err);
+	}
+#endif
+}
+
+int location_cache_lookup(const struct lte_lc_cells_info *cell_data,
+			  const struct wifi_scan_info *wifi_data,
+			  struct location_data *location)
+{
+	struct location_cache_entry *best = NULL;
+	int best_similarity = -1;
+	int64_t now;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	location_cache_key_build(cell_data, wifi_data, &pending_key);
+	pending_valid = true;
+	last_hit = false;
+
+	if (!location_cache_time_get(&now)) {
+		LOG_DBG("Time not known, location cache not used");
+		misses++;
+		k_mutex_unlock(&cache_lock);
+		return -ENOENT;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		int similarity;
+
+		if (!cache[i].valid) {
+			continue;
+		}
+
+		if (now - cache[i].timestamp > CONFIG_LOCATION_CACHE_TTL * MSEC_PER_SEC) {
+			cache[i].valid = false;
+			location_cache_entry_save(i);
+			continue;
+		}
+
+		similarity = location_cache_key_match(&pending_key, &cache[i].key);
+		if (similarity > best_similarity ||
+		    (similarity == best_similarity && similarity >= 0 &&
+		     cache[i].timestamp > best->timestamp)) {
+			best = &cache[i];
+			best_similarity = similarity;
+		}
+	}
+
+	if (best == NULL) {
+		misses++;
+		k_mutex_unlock(&cache_lock);
+		return -ENOENT;
+	}
+
+	location->latitude = best->latitude;
+	location->longitude = best->longitude;
+	location->accuracy = best->accuracy;
+
+	last_hit = true;
+	hits++;
+
+	/* Nothing new to store for this lookup */
+	pending_valid = false;
+
+	k_mutex_unlock(&cache_lock);
+
+	LOG_DBG("Location cache hit, similarity %d%%", best_similarity);
+
+	return 0;
+}
+
+void location_cache_store(const struct location_data *location)
+{
+	int idx = -1;
+	int64_t now;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!pending_valid) {
+		goto exit;
+	}
+
+	pending_valid = false;
+
+	if (location->accuracy > CONFIG_LOCATION_CACHE_ACCURACY_MAX) {
+		LOG_DBG("Location accuracy %d m too low for the cache", (int)location->accuracy);
+		goto exit;
+	}
+
+	if (!location_cache_time_get(&now)) {
+		goto exit;
+	}
+
+	/* Replace an entry for the same radio environment, a free entry or the oldest entry */
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].valid && location_cache_key_match(&pending_key, &cache[i].key) >= 0) {
+			idx = i;
+			break;
+		}
+
+		if (idx < 0 || (cache[idx].valid &&
+				(!cache[i].valid || cache[i].timestamp < cache[idx].timestamp))) {
+			idx = i;
+		}
+	}
+
+	cache[idx].key = pending_key;
+	cache[idx].latitude = location->latitude;
+	cache[idx].longitude = location->longitude;
+	cache[idx].accuracy = location->accuracy;
+	cache[idx].timestamp = now;
+	cache[idx].valid = true;
+
+	location_cache_entry_save(idx);
+
+exit:
+	k_mutex_unlock(&cache_lock);
+}
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+void location_cache_details_get(struct location_data_details *details)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	details->cache.hit = last_hit;
+	details->cache.hits = hits;
+	details->cache.misses = misses;
+
+	k_mutex_unlock(&cache_lock);
+}
+#endif
+
+void location_cache_clear(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].valid) {
+			cache[i].valid = false;
+			location_cache_entry_save(i);
+		}
+	}
+
+	pending_valid = false;
+
+	k_mutex_unlock(&cache_lock);
+}
+
+#if defined(CONFIG_LOCATION_CACHE_PERSIST)
+static int location_cache_settings_set(const char *key, size_t len_rd,
+				       settings_read_cb read_cb, void *cb_arg)
+{
+	long idx = strtol(key, NULL, 10);
+
+	if (idx < 0 || idx >= ARRAY_SIZE(cache) || len_rd != sizeof(cache[idx])) {
+		return -EINVAL;
+	}
+
+	if (read_cb(cb_arg, &cache[idx], sizeof(cache[idx])) != sizeof(cache[idx])) {
+		cache[idx].valid = false;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(location_cache, LOCATION_CACHE_SETTINGS_KEY, NULL,
+			       location_cache_settings_set, NULL, NULL);
+#endif
+
+void location_cache_init(void)
+{
+#if defined(CONFIG_LOCATION_CACHE_PERSIST)
+	int err;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	err = settings_load_subtree(LOCATION_CACHE_SETTINGS_KEY);
+	if (err) {
+		LOG_WRN("Failed to load location cache, error: %d", err);
+	}
+
+	k_mutex_unlock(&cache_lock);
+#endif
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LOCATION_CACHE_H
+#define LOCATION_CACHE_H
+
+#include <modem/location.h>
+#include <modem/lte_lc.h>
+#include <net/wifi_location_common.h>
+
+/**
+ * @brief Initialize the cache and load stored entries, if persistence is enabled.
+ */
+void location_cache_init(void);
+
+/**
+ * @brief Look up a cached location matching the given scan results.
+ *
+ * @details The scan results are also remembered so that a subsequent
+ * location_cache_store() call stores its result for them.
+ *
+ * @param[in] cell_data Cellular scan results or NULL.
+ * @param[in] wifi_data Wi-Fi scan results or NULL.
+ * @param[out] location Cached location. Only latitude, longitude and accuracy are set.
+ *
+ * @retval 0 Matching entry was found.
+ * @retval -ENOENT No matching entry.
+ */
+int location_cache_lookup(const struct lte_lc_cells_info *cell_data,
+			  const struct wifi_scan_info *wifi_data,
+			  struct location_data *location);
+
+/**
+ * @brief Store a cloud location result for the scan results given in the last lookup.
+ *
+ * @param[in] location Location received from the cloud service.
+ */
+void location_cache_store(const struct location_data *location);
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+/**
+ * @brief Fill cache details of the last lookup.
+ *
+ * @param[out] details Location details.
+ */
+void location_cache_details_get(struct location_data_details *details);
+#endif
+
+#endif /* LOCATION_CACHE_H */
@@ -24,6 +24,9 @@
 #if defined(CONFIG_LOCATION_METHOD_CELLULAR) || defined(CONFIG_LOCATION_METHOD_WIFI)
 #include "method_cloud_location.h"
 #endif
+#if defined(CONFIG_LOCATION_CACHE)
+#include "location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -564,6 +567,9 @@ void location_core_cloud_location_ext_result_set(
 	case LOCATION_EXT_RESULT_SUCCESS:
 		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
 		loc_req_info.current_event_data.location = *location;
+#if defined(CONFIG_LOCATION_CACHE)
+		location_cache_store(location);
+#endif
 		break;
 	case LOCATION_EXT_RESULT_UNKNOWN:
 		loc_req_info.current_event_data.id = LOCATION_EVT_RESULT_UNKNOWN;
@@ -595,6 +601,12 @@ static void location_core_event_details_get(struct location_event_data *event)
 
 		location_method_api_get(loc_req_info.current_method)->details_get(details);
 
+#if defined(CONFIG_LOCATION_CACHE)
+		if (loc_req_info.current_method != LOCATION_METHOD_GNSS) {
+			location_cache_details_get(details);
+		}
+#endif
+
 		details->elapsed_time_method = (uint32_t)
 			(k_uptime_get() - loc_req_info.elapsed_time_method_start_timestamp);
 	}
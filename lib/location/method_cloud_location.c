@@ -16,6 +16,7 @@
 #include "scan_cellular.h"
 #include "scan_wifi.h"
 #include "cloud_service.h"
+#include "location_cache.h"
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -93,6 +94,17 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 		goto end;
 	}
 
+#if defined(CONFIG_LOCATION_CACHE)
+	struct location_data cached_location = { 0 };
+
+	if (location_cache_lookup(scan_cellular_info, scan_wifi_info, &cached_location) == 0) {
+		LOG_DBG("Using cached location");
+		location_utils_systime_to_location_datetime(&cached_location.datetime);
+		location_core_event_cb(&cached_location);
+		goto end;
+	}
+#endif
+
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
 	struct location_data_cloud request = {
 #if defined(CONFIG_LOCATION_METHOD_CELLULAR)
@@ -146,6 +158,9 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 		location_result.latitude = location.latitude;
 		location_result.longitude = location.longitude;
 		location_result.accuracy = location.accuracy;
+#if defined(CONFIG_LOCATION_CACHE)
+		location_cache_store(&location_result);
+#endif
 		location_core_event_cb(&location_result);
 	}
 
@@ -224,5 +239,9 @@ int method_cloud_location_init(void)
 {
 	running = false;
 
+#if defined(CONFIG_LOCATION_CACHE)
+	location_cache_init();
+#endif
+
 	return 0;
 }
@@ -90,6 +90,14 @@ static struct bt_conn_le_cs_config cs_config;
 static uint16_t m_n_iqs[CONFIG_BT_RAS_MAX_ANTENNA_PATHS][CS_DE_NUM_CHANNELS];
 static cs_de_report_t m_cs_de_report;
 
+/* Parser of the ranging data, fed with each received segment of the peer ranging data. */
+static struct bt_ras_rreq_rd_parser rd_parser;
+static int32_t rd_parser_ranging_counter = PROCEDURE_COUNTER_NONE;
+
+/* Time from the end of the local procedure to the distance estimate. */
+static int64_t procedure_complete_ticks;
+static atomic_t procedure_latency_us;
+
 static void store_distance_estimates_in_buffer(cs_de_dist_estimates_t *p_estimates,
 					       struct distance_estimate_buffer *buffer)
 {
@@ -314,6 +322,35 @@ static bool process_step_data(struct bt_le_cs_subevent_step *local_step,
 	return true;
 }
 
+static void rd_parse_start(uint16_t ranging_counter)
+{
+	memset(&m_cs_de_report, 0x0, sizeof(cs_de_report_t));
+	memset(m_n_iqs, 0, sizeof(m_n_iqs));
+
+	bt_ras_rreq_rd_parser_init(&rd_parser, cs_config.role, process_ranging_header, NULL,
+				   process_step_data, &m_cs_de_report);
+	rd_parser_ranging_counter = ranging_counter;
+}
+
+static void ranging_data_segment_cb(struct bt_conn *conn, uint16_t ranging_counter,
+				    struct net_buf_simple *ranging_data)
+{
+	ARG_UNUSED(conn);
+
+	if (ranging_counter != most_recent_local_ranging_counter) {
+		return;
+	}
+
+	if (rd_parser_ranging_counter != ranging_counter) {
+		rd_parse_start(ranging_counter);
+	}
+
+	/* Extract the IQ values and RTT timings of the steps received so far, so that only the
+	 * distance estimation is left when the last segment is received.
+	 */
+	(void)bt_ras_rreq_rd_parser_feed(&rd_parser, ranging_data, &latest_local_steps);
+}
+
 static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int err)
 {
 	ARG_UNUSED(conn);
@@ -329,16 +366,22 @@ static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int
 			"data counter. (peer: %u, local: %u)",
 			ranging_counter, most_recent_local_ranging_counter);
 		net_buf_simple_reset(&latest_local_steps);
+		rd_parser_ranging_counter = PROCEDURE_COUNTER_NONE;
 		k_sem_give(&sem_local_steps);
 		return;
 	}
 
 	LOG_DBG("Ranging data received for ranging counter %d", ranging_counter);
 
-	if (latest_local_steps.len == 0) {
+	if (rd_parser_ranging_counter != ranging_counter) {
+		rd_parse_start(ranging_counter);
+	}
+
+	if (latest_local_steps.len == 0 && rd_parser.steps_parsed == 0) {
 		LOG_WRN("All subevents in ranging counter %u were aborted",
 			most_recent_local_ranging_counter);
 		net_buf_simple_reset(&latest_local_steps);
+		rd_parser_ranging_counter = PROCEDURE_COUNTER_NONE;
 		k_sem_give(&sem_local_steps);
 
 		if (!(ras_feature_bits & RAS_FEAT_REALTIME_RD)) {
@@ -347,12 +390,15 @@ static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int
 		return;
 	}
 
-	memset(&m_cs_de_report, 0x0, sizeof(cs_de_report_t));
-	memset(m_n_iqs, 0, sizeof(m_n_iqs));
+	/* Parse the remaining steps. Most of the steps were already parsed as the ranging data
+	 * segments were received.
+	 */
+	int parse_err = bt_ras_rreq_rd_parser_feed(&rd_parser, &latest_peer_steps,
+						   &latest_local_steps);
 
-	bt_ras_rreq_rd_subevent_data_parse(&latest_peer_steps, &latest_local_steps, cs_config.role,
-					   process_ranging_header, NULL, process_step_data,
-					   &m_cs_de_report);
+	if (!parse_err && (latest_local_steps.len != 0 || latest_peer_steps.len != 0)) {
+		LOG_WRN("Peer or local buffers not fully drained at the end of parsing.");
+	}
 
 	for (uint8_t ap = 0; ap < m_cs_de_report.n_ap; ap++) {
 		m_cs_de_report.distance_estimates[ap].ifft = NAN;
@@ -368,6 +414,7 @@ static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int
 	}
 
 	net_buf_simple_reset(&latest_local_steps);
+	rd_parser_ranging_counter = PROCEDURE_COUNTER_NONE;
 
 	if (!(ras_feature_bits & RAS_FEAT_REALTIME_RD)) {
 		net_buf_simple_reset(&latest_peer_steps);
@@ -377,6 +424,9 @@ static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int
 
 	cs_de_quality_t quality = cs_de_calc(&m_cs_de_report);
 
+	atomic_set(&procedure_latency_us,
+		   k_ticks_to_us_floor32(k_uptime_ticks() - procedure_complete_ticks));
+
 	if (quality == CS_DE_QUALITY_OK) {
 		for (uint8_t ap = 0; ap < m_cs_de_report.n_ap; ap++) {
 			if (m_cs_de_report.tone_quality[ap] == CS_DE_TONE_QUALITY_OK ||
@@ -433,6 +483,7 @@ static void subevent_result_cb(struct bt_conn *conn, struct bt_conn_le_cs_subeve
 	dropped_ranging_counter = PROCEDURE_COUNTER_NONE;
 
 	if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_COMPLETE) {
+		procedure_complete_ticks = k_uptime_ticks();
 		most_recent_local_ranging_counter =
 			bt_ras_rreq_get_ranging_counter(result->header.procedure_counter);
 	} else if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_ABORTED) {
@@ -910,6 +961,12 @@ int main(void)
 
 	const bool realtime_rd = ras_feature_bits & RAS_FEAT_REALTIME_RD;
 
+	err = bt_ras_rreq_segment_received_cb_register(connection, ranging_data_segment_cb);
+	if (err) {
+		LOG_ERR("RAS RREQ segment received callback register failed (err %d)", err);
+		return 0;
+	}
+
 	if (realtime_rd) {
 		err = bt_ras_rreq_realtime_rd_subscribe(connection,
 							&latest_peer_steps,
@@ -1022,6 +1079,8 @@ int main(void)
 				distance_estimates_print(ap);
 			}
 		}
+
+		LOG_INF("Latest procedure latency: %ld us", atomic_get(&procedure_latency_us));
 	}
 
 	return 0;
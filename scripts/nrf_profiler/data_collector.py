@@ -9,19 +9,26 @@ import signal
 import time
 from multiprocessing import Event, Process, active_children
 
+from file2stream import File2Stream
 from model_creator import ModelCreator
 from rtt2stream import Rtt2Stream
 from stream import Stream
+from uart2stream import Uart2Stream
 
 is_waiting = True
 def signal_handler(sig, frame):
     global is_waiting
     is_waiting = False
 
-def rtt2stream(stream, event, event_close, log_lvl_number):
+def rtt2stream(stream, event, event_close, backend, port, log_lvl_number):
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     try:
-        rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
+        if backend == 'uart':
+            rtt2s = Uart2Stream(stream, event_close, port, log_lvl=log_lvl_number)
+        elif backend == 'file':
+            rtt2s = File2Stream(stream, event_close, port, log_lvl=log_lvl_number)
+        else:
+            rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
         event.wait()
         rtt2s.read_and_transmit_data()
     except Exception as e:
@@ -51,8 +58,16 @@ def main():
     parser.add_argument('time', type=int, help='Time of collecting data [s]')
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    parser.add_argument('--backend', choices=['rtt', 'uart', 'file'], default='rtt',
+                        help='nrf_profiler backend used by the device')
+    parser.add_argument('--port',
+                        help='Serial port for the uart backend, path of the files without '
+                             'the extension for the file backend')
     args = parser.parse_args()
 
+    if args.backend != 'rtt' and args.port is None:
+        parser.error(f"--port is required for the {args.backend} backend")
+
     if args.log is not None:
         log_lvl_number = int(getattr(logging, args.log.upper(), None))
     else:
@@ -68,7 +83,8 @@ def main():
 
     processes = []
     processes.append((Process(target=rtt2stream,
-                                args=(streams[0], event, event_close_rtt2stream, log_lvl_number),
+                                args=(streams[0], event, event_close_rtt2stream,
+                                      args.backend, args.port, log_lvl_number),
                                 daemon=True),
                         event_close_rtt2stream))
     processes.append((Process(target=model_creator,
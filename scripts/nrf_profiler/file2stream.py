@@ -0,0 +1,110 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import logging
+import os
+import sys
+import time
+
+from stream import StreamError
+
+FileNordicConfig = {
+    'read_chunk_size': 8192,
+    'read_sleep_time': 0.01, # In seconds.
+    'descriptions_timeout': 20, # In seconds.
+}
+
+
+class File2Stream:
+    """Reads the files written by the file backend of a native_sim build."""
+
+    def __init__(self, out_stream, event_close, path, config=FileNordicConfig,
+                 log_lvl=logging.INFO):
+        self.config = config
+
+        self.out_stream = out_stream
+
+        self.event_close = event_close
+
+        self.logger = logging.getLogger('file2stream')
+        self.logger_console = logging.StreamHandler()
+        self.logger.setLevel(log_lvl)
+        self.log_format = logging.Formatter('[%(levelname)s] %(name)s: %(message)s')
+        self.logger_console.setFormatter(self.log_format)
+        self.logger.addHandler(self.logger_console)
+
+        self.info_path = path + '.info'
+        self.data_path = path + '.data'
+        self.data_file = None
+
+    def _read_all_events_descriptions(self):
+        start_time = time.time()
+        # Empty field is sent after last event description
+        while True:
+            if self.event_close.is_set():
+                self.logger.info("Module closed before receiving event descriptions.")
+                sys.exit()
+
+            if time.time() - start_time > self.config['descriptions_timeout']:
+                self.logger.error(f"Cannot read event descriptions from {self.info_path}")
+                sys.exit()
+
+            try:
+                with open(self.info_path, 'rb') as f:
+                    desc_buf = f.read()
+            except OSError:
+                desc_buf = b''
+
+            if desc_buf[-2:] == b'\n\n':
+                return desc_buf
+            time.sleep(0.1)
+
+    def _read_bytes(self):
+        if self.data_file is None:
+            if not os.path.exists(self.data_path):
+                return b''
+            self.data_file = open(self.data_path, 'rb')
+
+        return self.data_file.read(self.config['read_chunk_size'])
+
+    def read_and_transmit_data(self):
+        desc_buf = self._read_all_events_descriptions()
+        try:
+            self.out_stream.send_desc(desc_buf)
+        except StreamError as err:
+            self.logger.error(f"Error: {err}. Unable to send data")
+            sys.exit()
+
+        while True:
+            if self.event_close.is_set():
+                self.close()
+
+            buf = self._read_bytes()
+
+            if len(buf) > 0:
+                try:
+                    self.out_stream.send_ev(buf)
+                except StreamError as err:
+                    self.logger.error(f"Error: {err}. Unable to send data")
+                    sys.exit()
+            else:
+                time.sleep(self.config['read_sleep_time'])
+
+    def close(self):
+        self.logger.info("Real time transmission closed")
+
+        # Read remaining data from the file and send it.
+        buf = self._read_bytes()
+        while len(buf) > 0:
+            try:
+                self.out_stream.send_ev(buf)
+            except StreamError as err:
+                self.logger.error(f"Error: {err}. Unable to send remaining data")
+                break
+            buf = self._read_bytes()
+
+        if self.data_file is not None:
+            self.data_file.close()
+        sys.exit()
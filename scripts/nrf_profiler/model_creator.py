@@ -21,7 +21,9 @@ class Command(Enum):
     STOP = 2
     INFO = 3
 
+# Sent by devices that use 8-bit event type IDs, they stop sending events on buffer overflow
 NRF_PROFILER_FATAL_ERROR_EVENT_NAME = "_nrf_profiler_fatal_error_event_"
+NRF_PROFILER_DROPPED_EVENTS_EVENT_NAME = "_nrf_profiler_dropped_events_"
 
 class ModelCreator:
 
@@ -51,6 +53,10 @@ class ModelCreator:
         self.timestamp_overflows = 0
         self.after_half = False
 
+        # Devices that do not report the size use 8-bit event type IDs
+        self.event_id_size = 1
+        self.dropped_events = 0
+
         self.processed_events = ProcessedEvents()
         self.temp_events = []
         self.submitted_event_type = None
@@ -138,8 +144,15 @@ class ModelCreator:
                 raise ValueError(f"Incorrect value: {temp_data}. Value is expected to be bigger than 0.")
             return temp_data
 
+        def event_id_size_decode(data):
+            temp_data = int(data, 10)
+            if temp_data not in (1, 2):
+                raise ValueError(f"Incorrect value: {temp_data}. Value is expected to be 1 or 2.")
+            return temp_data
+
         DECODE_MAP = {
-            "sys_clock_hw_cycles_per_sec":  sys_clock_hw_cycles_per_sec_decode
+            "sys_clock_hw_cycles_per_sec":  sys_clock_hw_cycles_per_sec_decode,
+            "event_id_size": event_id_size_decode
         }
         ret_dict = {}
         items = data.strip().splitlines()
@@ -177,6 +190,7 @@ class ModelCreator:
         sys_cfg_start_tag = '<sys_config_start>\n'
         sys_cfg_stop_tag = '<sys_config_stop>\n'
         sys_clock_hw_cycles_per_sec_tag = 'sys_clock_hw_cycles_per_sec'
+        event_id_size_tag = 'event_id_size'
 
         in_data = bytes.decode()
         ev_info = self.decode_by_markers(in_data, ev_start_tag, ev_stop_tag)
@@ -191,6 +205,8 @@ class ModelCreator:
                               f"key {sys_clock_hw_cycles_per_sec_tag} is not provided at all.")
             sys.exit()
 
+        self.event_id_size = sys_dict.get(event_id_size_tag, 1)
+
         f = StringIO(ev_info)
         reader = csv.reader(f, delimiter=',')
         for row in reader:
@@ -222,7 +238,7 @@ class ModelCreator:
 
     def _read_single_event(self):
         id = int.from_bytes(
-            self._read_bytes(1),
+            self._read_bytes(self.event_id_size),
             byteorder=self.config['byteorder'],
             signed=False)
         et = self.raw_data.registered_events_types[id]
@@ -317,9 +333,15 @@ class ModelCreator:
                 self.event_types_filename)
         while True:
             event = self._read_single_event()
-            if self.raw_data.registered_events_types[event.type_id].name == NRF_PROFILER_FATAL_ERROR_EVENT_NAME:
+            event_name = self.raw_data.registered_events_types[event.type_id].name
+            if event_name == NRF_PROFILER_FATAL_ERROR_EVENT_NAME:
                 self.logger.error("Fatal error of Profiler on device! Event has been dropped. "
                                   "Data buffer has overflown. No more events will be received.")
+            elif event_name == NRF_PROFILER_DROPPED_EVENTS_EVENT_NAME:
+                self.dropped_events += event.data[0]
+                self.logger.warning(f"{event.data[0]} events dropped on device, "
+                                    f"{self.dropped_events} in total. "
+                                    "Data buffer has overflown.")
 
             if event.type_id == self.event_processing_start_id:
                 self.start_event = event
@@ -8,20 +8,27 @@ import logging
 import signal
 from multiprocessing import Event, Process, active_children
 
+from file2stream import File2Stream
 from model_creator import ModelCreator
 from plot_nordic import PlotNordic
 from rtt2stream import Rtt2Stream
 from stream import Stream
+from uart2stream import Uart2Stream
 
 is_waiting = True
 def signal_handler(sig, frame):
     global is_waiting
     is_waiting = False
 
-def rtt2stream(stream, event_plot, event_model_creator, event_close, log_lvl_number):
+def rtt2stream(stream, event_plot, event_model_creator, event_close, backend, port, log_lvl_number):
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     try:
-        rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
+        if backend == 'uart':
+            rtt2s = Uart2Stream(stream, event_close, port, log_lvl=log_lvl_number)
+        elif backend == 'file':
+            rtt2s = File2Stream(stream, event_close, port, log_lvl=log_lvl_number)
+        else:
+            rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
         event_plot.wait()
         event_model_creator.wait()
         rtt2s.read_and_transmit_data()
@@ -58,8 +65,16 @@ def main():
         allow_abbrev=False)
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    parser.add_argument('--backend', choices=['rtt', 'uart', 'file'], default='rtt',
+                        help='nrf_profiler backend used by the device')
+    parser.add_argument('--port',
+                        help='Serial port for the uart backend, path of the files without '
+                             'the extension for the file backend')
     args = parser.parse_args()
 
+    if args.backend != 'rtt' and args.port is None:
+        parser.error(f"--port is required for the {args.backend} backend")
+
     if args.log is not None:
         log_lvl_number = int(getattr(logging, args.log.upper(), None))
     else:
@@ -78,7 +93,8 @@ def main():
     processes = []
     processes.append((Process(target=rtt2stream,
                               args=(streams[0], event_plot, event_model_creator,
-                                    event_close_rtt2stream, log_lvl_number),
+                                    event_close_rtt2stream, args.backend, args.port,
+                                    log_lvl_number),
                               daemon=True),
                       event_close_rtt2stream))
     processes.append((Process(target=model_creator,
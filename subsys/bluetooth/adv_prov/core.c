@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
 #include <bluetooth/adv_prov.h>
 
 #include <zephyr/logging/log.h>
@@ -14,6 +15,19 @@ enum provider_set {
 	PROVIDER_SET_SD
 };
 
+#define ADV_SET_CNT COND_CODE_1(CONFIG_BT_EXT_ADV, (CONFIG_BT_EXT_ADV_MAX_ADV_SET), (1))
+
+struct payload_cache {
+	uint8_t buf[CONFIG_BT_ADV_PROV_PAYLOAD_CACHE_SIZE];
+	size_t len;
+	bool valid;
+};
+
+static struct payload_cache payload_cache[ADV_SET_CNT];
+static K_MUTEX_DEFINE(payload_cache_lock);
+
+static atomic_t provider_cache_hits;
+static atomic_t payload_update_skips;
 
 static void get_section_ptrs(enum provider_set set,
 			     const struct bt_le_adv_prov_provider **start,
@@ -75,6 +89,74 @@ static void update_common_feedback(struct bt_le_adv_prov_feedback *common_fb,
 	common_fb->grace_period_s = MAX(common_fb->grace_period_s, fb->grace_period_s);
 }
 
+static bool provider_cache_usable(const struct bt_le_adv_prov_cache *cache,
+				  const struct bt_le_adv_prov_adv_state *state)
+{
+	/* The RPA rotation and the new advertising session always require the data refresh. */
+	if (!cache->valid || atomic_get(&cache->dirty) ||
+	    state->new_adv_session || state->rpa_rotated) {
+		return false;
+	}
+
+	return (cache->state.pairing_mode == state->pairing_mode) &&
+	       (cache->state.in_grace_period == state->in_grace_period) &&
+	       (cache->state.adv_handle == state->adv_handle);
+}
+
+static int provider_data_get(const struct bt_le_adv_prov_provider *p, struct bt_data *d,
+			     const struct bt_le_adv_prov_adv_state *state,
+			     struct bt_le_adv_prov_feedback *fb)
+{
+	struct bt_le_adv_prov_cache *cache = p->cache;
+
+	if (!cache) {
+		return p->get_data(d, state, fb);
+	}
+
+	if (provider_cache_usable(cache, state)) {
+		atomic_inc(&provider_cache_hits);
+		*d = cache->d;
+		*fb = cache->fb;
+
+		return cache->err;
+	}
+
+	/* Clear the flag before calling the provider not to lose an invalidation that happens
+	 * in the meantime.
+	 */
+	atomic_clear(&cache->dirty);
+
+	cache->err = p->get_data(d, state, fb);
+	cache->d = *d;
+	cache->fb = *fb;
+	cache->state = *state;
+	cache->valid = (!cache->err || (cache->err == -ENOENT));
+
+	return cache->err;
+}
+
+static void invalidate_providers(enum provider_set set, bt_le_adv_prov_data_get get_data_fn)
+{
+	const struct bt_le_adv_prov_provider *start;
+	const struct bt_le_adv_prov_provider *end;
+
+	get_section_ptrs(set, &start, &end);
+
+	for (const struct bt_le_adv_prov_provider *p = start; p < end; p++) {
+		if (p->cache && (p->get_data == get_data_fn)) {
+			atomic_set(&p->cache->dirty, true);
+		}
+	}
+}
+
+void bt_le_adv_prov_invalidate(bt_le_adv_prov_data_get get_data_fn)
+{
+	__ASSERT_NO_MSG(get_data_fn);
+
+	invalidate_providers(PROVIDER_SET_AD, get_data_fn);
+	invalidate_providers(PROVIDER_SET_SD, get_data_fn);
+}
+
 static int get_providers_data(enum provider_set set, struct bt_data *d, size_t *d_len,
 			      const struct bt_le_adv_prov_adv_state *state,
 			      struct bt_le_adv_prov_feedback *fb)
@@ -95,7 +177,7 @@ static int get_providers_data(enum provider_set set, struct bt_data *d, size_t *
 
 	for (const struct bt_le_adv_prov_provider *p = start; p < end; p++) {
 		memset(fb, 0, sizeof(*fb));
-		err = p->get_data(&d[pos], state, fb);
+		err = provider_data_get(p, &d[pos], state, fb);
 
 		if (!err) {
 			pos++;
@@ -128,3 +210,110 @@ int bt_le_adv_prov_get_sd(struct bt_data *sd, size_t *sd_len,
 {
 	return get_providers_data(PROVIDER_SET_SD, sd, sd_len, state, fb);
 }
+
+static size_t payload_data_size(const struct bt_data *d, size_t d_len)
+{
+	/* Number of elements followed by type, length and data of each element. */
+	size_t size = sizeof(uint8_t);
+
+	for (size_t i = 0; i < d_len; i++) {
+		size += 2 * sizeof(uint8_t) + d[i].data_len;
+	}
+
+	return size;
+}
+
+static bool payload_byte_update(struct payload_cache *cache, size_t *pos, uint8_t byte)
+{
+	bool changed = (cache->buf[*pos] != byte);
+
+	cache->buf[*pos] = byte;
+	(*pos)++;
+
+	return changed;
+}
+
+static bool payload_data_update(struct payload_cache *cache, size_t *pos,
+				const struct bt_data *d, size_t d_len)
+{
+	bool changed = payload_byte_update(cache, pos, d_len);
+
+	for (size_t i = 0; i < d_len; i++) {
+		changed |= payload_byte_update(cache, pos, d[i].type);
+		changed |= payload_byte_update(cache, pos, d[i].data_len);
+
+		if (memcmp(&cache->buf[*pos], d[i].data, d[i].data_len)) {
+			memcpy(&cache->buf[*pos], d[i].data, d[i].data_len);
+			changed = true;
+		}
+
+		*pos += d[i].data_len;
+	}
+
+	return changed;
+}
+
+bool bt_le_adv_prov_payload_changed(const struct bt_le_adv_prov_adv_state *state,
+				    const struct bt_data *ad, size_t ad_len,
+				    const struct bt_data *sd, size_t sd_len)
+{
+	struct payload_cache *cache;
+	size_t len;
+	size_t pos = 0;
+	bool changed;
+
+	__ASSERT_NO_MSG(state);
+
+	if (state->adv_handle >= ARRAY_SIZE(payload_cache)) {
+		LOG_WRN("No payload cache for advertising handle %" PRIu8, state->adv_handle);
+		return true;
+	}
+
+	cache = &payload_cache[state->adv_handle];
+	len = payload_data_size(ad, ad_len) + payload_data_size(sd, sd_len);
+
+	k_mutex_lock(&payload_cache_lock, K_FOREVER);
+
+	if (len > sizeof(cache->buf)) {
+		LOG_DBG("Payload too big to be cached: %zu", len);
+		cache->valid = false;
+		changed = true;
+	} else {
+		/* The payload is compared with the cached one while being copied to the cache. */
+		changed = payload_data_update(cache, &pos, ad, ad_len);
+		changed |= payload_data_update(cache, &pos, sd, sd_len);
+		changed |= (!cache->valid || (cache->len != len) || state->new_adv_session);
+
+		cache->len = len;
+		cache->valid = true;
+	}
+
+	k_mutex_unlock(&payload_cache_lock);
+
+	if (!changed) {
+		atomic_inc(&payload_update_skips);
+		LOG_DBG("Payload update skipped for advertising handle %" PRIu8,
+			state->adv_handle);
+	}
+
+	return changed;
+}
+
+void bt_le_adv_prov_payload_invalidate(uint8_t adv_handle)
+{
+	if (adv_handle >= ARRAY_SIZE(payload_cache)) {
+		return;
+	}
+
+	k_mutex_lock(&payload_cache_lock, K_FOREVER);
+	payload_cache[adv_handle].valid = false;
+	k_mutex_unlock(&payload_cache_lock);
+}
+
+void bt_le_adv_prov_stats_get(struct bt_le_adv_prov_stats *stats)
+{
+	__ASSERT_NO_MSG(stats);
+
+	stats->provider_cache_hits = atomic_get(&provider_cache_hits);
+	stats->payload_update_skips = atomic_get(&payload_update_skips);
+}
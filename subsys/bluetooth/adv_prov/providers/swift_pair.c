@@ -11,10 +11,14 @@
 
 static bool enabled = true;
 
+static int get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *state,
+		    struct bt_le_adv_prov_feedback *fb);
+
 
 void bt_le_adv_prov_swift_pair_enable(bool enable)
 {
 	enabled = enable;
+	bt_le_adv_prov_invalidate(get_data);
 }
 
 static int get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *state,
@@ -44,4 +48,4 @@ static int get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *s
 	return 0;
 }
 
-BT_LE_ADV_PROV_AD_PROVIDER_REGISTER(swift_pair, get_data);
+BT_LE_ADV_PROV_AD_PROVIDER_REGISTER_CACHED(swift_pair, get_data);
@@ -59,4 +59,4 @@ static int get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *s
 	return err;
 }
 
-BT_LE_ADV_PROV_AD_PROVIDER_REGISTER(tx_power, get_data);
+BT_LE_ADV_PROV_AD_PROVIDER_REGISTER_CACHED(tx_power, get_data);
@@ -5,13 +5,40 @@
  */
 
 #include <bluetooth/conn_ctx.h>
+#include <bluetooth/mem_arena.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(bt_conn_ctx, CONFIG_BT_CONN_CTX_LOG_LEVEL);
 
-static void bt_conn_ctx_mem_free(struct k_mem_slab *mem_slab, void **data)
+static int bt_conn_ctx_mem_alloc(struct bt_conn_ctx_lib *ctx_lib, void **data)
 {
-	k_mem_slab_free(mem_slab, *data);
+#if defined(CONFIG_BT_CONN_CTX_MEM_ARENA)
+	if (ctx_lib->ctx_cnt >= ctx_lib->max_ctx) {
+		return -ENOMEM;
+	}
+
+	*data = bt_mem_arena_alloc(BT_MEM_ARENA_USER_CONN_CTX, ctx_lib->block_size,
+				   CONFIG_BT_CONN_CTX_MEM_BUF_ALIGN);
+	if (!*data) {
+		return -ENOMEM;
+	}
+
+	ctx_lib->ctx_cnt++;
+
+	return 0;
+#else
+	return k_mem_slab_alloc(ctx_lib->mem_slab, data, K_NO_WAIT);
+#endif /* defined(CONFIG_BT_CONN_CTX_MEM_ARENA) */
+}
+
+static void bt_conn_ctx_mem_free(struct bt_conn_ctx_lib *ctx_lib, void **data)
+{
+#if defined(CONFIG_BT_CONN_CTX_MEM_ARENA)
+	bt_mem_arena_free(BT_MEM_ARENA_USER_CONN_CTX, *data, ctx_lib->block_size);
+	ctx_lib->ctx_cnt--;
+#else
+	k_mem_slab_free(ctx_lib->mem_slab, *data);
+#endif /* defined(CONFIG_BT_CONN_CTX_MEM_ARENA) */
 	*data = NULL;
 }
 
@@ -20,38 +47,35 @@ void *bt_conn_ctx_alloc(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	int err = -ENOMEM;
-	struct bt_conn_ctx *ctx;
+	int err;
+	uint8_t index = bt_conn_index(conn);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[index];
 
 	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		ctx = &ctx_lib->ctx[i];
-
-		if (!ctx->conn && !ctx->data) {
-			err = k_mem_slab_alloc(ctx_lib->mem_slab,
-					       &ctx->data,
-					       K_NO_WAIT);
-			if (!err) {
-				ctx->conn = conn;
-
-				LOG_DBG("The memory for the connection context "
-					"has been allocated, conn %p, index: %u",
-					(void *)conn, i);
+	if (ctx->conn || ctx->data) {
+		LOG_WRN("The memory for the connection context is already allocated, "
+			"conn %p, index: %u", (void *)conn, index);
+		k_mutex_unlock(ctx_lib->mutex);
 
-				return ctx->data;
+		return NULL;
+	}
 
-			} else {
-				break;
-			}
+	err = bt_conn_ctx_mem_alloc(ctx_lib, &ctx->data);
+	if (err) {
+		LOG_WRN("Memory can not be allocated");
+		k_mutex_unlock(ctx_lib->mutex);
 
-		}
+		return NULL;
 	}
 
-	LOG_WRN("Memory can not be allocated");
-	k_mutex_unlock(ctx_lib->mutex);
+	ctx->conn = conn;
 
-	return NULL;
+	LOG_DBG("The memory for the connection context "
+		"has been allocated, conn %p, index: %u",
+		(void *)conn, index);
+
+	return ctx->data;
 }
 
 int bt_conn_ctx_free(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
@@ -59,24 +83,22 @@ int bt_conn_ctx_free(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
+	uint8_t index = bt_conn_index(conn);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[index];
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
+	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-		if (ctx->conn == conn) {
-			bt_conn_ctx_mem_free(ctx_lib->mem_slab, &ctx->data);
-			ctx->conn = NULL;
-			ctx->data = NULL;
+	if (ctx->conn == conn) {
+		bt_conn_ctx_mem_free(ctx_lib, &ctx->data);
+		ctx->conn = NULL;
 
-			LOG_DBG("The context memory for the connection "
-				"has been released, conn %p index %u",
-				(void *)conn, i);
+		LOG_DBG("The context memory for the connection "
+			"has been released, conn %p index %u",
+			(void *)conn, index);
 
-			k_mutex_unlock(ctx_lib->mutex);
+		k_mutex_unlock(ctx_lib->mutex);
 
-			return 0;
-		}
+		return 0;
 	}
 
 	LOG_WRN("There is no allocated memory for this connection");
@@ -95,9 +117,8 @@ void bt_conn_ctx_free_all(struct bt_conn_ctx_lib *ctx_lib)
 		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
 
 		if (ctx->data != NULL) {
-			k_mem_slab_free(ctx_lib->mem_slab, (void *)ctx->data);
+			bt_conn_ctx_mem_free(ctx_lib, &ctx->data);
 			ctx->conn = NULL;
-			ctx->data = NULL;
 		}
 	}
 
@@ -111,16 +132,14 @@ void *bt_conn_ctx_get(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[bt_conn_index(conn)];
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
+	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-		if (ctx->conn == conn) {
-			LOG_DBG("Memory block found for the connection");
+	if (ctx->conn == conn) {
+		LOG_DBG("Memory block found for the connection");
 
-			return ctx->data;
-		}
+		return ctx->data;
 	}
 
 	LOG_WRN("No memory block for connection");
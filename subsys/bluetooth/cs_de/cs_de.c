@@ -29,8 +29,26 @@ LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
 #define PHASE_INVALID (2 * PI)
 
 #define CHANNEL_SPACING_HZ (1e6f)
-#define NORMAL_PEAK_TO_NULL                                                                        \
-	((CONFIG_BT_CS_DE_NFFT_SIZE + CS_DE_NUM_CHANNELS - 1) / (CS_DE_NUM_CHANNELS))
+#define NORMAL_PEAK_TO_NULL(nfft) ((int32_t)(((nfft) + CS_DE_NUM_CHANNELS - 1) / (CS_DE_NUM_CHANNELS)))
+
+/* The zoomed IFFT finds the peak in a coarse IFFT and then evaluates the IFFT with the
+ * resolution of CONFIG_BT_CS_DE_NFFT_SIZE only around that peak.
+ */
+#define ZOOM_COARSE_NFFT 256
+#define ZOOM_FACTOR	 (CONFIG_BT_CS_DE_NFFT_SIZE / ZOOM_COARSE_NFFT)
+
+BUILD_ASSERT(ZOOM_COARSE_NFFT > CS_DE_NUM_CHANNELS);
+BUILD_ASSERT(CONFIG_BT_CS_DE_NFFT_SIZE >= 2 * ZOOM_COARSE_NFFT);
+
+#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
+#define NFFT_INSTANCE (&arm_cfft_sR_f32_len512)
+#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
+#define NFFT_INSTANCE (&arm_cfft_sR_f32_len1024)
+#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
+#define NFFT_INSTANCE (&arm_cfft_sR_f32_len2048)
+#else
+#error
+#endif
 
 static float m_iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
 
@@ -90,7 +108,9 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
 
 		p_report->distance_estimates[ap].phase_slope = cs_de_phase_slope(m_iq_scratch_mem);
 
-		p_report->distance_estimates[ap].ifft = cs_de_ifft(m_iq_scratch_mem);
+		p_report->distance_estimates[ap].ifft = IS_ENABLED(CONFIG_BT_CS_DE_ZOOM_FFT) ?
+								cs_de_ifft_zoom(m_iq_scratch_mem) :
+								cs_de_ifft(m_iq_scratch_mem);
 
 		if (set_best_estimate(&p_report->distance_estimates[ap]) == CS_DE_QUALITY_OK) {
 			estimation_quality = CS_DE_QUALITY_OK;
@@ -135,8 +155,8 @@ float cs_de_phase_slope(float iq_tones_comb[CS_DE_NUM_CHANNELS * 2])
 	return dist;
 }
 
-static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
-						   const float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+static float calculate_ifft_peak_index_to_distance(int32_t peak_index, const float *ifft_mag,
+						   uint32_t nfft)
 {
 	/* Peak interpolation */
 	float prompt = ifft_mag[peak_index];
@@ -144,10 +164,8 @@ static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
 	/* Find early and late magnitudes, if peak_index is at either first or last point in the
 	 * IFFT, wrap around since the IFFT is periodic.
 	 */
-	float early = (peak_index != 0) ? ifft_mag[peak_index - 1]
-					: ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE - 1];
-	float late = (peak_index != (CONFIG_BT_CS_DE_NFFT_SIZE - 1)) ? ifft_mag[peak_index + 1]
-								     : ifft_mag[0];
+	float early = (peak_index != 0) ? ifft_mag[peak_index - 1] : ifft_mag[nfft - 1];
+	float late = (peak_index != (nfft - 1)) ? ifft_mag[peak_index + 1] : ifft_mag[0];
 	/* Avoid interpolation of early, prompt and late if left null compensation has taken place.
 	 */
 	float t_hat = (prompt >= early && prompt >= late)
@@ -155,23 +173,23 @@ static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
 			      : 0.0f;
 
 	float distance = ((peak_index + t_hat) * SPEED_OF_LIGHT_M_PER_S) /
-			 (2.0f * CONFIG_BT_CS_DE_NFFT_SIZE * CHANNEL_SPACING_HZ);
+			 (2.0f * nfft * CHANNEL_SPACING_HZ);
 
-	if (peak_index >= (CONFIG_BT_CS_DE_NFFT_SIZE - 2) || distance < 0.0f) {
+	if (peak_index >= (nfft - 2) || distance < 0.0f) {
 		distance = NAN;
 	}
 	return distance;
 }
 
-static int32_t calculate_ifft_find_left_null(int32_t peak_index,
-					     float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+static int32_t calculate_ifft_find_left_null(int32_t peak_index, const float *ifft_mag,
+					     uint32_t nfft)
 {
 	int32_t left_null_index = peak_index;
 	bool found_left_null = false;
 
 	while (!found_left_null) {
 		int32_t next_left_null_index =
-			left_null_index == 0 ? CONFIG_BT_CS_DE_NFFT_SIZE - 1 : left_null_index - 1;
+			left_null_index == 0 ? nfft - 1 : left_null_index - 1;
 		/* This is a heuristic, probably non-optimal definition of a null. */
 		if ((ifft_mag[left_null_index] * 2 > ifft_mag[peak_index] ||
 		     ifft_mag[left_null_index] > 1.10f * ifft_mag[next_left_null_index]) &&
@@ -185,39 +203,41 @@ static int32_t calculate_ifft_find_left_null(int32_t peak_index,
 	return left_null_index;
 }
 
-static uint32_t calculate_distance_to_left_null(uint32_t peak_index, uint32_t left_null_index)
+static uint32_t calculate_distance_to_left_null(uint32_t peak_index, uint32_t left_null_index,
+						uint32_t nfft)
 {
 	return left_null_index > peak_index
-		       ? (CONFIG_BT_CS_DE_NFFT_SIZE + peak_index - left_null_index)
+		       ? (nfft + peak_index - left_null_index)
 		       : (peak_index - left_null_index);
 }
 
 static int32_t calculate_left_null_compensation_of_peak(int32_t peak_index,
-							float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+							const float *ifft_mag, uint32_t nfft)
 {
 	int32_t compensated_peak_index = peak_index;
-	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_mag);
+	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_mag, nfft);
 	uint32_t peak_to_null_distance =
-		calculate_distance_to_left_null(peak_index, left_null_index);
-	if (peak_to_null_distance > NORMAL_PEAK_TO_NULL) {
+		calculate_distance_to_left_null(peak_index, left_null_index, nfft);
+	if (peak_to_null_distance > NORMAL_PEAK_TO_NULL(nfft)) {
 		if (left_null_index > peak_index) {
-			compensated_peak_index = (left_null_index + NORMAL_PEAK_TO_NULL -
-						  CONFIG_BT_CS_DE_NFFT_SIZE) > 0
-							 ? (left_null_index + NORMAL_PEAK_TO_NULL -
-							    CONFIG_BT_CS_DE_NFFT_SIZE)
+			compensated_peak_index = (left_null_index + NORMAL_PEAK_TO_NULL(nfft) -
+						  (int32_t)nfft) > 0
+							 ? (left_null_index + NORMAL_PEAK_TO_NULL(nfft) -
+							    nfft)
 							 : peak_index;
 		} else {
-			compensated_peak_index = left_null_index + NORMAL_PEAK_TO_NULL;
+			compensated_peak_index = left_null_index + NORMAL_PEAK_TO_NULL(nfft);
 		}
 	}
 	return compensated_peak_index;
 }
 
-static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static void calculate_ifft_mag(float *iq_tones_comb, const arm_cfft_instance_f32 *fft,
+			       uint32_t nfft)
 {
 	/* This function calculates the magnitude of the IFFT of the input IQ values.
 	 * Note that the result is written back to the input array.
-	 * Also note that the input array is a complex array of size CONFIG_BT_CS_DE_NFFT_SIZE
+	 * Also note that the input array is a complex array of size nfft
 	 * Odd indexes contain the real part and even indexes contain the imaginary part.
 	 *
 	 * To find the IFFT this the function uses FFT functions provided by the CMSIS-DSP library.
@@ -235,30 +255,21 @@ static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE
 	}
 
 	/* Perform the FFT. */
-	#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
-		arm_cfft_f32(&arm_cfft_sR_f32_len512, iq_tones_comb, 0, 1);
-	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
-		arm_cfft_f32(&arm_cfft_sR_f32_len1024, iq_tones_comb, 0, 1);
-	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
-		arm_cfft_f32(&arm_cfft_sR_f32_len2048, iq_tones_comb, 0, 1);
-	#else
-	#error
-	#endif
-
-	/* Compute the magnitude of complex values in
-	 * iq_tones_comb[0:2*CONFIG_BT_CS_DE_NFFT_SIZE - 1]
-	 * and scale by 1/CONFIG_BT_CS_DE_NFFT_SIZE.
-	 * Store output in iq_tones_comb[0:CONFIG_BT_CS_DE_NFFT_SIZE - 1]
+	arm_cfft_f32(fft, iq_tones_comb, 0, 1);
+
+	/* Compute the magnitude of complex values in iq_tones_comb[0:2*nfft - 1]
+	 * and scale by 1/nfft.
+	 * Store output in iq_tones_comb[0:nfft - 1]
 	 */
-	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
-		float realIn = iq_tones_comb[2 * n] / CONFIG_BT_CS_DE_NFFT_SIZE;
-		float imagIn = iq_tones_comb[(2 * n) + 1] / CONFIG_BT_CS_DE_NFFT_SIZE;
+	for (uint32_t n = 0; n < nfft; n++) {
+		float realIn = iq_tones_comb[2 * n] / nfft;
+		float imagIn = iq_tones_comb[(2 * n) + 1] / nfft;
 
 		arm_sqrt_f32((realIn * realIn) + (imagIn * imagIn), &iq_tones_comb[n]);
 	}
 }
 
-static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static uint32_t find_ifft_peak_index(const float *ifft_mag, uint32_t nfft)
 {
 	/* This function tries to find the peak index of the input IFFT magnitude.
 	 *
@@ -271,11 +282,11 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 	uint32_t ifft_mag_max_index;
 	float ifft_mag_max;
 
-	arm_max_f32(ifft_mag, CONFIG_BT_CS_DE_NFFT_SIZE, &ifft_mag_max, &ifft_mag_max_index);
+	arm_max_f32(ifft_mag, nfft, &ifft_mag_max, &ifft_mag_max_index);
 
 	/* Search for strong peaks closer than the max value. */
-	uint32_t nw = CONFIG_BT_CS_DE_NFFT_SIZE - 2;
-	uint32_t nw_next = CONFIG_BT_CS_DE_NFFT_SIZE - 1;
+	uint32_t nw = nfft - 2;
+	uint32_t nw_next = nfft - 1;
 	uint32_t max_search_index = ifft_mag_max_index;
 	bool short_path_found = false;
 	bool first_rise_found = false;
@@ -293,14 +304,14 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 			first_rise_found = true;
 		}
 		nw = nw_next;
-		nw_next = (nw_next + 1) % CONFIG_BT_CS_DE_NFFT_SIZE;
+		nw_next = (nw_next + 1) % nfft;
 	}
 
 	uint32_t compensated_peak_index = shortest_path_idx;
 
-	if (compensated_peak_index < CONFIG_BT_CS_DE_NFFT_SIZE - 2) {
+	if (compensated_peak_index < nfft - 2) {
 		compensated_peak_index =
-			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_mag);
+			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_mag, nfft);
 	}
 
 	return compensated_peak_index;
@@ -317,12 +328,114 @@ float cs_de_ifft(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 	 *     to correspond to the path with the shortest propagattion time.
 	 *  3. Convert the peak index to a distance estimate.
 	 */
-	calculate_ifft_mag(iq_tones_comb);
+	calculate_ifft_mag(iq_tones_comb, NFFT_INSTANCE, CONFIG_BT_CS_DE_NFFT_SIZE);
 
 	/* The input IQ values are overwritten with the IFFT magnitude. */
 	float *ifft_mag = iq_tones_comb;
 
-	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_mag);
+	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_mag, CONFIG_BT_CS_DE_NFFT_SIZE);
+
+	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_mag,
+						     CONFIG_BT_CS_DE_NFFT_SIZE);
+}
+
+static float zoom_ifft_mag(const float iq_tones_comb[2 * CS_DE_NUM_CHANNELS], int32_t index)
+{
+	/* This function calculates the magnitude of a single point of the
+	 * CONFIG_BT_CS_DE_NFFT_SIZE-point IFFT of the input IQ values, scaled by
+	 * 1/CONFIG_BT_CS_DE_NFFT_SIZE as in calculate_ifft_mag().
+	 * The IFFT twiddle factor is rotated by complex multiplication, which keeps the cost at
+	 * one complex multiply-accumulate per channel.
+	 */
+	float angle = (2.0f * PI * index) / CONFIG_BT_CS_DE_NFFT_SIZE;
+	float w_re = cosf(angle);
+	float w_im = sinf(angle);
+	float p_re = 1.0f;
+	float p_im = 0.0f;
+	float acc_re = 0.0f;
+	float acc_im = 0.0f;
+	float mag;
+
+	for (uint32_t n = 0; n < CS_DE_NUM_CHANNELS; n++) {
+		float x_re = iq_tones_comb[2 * n];
+		float x_im = iq_tones_comb[2 * n + 1];
+		float tmp = p_re * w_re - p_im * w_im;
+
+		acc_re += x_re * p_re - x_im * p_im;
+		acc_im += x_re * p_im + x_im * p_re;
+		p_im = p_re * w_im + p_im * w_re;
+		p_re = tmp;
+	}
+
+	arm_sqrt_f32(acc_re * acc_re + acc_im * acc_im, &mag);
+
+	return mag / CONFIG_BT_CS_DE_NFFT_SIZE;
+}
+
+float cs_de_ifft_zoom(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+{
+	/* This function calculates a distance estimate
+	 * based on the IFFT magnitude of the input IQ values
+	 *
+	 * To do this the function uses the following steps:
+	 *  1. Calculate the magnitude of a coarse IFFT of the input IQ values.
+	 *  2. Find index of the peak in the coarse IFFT magnitude which is believed
+	 *     to correspond to the path with the shortest propagation time.
+	 *  3. Calculate the IFFT magnitude with the resolution of CONFIG_BT_CS_DE_NFFT_SIZE
+	 *     within one coarse bin around the peak, and find the peak there.
+	 *  4. Convert the peak index to a distance estimate.
+	 */
+	float *iq = &iq_tones_comb[2 * ZOOM_COARSE_NFFT];
+	float *ifft_mag = iq_tones_comb;
+	float zoom_mag[2 * ZOOM_FACTOR + 1];
+	uint32_t coarse_index;
+	uint32_t zoom_index;
+	int32_t zoom_start;
+	int32_t peak_index;
+	float zoom_max;
+	float t_hat = 0.0f;
+
+	/* Keep the input IQ values after the coarse IFFT for step 3. */
+	memcpy(iq, iq_tones_comb, 2 * CS_DE_NUM_CHANNELS * sizeof(float));
+	memset(&iq_tones_comb[2 * CS_DE_NUM_CHANNELS], 0,
+	       2 * (ZOOM_COARSE_NFFT - CS_DE_NUM_CHANNELS) * sizeof(float));
+
+	calculate_ifft_mag(iq_tones_comb, &arm_cfft_sR_f32_len256, ZOOM_COARSE_NFFT);
+	coarse_index = find_ifft_peak_index(ifft_mag, ZOOM_COARSE_NFFT);
+
+	/* A peak moved by the left null compensation is not a maximum to zoom in on. */
+	if (coarse_index >= ZOOM_COARSE_NFFT - 2 ||
+	    ifft_mag[coarse_index] < ifft_mag[(coarse_index + 1) % ZOOM_COARSE_NFFT] ||
+	    ifft_mag[coarse_index] <
+		    ifft_mag[(coarse_index + ZOOM_COARSE_NFFT - 1) % ZOOM_COARSE_NFFT]) {
+		return calculate_ifft_peak_index_to_distance(coarse_index, ifft_mag,
+							     ZOOM_COARSE_NFFT);
+	}
+
+	/* Zoom in on the window of one coarse bin on either side of the coarse peak. */
+	zoom_start = ((int32_t)coarse_index - 1) * ZOOM_FACTOR;
+
+	for (int32_t i = 0; i < ARRAY_SIZE(zoom_mag); i++) {
+		zoom_mag[i] = zoom_ifft_mag(iq, zoom_start + i);
+	}
+
+	arm_max_f32(zoom_mag, ARRAY_SIZE(zoom_mag), &zoom_max, &zoom_index);
+
+	/* Peak interpolation, unless the peak is at the edge of the zoomed window. */
+	if (zoom_index > 0 && zoom_index < ARRAY_SIZE(zoom_mag) - 1) {
+		float early = zoom_mag[zoom_index - 1];
+		float late = zoom_mag[zoom_index + 1];
+
+		t_hat = (late - early) / (4 * zoom_max - 2 * (early + late));
+	}
+
+	peak_index = zoom_start + (int32_t)zoom_index;
+
+	if (peak_index < 0) {
+		return NAN;
+	}
 
-	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_mag);
+	return fmaxf(((peak_index + t_hat) * SPEED_OF_LIGHT_M_PER_S) /
+			     (2.0f * CONFIG_BT_CS_DE_NFFT_SIZE * CHANNEL_SPACING_HZ),
+		     0.0f);
 }
@@ -199,9 +199,15 @@ static int fp_adv_payload_set(bool rpa_rotated, bool new_session)
 		return err;
 	}
 
+	if (!bt_le_adv_prov_payload_changed(&state, ad, ad_len, sd, sd_len)) {
+		LOG_DBG("Fast Pair Adv Manager: advertising payload did not change");
+		return 0;
+	}
+
 	err = bt_le_ext_adv_set_data(fp_adv_set, ad, ad_len, sd, sd_len);
 	if (err) {
 		LOG_ERR("Fast Pair Adv Manager: bt_le_ext_adv_set_data returned error: %d", err);
+		bt_le_adv_prov_payload_invalidate(adv_handle);
 		return err;
 	}
 
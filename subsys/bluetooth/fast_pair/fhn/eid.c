@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net_buf.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(fp_fhn_eid, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
+
+#include "fp_fhn_eid.h"
+#include "fp_crypto.h"
+#include "fp_storage_eik.h"
+
+/* EID seed data. */
+#define EID_SEED_PADDING_LEN        11
+#define EID_SEED_ROT_PERIOD_EXP_LEN 1
+#define EID_SEED_FHN_CLOCK_LEN      sizeof(uint32_t)
+#define EID_SEED_LEN                    \
+	((EID_SEED_PADDING_LEN +        \
+	  EID_SEED_ROT_PERIOD_EXP_LEN + \
+	  EID_SEED_FHN_CLOCK_LEN) * 2)
+
+#define EID_SEED_PADDING_TYPE_ONE 0xFF
+#define EID_SEED_PADDING_TYPE_TWO 0x00
+
+#define SECP_MOD_RES_LEN FP_FHN_EID_LEN
+
+BUILD_ASSERT((SECP_MOD_RES_LEN == FP_CRYPTO_ECC_SECP160R1_MOD_LEN) ||
+	     (SECP_MOD_RES_LEN == FP_CRYPTO_ECC_SECP256R1_MOD_LEN));
+
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+static K_THREAD_STACK_DEFINE(eid_wq_stack_area, CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE_STACK_SIZE);
+static struct k_work_q eid_wq;
+
+static void eid_precompute_work_handle(struct k_work *work);
+
+static K_WORK_DEFINE(eid_precompute_work, eid_precompute_work_handle);
+static K_MUTEX_DEFINE(eid_precompute_lock);
+
+/* Incremented on every EIK change to drop results calculated with the previous EIK. */
+static uint32_t eik_generation;
+static uint32_t requested_clock;
+
+static struct {
+	bool valid;
+	uint32_t fhn_clock;
+	uint32_t eik_generation;
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand;
+} precomputed;
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
+
+static void eid_seed_half_encode(struct net_buf_simple *buf,
+				 uint8_t padding_pattern,
+				 uint32_t fhn_clock)
+{
+	uint8_t padding[EID_SEED_PADDING_LEN];
+
+	memset(padding, padding_pattern, sizeof(padding));
+
+	net_buf_simple_add_mem(buf, padding, sizeof(padding));
+	net_buf_simple_add_u8(buf, FP_FHN_EID_ROT_PERIOD_EXP);
+	net_buf_simple_add_be32(buf, fhn_clock);
+}
+
+int fp_fhn_eid_calculate(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand)
+{
+	int err;
+	uint8_t eik[FP_STORAGE_EIK_LEN];
+	uint8_t encrypted_eid_seed[FP_CRYPTO_AES256_BLOCK_LEN];
+	uint8_t secp_mod_res[SECP_MOD_RES_LEN];
+	uint8_t mod_res_hash[FP_CRYPTO_SHA256_HASH_LEN];
+
+	NET_BUF_SIMPLE_DEFINE(eid_seed_buf, EID_SEED_LEN);
+
+	__ASSERT_NO_MSG(eid);
+	__ASSERT_NO_MSG(xor_operand);
+
+	fhn_clock = fp_fhn_eid_clock_align(fhn_clock);
+
+	/* Prepare the EID seed data. */
+	eid_seed_half_encode(&eid_seed_buf,
+			     EID_SEED_PADDING_TYPE_ONE,
+			     fhn_clock);
+	eid_seed_half_encode(&eid_seed_buf,
+			     EID_SEED_PADDING_TYPE_TWO,
+			     fhn_clock);
+
+	/* Load the EIK. */
+	err = fp_storage_eik_get(eik);
+	if (err) {
+		LOG_ERR("FHN EID: fp_storage_eik_get failed: %d", err);
+
+		return err;
+	}
+
+	LOG_HEXDUMP_DBG(eid_seed_buf.data, eid_seed_buf.len, "EID seed data:");
+	LOG_HEXDUMP_DBG(eik, sizeof(eik), "EIK:");
+
+	/* Encrypt the EID seed data with the Ephemeral Identity Key
+	 * using the AES-ECB-256 scheme.
+	 */
+	err = fp_crypto_aes256_ecb_encrypt(encrypted_eid_seed, eid_seed_buf.data, eik);
+	if (err) {
+		LOG_ERR("FHN EID: EID seed data encryption failed: %d", err);
+
+		return err;
+	}
+
+	LOG_HEXDUMP_DBG(encrypted_eid_seed,
+			sizeof(encrypted_eid_seed),
+			"Encrypted EID seed data:");
+
+	/* Calculate the EID as the x coordinate of a point on the elliptic curve. */
+	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP160R1)) {
+		err = fp_crypto_ecc_secp160r1_calculate(eid,
+							secp_mod_res,
+							encrypted_eid_seed,
+							sizeof(encrypted_eid_seed));
+		if (err) {
+			LOG_ERR("FHN EID: EID calculation using secp160r1 failed: %d",
+				err);
+
+			return err;
+		}
+	} else if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP256R1)) {
+		err = fp_crypto_ecc_secp256r1_calculate(eid,
+							secp_mod_res,
+							encrypted_eid_seed,
+							sizeof(encrypted_eid_seed));
+		if (err) {
+			LOG_ERR("FHN EID: EID calculation using secp256r1 failed: %d",
+				err);
+
+			return err;
+		}
+	} else {
+		__ASSERT(0, "ECC selection not supported");
+	}
+
+	LOG_HEXDUMP_DBG(eid, FP_FHN_EID_LEN, "EID:");
+
+	/* Calculate the XOR operand for the Hashed Flags bitmask. */
+	err = fp_crypto_sha256(mod_res_hash, secp_mod_res, sizeof(secp_mod_res));
+	if (err) {
+		LOG_ERR("FHN EID: secp modulo result hashing failed: %d", err);
+
+		return err;
+	}
+
+	*xor_operand = mod_res_hash[sizeof(mod_res_hash) - 1];
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+static void eid_precompute_work_handle(struct k_work *work)
+{
+	int err;
+	uint32_t fhn_clock;
+	uint32_t generation;
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand;
+
+	k_mutex_lock(&eid_precompute_lock, K_FOREVER);
+	fhn_clock = requested_clock;
+	generation = eik_generation;
+	k_mutex_unlock(&eid_precompute_lock);
+
+	err = fp_fhn_eid_calculate(fhn_clock, eid, &xor_operand);
+	if (err) {
+		LOG_WRN("FHN EID: precomputation failed: %d", err);
+		return;
+	}
+
+	k_mutex_lock(&eid_precompute_lock, K_FOREVER);
+
+	/* Drop the result if the EIK or the requested rotation period changed meanwhile. */
+	if ((generation == eik_generation) && (fhn_clock == requested_clock)) {
+		precomputed.valid = true;
+		precomputed.fhn_clock = fhn_clock;
+		precomputed.eik_generation = generation;
+		memcpy(precomputed.eid, eid, sizeof(precomputed.eid));
+		precomputed.xor_operand = xor_operand;
+
+		LOG_DBG("FHN EID: precomputed EID for FHN Clock %u", fhn_clock);
+	}
+
+	k_mutex_unlock(&eid_precompute_lock);
+}
+
+static bool eid_precomputed_take(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand)
+{
+	bool found = false;
+
+	k_mutex_lock(&eid_precompute_lock, K_FOREVER);
+
+	if (precomputed.valid &&
+	    (precomputed.fhn_clock == fhn_clock) &&
+	    (precomputed.eik_generation == eik_generation)) {
+		memcpy(eid, precomputed.eid, sizeof(precomputed.eid));
+		*xor_operand = precomputed.xor_operand;
+		found = true;
+	}
+
+	k_mutex_unlock(&eid_precompute_lock);
+
+	return found;
+}
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
+
+int fp_fhn_eid_get(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand)
+{
+	__ASSERT_NO_MSG(eid);
+	__ASSERT_NO_MSG(xor_operand);
+
+	fhn_clock = fp_fhn_eid_clock_align(fhn_clock);
+
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+	if (eid_precomputed_take(fhn_clock, eid, xor_operand)) {
+		LOG_DBG("FHN EID: using precomputed EID");
+		return 0;
+	}
+
+	LOG_DBG("FHN EID: precomputed EID not available, calculating synchronously");
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
+
+	return fp_fhn_eid_calculate(fhn_clock, eid, xor_operand);
+}
+
+void fp_fhn_eid_precompute(uint32_t fhn_clock)
+{
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+	fhn_clock = fp_fhn_eid_clock_align(fhn_clock);
+
+	k_mutex_lock(&eid_precompute_lock, K_FOREVER);
+	requested_clock = fhn_clock;
+	k_mutex_unlock(&eid_precompute_lock);
+
+	(void)k_work_submit_to_queue(&eid_wq, &eid_precompute_work);
+#else
+	ARG_UNUSED(fhn_clock);
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
+}
+
+void fp_fhn_eid_invalidate(void)
+{
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+	k_mutex_lock(&eid_precompute_lock, K_FOREVER);
+	eik_generation++;
+	precomputed.valid = false;
+	k_mutex_unlock(&eid_precompute_lock);
+
+	/* The result of an already running precomputation is dropped by the work handler. */
+	(void)k_work_cancel(&eid_precompute_work);
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
+}
+
+#if defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)
+static int eid_wq_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "FHN EID WQ"};
+
+	k_work_queue_init(&eid_wq);
+	k_work_queue_start(&eid_wq, eid_wq_stack_area,
+			   K_THREAD_STACK_SIZEOF(eid_wq_stack_area),
+			   CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(eid_wq_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* defined(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _FP_FHN_EID_H_
+#define _FP_FHN_EID_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <zephyr/sys/util.h>
+
+/**
+ * @defgroup fp_fhn_eid Fast Pair FHN EID
+ * @brief Internal API for Fast Pair FHN Ephemeral Identifier (EID) calculation
+ *
+ * The module calculates the Ephemeral Identifier (EID) and the XOR operand of the Hashed Flags
+ * byte for a given rotation period of the FHN Clock. The calculation of the upcoming EID can be
+ * started in advance in a low priority thread, so that the EID rotation only takes the ready
+ * result.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Length in bytes of the Ephemeral Identifier (EID). */
+#define FP_FHN_EID_LEN CONFIG_BT_FAST_PAIR_FHN_ECC_LEN
+
+/* Exponent of the EID rotation period. */
+#define FP_FHN_EID_ROT_PERIOD_EXP 10
+
+/* EID rotation period in seconds. */
+#define FP_FHN_EID_ROT_PERIOD BIT(FP_FHN_EID_ROT_PERIOD_EXP)
+
+/** Align the FHN Clock value to the start of its EID rotation period.
+ *
+ * @param[in] fhn_clock FHN Clock value in seconds.
+ *
+ * @return FHN Clock value with the K lowest bits cleared.
+ */
+static inline uint32_t fp_fhn_eid_clock_align(uint32_t fhn_clock)
+{
+	return fhn_clock & ~BIT_MASK(FP_FHN_EID_ROT_PERIOD_EXP);
+}
+
+/** Calculate the EID synchronously.
+ *
+ * The function uses the currently provisioned Ephemeral Identity Key (EIK).
+ *
+ * @param[in] fhn_clock FHN Clock value in seconds.
+ * @param[out] eid Ephemeral Identifier (@ref FP_FHN_EID_LEN bytes).
+ * @param[out] xor_operand XOR operand of the Hashed Flags byte.
+ *
+ * @return 0 if the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_fhn_eid_calculate(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand);
+
+/** Get the EID.
+ *
+ * The precomputed result is used if it was calculated for the rotation period of the FHN Clock
+ * value and if the EIK did not change since the precomputation was requested. Otherwise, the EID
+ * is calculated synchronously.
+ *
+ * @param[in] fhn_clock FHN Clock value in seconds.
+ * @param[out] eid Ephemeral Identifier (@ref FP_FHN_EID_LEN bytes).
+ * @param[out] xor_operand XOR operand of the Hashed Flags byte.
+ *
+ * @return 0 if the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_fhn_eid_get(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand);
+
+/** Request the precomputation of the EID.
+ *
+ * The EID is calculated in the background by a low priority thread. The function does nothing
+ * if the CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE Kconfig option is disabled.
+ *
+ * @param[in] fhn_clock FHN Clock value in seconds from the rotation period of the requested EID.
+ */
+void fp_fhn_eid_precompute(uint32_t fhn_clock);
+
+/** Invalidate the precomputed EID.
+ *
+ * The function must be called when the EIK changes. The ongoing precomputation is cancelled or
+ * its result is dropped.
+ */
+void fp_fhn_eid_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _FP_FHN_EID_H_ */
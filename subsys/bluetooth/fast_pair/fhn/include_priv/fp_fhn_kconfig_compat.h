@@ -155,6 +155,10 @@
 
 #ifdef CONFIG_BT_FAST_PAIR_FMDN_STATE
 #define CONFIG_BT_FAST_PAIR_FHN_STATE 1
+/* The EID precomputation (CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) is not
+ * available with the deprecated Kconfig tree. The EID is calculated
+ * synchronously on each rotation.
+ */
 #endif
 
 #ifdef CONFIG_BT_FAST_PAIR_FMDN_CRYPTO
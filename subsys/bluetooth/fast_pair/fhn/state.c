@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(fp_fhn_state, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 #include "fp_fhn_battery.h"
 #include "fp_fhn_callbacks.h"
 #include "fp_fhn_clock.h"
+#include "fp_fhn_eid.h"
 #include "fp_fhn_state.h"
 #include "fp_crypto.h"
 #include "fp_storage_eik.h"
@@ -57,20 +58,6 @@ LOG_MODULE_REGISTER(fp_fhn_state, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 #define FHN_FRAME_TYPE_UTP_MODE_OFF 0x40
 #define FHN_FRAME_TYPE_UTP_MODE_ON  0x41
 
-/* Byte length and offset of fields used to generate a seed for Ephemeral Identifier. */
-#define FHN_EID_SEED_PADDING_LEN        11
-#define FHN_EID_SEED_ROT_PERIOD_EXP_LEN 1
-#define FHN_EID_SEED_FHN_CLOCK_LEN     sizeof(uint32_t)
-#define FHN_EID_SEED_LEN                    \
-	((FHN_EID_SEED_PADDING_LEN +        \
-	  FHN_EID_SEED_ROT_PERIOD_EXP_LEN + \
-	  FHN_EID_SEED_FHN_CLOCK_LEN) * 2)
-
-/* Constants used to generate a seed for Ephemeral Identifier. */
-#define FHN_EID_SEED_ROT_PERIOD_EXP   10
-#define FHN_EID_SEED_PADDING_TYPE_ONE 0xFF
-#define FHN_EID_SEED_PADDING_TYPE_TWO 0x00
-
 /* Limits in seconds to the EID rotation period randomness as recommended by the specification. */
 #define FHN_EID_ROT_PERIOD_RAND_LOWER_LIMIT 1
 #define FHN_EID_ROT_PERIOD_RAND_UPPER_LIMIT 204
@@ -87,9 +74,6 @@ LOG_MODULE_REGISTER(fp_fhn_state, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 #define FHN_TX_POWER_CALIBRATED_MIN (-100)
 #define FHN_TX_POWER_CALIBRATED_MAX (20)
 
-/* Constants used in Elliptic Curve calculation. */
-#define SECP_MOD_RES_LEN FP_FHN_STATE_EID_LEN
-
 /* Constants used for Unwanted Tracking Protection mode. */
 #define UTP_EID_ROTATIONS_PER_RPA_ROTATION 85 /* 85 * 1024s = 87040s ~ 1451m ~ 24h11m */
 
@@ -107,8 +91,7 @@ BUILD_ASSERT(CONFIG_BT_MAX_CONN > FHN_MAX_CONN);
 /* Validate the Elliptic Curve configuration. */
 BUILD_ASSERT(IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP256R1) ||
 	     IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP160R1));
-BUILD_ASSERT((SECP_MOD_RES_LEN == FP_CRYPTO_ECC_SECP160R1_MOD_LEN) ||
-	     (SECP_MOD_RES_LEN == FP_CRYPTO_ECC_SECP256R1_MOD_LEN));
+BUILD_ASSERT(FP_FHN_STATE_EID_LEN == FP_FHN_EID_LEN);
 
 static uint8_t fhn_frame_payload[FHN_FRAME_PAYLOAD_LEN] = {
 	BT_UUID_16_ENCODE(FHN_FRAME_UUID), FHN_FRAME_TYPE_UTP_MODE_OFF,
@@ -155,36 +138,17 @@ static K_WORK_DEFINE(fhn_post_init_work, fhn_post_init_work_handle);
 
 static int fhn_adv_start(void);
 
-static void eid_seed_half_encode(struct net_buf_simple *buf,
-				 uint8_t padding_pattern,
-				 uint32_t fhn_clock)
-{
-	uint8_t padding[FHN_EID_SEED_PADDING_LEN];
-
-	memset(padding, padding_pattern, sizeof(padding));
-
-	net_buf_simple_add_mem(buf, padding, sizeof(padding));
-	net_buf_simple_add_u8(buf, FHN_EID_SEED_ROT_PERIOD_EXP);
-	net_buf_simple_add_be32(buf, fhn_clock);
-}
-
 static int eid_encode(void)
 {
 	int err;
 	uint32_t fhn_clock;
-	uint8_t eik[FP_STORAGE_EIK_LEN];
-	uint8_t encrypted_eid_seed[FP_CRYPTO_AES256_BLOCK_LEN];
 	const uint8_t uninitialized_eid[FP_FHN_STATE_EID_LEN] = {};
-	uint8_t secp_mod_res[SECP_MOD_RES_LEN];
-	uint8_t mod_res_hash[FP_CRYPTO_SHA256_HASH_LEN];
-
-	NET_BUF_SIMPLE_DEFINE(eid_seed_buf, FHN_EID_SEED_LEN);
 
 	/* Prepare the FHN Clock value. */
 	fhn_clock = fp_fhn_clock_read();
 
 	/* Clear the K lowest bits in the clock value. */
-	fhn_clock &= ~BIT_MASK(FHN_EID_SEED_ROT_PERIOD_EXP);
+	fhn_clock = fp_fhn_eid_clock_align(fhn_clock);
 
 	/* Check if the EID seed or EIK has changed since the last call. */
 	if (memcmp(fhn_eid, uninitialized_eid, sizeof(uninitialized_eid)) != 0) {
@@ -194,79 +158,22 @@ static int eid_encode(void)
 			return 0;
 		}
 	}
-	fhn_eid_clock_checkpoint = fhn_clock;
 
-	/* Prepare the EID seed data. */
-	eid_seed_half_encode(&eid_seed_buf,
-			     FHN_EID_SEED_PADDING_TYPE_ONE,
-			     fhn_clock);
-	eid_seed_half_encode(&eid_seed_buf,
-			     FHN_EID_SEED_PADDING_TYPE_TWO,
-			     fhn_clock);
-
-	/* Load the EIK. */
-	err = fp_storage_eik_get(eik);
+	/* Take the EID precomputed in the background or calculate it now. */
+	err = fp_fhn_eid_get(fhn_clock, fhn_eid, &fhn_frame_hashed_flags_xor_operand);
 	if (err) {
-		LOG_ERR("FHN State: fp_storage_eik_get failed: %d", err);
-
-		return err;
-	}
+		LOG_ERR("FHN State: fp_fhn_eid_get failed: %d", err);
 
-	LOG_HEXDUMP_DBG(eid_seed_buf.data, eid_seed_buf.len, "EID seed data:");
-	LOG_HEXDUMP_DBG(eik, sizeof(eik), "EIK:");
-
-	/* Encrypt the EID seed data with the Ephemeral Identity Key
-	 * using the AES-ECB-256 scheme.
-	 */
-	err = fp_crypto_aes256_ecb_encrypt(encrypted_eid_seed, eid_seed_buf.data, eik);
-	if (err) {
-		LOG_ERR("FHN State: EID seed data encryption failed: %d", err);
+		/* Force the recalculation on the next call. */
+		memset(fhn_eid, 0, FP_FHN_STATE_EID_LEN);
 
 		return err;
 	}
 
-	LOG_HEXDUMP_DBG(encrypted_eid_seed,
-			sizeof(encrypted_eid_seed),
-			"Encrypted EID seed data:");
-
-	/* Calculate the EID as the x coordinate of a point on the elliptic curve. */
-	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP160R1)) {
-		err = fp_crypto_ecc_secp160r1_calculate(fhn_eid,
-							secp_mod_res,
-							encrypted_eid_seed,
-							sizeof(encrypted_eid_seed));
-		if (err) {
-			LOG_ERR("FHN State: EID calculation using secp160r1 failed: %d",
-				err);
-
-			return err;
-		}
-	} else if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_ECC_SECP256R1)) {
-		err = fp_crypto_ecc_secp256r1_calculate(fhn_eid,
-							secp_mod_res,
-							encrypted_eid_seed,
-							sizeof(encrypted_eid_seed));
-		if (err) {
-			LOG_ERR("FHN State: EID calculation using secp256r1 failed: %d",
-				err);
-
-			return err;
-		}
-	} else {
-		__ASSERT(0, "ECC selection not supported");
-	}
-
-	LOG_HEXDUMP_DBG(fhn_eid, FP_FHN_STATE_EID_LEN, "EID:");
-
-	/* Calculate the XOR operand for the Hashed Flags bitmask. */
-	err = fp_crypto_sha256(mod_res_hash, secp_mod_res, sizeof(secp_mod_res));
-	if (err) {
-		LOG_ERR("FHN State: secp modulo result hashing failed: %d", err);
-
-		return err;
-	}
+	fhn_eid_clock_checkpoint = fhn_clock;
 
-	fhn_frame_hashed_flags_xor_operand = mod_res_hash[sizeof(mod_res_hash) - 1];
+	/* Prepare the EID for the next rotation period in advance. */
+	fp_fhn_eid_precompute(fhn_clock + FP_FHN_EID_ROT_PERIOD);
 
 	return 0;
 }
@@ -366,8 +273,8 @@ static uint16_t fhn_adv_rpa_timeout_calculate(void)
 
 	/* Calculate non-random part as the next anticipated rotation time. */
 	fhn_clock = fp_fhn_clock_read();
-	non_rand_rotation_time = BIT(FHN_EID_SEED_ROT_PERIOD_EXP);
-	non_rand_rotation_time -= fhn_clock % BIT(FHN_EID_SEED_ROT_PERIOD_EXP);
+	non_rand_rotation_time = FP_FHN_EID_ROT_PERIOD;
+	non_rand_rotation_time -= fhn_clock % FP_FHN_EID_ROT_PERIOD;
 
 	/* Calculate the positive randomized time factor. */
 	err = sys_csrand_get(&rand_rotation_time_seed, sizeof(rand_rotation_time_seed));
@@ -1007,6 +914,7 @@ static int fhn_storage_unprovision(void)
 	}
 
 	memset(fhn_eid, 0, FP_FHN_STATE_EID_LEN);
+	fp_fhn_eid_invalidate();
 
 	return 0;
 }
@@ -1052,6 +960,7 @@ static int fhn_storage_provision(const uint8_t *eik)
 	}
 
 	memset(fhn_eid, 0, FP_FHN_STATE_EID_LEN);
+	fp_fhn_eid_invalidate();
 
 	return 0;
 }
@@ -1326,6 +1235,9 @@ int fp_fhn_state_uninit(void)
 	/* Cancel the work for the provisioning_state_changed callback. */
 	(void) k_work_cancel(&fhn_post_init_work);
 
+	/* Drop the EID precomputed for the next rotation period. */
+	fp_fhn_eid_invalidate();
+
 	LOG_DBG("FHN State: disabled");
 
 	return 0;
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/settings/settings.h>
 #include <bluetooth/fast_pair/fast_pair.h>
@@ -50,6 +51,10 @@ static uint8_t account_key_count;
 
 static uint8_t account_key_order[ACCOUNT_KEY_CNT];
 
+static void ak_order_save_work_handle(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(ak_order_save_work, ak_order_save_work_handle);
+
 static int settings_set_err;
 static bool is_enabled;
 
@@ -274,6 +279,42 @@ static void ak_order_update_ram(uint8_t used_id)
 	account_key_order[0] = used_id;
 }
 
+static void ak_order_save(void)
+{
+	int err;
+
+	/* The order saved now includes all of the pending updates. */
+	(void)k_work_cancel_delayable(&ak_order_save_work);
+
+	err = settings_save_one(SETTINGS_AK_ORDER_FULL_NAME, account_key_order,
+				sizeof(account_key_order));
+	if (err) {
+		LOG_ERR("Unable to save new Account Key order in Settings. "
+			"Not propagating the error and keeping updated Account Key "
+			"order in RAM. After the Settings error the Account Key "
+			"order may change at reboot.");
+	}
+}
+
+static void ak_order_save_work_handle(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	ak_order_save();
+}
+
+static void ak_order_save_schedule(void)
+{
+	if (CONFIG_BT_FAST_PAIR_STORAGE_AK_ORDER_SAVE_DELAY == 0) {
+		ak_order_save();
+		return;
+	}
+
+	/* Subsequent updates do not postpone the already scheduled save. */
+	(void)k_work_schedule(&ak_order_save_work,
+			      K_MSEC(CONFIG_BT_FAST_PAIR_STORAGE_AK_ORDER_SAVE_DELAY));
+}
+
 static int fp_settings_validate_ak_order(void)
 {
 	int err;
@@ -578,23 +619,25 @@ int fp_storage_ak_find(struct fp_account_key *account_key,
 		return -EINVAL;
 	}
 
+	/* Check the most recently used Account Keys first. A peer that uses the device often
+	 * is found after a single check instead of checking all of the stored keys.
+	 */
 	for (size_t i = 0; i < account_key_count; i++) {
-		if (account_key_check_cb(&account_key_list[i], context)) {
-			int err;
+		uint8_t id = account_key_order[i];
+		uint8_t index = account_key_id_to_idx(id);
 
-			ak_order_update_ram(ACCOUNT_KEY_METADATA_FIELD_GET(account_key_metadata[i],
-									   ID));
-			err = settings_save_one(SETTINGS_AK_ORDER_FULL_NAME, account_key_order,
-						sizeof(account_key_order));
-			if (err) {
-				LOG_ERR("Unable to save new Account Key order in Settings. "
-					"Not propagating the error and keeping updated Account Key "
-					"order in RAM. After the Settings error the Account Key "
-					"order may change at reboot.");
+		__ASSERT_NO_MSG(ACCOUNT_KEY_METADATA_FIELD_GET(account_key_metadata[index], ID) ==
+				id);
+
+		if (account_key_check_cb(&account_key_list[index], context)) {
+			/* The order does not change if the most recently used key is found. */
+			if (i > 0) {
+				ak_order_update_ram(id);
+				ak_order_save_schedule();
 			}
 
 			if (account_key) {
-				*account_key = account_key_list[i];
+				*account_key = account_key_list[index];
 			}
 
 			return 0;
@@ -739,14 +782,7 @@ int fp_storage_ak_save(const struct fp_account_key *account_key, const void *con
 	}
 
 	ak_order_update_ram(id);
-	err = settings_save_one(SETTINGS_AK_ORDER_FULL_NAME, account_key_order,
-				sizeof(account_key_order));
-	if (err) {
-		LOG_ERR("Unable to save new Account Key order in Settings. "
-			"Not propagating the error and keeping updated Account Key "
-			"order in RAM. After the Settings error the Account Key "
-			"order may change at reboot.");
-	}
+	ak_order_save();
 
 	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_STORAGE_AK_BOND) && ak_overwritten) {
 		/* Account Key overwritten. Remove bonds related with overwritten Account Key. */
@@ -967,6 +1003,8 @@ void fp_storage_ak_bond_delete(const bt_addr_le_t *addr)
 
 void fp_storage_ak_ram_clear(void)
 {
+	(void)k_work_cancel_delayable(&ak_order_save_work);
+
 	memset(account_key_list, 0, sizeof(account_key_list));
 	memset(account_key_metadata, 0, sizeof(account_key_metadata));
 	account_key_count = 0;
@@ -1033,6 +1071,11 @@ static int fp_storage_ak_uninit(void)
 		return 0;
 	}
 
+	/* Do not lose the Account Key order update that is waiting to be saved. */
+	if (k_work_delayable_is_pending(&ak_order_save_work)) {
+		ak_order_save();
+	}
+
 	is_enabled = false;
 
 	return 0;
@@ -5,8 +5,12 @@
  */
 
 #include <inttypes.h>
+#include <stdlib.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/bluetooth/conn.h>
 
 #include <bluetooth/gatt_dm.h>
 
@@ -44,9 +48,34 @@ SYS_INIT(gatt_dm_wq_init, POST_KERNEL, CONFIG_BT_GATT_DM_WORKQ_INIT_PRIO);
 enum {
 	STATE_ATTRS_LOCKED,
 	STATE_ATTRS_RELEASE_PENDING,
+	STATE_CACHE_LOOKUP,
 	STATE_NUM
 };
 
+/* Storage for any type of UUID */
+union gatt_dm_uuid {
+	struct bt_uuid uuid;
+	struct bt_uuid_16 u16;
+	struct bt_uuid_32 u32;
+	struct bt_uuid_128 u128;
+};
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+#define DB_HASH_LEN 16
+#define CACHE_SETTINGS_KEY "bt/dm"
+
+/* Key of a cached discovery result */
+struct cache_key {
+	/* Identity address of the peer */
+	bt_addr_le_t peer;
+	/* The UUID of the service to discover, if searched by the UUID */
+	union gatt_dm_uuid svc_uuid;
+	bool search_svc_by_uuid;
+	/* The first handle of the discovery range */
+	uint16_t start_handle;
+};
+#endif
+
 /* One item in linked list containing dynamically allocated user data chunks */
 struct data_chunk_item {
 	/* Required by the sys_slist */
@@ -72,12 +101,7 @@ struct bt_gatt_dm {
 	ATOMIC_DEFINE(state_flags, STATE_NUM);
 
 	/* The UUID of the service to discover. */
-	union {
-		struct bt_uuid uuid;
-		struct bt_uuid_16 u16;
-		struct bt_uuid_32 u32;
-		struct bt_uuid_128 u128;
-	} svc_uuid;
+	union gatt_dm_uuid svc_uuid;
 
 	/* Single-linked list of allocated chunks for user data */
 	sys_slist_t chunk_list;
@@ -92,10 +116,21 @@ struct bt_gatt_dm {
 
 	/* Work item used for discovery callbacks. */
 	struct k_work discover_work;
+
+	/* Indicates that the discovery result should be stored in the cache. */
+	bool cache_result;
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* The key of the discovery result in the cache */
+	struct cache_key cache_key;
+	/* Parameters used to read the GATT Database Hash */
+	struct bt_gatt_read_params hash_read_params;
+	/* GATT Database Hash read at the start of the discovery */
+	uint8_t db_hash[DB_HASH_LEN];
+#endif
 };
 
-/* Currently only one instance is supported */
-static struct bt_gatt_dm bt_gatt_dm_inst;
+static struct bt_gatt_dm bt_gatt_dm_inst[CONFIG_BT_GATT_DM_MAX_INSTANCES];
 
 /* Returns pointer to newly allocated space in a dm->data_chunk */
 static void *user_data_alloc(struct bt_gatt_dm *dm,
@@ -268,9 +303,517 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+static void discover_work_submit(struct bt_gatt_dm *dm)
+{
+#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
+	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
+#else
+	k_work_submit(&dm->discover_work);
+#endif
+}
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+
+/* Cached discovery result. Only the used part of the data is stored in the settings. */
+struct cache_entry {
+	struct cache_key key;
+	/* GATT Database Hash of the peer when the result was discovered */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* Length of the encoded attributes */
+	uint16_t len;
+	/* Encoded attributes, empty if the service was not found */
+	uint8_t data[CONFIG_BT_GATT_DM_CACHE_ENTRY_SIZE];
+};
+
+static struct cache_entry cache[CONFIG_BT_GATT_DM_CACHE_SIZE];
+/* Order of use of the entries, zero for unused entries */
+static uint32_t cache_seq[CONFIG_BT_GATT_DM_CACHE_SIZE];
+static uint32_t cache_seq_cnt;
+static K_MUTEX_DEFINE(cache_lock);
+
+static bool cache_key_eq(const struct cache_key *a, const struct cache_key *b)
+{
+	if (!bt_addr_le_eq(&a->peer, &b->peer) ||
+	    (a->start_handle != b->start_handle) ||
+	    (a->search_svc_by_uuid != b->search_svc_by_uuid)) {
+		return false;
+	}
+
+	return !a->search_svc_by_uuid || !bt_uuid_cmp(&a->svc_uuid.uuid, &b->svc_uuid.uuid);
+}
+
+static int cache_entry_find(const struct cache_key *key)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache_seq[i] && cache_key_eq(&cache[i].key, key)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Returns the unused or the least recently used entry */
+static size_t cache_entry_alloc(void)
+{
+	size_t lru = 0;
+
+	for (size_t i = 1; i < ARRAY_SIZE(cache); i++) {
+		if (cache_seq[i] < cache_seq[lru]) {
+			lru = i;
+		}
+	}
+
+	return lru;
+}
+
+static void cache_entry_save(size_t idx)
+{
+	char name[sizeof(CACHE_SETTINGS_KEY "/255")];
+	int err;
+
+	snprintk(name, sizeof(name), CACHE_SETTINGS_KEY "/%zu", idx);
+
+	err = settings_save_one(name, &cache[idx],
+				offsetof(struct cache_entry, data) + cache[idx].len);
+	if (err) {
+		LOG_WRN("Failed to store cache entry %zu, error: %d", idx, err);
+	}
+}
+
+static void cache_entry_delete(size_t idx)
+{
+	char name[sizeof(CACHE_SETTINGS_KEY "/255")];
+
+	cache_seq[idx] = 0;
+
+	snprintk(name, sizeof(name), CACHE_SETTINGS_KEY "/%zu", idx);
+	(void)settings_delete(name);
+}
+
+static void cache_peer_invalidate(const bt_addr_le_t *peer)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache_seq[i] && bt_addr_le_eq(&cache[i].key.peer, peer)) {
+			cache_entry_delete(i);
+		}
+	}
+}
+
+static int cache_settings_set(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg)
+{
+	const size_t hdr_len = offsetof(struct cache_entry, data);
+	struct cache_entry *entry;
+	size_t idx;
+	ssize_t size;
+	int err = 0;
+
+	if (!key) {
+		return -ENOENT;
+	}
+
+	idx = atoi(key);
+	if (idx >= ARRAY_SIZE(cache)) {
+		return -ENOMEM;
+	}
+
+	if ((len < hdr_len) || (len > sizeof(*entry))) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	entry = &cache[idx];
+	size = read_cb(cb_arg, entry, len);
+	if ((size != len) || (entry->len != len - hdr_len)) {
+		cache_seq[idx] = 0;
+		err = -EINVAL;
+	} else {
+		cache_seq[idx] = ++cache_seq_cnt;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return err;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bt_gatt_dm, CACHE_SETTINGS_KEY, NULL, cache_settings_set, NULL,
+			       NULL);
+
+static int uuid_encode(struct net_buf_simple *buf, const struct bt_uuid *uuid)
+{
+	static const uint8_t uuid_len[] = {
+		[BT_UUID_TYPE_16] = BT_UUID_SIZE_16,
+		[BT_UUID_TYPE_32] = BT_UUID_SIZE_32,
+		[BT_UUID_TYPE_128] = BT_UUID_SIZE_128,
+	};
+
+	if (uuid->type >= ARRAY_SIZE(uuid_len)) {
+		return -EINVAL;
+	}
+
+	if (net_buf_simple_tailroom(buf) < sizeof(uint8_t) + uuid_len[uuid->type]) {
+		return -ENOMEM;
+	}
+
+	net_buf_simple_add_u8(buf, uuid_len[uuid->type]);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		net_buf_simple_add_le16(buf, BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		net_buf_simple_add_le32(buf, BT_UUID_32(uuid)->val);
+		break;
+	default:
+		net_buf_simple_add_mem(buf, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		break;
+	}
+
+	return 0;
+}
+
+static int uuid_decode(struct net_buf_simple *buf, union gatt_dm_uuid *uuid)
+{
+	uint8_t len;
+
+	if (buf->len < sizeof(len)) {
+		return -EINVAL;
+	}
+
+	len = net_buf_simple_pull_u8(buf);
+	if (buf->len < len) {
+		return -EINVAL;
+	}
+
+	if (!bt_uuid_create(&uuid->uuid, net_buf_simple_pull_mem(buf, len), len)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Encodes the handle, permissions and UUID of the attribute, followed by
+ * the service value or the characteristic value.
+ */
+static int attr_encode(struct net_buf_simple *buf, const struct bt_gatt_dm_attr *attr)
+{
+	const struct bt_gatt_service_val *service_val = bt_gatt_dm_attr_service_val(attr);
+	const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+	int err;
+
+	if (net_buf_simple_tailroom(buf) < sizeof(attr->handle) + sizeof(attr->perm)) {
+		return -ENOMEM;
+	}
+
+	net_buf_simple_add_le16(buf, attr->handle);
+	net_buf_simple_add_u8(buf, attr->perm);
+
+	err = uuid_encode(buf, attr->uuid);
+	if (err) {
+		return err;
+	}
+
+	if (service_val) {
+		err = uuid_encode(buf, service_val->uuid);
+		if (err) {
+			return err;
+		}
+
+		if (net_buf_simple_tailroom(buf) < sizeof(service_val->end_handle)) {
+			return -ENOMEM;
+		}
+
+		net_buf_simple_add_le16(buf, service_val->end_handle);
+	} else if (chrc) {
+		err = uuid_encode(buf, chrc->uuid);
+		if (err) {
+			return err;
+		}
+
+		if (net_buf_simple_tailroom(buf) <
+		    sizeof(chrc->value_handle) + sizeof(chrc->properties)) {
+			return -ENOMEM;
+		}
+
+		net_buf_simple_add_le16(buf, chrc->value_handle);
+		net_buf_simple_add_u8(buf, chrc->properties);
+	}
+
+	return 0;
+}
+
+static int attr_decode(struct bt_gatt_dm *dm, struct net_buf_simple *buf)
+{
+	union gatt_dm_uuid uuid;
+	union gatt_dm_uuid val_uuid;
+	struct bt_gatt_attr attr = {
+		.uuid = &uuid.uuid,
+	};
+	struct bt_gatt_dm_attr *cur_attr;
+
+	if (buf->len < sizeof(attr.handle) + sizeof(uint8_t)) {
+		return -EINVAL;
+	}
+
+	attr.handle = net_buf_simple_pull_le16(buf);
+	attr.perm = net_buf_simple_pull_u8(buf);
+
+	if (uuid_decode(buf, &uuid)) {
+		return -EINVAL;
+	}
+
+	if (!bt_uuid_cmp(&uuid.uuid, BT_UUID_GATT_PRIMARY) ||
+	    !bt_uuid_cmp(&uuid.uuid, BT_UUID_GATT_SECONDARY)) {
+		struct bt_gatt_service_val *service_val;
+
+		if (uuid_decode(buf, &val_uuid) || (buf->len < sizeof(service_val->end_handle))) {
+			return -EINVAL;
+		}
+
+		cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		service_val = bt_gatt_dm_attr_service_val(cur_attr);
+		service_val->end_handle = net_buf_simple_pull_le16(buf);
+		service_val->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!service_val->uuid) {
+			return -ENOMEM;
+		}
+	} else if (!bt_uuid_cmp(&uuid.uuid, BT_UUID_GATT_CHRC)) {
+		struct bt_gatt_chrc *chrc;
+
+		if (uuid_decode(buf, &val_uuid) ||
+		    (buf->len < sizeof(chrc->value_handle) + sizeof(chrc->properties))) {
+			return -EINVAL;
+		}
+
+		cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		chrc->value_handle = net_buf_simple_pull_le16(buf);
+		chrc->properties = net_buf_simple_pull_u8(buf);
+		chrc->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!chrc->uuid) {
+			return -ENOMEM;
+		}
+	} else {
+		cur_attr = attr_store(dm, &attr, 0);
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+/* Stores the discovery result, the attributes are empty if the service was not found. */
+static void cache_result_store(struct bt_gatt_dm *dm)
+{
+	struct net_buf_simple buf;
+	struct cache_entry *entry;
+	int idx;
+	int err = 0;
+
+	if (!dm->cache_result) {
+		return;
+	}
+
+	dm->cache_result = false;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	idx = cache_entry_find(&dm->cache_key);
+	if (idx < 0) {
+		idx = cache_entry_alloc();
+	}
+
+	entry = &cache[idx];
+
+	net_buf_simple_init_with_data(&buf, entry->data, sizeof(entry->data));
+	net_buf_simple_reset(&buf);
+
+	for (size_t i = 0; i < dm->cur_attr_id; i++) {
+		err = attr_encode(&buf, &dm->attrs[i]);
+		if (err) {
+			break;
+		}
+	}
+
+	if (err) {
+		LOG_DBG("Discovery result does not fit in the cache");
+		cache_entry_delete(idx);
+	} else {
+		entry->key = dm->cache_key;
+		memcpy(entry->db_hash, dm->db_hash, DB_HASH_LEN);
+		entry->len = buf.len;
+		cache_seq[idx] = ++cache_seq_cnt;
+		cache_entry_save(idx);
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+/* Fills the attributes from the cache. Returns true on a cache hit. */
+static bool cache_lookup(struct bt_gatt_dm *dm)
+{
+	struct net_buf_simple buf;
+	bool hit = false;
+	int idx;
+	int err = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	idx = cache_entry_find(&dm->cache_key);
+	if (idx < 0) {
+		goto unlock;
+	}
+
+	if (memcmp(cache[idx].db_hash, dm->db_hash, DB_HASH_LEN)) {
+		LOG_DBG("Database of the peer changed, invalidating its cache");
+		cache_peer_invalidate(&dm->cache_key.peer);
+		goto unlock;
+	}
+
+	net_buf_simple_init_with_data(&buf, cache[idx].data, cache[idx].len);
+
+	while ((buf.len > 0) && !err) {
+		err = attr_decode(dm, &buf);
+	}
+
+	if (!err && (dm->cur_attr_id > 0) && !bt_gatt_dm_attr_service_val(&dm->attrs[0])) {
+		err = -EINVAL;
+	}
+
+	if (err) {
+		LOG_WRN("Invalid cache entry %d, error: %d", idx, err);
+		svc_attr_memory_release(dm);
+		cache_entry_delete(idx);
+		goto unlock;
+	}
+
+	cache_seq[idx] = ++cache_seq_cnt;
+	hit = true;
+
+unlock:
+	k_mutex_unlock(&cache_lock);
+
+	if (hit) {
+		LOG_DBG("Discovery result found in the cache");
+		dm->cache_result = false;
+
+		if (dm->cur_attr_id > 0) {
+			/* Set the parameters as if the service was discovered. */
+			dm->discover_params.uuid = NULL;
+			dm->discover_params.end_handle =
+				bt_gatt_dm_attr_service_val(&dm->attrs[0])->end_handle;
+		}
+	}
+
+	return hit;
+}
+
+static uint8_t db_hash_read_callback(struct bt_conn *conn, uint8_t err,
+				     struct bt_gatt_read_params *params,
+				     const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, hash_read_params);
+
+	if (!err && data && (length == DB_HASH_LEN)) {
+		memcpy(dm->db_hash, data, DB_HASH_LEN);
+	} else {
+		LOG_DBG("Database Hash not available, error: %u", err);
+		dm->cache_result = false;
+		atomic_clear_bit(dm->state_flags, STATE_CACHE_LOOKUP);
+	}
+
+	discover_work_submit(dm);
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Starts the cache lookup if the result of the discovery can be cached.
+ * The GATT Database Hash is read at every start, as the database of the peer
+ * may change during the connection.
+ */
+static int cache_lookup_start(struct bt_gatt_dm *dm)
+{
+	struct bt_conn_info info;
+	int err;
+
+	dm->cache_result = false;
+	atomic_clear_bit(dm->state_flags, STATE_CACHE_LOOKUP);
+
+	err = bt_conn_get_info(dm->conn, &info);
+	if (err || (info.type != BT_CONN_TYPE_LE) || !bt_addr_le_is_identity(info.le.dst)) {
+		return -ENOTSUP;
+	}
+
+	memset(&dm->cache_key, 0, sizeof(dm->cache_key));
+	bt_addr_le_copy(&dm->cache_key.peer, info.le.dst);
+	dm->cache_key.start_handle = dm->discover_params.start_handle;
+	dm->cache_key.search_svc_by_uuid = dm->search_svc_by_uuid;
+	if (dm->search_svc_by_uuid) {
+		memcpy(&dm->cache_key.svc_uuid, &dm->svc_uuid, get_uuid_size(&dm->svc_uuid.uuid));
+	}
+
+	dm->cache_result = true;
+	atomic_set_bit(dm->state_flags, STATE_CACHE_LOOKUP);
+
+	dm->hash_read_params.func = db_hash_read_callback;
+	dm->hash_read_params.handle_count = 0;
+	dm->hash_read_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+	dm->hash_read_params.by_uuid.start_handle = 0x0001;
+	dm->hash_read_params.by_uuid.end_handle = 0xffff;
+
+	err = bt_gatt_read(dm->conn, &dm->hash_read_params);
+	if (err) {
+		LOG_DBG("Database Hash read failed, error: %d", err);
+		dm->cache_result = false;
+		atomic_clear_bit(dm->state_flags, STATE_CACHE_LOOKUP);
+	}
+
+	return err;
+}
+
+#else
+
+static void cache_result_store(struct bt_gatt_dm *dm)
+{
+}
+
+static bool cache_lookup(struct bt_gatt_dm *dm)
+{
+	return false;
+}
+
+static int cache_lookup_start(struct bt_gatt_dm *dm)
+{
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
+/* Starts the discovery, or the cache lookup if the result can be cached. */
+static int discovery_start(struct bt_gatt_dm *dm)
+{
+	if (!cache_lookup_start(dm)) {
+		return 0;
+	}
+
+	return bt_gatt_discover(dm->conn, &dm->discover_params);
+}
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+	cache_result_store(dm);
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -282,6 +825,7 @@ static void discovery_complete_not_found(struct bt_gatt_dm *dm)
 	LOG_DBG("Discover complete. No service found.");
 
 	svc_attr_memory_release(dm);
+	cache_result_store(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 
 	if (dm->callback->service_not_found) {
@@ -291,6 +835,7 @@ static void discovery_complete_not_found(struct bt_gatt_dm *dm)
 
 static void discovery_complete_error(struct bt_gatt_dm *dm, int err)
 {
+	dm->cache_result = false;
 	svc_attr_memory_release(dm);
 	atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
 	if (dm->callback->error_found) {
@@ -307,6 +852,16 @@ static void gatt_discover_work(struct k_work *work)
 		return;
 	}
 
+	if (atomic_test_and_clear_bit(dm->state_flags, STATE_CACHE_LOOKUP) &&
+	    cache_lookup(dm)) {
+		if (dm->cur_attr_id > 0) {
+			discovery_complete(dm);
+		} else {
+			discovery_complete_not_found(dm);
+		}
+		return;
+	}
+
 	int err = bt_gatt_discover(dm->conn, &(dm->discover_params));
 
 	if (err) {
@@ -373,11 +928,7 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 	dm->discover_params.start_handle = cur_attr->handle + 1;
 	LOG_DBG("Starting descriptors discovery");
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-	k_work_submit(&dm->discover_work);
-#endif
+	discover_work_submit(dm);
 
 	return BT_GATT_ITER_STOP;
 }
@@ -396,11 +947,7 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 			dm->discover_params.type =
 				BT_GATT_DISCOVER_CHARACTERISTIC;
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-			k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-			k_work_submit(&dm->discover_work);
-#endif
+			discover_work_submit(dm);
 		} else {
 			discovery_complete(dm);
 		}
@@ -469,34 +1016,32 @@ static uint8_t discovery_callback(struct bt_conn *conn,
 			       const struct bt_gatt_attr *attr,
 			       struct bt_gatt_discover_params *params)
 {
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, discover_params);
+
 	if (!attr) {
 		LOG_DBG("NULL attribute");
 	} else {
 		LOG_DBG("Attr: handle %u", attr->handle);
 	}
 
-	if (conn != bt_gatt_dm_inst.conn) {
+	if (conn != dm->conn) {
 		LOG_ERR("Unexpected conn object. Aborting.");
-		discovery_complete_error(&bt_gatt_dm_inst, -EFAULT);
+		discovery_complete_error(dm, -EFAULT);
 		return BT_GATT_ITER_STOP;
 	}
 
 	switch (params->type) {
 	case BT_GATT_DISCOVER_PRIMARY:
 	case BT_GATT_DISCOVER_SECONDARY:
-		return discovery_process_service(&bt_gatt_dm_inst,
-						 attr, params);
+		return discovery_process_service(dm, attr, params);
 	case BT_GATT_DISCOVER_ATTRIBUTE:
-		return discovery_process_attribute(&bt_gatt_dm_inst,
-						   attr, params);
+		return discovery_process_attribute(dm, attr, params);
 	case BT_GATT_DISCOVER_CHARACTERISTIC:
-		return discovery_process_characteristic(&bt_gatt_dm_inst,
-							attr,
-							params);
+		return discovery_process_characteristic(dm, attr, params);
 	default:
 		/* This should not be possible */
 		__ASSERT(false, "Unknown param type.");
-		discovery_complete_error(&bt_gatt_dm_inst, -EINVAL);
+		discovery_complete_error(dm, -EINVAL);
 
 		break;
 	}
@@ -639,7 +1184,7 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 		     void *context)
 {
 	int err;
-	struct bt_gatt_dm *dm;
+	struct bt_gatt_dm *dm = NULL;
 
 	if (svc_uuid &&
 	    (svc_uuid->type != BT_UUID_TYPE_16) &&
@@ -651,9 +1196,15 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 		return -EINVAL;
 	}
 
-	dm = &bt_gatt_dm_inst;
+	for (size_t i = 0; i < ARRAY_SIZE(bt_gatt_dm_inst); i++) {
+		if (!atomic_test_and_set_bit(bt_gatt_dm_inst[i].state_flags,
+					     STATE_ATTRS_LOCKED)) {
+			dm = &bt_gatt_dm_inst[i];
+			break;
+		}
+	}
 
-	if (atomic_test_and_set_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+	if (!dm) {
 		return -EALREADY;
 	}
 
@@ -679,7 +1230,7 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	k_work_init(&dm->discover_work, gatt_discover_work);
 
-	err = bt_gatt_discover(conn, &dm->discover_params);
+	err = discovery_start(dm);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
@@ -712,6 +1263,7 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 
 	if (dm->discover_params.end_handle == 0xffff) {
 		/* No more handles to discover. */
+		dm->cache_result = false;
 		discovery_complete_not_found(dm);
 		return 0;
 	}
@@ -722,7 +1274,7 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	dm->discover_params.uuid = dm->search_svc_by_uuid ? &dm->svc_uuid.uuid : NULL;
 
-	err = bt_gatt_discover(dm->conn, &dm->discover_params);
+	err = discovery_start(dm);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
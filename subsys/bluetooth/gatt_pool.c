@@ -6,11 +6,94 @@
 
 #include <errno.h>
 #include <bluetooth/gatt_pool.h>
+#include <bluetooth/mem_arena.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(bt_gatt_pool, CONFIG_BT_GATT_POOL_LOG_LEVEL);
 
+#if defined(CONFIG_BT_GATT_POOL_MEM_ARENA)
+/* Elements are aligned for the UUID pointer of the characteristic declaration. */
+#define EL_ALIGN sizeof(void *)
 
+static void *el_get(size_t size)
+{
+	return bt_mem_arena_alloc(BT_MEM_ARENA_USER_GATT_POOL, size, EL_ALIGN);
+}
+
+static void el_release(void const *el, size_t size)
+{
+	bt_mem_arena_free(BT_MEM_ARENA_USER_GATT_POOL, (void *)el, size);
+}
+
+static int uuid_16_get(struct bt_uuid **uuid)
+{
+	*uuid = el_get(sizeof(struct bt_uuid_16));
+	if (!*uuid) {
+		LOG_ERR("No memory for UUID16 in the arena!");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static int uuid_32_get(struct bt_uuid **uuid)
+{
+	*uuid = el_get(sizeof(struct bt_uuid_32));
+	if (!*uuid) {
+		LOG_ERR("No memory for UUID32 in the arena!");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static int uuid_128_get(struct bt_uuid **uuid)
+{
+	*uuid = el_get(sizeof(struct bt_uuid_128));
+	if (!*uuid) {
+		LOG_ERR("No memory for UUID128 in the arena!");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static int chrc_get(struct bt_gatt_chrc **chrc)
+{
+	*chrc = el_get(sizeof(struct bt_gatt_chrc));
+	if (!*chrc) {
+		LOG_ERR("No memory for chrc descriptor in the arena!");
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static void chrc_release(struct bt_gatt_chrc const *chrc)
+{
+	el_release(chrc, sizeof(struct bt_gatt_chrc));
+}
+
+static void uuid_unregister(struct bt_uuid const *uuid)
+{
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		el_release(uuid, sizeof(struct bt_uuid_16));
+		break;
+
+	case BT_UUID_TYPE_32:
+		el_release(uuid, sizeof(struct bt_uuid_32));
+		break;
+
+	case BT_UUID_TYPE_128:
+		el_release(uuid, sizeof(struct bt_uuid_128));
+		break;
+
+	default:
+		__ASSERT(false, "Unknown UUID type");
+	}
+}
+#else
 struct svc_el_pool {
 	void *elements;
 	atomic_t *locks;
@@ -72,11 +155,13 @@ static struct svc_el_pool chrc_pool = {
 	.elements = BT_GATT_CHRC_TAB,
 	.locks = BT_GATT_CHRC_LOCKS,
 };
+#endif /* defined(CONFIG_BT_GATT_POOL_MEM_ARENA) */
 
 static struct bt_uuid const * const uuid_primary = BT_UUID_GATT_PRIMARY;
 static struct bt_uuid const * const uuid_chrc = BT_UUID_GATT_CHRC;
 static struct bt_uuid const * const uuid_ccc = BT_UUID_GATT_CCC;
 
+#if !defined(CONFIG_BT_GATT_POOL_MEM_ARENA)
 #define EL_IN_POOL_VERIFY(pool, el)                                            \
 	do {                                                                   \
 		__ASSERT(pool != NULL, "Pool is uninitialized");               \
@@ -101,8 +186,9 @@ static size_t free_element_find(struct svc_el_pool *el_pool, size_t el_cnt)
 	return el_cnt;
 }
 
-static int uuid_16_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
+static int uuid_16_get(struct bt_uuid **uuid)
 {
+	struct svc_el_pool *uuid_pool = &uuid_16_pool;
 	size_t ind = free_element_find(uuid_pool,
 				       CONFIG_BT_GATT_UUID16_POOL_SIZE);
 
@@ -116,8 +202,9 @@ static int uuid_16_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
 	return 0;
 }
 
-static int uuid_32_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
+static int uuid_32_get(struct bt_uuid **uuid)
 {
+	struct svc_el_pool *uuid_pool = &uuid_32_pool;
 	size_t ind = free_element_find(uuid_pool,
 				       CONFIG_BT_GATT_UUID32_POOL_SIZE);
 
@@ -131,8 +218,9 @@ static int uuid_32_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
 	return 0;
 }
 
-static int uuid_128_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
+static int uuid_128_get(struct bt_uuid **uuid)
 {
+	struct svc_el_pool *uuid_pool = &uuid_128_pool;
 	size_t ind = free_element_find(uuid_pool,
 				       CONFIG_BT_GATT_UUID128_POOL_SIZE);
 
@@ -166,6 +254,7 @@ static void chrc_release(struct bt_gatt_chrc const *chrc)
 	atomic_clear_bit(chrc_pool.locks,
 			 ADDR_2_INDEX(BT_GATT_CHRC_TAB, chrc));
 }
+#endif /* !defined(CONFIG_BT_GATT_POOL_MEM_ARENA) */
 
 static int uuid_register(struct bt_uuid **dest_uuid,
 			 struct bt_uuid const *src_uuid)
@@ -176,21 +265,21 @@ static int uuid_register(struct bt_uuid **dest_uuid,
 
 	switch (src_uuid->type) {
 	case BT_UUID_TYPE_16:
-		ret = uuid_16_get(dest_uuid, &uuid_16_pool);
+		ret = uuid_16_get(dest_uuid);
 		if (!ret) {
 			memcpy(*dest_uuid, src_uuid, sizeof(struct bt_uuid_16));
 		}
 		break;
 
 	case BT_UUID_TYPE_32:
-		ret = uuid_32_get(dest_uuid, &uuid_32_pool);
+		ret = uuid_32_get(dest_uuid);
 		if (!ret) {
 			memcpy(*dest_uuid, src_uuid, sizeof(struct bt_uuid_32));
 		}
 		break;
 
 	case BT_UUID_TYPE_128:
-		ret = uuid_128_get(dest_uuid, &uuid_128_pool);
+		ret = uuid_128_get(dest_uuid);
 		if (!ret) {
 			memcpy(*dest_uuid, src_uuid,
 			       sizeof(struct bt_uuid_128));
@@ -204,6 +293,7 @@ static int uuid_register(struct bt_uuid **dest_uuid,
 	return ret;
 }
 
+#if !defined(CONFIG_BT_GATT_POOL_MEM_ARENA)
 static void uuid_unregister(struct bt_uuid const *uuid)
 {
 	switch (uuid->type) {
@@ -235,6 +325,7 @@ static void uuid_unregister(struct bt_uuid const *uuid)
 		__ASSERT(false, "Unknown UUID type");
 	}
 }
+#endif /* !defined(CONFIG_BT_GATT_POOL_MEM_ARENA) */
 
 /** @brief Free a single attribute.
  *
@@ -420,6 +511,18 @@ void bt_gatt_pool_free(struct bt_gatt_pool *gp)
 
 
 #if CONFIG_BT_GATT_POOL_STATS != 0
+#if defined(CONFIG_BT_GATT_POOL_MEM_ARENA)
+void bt_gatt_pool_stats_print(void)
+{
+	struct bt_mem_arena_stats stats;
+
+	(void)bt_mem_arena_stats_get(BT_MEM_ARENA_USER_GATT_POOL, &stats);
+
+	printk("Memory arena usage: %zu bytes, high-water mark: %zu bytes\n",
+	       stats.used, stats.max_used);
+	printk("Failed allocations: %u\n\n", stats.alloc_failed);
+}
+#else
 static size_t mask_print(atomic_t *mask, size_t mask_size)
 {
 	size_t used_el_cnt = 0;
@@ -477,4 +580,5 @@ void bt_gatt_pool_stats_print(void)
 	       CONFIG_BT_GATT_CHRC_POOL_SIZE);
 #endif
 }
+#endif /* defined(CONFIG_BT_GATT_POOL_MEM_ARENA) */
 #endif /* CONFIG_BT_GATT_POOL_STATS */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <bluetooth/mem_arena.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bt_mem_arena, CONFIG_BT_MEM_ARENA_LOG_LEVEL);
+
+K_HEAP_DEFINE(arena_heap, CONFIG_BT_MEM_ARENA_SIZE);
+
+static struct k_spinlock stats_lock;
+static struct bt_mem_arena_stats user_stats[BT_MEM_ARENA_USER_COUNT];
+static struct bt_mem_arena_stats total_stats;
+
+static void stats_alloc_update(struct bt_mem_arena_stats *stats, size_t size)
+{
+	stats->used += size;
+	stats->max_used = MAX(stats->max_used, stats->used);
+}
+
+void *bt_mem_arena_alloc(enum bt_mem_arena_user user, size_t size, size_t align)
+{
+	__ASSERT_NO_MSG(user < BT_MEM_ARENA_USER_COUNT);
+	__ASSERT_NO_MSG(size > 0);
+
+	void *block;
+	k_spinlock_key_t key;
+
+	block = k_heap_aligned_alloc(&arena_heap, align, size, K_NO_WAIT);
+
+	key = k_spin_lock(&stats_lock);
+
+	if (block) {
+		stats_alloc_update(&user_stats[user], size);
+		stats_alloc_update(&total_stats, size);
+	} else {
+		user_stats[user].alloc_failed++;
+		total_stats.alloc_failed++;
+	}
+
+	k_spin_unlock(&stats_lock, key);
+
+	if (!block) {
+		LOG_WRN("No memory left in the arena for %zu bytes, user %d", size, user);
+		return NULL;
+	}
+
+	LOG_DBG("Allocated %zu bytes, user %d", size, user);
+
+	return block;
+}
+
+void bt_mem_arena_free(enum bt_mem_arena_user user, void *block, size_t size)
+{
+	__ASSERT_NO_MSG(user < BT_MEM_ARENA_USER_COUNT);
+
+	k_spinlock_key_t key;
+
+	if (!block) {
+		return;
+	}
+
+	k_heap_free(&arena_heap, block);
+
+	key = k_spin_lock(&stats_lock);
+
+	__ASSERT(user_stats[user].used >= size, "Freeing more memory than allocated");
+
+	user_stats[user].used -= size;
+	total_stats.used -= size;
+
+	k_spin_unlock(&stats_lock, key);
+
+	LOG_DBG("Freed %zu bytes, user %d", size, user);
+}
+
+int bt_mem_arena_stats_get(enum bt_mem_arena_user user, struct bt_mem_arena_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (user >= BT_MEM_ARENA_USER_COUNT || !stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&stats_lock);
+	*stats = user_stats[user];
+	k_spin_unlock(&stats_lock, key);
+
+	return 0;
+}
+
+void bt_mem_arena_stats_total_get(struct bt_mem_arena_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&stats_lock);
+	*stats = total_stats;
+	k_spin_unlock(&stats_lock, key);
+}
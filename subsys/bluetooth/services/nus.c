@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
@@ -15,6 +17,23 @@ LOG_MODULE_REGISTER(bt_nus, CONFIG_BT_NUS_LOG_LEVEL);
 
 static struct bt_nus_cb nus_cb;
 
+#if defined(CONFIG_BT_NUS_STREAM)
+/* Delay before retrying a notification if no TX buffer was available. */
+#define STREAM_TX_RETRY_DELAY K_MSEC(1)
+
+struct nus_stream {
+	struct bt_conn *conn;
+	struct ring_buf tx_ring;
+	uint8_t tx_ring_buf[CONFIG_BT_NUS_STREAM_TX_BUF_SIZE];
+	struct k_spinlock lock;
+	struct k_sem tx_space_sem;
+	struct k_work_delayable tx_work;
+	atomic_t in_flight;
+};
+
+static struct nus_stream streams[CONFIG_BT_MAX_CONN];
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
+
 static void nus_ccc_cfg_changed(const struct bt_gatt_attr *attr,
 				  uint16_t value)
 {
@@ -81,6 +100,19 @@ BT_GATT_PRIMARY_SERVICE(BT_UUID_NUS_SERVICE),
 			       NULL, on_receive, NULL),
 );
 
+#if defined(CONFIG_BT_NUS_STREAM)
+static void stream_tx_work_handler(struct k_work *work);
+
+static void stream_init(void)
+{
+	ARRAY_FOR_EACH_PTR(streams, stream) {
+		ring_buf_init(&stream->tx_ring, sizeof(stream->tx_ring_buf), stream->tx_ring_buf);
+		k_sem_init(&stream->tx_space_sem, 0, 1);
+		k_work_init_delayable(&stream->tx_work, stream_tx_work_handler);
+	}
+}
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
+
 int bt_nus_init(struct bt_nus_cb *callbacks)
 {
 	if (callbacks) {
@@ -89,6 +121,10 @@ int bt_nus_init(struct bt_nus_cb *callbacks)
 		nus_cb.send_enabled = callbacks->send_enabled;
 	}
 
+#if defined(CONFIG_BT_NUS_STREAM)
+	stream_init();
+#endif
+
 	return 0;
 }
 
@@ -111,3 +147,194 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 		return -EINVAL;
 	}
 }
+
+#if defined(CONFIG_BT_NUS_STREAM)
+static void stream_in_flight_dec(struct nus_stream *stream)
+{
+	atomic_val_t in_flight;
+
+	/* The counter is reset on disconnection, while the notifications queued before can
+	 * still be reported as sent.
+	 */
+	do {
+		in_flight = atomic_get(&stream->in_flight);
+		if (in_flight <= 0) {
+			return;
+		}
+	} while (!atomic_cas(&stream->in_flight, in_flight, in_flight - 1));
+}
+
+static void stream_on_sent(struct bt_conn *conn, void *user_data)
+{
+	struct nus_stream *stream = user_data;
+
+	LOG_DBG("Stream data sent, conn %p", (void *)conn);
+
+	if (!stream->conn) {
+		/* Notification queued before the disconnection. */
+		return;
+	}
+
+	stream_in_flight_dec(stream);
+	k_work_reschedule(&stream->tx_work, K_NO_WAIT);
+}
+
+static void stream_tx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nus_stream *stream = CONTAINER_OF(dwork, struct nus_stream, tx_work);
+	struct bt_gatt_notify_params params = {
+		.attr = &nus_svc.attrs[2],
+		.func = stream_on_sent,
+		.user_data = stream,
+	};
+	uint32_t max_len;
+	k_spinlock_key_t key;
+	int err;
+
+	if (!stream->conn) {
+		return;
+	}
+
+	max_len = bt_nus_get_mtu(stream->conn);
+
+	while (atomic_get(&stream->in_flight) < CONFIG_BT_NUS_STREAM_TX_WINDOW) {
+		uint8_t *data;
+		uint32_t len;
+
+		key = k_spin_lock(&stream->lock);
+
+		/* Small writes are packed together while the previous notifications are in
+		 * flight. Data is sent right away if nothing is in flight to keep the latency low.
+		 */
+		len = ring_buf_size_get(&stream->tx_ring);
+		if ((len == 0) || ((len < max_len) && (atomic_get(&stream->in_flight) > 0))) {
+			k_spin_unlock(&stream->lock, key);
+			break;
+		}
+
+		/* The notification is sent straight from the ring buffer. */
+		len = ring_buf_get_claim(&stream->tx_ring, &data, max_len);
+		k_spin_unlock(&stream->lock, key);
+
+		params.data = data;
+		params.len = len;
+
+		atomic_inc(&stream->in_flight);
+		err = bt_gatt_notify_cb(stream->conn, &params);
+
+		/* The notification data is copied to the TX buffer. */
+		key = k_spin_lock(&stream->lock);
+		(void)ring_buf_get_finish(&stream->tx_ring, err ? 0 : len);
+		k_spin_unlock(&stream->lock, key);
+
+		if (err) {
+			atomic_dec(&stream->in_flight);
+
+			if ((err == -ENOMEM) && (atomic_get(&stream->in_flight) == 0)) {
+				/* No TX buffer released by this stream will trigger the retry. */
+				k_work_reschedule(&stream->tx_work, STREAM_TX_RETRY_DELAY);
+			} else if (err != -ENOMEM) {
+				LOG_WRN("Stream notification failed (err %d)", err);
+			}
+
+			break;
+		}
+
+		k_sem_give(&stream->tx_space_sem);
+	}
+}
+
+static void stream_reset(struct nus_stream *stream)
+{
+	k_spinlock_key_t key;
+
+	(void)k_work_cancel_delayable(&stream->tx_work);
+
+	key = k_spin_lock(&stream->lock);
+	ring_buf_reset(&stream->tx_ring);
+	k_spin_unlock(&stream->lock, key);
+
+	atomic_set(&stream->in_flight, 0);
+
+	if (stream->conn) {
+		bt_conn_unref(stream->conn);
+		stream->conn = NULL;
+	}
+
+	/* Wake up the writer waiting for free space. */
+	k_sem_give(&stream->tx_space_sem);
+}
+
+static void stream_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	ARG_UNUSED(reason);
+
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+
+	if (stream->conn == conn) {
+		stream_reset(stream);
+	}
+}
+
+BT_CONN_CB_DEFINE(nus_stream_conn_callbacks) = {
+	.disconnected = stream_disconnected,
+};
+
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len,
+		       k_timeout_t timeout)
+{
+	struct nus_stream *stream;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	size_t written = 0;
+
+	if (!conn || (!data && (len > 0))) {
+		return -EINVAL;
+	}
+
+	if (!bt_gatt_is_subscribed(conn, &nus_svc.attrs[2], BT_GATT_CCC_NOTIFY)) {
+		return -EINVAL;
+	}
+
+	stream = &streams[bt_conn_index(conn)];
+
+	key = k_spin_lock(&stream->lock);
+	if (!stream->conn) {
+		stream->conn = bt_conn_ref(conn);
+	}
+	k_spin_unlock(&stream->lock, key);
+
+	while (written < len) {
+		uint32_t put;
+
+		k_sem_reset(&stream->tx_space_sem);
+
+		key = k_spin_lock(&stream->lock);
+		if (stream->conn != conn) {
+			k_spin_unlock(&stream->lock, key);
+			break;
+		}
+
+		put = ring_buf_put(&stream->tx_ring, &data[written], len - written);
+		k_spin_unlock(&stream->lock, key);
+
+		if (put > 0) {
+			written += put;
+			k_work_reschedule(&stream->tx_work, K_NO_WAIT);
+			continue;
+		}
+
+		/* Flow control: wait until notifications free space in the ring buffer. */
+		if (k_sem_take(&stream->tx_space_sem, sys_timepoint_timeout(end))) {
+			break;
+		}
+	}
+
+	if ((written == 0) && (len > 0) && (stream->conn != conn)) {
+		return -ENOTCONN;
+	}
+
+	return (int)written;
+}
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
@@ -10,6 +10,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/gatt.h>
+#include <zephyr/net_buf.h>
 #include <bluetooth/services/ras.h>
 #include <stdint.h>
 
@@ -77,6 +78,54 @@ struct ras_segment {
 	uint8_t               data[];
 } __packed;
 
+/** @brief Reassembly of the Ranging Data segments received by the RREQ.
+ *
+ * Segments are copied straight to their position in the ranging data buffer. Segments received
+ * ahead of a missing segment are kept in the buffer tailroom and appended once the missing segment
+ * is received. All segments except the last one must have the same length to be placed ahead.
+ */
+struct ras_rd_reassembly {
+	/** Bitmap of the segments received ahead, bit n is segment next_segment + n. */
+	uint32_t received;
+	/** Index of the next segment to be appended to the buffer. */
+	uint16_t next_segment;
+	/** Length of the segments except the last one, 0 if not known yet. */
+	uint16_t segment_len;
+	/** Index of the last segment, valid if last_segment_len is not 0. */
+	uint16_t last_segment;
+	/** Length of the last segment, 0 if the last segment was not received yet. */
+	uint16_t last_segment_len;
+	/** All segments have been appended to the buffer. */
+	bool complete;
+};
+
+/** @brief Reset the ranging data reassembly before receiving a new procedure.
+ *
+ * @param[out] reasm Reassembly context.
+ */
+void ras_rd_reassembly_reset(struct ras_rd_reassembly *reasm);
+
+/** @brief Store a received ranging data segment.
+ *
+ * The buffer must not be reset while the procedure is received. Data that has already been
+ * appended can be pulled from the buffer.
+ *
+ * @param[in,out] reasm  Reassembly context.
+ * @param[in,out] buf    Ranging data buffer.
+ * @param[in]     header Segmentation header.
+ * @param[in]     data   Segment data without the segmentation header.
+ * @param[in]     len    Length of the segment data.
+ *
+ * @retval >=0      Number of bytes appended to the buffer. 0 if the segment is a duplicate or was
+ *                  received ahead of a missing segment.
+ * @retval -EINVAL  Invalid segment.
+ * @retval -ENODATA Segment cannot be placed, because too many segments are missing.
+ * @retval -ENOMEM  Buffer not large enough for the segment.
+ */
+int ras_rd_reassembly_segment_store(struct ras_rd_reassembly *reasm, struct net_buf_simple *buf,
+				    struct ras_seg_header header, const uint8_t *data,
+				    uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
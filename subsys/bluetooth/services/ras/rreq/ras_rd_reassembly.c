@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/util.h>
+
+#include "../ras_internal.h"
+
+LOG_MODULE_DECLARE(ras_rreq, CONFIG_BT_RAS_RREQ_LOG_LEVEL);
+
+/* Segment counter is between 0-63. */
+#define SEG_COUNTER_MASK BIT_MASK(6)
+#define SEG_COUNTER_CNT	 (SEG_COUNTER_MASK + 1)
+
+#define REORDER_WINDOW	 CONFIG_BT_RAS_RREQ_REORDER_WINDOW
+
+BUILD_ASSERT(REORDER_WINDOW < (SEG_COUNTER_CNT / 2));
+/* Bitmap of the received segments is shifted by up to REORDER_WINDOW + 1 bits. */
+BUILD_ASSERT((REORDER_WINDOW + 1) < (sizeof(uint32_t) * BITS_PER_BYTE));
+
+void ras_rd_reassembly_reset(struct ras_rd_reassembly *reasm)
+{
+	memset(reasm, 0, sizeof(*reasm));
+}
+
+static bool last_segment_known(const struct ras_rd_reassembly *reasm)
+{
+	return reasm->last_segment_len != 0;
+}
+
+static int last_segment_set(struct ras_rd_reassembly *reasm, uint16_t index, uint16_t len)
+{
+	/* Segments must not be received after the last segment. */
+	if ((reasm->received >> (index - reasm->next_segment + 1)) != 0) {
+		LOG_WRN("Ranging data segment received after the last segment");
+		return -EINVAL;
+	}
+
+	reasm->last_segment = index;
+	reasm->last_segment_len = len;
+
+	return 0;
+}
+
+static int segment_append(struct ras_rd_reassembly *reasm, struct net_buf_simple *buf,
+			  bool last, const uint8_t *data, uint16_t len)
+{
+	int err;
+	uint16_t appended = len;
+
+	if (!last && (reasm->segment_len != len)) {
+		/* Segments received ahead were placed using the previous length. */
+		if (reasm->received != 0) {
+			LOG_WRN("Ranging data segment length changed from %u to %u",
+				reasm->segment_len, len);
+			return -EINVAL;
+		}
+
+		reasm->segment_len = len;
+	}
+
+	if (net_buf_simple_tailroom(buf) < len) {
+		LOG_WRN("Ranging data out buffer not large enough for next segment");
+		return -ENOMEM;
+	}
+
+	if (last) {
+		err = last_segment_set(reasm, reasm->next_segment, len);
+		if (err) {
+			return err;
+		}
+	}
+
+	net_buf_simple_add_mem(buf, data, len);
+	reasm->next_segment++;
+	reasm->received >>= 1;
+
+	/* Segments received ahead are already in place, only the buffer length is updated. */
+	while (reasm->received & BIT(0)) {
+		uint16_t seg_len = (last_segment_known(reasm) &&
+				    (reasm->next_segment == reasm->last_segment)) ?
+				   reasm->last_segment_len : reasm->segment_len;
+
+		(void)net_buf_simple_add(buf, seg_len);
+		appended += seg_len;
+		reasm->next_segment++;
+		reasm->received >>= 1;
+	}
+
+	if (last_segment_known(reasm) && (reasm->next_segment > reasm->last_segment)) {
+		reasm->complete = true;
+	}
+
+	return appended;
+}
+
+static int segment_place_ahead(struct ras_rd_reassembly *reasm, struct net_buf_simple *buf,
+			       uint8_t distance, bool last, const uint8_t *data, uint16_t len)
+{
+	int err;
+	size_t offset;
+
+	if (reasm->received & BIT(distance)) {
+		LOG_DBG("Duplicate ranging data segment %u ignored", reasm->next_segment + distance);
+		return 0;
+	}
+
+	if (last_segment_known(reasm) && ((reasm->next_segment + distance) > reasm->last_segment)) {
+		LOG_WRN("Ranging data segment received after the last segment");
+		return -EINVAL;
+	}
+
+	if (!last) {
+		if (reasm->segment_len == 0) {
+			reasm->segment_len = len;
+		} else if (reasm->segment_len != len) {
+			LOG_WRN("Ranging data segments of different length received out of order");
+			return -EINVAL;
+		}
+	} else if ((reasm->segment_len == 0) || (len > reasm->segment_len)) {
+		LOG_WRN("Cannot place the last ranging data segment received out of order");
+		return -ENODATA;
+	}
+
+	/* The missing segments before this one have the common segment length. */
+	offset = (size_t)distance * reasm->segment_len;
+	if (net_buf_simple_tailroom(buf) < (offset + len)) {
+		LOG_WRN("Ranging data out buffer not large enough for next segment");
+		return -ENOMEM;
+	}
+
+	if (last) {
+		err = last_segment_set(reasm, reasm->next_segment + distance, len);
+		if (err) {
+			return err;
+		}
+	}
+
+	memcpy(net_buf_simple_tail(buf) + offset, data, len);
+	reasm->received |= BIT(distance);
+
+	LOG_DBG("Ranging data segment %u received ahead of segment %u",
+		reasm->next_segment + distance, reasm->next_segment);
+
+	return 0;
+}
+
+int ras_rd_reassembly_segment_store(struct ras_rd_reassembly *reasm, struct net_buf_simple *buf,
+				    struct ras_seg_header header, const uint8_t *data,
+				    uint16_t len)
+{
+	uint8_t distance;
+
+	if (header.first_seg && header.seg_counter != 0) {
+		LOG_WRN("Ranging Data notification received invalid "
+			"rolling_segment_counter %d",
+			header.seg_counter);
+		return -EINVAL;
+	}
+
+	if (reasm->complete) {
+		LOG_DBG("Ranging data segment received after the last segment ignored");
+		return 0;
+	}
+
+	distance = (header.seg_counter - reasm->next_segment) & SEG_COUNTER_MASK;
+
+	if (distance > REORDER_WINDOW) {
+		/* Segments from the previous half of the counter range were already appended to the
+		 * buffer and are received again.
+		 */
+		if ((distance >= (SEG_COUNTER_CNT / 2)) &&
+		    ((SEG_COUNTER_CNT - distance) <= reasm->next_segment)) {
+			LOG_DBG("Duplicate ranging data segment %d ignored", header.seg_counter);
+			return 0;
+		}
+
+		LOG_WRN("Ranging data segment out of order, expected counter %d, "
+			"received counter %d",
+			reasm->next_segment & SEG_COUNTER_MASK, header.seg_counter);
+		return -ENODATA;
+	}
+
+	if (header.first_seg && (reasm->next_segment + distance) != 0) {
+		LOG_WRN("First ranging data segment received in the middle of the procedure");
+		return -EINVAL;
+	}
+
+	if (distance == 0) {
+		return segment_append(reasm, buf, header.last_seg, data, len);
+	}
+
+	return segment_place_ahead(reasm, buf, distance, header.last_seg, data, len);
+}
@@ -67,9 +67,9 @@ static struct bt_ras_rreq {
 	struct bt_ras_features_read features_read;
 
 	bt_gatt_subscribe_func_t subscribe_cb;
+	bt_ras_rreq_segment_received_t segment_cb;
 	uint16_t counter_in_progress;
-	uint8_t next_expected_segment_counter;
-	bool last_segment_received;
+	struct ras_rd_reassembly reassembly;
 	int data_error_status;
 	bool realtime;
 } rreq_pool[CONFIG_BT_RAS_RREQ_MAX_ACTIVE_CONN];
@@ -178,7 +178,7 @@ static uint8_t ranging_data_ready_notify_func(struct bt_conn *conn,
 
 static void data_receive_finished(struct bt_ras_rreq *rreq)
 {
-	if (rreq->data_error_status == 0 && !rreq->last_segment_received) {
+	if (rreq->data_error_status == 0 && !rreq->reassembly.complete) {
 		LOG_WRN("Ranging data completed with missing segments");
 		rreq->data_error_status = -ENODATA;
 	}
@@ -193,8 +193,7 @@ static void data_receive_finished(struct bt_ras_rreq *rreq)
 		rreq->on_demand_rd.data_get_in_progress = false;
 	}
 
-	rreq->last_segment_received = false;
-	rreq->next_expected_segment_counter = 0;
+	ras_rd_reassembly_reset(&rreq->reassembly);
 	rreq->data_error_status = 0;
 }
 
@@ -387,59 +386,32 @@ static uint8_t ras_cp_notify_func(struct bt_conn *conn, struct bt_gatt_subscribe
 
 static void store_ranging_data_segment(struct bt_ras_rreq *rreq, const void *data, uint16_t length)
 {
-	struct net_buf_simple segment;
-
-	net_buf_simple_init_with_data(&segment, (uint8_t *)data, length);
-
-	uint8_t segmentation_header = net_buf_simple_pull_u8(&segment);
-
-	bool first_segment = segmentation_header & BIT(0);
-	bool last_segment = segmentation_header & BIT(1);
-	uint8_t rolling_segment_counter = segmentation_header >> 2;
-
-	if (first_segment && rolling_segment_counter != 0) {
-		LOG_WRN("Ranging Data notification received invalid "
-			"rolling_segment_counter %d",
-			rolling_segment_counter);
-		rreq->data_error_status = -EINVAL;
-		return;
-	}
+	const struct ras_segment *segment = data;
+	uint16_t ranging_data_segment_length = length - sizeof(segment->header);
+	struct net_buf_simple *ranging_data_out = rreq->realtime
+							  ? rreq->real_time_rd.ranging_data_out
+							  : rreq->on_demand_rd.ranging_data_out;
+	int ret;
 
-	if (rreq->realtime && first_segment) {
+	if (rreq->realtime && segment->header.first_seg && segment->header.seg_counter == 0) {
 		struct ras_ranging_header *ranging_header =
-			(struct ras_ranging_header *)segment.data;
+			(struct ras_ranging_header *)segment->data;
 		rreq->counter_in_progress = ranging_header->ranging_counter;
 	}
 
-	if (rreq->next_expected_segment_counter != rolling_segment_counter) {
-		LOG_WRN("No support for receiving segments out of order, expected counter %d, "
-			"received counter %d",
-			rreq->next_expected_segment_counter, rolling_segment_counter);
-		rreq->data_error_status = -ENODATA;
-		return;
-	}
-
-	uint16_t ranging_data_segment_length = segment.len;
-	struct net_buf_simple *ranging_data_out = rreq->realtime
-							  ? rreq->real_time_rd.ranging_data_out
-							  : rreq->on_demand_rd.ranging_data_out;
-
-	if (net_buf_simple_tailroom(ranging_data_out) < ranging_data_segment_length) {
-		LOG_WRN("Ranging data out buffer not large enough for next segment");
-		rreq->data_error_status = -ENOMEM;
+	/* The segment is copied straight to its position in the ranging data buffer,
+	 * also when received out of order.
+	 */
+	ret = ras_rd_reassembly_segment_store(&rreq->reassembly, ranging_data_out, segment->header,
+					      segment->data, ranging_data_segment_length);
+	if (ret < 0) {
+		rreq->data_error_status = ret;
 		return;
 	}
 
-	uint8_t *ranging_data_segment =
-		net_buf_simple_pull_mem(&segment, ranging_data_segment_length);
-	net_buf_simple_add_mem(ranging_data_out, ranging_data_segment, ranging_data_segment_length);
-
-	if (last_segment) {
-		rreq->last_segment_received = true;
+	if (ret > 0 && rreq->segment_cb) {
+		rreq->segment_cb(rreq->conn, rreq->counter_in_progress, ranging_data_out);
 	}
-
-	/* Segment counter is between 0-63. */
-	rreq->next_expected_segment_counter = (rolling_segment_counter + 1) & BIT_MASK(6);
 }
 
 static uint8_t ras_on_demand_ranging_data_notify_func(struct bt_conn *conn,
@@ -472,7 +444,7 @@ static uint8_t ras_on_demand_ranging_data_notify_func(struct bt_conn *conn,
 		return BT_GATT_ITER_CONTINUE;
 	}
 
-	if (rreq->last_segment_received) {
+	if (rreq->reassembly.complete) {
 		LOG_WRN("On-demand Ranging Data notification received after last segment");
 		return BT_GATT_ITER_CONTINUE;
 	}
@@ -531,7 +503,7 @@ static uint8_t ras_real_time_ranging_data_notify_func(struct bt_conn *conn,
 
 	store_ranging_data_segment(rreq, data, length);
 
-	if (rreq->last_segment_received || rreq->data_error_status) {
+	if (rreq->reassembly.complete || rreq->data_error_status) {
 		data_receive_finished(rreq);
 	}
 
@@ -1162,6 +1134,20 @@ int bt_ras_rreq_read_features(struct bt_conn *conn, bt_ras_rreq_features_read_cb
 	return 0;
 }
 
+int bt_ras_rreq_segment_received_cb_register(struct bt_conn *conn,
+					     bt_ras_rreq_segment_received_t cb)
+{
+	struct bt_ras_rreq *rreq = ras_rreq_find(conn);
+
+	if (rreq == NULL) {
+		return -EINVAL;
+	}
+
+	rreq->segment_cb = cb;
+
+	return 0;
+}
+
 int bt_ras_rreq_cp_get_ranging_data(struct bt_conn *conn, struct net_buf_simple *ranging_data_out,
 				    uint16_t ranging_counter,
 				    bt_ras_rreq_ranging_data_received_t cb)
@@ -1186,8 +1172,7 @@ int bt_ras_rreq_cp_get_ranging_data(struct bt_conn *conn, struct net_buf_simple
 	rreq->on_demand_rd.ranging_data_out = ranging_data_out;
 	rreq->counter_in_progress = ranging_counter;
 	rreq->on_demand_rd.data_cb = cb;
-	rreq->next_expected_segment_counter = 0;
-	rreq->last_segment_received = false;
+	ras_rd_reassembly_reset(&rreq->reassembly);
 	rreq->data_error_status = 0;
 
 	NET_BUF_SIMPLE_DEFINE(get_ranging_data, RASCP_CMD_OPCODE_LEN + sizeof(uint16_t));
@@ -1206,138 +1191,197 @@ int bt_ras_rreq_cp_get_ranging_data(struct bt_conn *conn, struct net_buf_simple
 	return 0;
 }
 
-void bt_ras_rreq_rd_subevent_data_parse(struct net_buf_simple *peer_ranging_data_buf,
-					struct net_buf_simple *local_step_data_buf,
-					enum bt_conn_le_cs_role cs_role,
-					bt_ras_rreq_ranging_header_cb_t ranging_header_cb,
-					bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
-					bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data)
+void bt_ras_rreq_rd_parser_init(struct bt_ras_rreq_rd_parser *parser,
+				enum bt_conn_le_cs_role cs_role,
+				bt_ras_rreq_ranging_header_cb_t ranging_header_cb,
+				bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
+				bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data)
 {
-	bool error = false;
+	memset(parser, 0, sizeof(*parser));
 
-	if (!peer_ranging_data_buf) {
-		LOG_ERR("No peer step data provided.");
-		error = true;
-	} else if (peer_ranging_data_buf->len == 0) {
-		LOG_ERR("Tried to parse empty peer step data.");
-		error = true;
-	}
+	parser->cs_role = cs_role;
+	parser->ranging_header_cb = ranging_header_cb;
+	parser->subevent_header_cb = subevent_header_cb;
+	parser->step_data_cb = step_data_cb;
+	parser->user_data = user_data;
+}
 
-	if (!local_step_data_buf) {
-		LOG_ERR("No local step data provided.");
-		error = true;
-	} else if (local_step_data_buf->len == 0) {
-		LOG_ERR("Tried to parse empty local step data.");
-		error = true;
+static int rd_parser_step_parse(struct bt_ras_rreq_rd_parser *parser,
+				struct net_buf_simple *peer_ranging_data_buf,
+				struct net_buf_simple *local_step_data_buf)
+{
+	struct bt_le_cs_subevent_step local_step;
+	struct bt_le_cs_subevent_step peer_step;
+
+	/* Step headers are only removed from the buffers once the complete step is available. */
+	if (local_step_data_buf->len < 3 || peer_ranging_data_buf->len < 1) {
+		return -EAGAIN;
 	}
 
-	if (error) {
-		return;
+	local_step.mode = local_step_data_buf->data[0];
+	local_step.channel = local_step_data_buf->data[1];
+	local_step.data_len = local_step_data_buf->data[2];
+
+	peer_step.mode = peer_ranging_data_buf->data[0];
+	peer_step.channel = local_step.channel;
+
+	if (peer_step.mode & BIT(7)) {
+		/* From RAS spec:
+		 * Bit 7: 1 means Aborted, 0 means Success
+		 * If the Step is aborted and bit 7 is set to 1, then bits 0-6 do
+		 * not contain any valid data
+		 */
+		LOG_INF("Peer step aborted");
+		return -ECONNABORTED;
 	}
 
-	/* Remove ranging data header. */
-	struct ras_ranging_header *peer_ranging_header =
-		net_buf_simple_pull_mem(peer_ranging_data_buf, sizeof(struct ras_ranging_header));
+	if (peer_step.mode != local_step.mode) {
+		LOG_WRN("Mismatch of local and peer step mode %d != %d", peer_step.mode,
+			local_step.mode);
+		return -EBADMSG;
+	}
 
-	if (ranging_header_cb && !ranging_header_cb(peer_ranging_header, user_data)) {
-		return;
+	if (local_step.data_len == 0) {
+		LOG_WRN("Encountered zero-length step data.");
+		return -EBADMSG;
 	}
 
-	while (peer_ranging_data_buf->len >= sizeof(struct ras_subevent_header)) {
-		struct ras_subevent_header *peer_subevent_header_data = net_buf_simple_pull_mem(
-			peer_ranging_data_buf, sizeof(struct ras_subevent_header));
+	peer_step.data_len = local_step.data_len;
 
-		if (subevent_header_cb &&
-		    !subevent_header_cb(peer_subevent_header_data, user_data)) {
-			return;
-		}
+	if (peer_step.mode == 0) {
+		/* Only occasion where peer step mode length is not equal to local
+		 * step mode length is mode 0 steps.
+		 */
+		peer_step.data_len =
+			(parser->cs_role == BT_CONN_LE_CS_ROLE_INITIATOR)
+				? sizeof(struct bt_hci_le_cs_step_data_mode_0_reflector)
+				: sizeof(struct bt_hci_le_cs_step_data_mode_0_initiator);
+	}
 
-		if (peer_subevent_header_data->num_steps_reported == 0) {
-			LOG_DBG("Skipping subevent with no steps.");
-			continue;
-		}
+	if (local_step_data_buf->len < 3 + local_step.data_len ||
+	    peer_ranging_data_buf->len < 1 + peer_step.data_len) {
+		return -EAGAIN;
+	}
 
-		if (peer_ranging_data_buf->len == 0) {
-			LOG_WRN("Empty peer step data buf where steps were expected.");
-			return;
-		}
+	net_buf_simple_pull(local_step_data_buf, 3);
+	net_buf_simple_pull(peer_ranging_data_buf, 1);
 
-		for (uint8_t i = 0; i < peer_subevent_header_data->num_steps_reported; i++) {
-			struct bt_le_cs_subevent_step local_step;
-			struct bt_le_cs_subevent_step peer_step;
+	peer_step.data = peer_ranging_data_buf->data;
+	local_step.data = local_step_data_buf->data;
 
-			if (local_step_data_buf->len < 3) {
-				LOG_WRN("Local step data appears malformed.");
-				return;
-			}
+	if (parser->step_data_cb &&
+	    !parser->step_data_cb(&local_step, &peer_step, parser->user_data)) {
+		return -ECANCELED;
+	}
 
-			if (peer_ranging_data_buf->len < 1) {
-				LOG_WRN("Peer step data appears malformed.");
-				return;
-			}
+	net_buf_simple_pull(peer_ranging_data_buf, peer_step.data_len);
+	net_buf_simple_pull(local_step_data_buf, local_step.data_len);
 
-			local_step.mode = net_buf_simple_pull_u8(local_step_data_buf);
-			local_step.channel = net_buf_simple_pull_u8(local_step_data_buf);
-			local_step.data_len = net_buf_simple_pull_u8(local_step_data_buf);
+	return 0;
+}
 
-			peer_step.mode = net_buf_simple_pull_u8(peer_ranging_data_buf);
-			peer_step.channel = local_step.channel;
+int bt_ras_rreq_rd_parser_feed(struct bt_ras_rreq_rd_parser *parser,
+			       struct net_buf_simple *peer_ranging_data_buf,
+			       struct net_buf_simple *local_step_data_buf)
+{
+	int err;
 
-			if (peer_step.mode != local_step.mode) {
-				LOG_WRN("Mismatch of local and peer step mode %d != %d",
-					peer_step.mode, local_step.mode);
-				return;
-			}
+	if (parser->err) {
+		return parser->err;
+	}
 
-			if (local_step.data_len == 0) {
-				LOG_WRN("Encountered zero-length step data.");
-				return;
-			}
+	if (!parser->ranging_header_parsed) {
+		if (peer_ranging_data_buf->len < sizeof(struct ras_ranging_header)) {
+			return 0;
+		}
 
-			peer_step.data = peer_ranging_data_buf->data;
-			local_step.data = local_step_data_buf->data;
+		/* Remove ranging data header. */
+		struct ras_ranging_header *peer_ranging_header = net_buf_simple_pull_mem(
+			peer_ranging_data_buf, sizeof(struct ras_ranging_header));
 
-			peer_step.data_len = local_step.data_len;
+		parser->ranging_header_parsed = true;
 
-			if (peer_step.mode & BIT(7)) {
-				/* From RAS spec:
-				 * Bit 7: 1 means Aborted, 0 means Success
-				 * If the Step is aborted and bit 7 is set to 1, then bits 0-6 do
-				 * not contain any valid data
-				 */
-				LOG_INF("Peer step aborted");
-				return;
-			}
+		if (parser->ranging_header_cb &&
+		    !parser->ranging_header_cb(peer_ranging_header, parser->user_data)) {
+			parser->err = -ECANCELED;
+			return parser->err;
+		}
+	}
 
-			if (peer_step.mode == 0) {
-				/* Only occasion where peer step mode length is not equal to local
-				 * step mode length is mode 0 steps.
-				 */
-				peer_step.data_len =
-					(cs_role == BT_CONN_LE_CS_ROLE_INITIATOR)
-						? sizeof(struct
-							 bt_hci_le_cs_step_data_mode_0_reflector)
-						: sizeof(struct
-							 bt_hci_le_cs_step_data_mode_0_initiator);
+	while (true) {
+		if (parser->steps_remaining == 0) {
+			if (peer_ranging_data_buf->len < sizeof(struct ras_subevent_header)) {
+				return 0;
 			}
 
-			if (local_step.data_len > local_step_data_buf->len) {
-				LOG_WRN("Local step data appears malformed.");
-				return;
-			}
+			struct ras_subevent_header *peer_subevent_header_data =
+				net_buf_simple_pull_mem(peer_ranging_data_buf,
+							sizeof(struct ras_subevent_header));
 
-			if (peer_step.data_len > peer_ranging_data_buf->len) {
-				LOG_WRN("Peer step data appears malformed.");
-				return;
+			if (parser->subevent_header_cb &&
+			    !parser->subevent_header_cb(peer_subevent_header_data,
+							parser->user_data)) {
+				parser->err = -ECANCELED;
+				return parser->err;
 			}
 
-			if (step_data_cb && !step_data_cb(&local_step, &peer_step, user_data)) {
-				return;
+			parser->steps_remaining = peer_subevent_header_data->num_steps_reported;
+
+			if (parser->steps_remaining == 0) {
+				LOG_DBG("Skipping subevent with no steps.");
 			}
 
-			net_buf_simple_pull(peer_ranging_data_buf, peer_step.data_len);
-			net_buf_simple_pull(local_step_data_buf, local_step.data_len);
+			continue;
 		}
+
+		err = rd_parser_step_parse(parser, peer_ranging_data_buf, local_step_data_buf);
+		if (err == -EAGAIN) {
+			return 0;
+		} else if (err) {
+			parser->err = err;
+			return parser->err;
+		}
+
+		parser->steps_remaining--;
+		parser->steps_parsed++;
+	}
+}
+
+void bt_ras_rreq_rd_subevent_data_parse(struct net_buf_simple *peer_ranging_data_buf,
+					struct net_buf_simple *local_step_data_buf,
+					enum bt_conn_le_cs_role cs_role,
+					bt_ras_rreq_ranging_header_cb_t ranging_header_cb,
+					bt_ras_rreq_subevent_header_cb_t subevent_header_cb,
+					bt_ras_rreq_step_data_cb_t step_data_cb, void *user_data)
+{
+	struct bt_ras_rreq_rd_parser parser;
+	bool error = false;
+
+	if (!peer_ranging_data_buf) {
+		LOG_ERR("No peer step data provided.");
+		error = true;
+	} else if (peer_ranging_data_buf->len == 0) {
+		LOG_ERR("Tried to parse empty peer step data.");
+		error = true;
+	}
+
+	if (!local_step_data_buf) {
+		LOG_ERR("No local step data provided.");
+		error = true;
+	} else if (local_step_data_buf->len == 0) {
+		LOG_ERR("Tried to parse empty local step data.");
+		error = true;
+	}
+
+	if (error) {
+		return;
+	}
+
+	bt_ras_rreq_rd_parser_init(&parser, cs_role, ranging_header_cb, subevent_header_cb,
+				   step_data_cb, user_data);
+
+	if (bt_ras_rreq_rd_parser_feed(&parser, peer_ranging_data_buf, local_step_data_buf)) {
+		return;
 	}
 
 	if (local_step_data_buf->len != 0 || peer_ranging_data_buf->len != 0) {
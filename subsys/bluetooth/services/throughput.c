@@ -17,11 +17,23 @@
 
 #include <bluetooth/services/throughput.h>
 
+#if defined(CONFIG_NRF_CPU_LOAD)
+#include <debug/cpu_load.h>
+#endif
+
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(bt_throughput, CONFIG_BT_THROUGHPUT_LOG_LEVEL);
 
-static struct bt_throughput_metrics met;
+/* ATT header of the Write Command. */
+#define WRITE_CMD_HDR_LEN 3
+
+/* Metrics are kept separately for each connection. */
+static struct {
+	struct bt_throughput_metrics met;
+	uint32_t clock_cycles;
+} conn_metrics[CONFIG_BT_MAX_CONN];
+
 static const struct bt_throughput_cb *callbacks;
 
 static uint8_t read_fn(struct bt_conn *conn, uint8_t err,
@@ -48,23 +60,20 @@ static ssize_t write_callback(struct bt_conn *conn,
 			      const struct bt_gatt_attr *attr, const void *buf,
 			      uint16_t len, uint16_t offset, uint8_t flags)
 {
-	static uint32_t clock_cycles;
-	static uint32_t kb;
-
 	uint64_t delta;
 
-	struct bt_throughput_metrics *met_data = attr->user_data;
+	uint8_t conn_index = bt_conn_index(conn);
+	struct bt_throughput_metrics *met_data = &conn_metrics[conn_index].met;
 
-	delta = k_cycle_get_32() - clock_cycles;
+	delta = k_cycle_get_32() - conn_metrics[conn_index].clock_cycles;
 	delta = k_cyc_to_ns_floor64(delta);
 
 	if (len == 1) {
 		/* reset metrics */
-		kb = 0;
 		met_data->write_count = 0;
 		met_data->write_len = 0;
 		met_data->write_rate = 0;
-		clock_cycles = k_cycle_get_32();
+		conn_metrics[conn_index].clock_cycles = k_cycle_get_32();
 	} else {
 		met_data->write_count++;
 		met_data->write_len += len;
@@ -85,7 +94,7 @@ static ssize_t read_callback(struct bt_conn *conn,
 			     const struct bt_gatt_attr *attr, void *buf,
 			     uint16_t len, uint16_t offset)
 {
-	const struct bt_throughput_metrics *metrics = attr->user_data;
+	const struct bt_throughput_metrics *metrics = &conn_metrics[bt_conn_index(conn)].met;
 
 	len = MIN(sizeof(struct bt_throughput_metrics), len);
 
@@ -96,7 +105,7 @@ static ssize_t read_callback(struct bt_conn *conn,
 	LOG_DBG("Data send.");
 
 	return bt_gatt_attr_read(
-		conn, attr, buf, len, offset, attr->user_data, len);
+		conn, attr, buf, len, offset, metrics, len);
 }
 
 
@@ -105,7 +114,7 @@ BT_GATT_PRIMARY_SERVICE(BT_UUID_THROUGHPUT),
 	BT_GATT_CHARACTERISTIC(BT_UUID_THROUGHPUT_CHAR,
 		BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE_WITHOUT_RESP,
 		BT_GATT_PERM_READ | BT_GATT_PERM_WRITE,
-		read_callback, write_callback, &met),
+		read_callback, write_callback, NULL),
 );
 
 int bt_throughput_init(struct bt_throughput *throughput,
@@ -181,3 +190,168 @@ int bt_throughput_write(struct bt_throughput *throughput,
 					      throughput->char_handle,
 					      data, len, false);
 }
+
+#if defined(CONFIG_BT_THROUGHPUT_STREAM)
+#define STREAM_WRITE_LEN_MAX (CONFIG_BT_L2CAP_TX_MTU - WRITE_CMD_HDR_LEN)
+#define STREAM_TX_WINDOW     CONFIG_BT_THROUGHPUT_STREAM_TX_WINDOW
+#define STREAM_TX_WAIT	     K_MSEC(10)
+#define STREAM_DRAIN_TIMEOUT 1000
+
+static const uint8_t stream_data[STREAM_WRITE_LEN_MAX];
+static K_SEM_DEFINE(stream_tx_sem, 0, 1);
+
+static void stream_write_sent(struct bt_conn *conn, void *user_data)
+{
+	struct bt_throughput *throughput = user_data;
+
+	atomic_inc(&throughput->stream_sent);
+	atomic_dec(&throughput->stream_in_flight);
+	k_sem_give(&stream_tx_sem);
+}
+
+static int stream_write(struct bt_throughput *throughput, uint16_t write_len)
+{
+	int err;
+
+	atomic_inc(&throughput->stream_in_flight);
+
+	err = bt_gatt_write_without_response_cb(throughput->conn, throughput->char_handle,
+						stream_data, write_len, false,
+						stream_write_sent, throughput);
+	if (err) {
+		atomic_dec(&throughput->stream_in_flight);
+	}
+
+	return err;
+}
+
+static bool stream_drained(struct bt_throughput *throughput[], size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		if (atomic_get(&throughput[i]->stream_in_flight) > 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void stream_report_fill(struct bt_throughput *throughput[], size_t cnt,
+			       uint16_t write_len, uint32_t duration,
+			       struct bt_throughput_stream_report *report)
+{
+	memset(report, 0, sizeof(*report));
+	report->duration = duration;
+
+	for (size_t i = 0; i < cnt; i++) {
+		struct bt_throughput_stream_stats *stats = &throughput[i]->stream;
+
+		stats->write_count = atomic_get(&throughput[i]->stream_sent);
+		stats->write_len = stats->write_count * write_len;
+		stats->goodput = ((uint64_t)stats->write_len << 3) * MSEC_PER_SEC /
+				 MAX(duration, 1);
+
+		report->write_count += stats->write_count;
+		report->write_len += stats->write_len;
+		report->goodput += stats->goodput;
+		report->tx_starved += stats->tx_starved;
+	}
+
+#if defined(CONFIG_NRF_CPU_LOAD)
+	report->cpu_load = cpu_load_get();
+#else
+	report->cpu_load = -ENOTSUP;
+#endif
+}
+
+int bt_throughput_stream_run(struct bt_throughput *throughput[], size_t cnt,
+			     uint16_t write_len, uint32_t duration,
+			     struct bt_throughput_stream_report *report)
+{
+	int err = 0;
+	int64_t start;
+	int64_t drain_start;
+
+	if (!throughput || (cnt == 0) || (write_len <= 1) || !report) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		if (!throughput[i] || !throughput[i]->conn ||
+		    (write_len > STREAM_WRITE_LEN_MAX) ||
+		    (write_len > (bt_gatt_get_mtu(throughput[i]->conn) - WRITE_CMD_HDR_LEN))) {
+			return -EINVAL;
+		}
+	}
+
+	/* Reset the metrics of the peers. */
+	for (size_t i = 0; i < cnt; i++) {
+		memset(&throughput[i]->stream, 0, sizeof(throughput[i]->stream));
+		atomic_set(&throughput[i]->stream_sent, 0);
+		atomic_set(&throughput[i]->stream_in_flight, 0);
+
+		err = bt_throughput_write(throughput[i], stream_data, 1);
+		if (err) {
+			LOG_ERR("Metrics reset failed (err %d)", err);
+			return err;
+		}
+	}
+
+#if defined(CONFIG_NRF_CPU_LOAD)
+	cpu_load_reset();
+#endif
+
+	LOG_DBG("Streaming to %zu connections", cnt);
+
+	start = k_uptime_get();
+
+	while ((k_uptime_get() - start) < duration) {
+		bool queued = false;
+
+		/* Connections take turns, so that one connection cannot take all TX buffers. */
+		for (size_t i = 0; i < cnt; i++) {
+			if (atomic_get(&throughput[i]->stream_in_flight) >= STREAM_TX_WINDOW) {
+				continue;
+			}
+
+			err = stream_write(throughput[i], write_len);
+			if ((err == -ENOMEM) || (err == -ENOBUFS)) {
+				throughput[i]->stream.tx_starved++;
+				err = 0;
+				continue;
+			} else if (err) {
+				LOG_ERR("Write failed (err %d)", err);
+				break;
+			}
+
+			queued = true;
+		}
+
+		if (err) {
+			break;
+		}
+
+		if (!queued) {
+			(void)k_sem_take(&stream_tx_sem, STREAM_TX_WAIT);
+		}
+	}
+
+	/* Writes in flight are counted when sent. */
+	drain_start = k_uptime_get();
+	while (!stream_drained(throughput, cnt)) {
+		if ((k_uptime_get() - drain_start) > STREAM_DRAIN_TIMEOUT) {
+			LOG_WRN("Writes still in flight after stream end");
+			break;
+		}
+
+		(void)k_sem_take(&stream_tx_sem, STREAM_TX_WAIT);
+	}
+
+	stream_report_fill(throughput, cnt, write_len, k_uptime_get() - start, report);
+
+	LOG_DBG("Stream finished: %u bytes, %u bps, %u TX starvations", report->write_len,
+		report->goodput, report->tx_starved);
+
+	return err;
+}
+#endif /* defined(CONFIG_BT_THROUGHPUT_STREAM) */
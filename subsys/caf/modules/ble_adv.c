@@ -314,13 +314,28 @@ static int update_undirected_advertising(struct bt_le_adv_param *adv_param)
 	}
 
 	if (adv_param) {
-		return bt_le_adv_start(adv_param, ad, ad_len, sd, sd_len);
+		/* Payload is always sent on advertising start. Store it for the later updates. */
+		bt_le_adv_prov_payload_invalidate(adv_state.adv_handle);
+		(void)bt_le_adv_prov_payload_changed(&adv_state, ad, ad_len, sd, sd_len);
+
+		err = bt_le_adv_start(adv_param, ad, ad_len, sd, sd_len);
 	} else {
 		__ASSERT_NO_MSG(!adv_state.new_adv_session);
 		__ASSERT_NO_MSG(!adv_state.rpa_rotated);
 
-		return bt_le_adv_update_data(ad, ad_len, sd, sd_len);
+		if (!bt_le_adv_prov_payload_changed(&adv_state, ad, ad_len, sd, sd_len)) {
+			LOG_DBG("Advertising payload did not change");
+			return 0;
+		}
+
+		err = bt_le_adv_update_data(ad, ad_len, sd, sd_len);
 	}
+
+	if (err) {
+		bt_le_adv_prov_payload_invalidate(adv_state.adv_handle);
+	}
+
+	return err;
 }
 
 static void setup_accept_list_cb(const struct bt_bond_info *info, void *user_data)
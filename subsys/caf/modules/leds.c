@@ -19,6 +19,9 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_LEDS_LOG_LEVEL);
 
 #define LED_ID(led) ((led) - &leds[0])
 
+#define UPDATE_NONE	INT64_MAX
+#define UPDATE_TICK_MS	CONFIG_CAF_LEDS_TICK_MS
+
 struct led {
 	const struct device *dev;
 	uint8_t color_count;
@@ -28,7 +31,12 @@ struct led {
 	uint16_t effect_step;
 	uint16_t effect_substep;
 
-	struct k_work_delayable work;
+	/* Uptime of the next effect substep. */
+	int64_t next_update;
+
+	/* Brightness last written to the driver. */
+	uint8_t brightness[_CAF_LED_COLOR_CHANNEL_COUNT];
+	bool brightness_valid;
 };
 
 #ifdef CONFIG_CAF_LEDS_PWM
@@ -50,6 +58,25 @@ static struct led leds[] = {
 	DT_INST_FOREACH_STATUS_OKAY(_LED_INSTANCE_DEF)
 };
 
+/* All of the LEDs are updated from a single work. */
+static struct k_work_delayable update_work;
+
+
+static int set_brightness(struct led *led, uint32_t channel, uint8_t brightness)
+{
+	/* Skip the driver call if the channel does not change. */
+	if (led->brightness_valid && (led->brightness[channel] == brightness)) {
+		return 0;
+	}
+
+	int err = led_set_brightness(led->dev, channel, brightness);
+
+	if (!err) {
+		led->brightness[channel] = brightness;
+	}
+
+	return err;
+}
 
 static int set_color_one_channel(struct led *led, struct led_color *color)
 {
@@ -61,7 +88,7 @@ static int set_color_one_channel(struct led *led, struct led_color *color)
 	}
 	brightness /= ARRAY_SIZE(color->c);
 
-	return led_set_brightness(led->dev, 0, brightness);
+	return set_brightness(led, 0, brightness);
 }
 
 static int set_color_all_channels(struct led *led, struct led_color *color)
@@ -69,7 +96,7 @@ static int set_color_all_channels(struct led *led, struct led_color *color)
 	int err = 0;
 
 	for (size_t i = 0; (i < ARRAY_SIZE(color->c)) && !err; i++) {
-		err = led_set_brightness(led->dev, i, color->c[i]);
+		err = set_brightness(led, i, color->c[i]);
 	}
 
 	return err;
@@ -88,6 +115,8 @@ static void set_color(struct led *led, struct led_color *color)
 	if (err) {
 		LOG_ERR("Cannot set LED brightness (err: %d)", err);
 	}
+
+	led->brightness_valid = !err;
 }
 
 static void set_off(struct led *led)
@@ -97,11 +126,8 @@ static void set_off(struct led *led)
 	set_color(led, &nocolor);
 }
 
-static void work_handler(struct k_work *work)
+static void effect_substep(struct led *led)
 {
-	struct k_work_delayable *delayable_work = k_work_delayable_from_work(work);
-	struct led *led = CONTAINER_OF(delayable_work, struct led, work);
-
 	const struct led_effect_step *effect_step =
 		&led->effect->steps[led->effect_step];
 
@@ -113,7 +139,6 @@ static void work_handler(struct k_work *work)
 			substeps_left;
 		led->color.c[i] += diff;
 	}
-	set_color(led, &led->color);
 
 	led->effect_substep++;
 	if (led->effect_substep == effect_step->substep_count) {
@@ -135,19 +160,72 @@ static void work_handler(struct k_work *work)
 	}
 
 	if (led->effect_step < led->effect->step_count) {
-		int32_t next_delay =
-			led->effect->steps[led->effect_step].substep_time;
+		/* Deadlines are absolute, so that the effect does not drift. */
+		led->next_update += led->effect->steps[led->effect_step].substep_time;
+	} else {
+		led->next_update = UPDATE_NONE;
+	}
+}
 
-		k_work_reschedule(&led->work, K_MSEC(next_delay));
+static void update_schedule(void)
+{
+	int64_t next_update = UPDATE_NONE;
+
+	for (size_t i = 0; i < ARRAY_SIZE(leds); i++) {
+		next_update = MIN(next_update, leds[i].next_update);
 	}
+
+	if (next_update == UPDATE_NONE) {
+		k_work_cancel_delayable(&update_work);
+		return;
+	}
+
+	if (UPDATE_TICK_MS > 0) {
+		/* Align to the tick to update multiple LEDs at a single wake up. */
+		next_update = DIV_ROUND_UP(next_update, UPDATE_TICK_MS) * UPDATE_TICK_MS;
+	}
+
+	k_work_reschedule(&update_work, K_TIMEOUT_ABS_MS(next_update));
 }
 
-static void led_update(struct led *led)
+static void update_work_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < ARRAY_SIZE(leds); i++) {
+		struct led *led = &leds[i];
+		bool color_changed = false;
+
+		/* Substeps that were due since the last update are merged. */
+		while (led->next_update <= now) {
+			effect_substep(led);
+			color_changed = true;
+		}
+
+		if (color_changed) {
+			set_color(led, &led->color);
+		}
+	}
+
+	update_schedule();
+}
+
+static uint32_t effect_duration(const struct led_effect *effect)
 {
-	k_work_cancel_delayable(&led->work);
+	uint32_t duration = 0;
 
+	for (size_t i = 0; i < effect->step_count; i++) {
+		duration += effect->steps[i].substep_time;
+	}
+
+	return duration;
+}
+
+static void led_update(struct led *led)
+{
 	led->effect_step = 0;
 	led->effect_substep = 0;
+	led->next_update = UPDATE_NONE;
 
 	if (!led->effect) {
 		LOG_DBG("No effect set");
@@ -157,10 +235,14 @@ static void led_update(struct led *led)
 	__ASSERT_NO_MSG(led->effect->steps);
 
 	if (led->effect->step_count > 0) {
-		int32_t next_delay =
-			led->effect->steps[led->effect_step].substep_time;
+		if (led->effect->loop_forever && (effect_duration(led->effect) == 0)) {
+			/* The update work would never leave the loop merging the due substeps. */
+			LOG_ERR("Looped LED effect must take time, effect rejected");
+			return;
+		}
 
-		k_work_reschedule(&led->work, K_MSEC(next_delay));
+		led->next_update = k_uptime_get() +
+				   led->effect->steps[led->effect_step].substep_time;
 	} else {
 		LOG_WRN("LED effect with no effect");
 	}
@@ -181,11 +263,15 @@ static int leds_init(void)
 			LOG_ERR("Device %s is not ready", led->dev->name);
 			err = -ENODEV;
 		} else {
-			k_work_init_delayable(&led->work, work_handler);
 			led_update(led);
 		}
 	}
 
+	if (!err) {
+		k_work_init_delayable(&update_work, update_work_handler);
+		update_schedule();
+	}
+
 	return err;
 }
 
@@ -202,15 +288,20 @@ static void leds_start(void)
 			LOG_ERR("Failed to set LED driver into active state (err: %d)", err);
 		}
 #endif
+		/* The driver state may be lost while suspended. */
+		leds[i].brightness_valid = false;
 		led_update(&leds[i]);
 	}
+
+	update_schedule();
 }
 
 static void leds_stop(void)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(leds); i++) {
-		k_work_cancel_delayable(&leds[i].work);
+	k_work_cancel_delayable(&update_work);
 
+	for (size_t i = 0; i < ARRAY_SIZE(leds); i++) {
+		leds[i].next_update = UPDATE_NONE;
 		set_off(&leds[i]);
 
 #if defined(CONFIG_PM_DEVICE) && !defined(CONFIG_CAF_LEDS_GPIO)
@@ -241,6 +332,7 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 		if (initialized) {
 			led_update(led);
+			update_schedule();
 		}
 
 		return false;
@@ -129,13 +129,10 @@ static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
 	APP_EVENT_SUBMIT(event);
 }
 
-static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
+static int enqueue_sample(struct aggregator *agg, const struct sensor_value *sample)
 {
 	size_t chunk_bytes = agg->values_in_sample * sizeof(struct sensor_value);
 
-	if ((event->dyndata.size) != chunk_bytes) {
-		return -EBADMSG;
-	}
 	if (!agg->active_buf) {
 		return -ENOMEM;
 	}
@@ -148,7 +145,7 @@ static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
 		__ASSERT_NO_MSG(false);
 		return -ENOMEM;
 	}
-	memcpy(&ab->samples[pos_values], (uint8_t *)event->dyndata.data, chunk_bytes);
+	memcpy(&ab->samples[pos_values], sample, chunk_bytes);
 	ab->sample_cnt++;
 	avail_bytes -= chunk_bytes;
 
@@ -160,6 +157,25 @@ static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
 	return 0;
 }
 
+static int enqueue_samples(struct aggregator *agg, struct sensor_event *event)
+{
+	/* A sensor_event may contain a batch of samples. */
+	size_t sample_cnt = sensor_event_get_data_cnt(event) / agg->values_in_sample;
+	const struct sensor_value *data = sensor_event_get_data_ptr(event);
+	int err = 0;
+
+	if ((sample_cnt == 0) ||
+	    (sensor_event_get_data_cnt(event) % agg->values_in_sample) != 0) {
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; !err && (i < sample_cnt); i++) {
+		err = enqueue_sample(agg, &data[i * agg->values_in_sample]);
+	}
+
+	return err;
+}
+
 static bool event_handler(const struct app_event_header *aeh)
 {
 	if (is_sensor_event(aeh)) {
@@ -167,7 +183,7 @@ static bool event_handler(const struct app_event_header *aeh)
 		struct aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			int err = enqueue_sample(agg, event);
+			int err = enqueue_samples(agg, event);
 
 			if (err) {
 				LOG_ERR("Error code: %d", err);
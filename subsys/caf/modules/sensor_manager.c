@@ -31,10 +31,18 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+#if CONFIG_CAF_SENSOR_MANAGER_STATS
+	struct sm_stats stats;
+#endif
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
 
+#if CONFIG_CAF_SENSOR_MANAGER_STATS
+static uint32_t thread_wake_up_cnt;
+static struct k_spinlock stats_lock;
+#endif
+
 static K_THREAD_STACK_DEFINE(sample_thread_stack, SAMPLE_THREAD_STACK_SIZE);
 static struct k_thread sample_thread;
 static struct k_sem can_sample;
@@ -52,19 +60,41 @@ static void update_sensor_state(const struct sm_sensor_config *sc, struct sensor
 	APP_EVENT_SUBMIT(event);
 }
 
-static void send_sensor_event(const char *descr, const struct sensor_value *data, const size_t data_cnt,
-			      atomic_t *event_cnt)
+static void stats_update(struct sensor_data *sd, size_t sample_cnt, bool event_sent)
 {
-	struct sensor_event *event = new_sensor_event(sizeof(struct sensor_value) * data_cnt);
-	struct sensor_value *data_ptr = sensor_event_get_data_ptr(event);
+#if CONFIG_CAF_SENSOR_MANAGER_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
 
-	event->descr = descr;
+	sd->stats.wake_up_cnt++;
+	sd->stats.sample_cnt += sample_cnt;
+	if (event_sent) {
+		sd->stats.event_cnt++;
+	}
 
-	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) == data_cnt);
-	memcpy(data_ptr, data, sizeof(struct sensor_value) * data_cnt);
+	k_spin_unlock(&stats_lock, key);
+#endif
+}
 
-	atomic_inc(event_cnt);
-	APP_EVENT_SUBMIT(event);
+static void stats_thread_wake_up(void)
+{
+#if CONFIG_CAF_SENSOR_MANAGER_STATS
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	thread_wake_up_cnt++;
+
+	k_spin_unlock(&stats_lock, key);
+#endif
+}
+
+static size_t get_batch_size(const struct sm_sensor_config *sc)
+{
+	return MAX(sc->batch_size, 1);
+}
+
+static int64_t get_wake_up_period(const struct sm_sensor_config *sc,
+				  const struct sensor_data *sd)
+{
+	return (int64_t)sd->sampling_period * get_batch_size(sc);
 }
 
 static struct sensor_data *get_sensor_data(const struct device *dev)
@@ -168,6 +198,10 @@ static bool is_sensor_active(const struct sensor_data *sd)
 static void sensor_wake_up_post(const struct sm_sensor_config *sc, struct sensor_data *sd)
 {
 	sd->sample_timeout = k_uptime_get();
+	if (get_batch_size(sc) > 1) {
+		/* Let the sensor FIFO buffer a batch of samples. */
+		sd->sample_timeout += get_wake_up_period(sc, sd);
+	}
 	if (sc->trigger) {
 		reset_sensor_sleep_cnt(sc, sd);
 	}
@@ -215,12 +249,9 @@ static void enter_sleep(const struct sm_sensor_config *sc,
 	k_sched_unlock();
 }
 
-static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config *sc)
+static int read_sample(const struct sm_sensor_config *sc, struct sensor_value *data)
 {
 	size_t data_idx = 0;
-	size_t data_cnt = get_sensor_data_cnt(sc);
-	struct sensor_value data[data_cnt];
-
 	int err = sensor_sample_fetch(sc->dev);
 
 	for (size_t i = 0; !err && (i < sc->chan_cnt); i++) {
@@ -230,24 +261,101 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 		data_idx += sampled_chan->data_cnt;
 	}
 
-	if (err) {
-		LOG_ERR("Sensor sampling error (err %d)", err);
-		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
-	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
-					  &sd->event_cnt);
-		} else {
-			LOG_WRN("Did not send event due to too many active events on sensor: %s",
-				sc->dev->name);
+	return err;
+}
+
+static int read_samples(const struct sm_sensor_config *sc, struct sensor_value *data,
+			size_t sample_cnt)
+{
+	if (sc->fifo_read) {
+		return sc->fifo_read(sc->dev, data, sample_cnt);
+	}
+
+	__ASSERT_NO_MSG(sample_cnt == 1);
+
+	int err = read_sample(sc, data);
+
+	return err ? err : 1;
+}
+
+static struct sensor_event *trim_sensor_event(struct sensor_event *event, size_t data_cnt)
+{
+	struct sensor_event *trimmed = NULL;
+
+	if (data_cnt > 0) {
+		trimmed = new_sensor_event(sizeof(struct sensor_value) * data_cnt);
+		trimmed->descr = event->descr;
+		memcpy(sensor_event_get_data_ptr(trimmed), sensor_event_get_data_ptr(event),
+		       sizeof(struct sensor_value) * data_cnt);
+	}
+
+	app_event_manager_free(event);
+
+	return trimmed;
+}
+
+static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config *sc)
+{
+	size_t data_cnt = get_sensor_data_cnt(sc);
+	size_t sample_cnt = get_batch_size(sc);
+	size_t read_cnt = 0;
+	struct sensor_event *event = NULL;
+	struct sensor_value data[data_cnt];
+	int ret = 0;
+
+	if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+		/* Samples are read directly into the event. */
+		event = new_sensor_event(sizeof(struct sensor_value) * data_cnt * sample_cnt);
+		event->descr = sc->event_descr;
+	}
+
+	while (read_cnt < sample_cnt) {
+		/* Without the event, samples are read one by one to check the activity. */
+		struct sensor_value *samples = event ?
+			&sensor_event_get_data_ptr(event)[read_cnt * data_cnt] : data;
+
+		ret = read_samples(sc, samples, event ? (sample_cnt - read_cnt) : 1);
+
+		if (ret <= 0) {
+			break;
 		}
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
-			process_sensor_activity(sc, sd, data);
-			if (!is_sensor_active(sd)) {
-				enter_sleep(sc, sd);
+			for (int i = 0; i < ret; i++) {
+				process_sensor_activity(sc, sd, &samples[i * data_cnt]);
 			}
+		}
+
+		read_cnt += ret;
+	}
 
+	if (ret < 0) {
+		if (event) {
+			app_event_manager_free(event);
+		}
+		LOG_ERR("Sensor sampling error (err %d)", ret);
+		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
+		return;
+	}
+
+	if (event && (read_cnt < sample_cnt)) {
+		/* Sensor FIFO did not hold a whole batch of samples. */
+		event = trim_sensor_event(event, read_cnt * data_cnt);
+	}
+
+	if (event) {
+		atomic_inc(&sd->event_cnt);
+		APP_EVENT_SUBMIT(event);
+	} else if (read_cnt > 0) {
+		LOG_WRN("Did not send event due to too many active events on sensor: %s",
+			sc->dev->name);
+	}
+
+	stats_update(sd, read_cnt, event != NULL);
+
+	if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
+		if (!is_sensor_active(sd)) {
+			enter_sleep(sc, sd);
 		}
 	}
 }
@@ -270,7 +378,7 @@ static size_t sample_sensors(int64_t *next_timeout)
 
 			int drops = -1;
 			while (sd->sample_timeout <= cur_uptime) {
-				sd->sample_timeout += sd->sampling_period;
+				sd->sample_timeout += get_wake_up_period(sc, sd);
 				drops++;
 			}
 
@@ -387,8 +495,13 @@ static size_t sensor_init(void)
 			LOG_ERR("%s sensor not ready", sc->dev->name);
 			continue;
 		}
+		if ((get_batch_size(sc) > 1) && !sc->fifo_read) {
+			update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
+			LOG_ERR("%s sensor cannot read batch without FIFO", sc->dev->name);
+			continue;
+		}
 		sd->sampling_period = sc->sampling_period_ms;
-		sd->sample_timeout = cur_uptime + sc->sampling_period_ms;
+		sd->sample_timeout = cur_uptime + get_wake_up_period(sc, sd);
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
 			int err = sensor_trigger_init(sc, sd);
@@ -421,6 +534,7 @@ static void sample_thread_fn(void)
 
 		while (alive_sensors > 0) {
 			k_sem_take(&can_sample, K_TIMEOUT_ABS_MS(next_timeout));
+			stats_thread_wake_up();
 
 			alive_sensors = sample_sensors(&next_timeout);
 			configure_max_power_state();
@@ -535,7 +649,7 @@ static bool handle_set_sensor_period_event(const struct app_event_header *aeh)
 			struct sensor_data *sd = &sensor_data[i];
 
 			sd->sampling_period = event->sampling_period;
-			sd->sample_timeout = k_uptime_get() + event->sampling_period;
+			sd->sample_timeout = k_uptime_get() + get_wake_up_period(sc, sd);
 			if (sd->state == SENSOR_STATE_ACTIVE) {
 				k_sem_give(&can_sample);
 			}
@@ -547,6 +661,37 @@ static bool handle_set_sensor_period_event(const struct app_event_header *aeh)
 	return false;
 }
 
+#if CONFIG_CAF_SENSOR_MANAGER_STATS
+int sensor_manager_stats_get(const char *descr, struct sm_stats *stats)
+{
+	int err = descr ? -ENOENT : 0;
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (size_t i = 0; i < ARRAY_SIZE(sensor_data); i++) {
+		const struct sm_stats *sensor_stats = &sensor_data[i].stats;
+
+		if (descr && (descr != sensor_configs[i].event_descr)) {
+			continue;
+		}
+
+		stats->wake_up_cnt += sensor_stats->wake_up_cnt;
+		stats->sample_cnt += sensor_stats->sample_cnt;
+		stats->event_cnt += sensor_stats->event_cnt;
+		err = 0;
+	}
+
+	if (!descr) {
+		stats->wake_up_cnt = thread_wake_up_cnt;
+	}
+
+	k_spin_unlock(&stats_lock, key);
+
+	return err;
+}
+#endif /* CONFIG_CAF_SENSOR_MANAGER_STATS */
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
 	if (is_module_state_event(aeh)) {
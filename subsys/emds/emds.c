@@ -86,6 +86,23 @@ static sys_slist_t emds_dynamic_entries;
 static struct emds_partition partition[PARTITIONS_NUM_MAX];
 static emds_store_cb_t app_store_cb;
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+/* Entries are indexed in storing order: static entries first, then dynamic entries.
+ * The CRC of an entry is taken when it is loaded, so that only the entries that changed
+ * since then are stored in an incremental snapshot. Entries without a valid CRC are always
+ * stored.
+ */
+static uint32_t entry_crc[CONFIG_EMDS_DELTA_ENTRIES_MAX];
+static ATOMIC_DEFINE(entry_crc_valid, CONFIG_EMDS_DELTA_ENTRIES_MAX);
+static ATOMIC_DEFINE(entry_changed, CONFIG_EMDS_DELTA_ENTRIES_MAX);
+
+/* Snapshots restored by emds_load, from the freshest to the last full snapshot */
+static struct emds_snapshot_candidate chain[CONFIG_EMDS_DELTA_CHAIN_MAX];
+static int chain_len;
+/* The allocated snapshot only holds the changed entries */
+static bool allocated_delta;
+#endif
+
 static void emds_print_init_info(void)
 {
 	LOG_DBG("EMDS initialized with the following partitions:");
@@ -227,11 +244,22 @@ bool emds_is_ready(void)
 	return emds_state == EMDS_STATE_READY;
 }
 
-int emds_store_time_get(uint32_t *store_time)
+static uint32_t emds_write_time_get(size_t store_size)
 {
-	size_t store_size = 0;
 	size_t words;
 	int chunk_handling;
+
+	words = DIV_ROUND_UP(store_size, 4);
+	words += DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4);
+	chunk_handling = DIV_ROUND_UP(store_size, CHUNK_SIZE);
+
+	return words * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US +
+	       chunk_handling * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+}
+
+int emds_store_time_get(uint32_t *store_time)
+{
+	size_t store_size = 0;
 	int rc;
 
 	rc = emds_store_size_get(&store_size);
@@ -239,23 +267,26 @@ int emds_store_time_get(uint32_t *store_time)
 		return rc;
 	}
 
-	words = DIV_ROUND_UP(store_size, 4);
-	words += DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4);
-	chunk_handling = DIV_ROUND_UP(store_size, CHUNK_SIZE);
+	*store_time = emds_write_time_get(store_size);
 
-	*store_time = words * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US;
-	*store_time += chunk_handling * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	/* All entries are checked for changes before they are stored */
+	*store_time += DIV_ROUND_UP(store_size, CHUNK_SIZE) * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+#endif
 
 	return 0;
 }
 
-static uint8_t *emds_entry_memory_get(struct emds_data_entry *entry)
+static uint8_t *emds_entry_memory_get(struct emds_data_entry *entry, int *idx)
 {
+	*idx = 0;
+
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
 		if (ch->id == entry->id) {
 			entry->length = MIN(ch->len, entry->length);
 			return ch->data;
 		}
+		(*idx)++;
 	}
 
 	struct emds_dynamic_entry *ch;
@@ -265,12 +296,120 @@ static uint8_t *emds_entry_memory_get(struct emds_data_entry *entry)
 			entry->length = MIN(ch->entry.len, entry->length);
 			return ch->entry.data;
 		}
+		(*idx)++;
 	}
 
 	LOG_WRN("Entry with ID %u not found", entry->id);
 	return NULL;
 }
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+static bool entry_changed_check(int idx, const struct emds_entry *entry)
+{
+	if (idx >= CONFIG_EMDS_DELTA_ENTRIES_MAX || !atomic_test_bit(entry_crc_valid, idx)) {
+		return true;
+	}
+
+	return crc32_k_4_2_update(0, entry->data, entry->len) != entry_crc[idx];
+}
+
+static size_t entry_changed_size(int idx, const struct emds_entry *entry)
+{
+	bool changed = entry_changed_check(idx, entry);
+
+	if (idx < CONFIG_EMDS_DELTA_ENTRIES_MAX) {
+		atomic_set_bit_to(entry_changed, idx, changed);
+	}
+
+	return changed ? entry->len + sizeof(struct emds_data_entry) : 0;
+}
+
+/* Find the entries that changed since they were loaded, and return their storing size. */
+static size_t emds_changed_entries_size(void)
+{
+	size_t size = 0;
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		size += entry_changed_size(idx++, ch);
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		size += entry_changed_size(idx++, &ch->entry);
+	}
+
+	return size;
+}
+
+static bool entry_store_needed(int idx)
+{
+	return !allocated_delta || idx >= CONFIG_EMDS_DELTA_ENTRIES_MAX ||
+	       atomic_test_bit(entry_changed, idx);
+}
+
+static void emds_delta_reset(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(entry_crc_valid); i++) {
+		atomic_clear(&entry_crc_valid[i]);
+	}
+
+	chain_len = 0;
+	allocated_delta = false;
+}
+
+/* Take the CRC of the entries that were fully loaded */
+static void emds_entries_crc_update(void)
+{
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (idx < CONFIG_EMDS_DELTA_ENTRIES_MAX && atomic_test_bit(entry_crc_valid, idx)) {
+			entry_crc[idx] = crc32_k_4_2_update(0, ch->data, ch->len);
+		}
+		idx++;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (idx < CONFIG_EMDS_DELTA_ENTRIES_MAX && atomic_test_bit(entry_crc_valid, idx)) {
+			entry_crc[idx] = crc32_k_4_2_update(0, ch->entry.data, ch->entry.len);
+		}
+		idx++;
+	}
+}
+#endif /* CONFIG_EMDS_DELTA_SNAPSHOTS */
+
+int emds_store_time_changed_get(uint32_t *store_time)
+{
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	size_t store_size = 0;
+	size_t changed_size;
+	unsigned int key;
+
+	if (emds_state != EMDS_STATE_READY || !allocated_delta) {
+		return emds_store_time_get(store_time);
+	}
+
+	(void)emds_store_size_get(&store_size);
+
+	key = irq_lock();
+	changed_size = emds_changed_entries_size();
+	irq_unlock(key);
+
+	*store_time = DIV_ROUND_UP(store_size, CHUNK_SIZE) * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+	if (changed_size) {
+		*store_time += emds_write_time_get(changed_size);
+	}
+
+	return 0;
+#else
+	return emds_store_time_get(store_time);
+#endif
+}
+
 static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_metadata *metadata)
 {
 	struct emds_data_entry entry;
@@ -278,6 +417,7 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 	int32_t data_len = metadata->data_instance_len;
 	int32_t flash_entry_data_len;
 	uint8_t *data_buf;
+	int idx;
 	int rc;
 
 	while (data_len > 0) {
@@ -291,7 +431,7 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 		data_len -= sizeof(entry);
 		flash_entry_data_len = entry.length;
 
-		data_buf = emds_entry_memory_get(&entry);
+		data_buf = emds_entry_memory_get(&entry, &idx);
 
 		if (data_buf) {
 			rc = flash_area_read(fa, data_off, data_buf, entry.length);
@@ -299,6 +439,14 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 				LOG_ERR("Failed to read data for entry ID %u: %d", entry.id, rc);
 				return -EIO;
 			}
+
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+			/* An entry that changed its length is stored again */
+			if (idx < CONFIG_EMDS_DELTA_ENTRIES_MAX) {
+				atomic_set_bit_to(entry_crc_valid, idx,
+						  entry.length == flash_entry_data_len);
+			}
+#endif
 		}
 
 		data_off += flash_entry_data_len;
@@ -308,6 +456,45 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 	return 0;
 }
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+/* Restore the freshest snapshot and the incremental snapshots it depends on */
+static int emds_chain_read(void)
+{
+	const struct emds_partition *p = &partition[freshest_snapshot.partition_index];
+	int rc;
+
+	chain[0] = freshest_snapshot;
+	chain_len = 1;
+
+	while (emds_flash_snapshot_is_delta(&chain[chain_len - 1].metadata)) {
+		if (chain_len == ARRAY_SIZE(chain) ||
+		    emds_flash_snapshot_prev_get(p, &chain[chain_len - 1], &chain[chain_len])) {
+			LOG_ERR("No full snapshot before fresh_cnt %u",
+				chain[chain_len - 1].metadata.fresh_cnt);
+			chain_len = 0;
+			memset(&freshest_snapshot, 0, sizeof(freshest_snapshot));
+			return -ENOENT;
+		}
+
+		chain_len++;
+	}
+
+	LOG_DBG("Restoring %d snapshots", chain_len);
+
+	for (int i = chain_len - 1; i >= 0; i--) {
+		rc = emds_read_data(p->fa, &chain[i].metadata);
+		if (rc) {
+			chain_len = 0;
+			return rc;
+		}
+	}
+
+	emds_entries_crc_update();
+
+	return 0;
+}
+#endif /* CONFIG_EMDS_DELTA_SNAPSHOTS */
+
 int emds_load(void)
 {
 	struct emds_snapshot_candidate candidate = {0};
@@ -316,6 +503,10 @@ int emds_load(void)
 		return -ECANCELED;
 	}
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	emds_delta_reset();
+#endif
+
 	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
 		if (emds_flash_scan_partition(&partition[i], &candidate)) {
 			LOG_ERR("Failed to scan partition: %d", i);
@@ -338,8 +529,12 @@ int emds_load(void)
 	LOG_DBG("Found freshest snapshot in partition %d with fresh_cnt %u",
 		freshest_snapshot.partition_index, freshest_snapshot.metadata.fresh_cnt);
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	return emds_chain_read();
+#else
 	return emds_read_data(partition[freshest_snapshot.partition_index].fa,
 			      &freshest_snapshot.metadata);
+#endif
 }
 
 int emds_prepare(void)
@@ -367,12 +562,21 @@ int emds_prepare(void)
 						  data_size);
 		if (rc == 0) {
 			allocated_snapshot.partition_index = freshest_partition_idx;
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+			/* Limit the number of snapshots to restore */
+			allocated_delta = chain_len > 0 && chain_len < CONFIG_EMDS_DELTA_CHAIN_MAX;
+#endif
 			emds_state = EMDS_STATE_READY;
 			return 0;
 		}
 		rc = 0;
 	}
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	/* The first snapshot in a partition holds all entries */
+	allocated_delta = false;
+#endif
+
 	do {
 		if (idx != freshest_partition_idx) {
 			if (erase_enabled) {
@@ -455,6 +659,12 @@ static void stream_fflush(const struct emds_partition *partition, off_t *data_of
 	}
 }
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+#define ENTRY_STORE_NEEDED(idx) entry_store_needed(idx)
+#else
+#define ENTRY_STORE_NEEDED(idx) true
+#endif
+
 int emds_store(void)
 {
 	uint32_t store_key;
@@ -476,6 +686,19 @@ int emds_store(void)
 		goto unlock_and_exit;
 	}
 
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	if (allocated_delta) {
+		size_t data_size = emds_changed_entries_size();
+
+		if (data_size == 0) {
+			/* The freshest snapshot is up to date */
+			goto unlock_and_exit;
+		}
+
+		emds_flash_snapshot_delta_set(&allocated_snapshot, data_size);
+	}
+#endif
+
 	if (flash_params_get_erase_cap(partition[idx].fp) & FLASH_ERASE_C_EXPLICIT) {
 		LOG_DBG("Writing metadata on offset: 0x%4lx, address : 0x%4lx",
 			 allocated_snapshot.metadata_off,
@@ -485,14 +708,20 @@ int emds_store(void)
 				      offsetof(struct emds_snapshot_metadata, snapshot_crc));
 	}
 
+	int entry_idx = 0;
+
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
+		if (ENTRY_STORE_NEEDED(entry_idx++)) {
+			entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
+		}
 	}
 
 	struct emds_dynamic_entry *ch;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
+		if (ENTRY_STORE_NEEDED(entry_idx++)) {
+			entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
+		}
 	}
 
 	stream_fflush(&partition[idx], &data_off, data_chunk, &wp);
@@ -541,6 +770,9 @@ int emds_clear(void)
 	emds_state = EMDS_STATE_INITIALIZED;
 	memset(&freshest_snapshot, 0, sizeof(freshest_snapshot));
 	memset(&allocated_snapshot, 0, sizeof(allocated_snapshot));
+#if defined(CONFIG_EMDS_DELTA_SNAPSHOTS)
+	emds_delta_reset();
+#endif
 	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
 		rc = emds_flash_erase_partition(&partition[i]);
 		if (rc) {
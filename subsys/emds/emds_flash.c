@@ -22,6 +22,27 @@ LOG_MODULE_REGISTER(emds_flash, CONFIG_EMDS_LOG_LEVEL);
 #define SOC_NV_FLASH_NODE             DT_INST(0, soc_nv_flash)
 /* "EMDS" in ASCII */
 #define EMDS_SNAPSHOT_METADATA_MARKER 0x4D444553
+/* "EMDD" in ASCII, snapshot holding only the entries changed since the previous snapshot */
+#define EMDS_SNAPSHOT_METADATA_MARKER_DELTA 0x4D444544
+
+static bool metadata_check(const struct emds_snapshot_metadata *metadata)
+{
+	uint32_t crc;
+
+	/* Without incremental snapshots support, an incremental snapshot is skipped, so that the
+	 * last snapshot with all entries is restored.
+	 */
+	if (metadata->marker != EMDS_SNAPSHOT_METADATA_MARKER &&
+	    (!IS_ENABLED(CONFIG_EMDS_DELTA_SNAPSHOTS) ||
+	     metadata->marker != EMDS_SNAPSHOT_METADATA_MARKER_DELTA)) {
+		return false;
+	}
+
+	crc = crc32_k_4_2_update(0, (const unsigned char *)metadata,
+				 offsetof(struct emds_snapshot_metadata, metadata_crc));
+
+	return crc == metadata->metadata_crc;
+}
 
 static void cand_list_init(sys_slist_t *cand_list, struct emds_snapshot_candidate *cand_buf)
 {
@@ -155,7 +176,6 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 	const struct flash_area *fa = partition->fa;
 	off_t read_off = fa->fa_size - sizeof(cache);
 	int failures = 0;
-	uint32_t crc;
 	int rc;
 
 	cand_list_init(&cand_list, cand_buf);
@@ -167,18 +187,9 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 			return rc;
 		}
 
-		if (cache.marker != EMDS_SNAPSHOT_METADATA_MARKER) {
-			failures++;
-			LOG_DBG("Snapshot metadata marker mismatch at address 0x%04lx",
-				fa->fa_off + read_off);
-			continue;
-		}
-
-		crc = crc32_k_4_2_update(0, (const unsigned char *)&cache,
-					 offsetof(struct emds_snapshot_metadata, metadata_crc));
-		if (crc != cache.metadata_crc) {
+		if (!metadata_check(&cache)) {
 			failures++;
-			LOG_DBG("Snapshot metadata CRC mismatch at address 0x%04lx",
+			LOG_DBG("Snapshot metadata marker or CRC mismatch at address 0x%04lx",
 				fa->fa_off + read_off);
 			continue;
 		}
@@ -297,6 +308,54 @@ int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 	return 0;
 }
 
+int emds_flash_snapshot_prev_get(const struct emds_partition *partition,
+				 const struct emds_snapshot_candidate *snapshot,
+				 struct emds_snapshot_candidate *prev)
+{
+	const struct flash_area *fa = partition->fa;
+	off_t metadata_off = snapshot->metadata_off + sizeof(struct emds_snapshot_metadata);
+	int rc;
+
+	/* Snapshots in a partition are allocated with descending metadata offsets */
+	if (metadata_off + sizeof(struct emds_snapshot_metadata) > fa->fa_size) {
+		return -ENOENT;
+	}
+
+	rc = flash_area_read(fa, metadata_off, &prev->metadata, sizeof(prev->metadata));
+	if (rc) {
+		LOG_ERR("Failed to read snapshot metadata: %d", rc);
+		return rc;
+	}
+
+	if (!metadata_check(&prev->metadata) ||
+	    prev->metadata.fresh_cnt + 1 != snapshot->metadata.fresh_cnt ||
+	    prev->metadata.data_instance_off + prev->metadata.data_instance_len >
+		    snapshot->metadata.data_instance_off ||
+	    !cand_snapshot_crc_check(partition, &prev->metadata)) {
+		LOG_DBG("No valid snapshot at address 0x%04lx", fa->fa_off + metadata_off);
+		return -ENOENT;
+	}
+
+	prev->partition_index = snapshot->partition_index;
+	prev->metadata_off = metadata_off;
+
+	return 0;
+}
+
+bool emds_flash_snapshot_is_delta(const struct emds_snapshot_metadata *metadata)
+{
+	return metadata->marker == EMDS_SNAPSHOT_METADATA_MARKER_DELTA;
+}
+
+void emds_flash_snapshot_delta_set(struct emds_snapshot_candidate *snapshot, size_t data_size)
+{
+	snapshot->metadata.marker = EMDS_SNAPSHOT_METADATA_MARKER_DELTA;
+	snapshot->metadata.data_instance_len = data_size;
+	snapshot->metadata.metadata_crc =
+		crc32_k_4_2_update(0, (const unsigned char *)&snapshot->metadata,
+				   offsetof(struct emds_snapshot_metadata, metadata_crc));
+}
+
 static void nvmc_wait_ready(void)
 {
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
@@ -153,6 +153,44 @@ int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 				 struct emds_snapshot_candidate *allocated_snapshot,
 				 size_t data_size);
 
+/**
+ * @brief Get the snapshot stored before the given snapshot in the same partition.
+ *
+ * The previous snapshot is valid if its metadata and data are intact, its fresh_cnt
+ * precedes the fresh_cnt of the given snapshot and its data is stored before the data
+ * of the given snapshot.
+ *
+ * @param partition Pointer to the emergency data storage partition structure.
+ * @param snapshot Pointer to the snapshot candidate structure of the given snapshot.
+ * @param prev Pointer to the snapshot candidate structure that will be filled with the
+ * previous snapshot.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if there is no valid previous snapshot.
+ */
+int emds_flash_snapshot_prev_get(const struct emds_partition *partition,
+				 const struct emds_snapshot_candidate *snapshot,
+				 struct emds_snapshot_candidate *prev);
+
+/**
+ * @brief Check if the snapshot only holds the entries changed since the previous snapshot.
+ *
+ * @param metadata Pointer to the snapshot metadata.
+ *
+ * @return true for an incremental snapshot, false for a full snapshot.
+ */
+bool emds_flash_snapshot_is_delta(const struct emds_snapshot_metadata *metadata);
+
+/**
+ * @brief Turn an allocated snapshot into an incremental snapshot.
+ *
+ * Updates the marker, the data instance length and the metadata CRC.
+ *
+ * @param snapshot Pointer to the allocated snapshot candidate structure.
+ * @param data_size The size of the changed entries, not larger than the allocated size.
+ */
+void emds_flash_snapshot_delta_set(struct emds_snapshot_candidate *snapshot, size_t data_size);
+
 /** * @brief Write data to the emergency data storage partition.
  *
  * @param partition Pointer to the emergency data storage partition structure.
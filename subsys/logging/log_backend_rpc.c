@@ -113,6 +113,8 @@ static bool history_threshold_active;
 static void history_transfer_task(struct k_work *work);
 static K_MUTEX_DEFINE(history_transfer_mtx);
 static uint32_t history_transfer_id;
+static enum log_rpc_level history_transfer_level;
+static uint64_t history_transfer_since_us;
 static union log_msg_generic *history_cur_msg;
 static K_WORK_DEFINE(history_transfer_work, history_transfer_task);
 static K_THREAD_STACK_DEFINE(history_transfer_workq_stack,
@@ -606,6 +608,10 @@ static void panic(struct log_backend const *const backend)
 #ifdef CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_RAM
 	/* Stores the buffer checksum for integrity verification. */
 	log_rpc_history_save_checksum();
+#endif
+#ifdef CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB
+	/* Writes the messages that would be lost if the flush work never runs. */
+	log_rpc_history_flush();
 #endif
 	panic_mode = true;
 }
@@ -701,12 +707,20 @@ static void log_rpc_set_history_level_handler(const struct nrf_rpc_group *group,
 NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_set_history_level_handler,
 			 LOG_RPC_CMD_SET_HISTORY_LEVEL, log_rpc_set_history_level_handler, NULL);
 
+static bool history_transfer_includes(struct log_msg *msg)
+{
+	return log_msg_get_level(msg) <= history_transfer_level &&
+	       log_output_timestamp_to_us(log_msg_get_timestamp(msg)) >= history_transfer_since_us;
+}
+
 static void history_transfer_task(struct k_work *work)
 {
 	const uint32_t flags = common_output_flags | LOG_OUTPUT_FLAG_CRLF_NONE;
 
 	struct nrf_rpc_cbor_ctx ctx;
+	zcbor_state_t saved_state;
 	bool any_msg_consumed = false;
+	bool msg_fits;
 	struct log_msg *msg;
 	size_t length;
 	size_t max_length;
@@ -733,22 +747,28 @@ static void history_transfer_task(struct k_work *work)
 		}
 
 		msg = &history_cur_msg->log;
-		length = 6 + format_message_to_buf(msg, flags, NULL, 0);
-		max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
 
-		/* Check if there is enough buffer space to fit in the current message. */
-		if (length > max_length) {
-			break;
-		}
-
-		nrf_rpc_encode_uint(&ctx, log_msg_get_level(msg));
+		if (history_transfer_includes(msg)) {
+			/*
+			 * Format the message directly into the chunk, and roll the encoder back
+			 * if the message does not fit, so that it is formatted only once.
+			 */
+			saved_state = ctx.zs[0];
+			msg_fits = false;
+			nrf_rpc_encode_uint(&ctx, log_msg_get_level(msg));
+
+			if (zcbor_bstr_start_encode(ctx.zs)) {
+				max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
+				length = format_message_to_buf(msg, flags, ctx.zs[0].payload_mut,
+							       max_length);
+				ctx.zs[0].payload_mut += MIN(length, max_length);
+				msg_fits = zcbor_bstr_end_encode(ctx.zs, NULL) && length <= max_length;
+			}
 
-		if (zcbor_bstr_start_encode(ctx.zs)) {
-			max_length = ctx.zs[0].payload_end - ctx.zs[0].payload_mut;
-			length = format_message_to_buf(msg, flags, ctx.zs[0].payload_mut,
-						       max_length);
-			ctx.zs[0].payload_mut += MIN(length, max_length);
-			zcbor_bstr_end_encode(ctx.zs, NULL);
+			if (!msg_fits) {
+				ctx.zs[0] = saved_state;
+				break;
+			}
 		}
 
 		log_rpc_history_free(history_cur_msg);
@@ -772,6 +792,21 @@ static void history_transfer_task(struct k_work *work)
 				nrf_rpc_rsp_decode_void, NULL);
 }
 
+static void history_transfer_start(uint32_t transfer_id, enum log_rpc_level level,
+				   uint64_t since_us)
+{
+	k_mutex_lock(&history_transfer_mtx, K_FOREVER);
+	history_transfer_id = transfer_id;
+	history_transfer_level = level;
+	history_transfer_since_us = since_us;
+#ifdef CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB
+	log_rpc_history_seek(level, since_us);
+#endif
+	log_rpc_history_set_overwriting(false);
+	k_work_submit_to_queue(&history_transfer_workq, &history_transfer_work);
+	k_mutex_unlock(&history_transfer_mtx);
+}
+
 static void log_rpc_fetch_history_handler(const struct nrf_rpc_group *group,
 					  struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
@@ -785,11 +820,7 @@ static void log_rpc_fetch_history_handler(const struct nrf_rpc_group *group,
 		return;
 	}
 
-	k_mutex_lock(&history_transfer_mtx, K_FOREVER);
-	history_transfer_id = transfer_id;
-	log_rpc_history_set_overwriting(false);
-	k_work_submit_to_queue(&history_transfer_workq, &history_transfer_work);
-	k_mutex_unlock(&history_transfer_mtx);
+	history_transfer_start(transfer_id, LOG_RPC_LEVEL_DBG, 0);
 
 	nrf_rpc_rsp_send_void(group);
 }
@@ -797,6 +828,33 @@ static void log_rpc_fetch_history_handler(const struct nrf_rpc_group *group,
 NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_fetch_history_handler, LOG_RPC_CMD_FETCH_HISTORY,
 			 log_rpc_fetch_history_handler, NULL);
 
+static void log_rpc_fetch_history_filtered_handler(const struct nrf_rpc_group *group,
+						   struct nrf_rpc_cbor_ctx *ctx,
+						   void *handler_data)
+{
+	uint32_t transfer_id;
+	enum log_rpc_level level;
+	uint64_t since_us;
+
+	transfer_id = nrf_rpc_decode_uint(ctx);
+	level = (enum log_rpc_level)nrf_rpc_decode_uint(ctx);
+	since_us = nrf_rpc_decode_uint64(ctx);
+
+	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, group,
+			    LOG_RPC_CMD_FETCH_HISTORY_FILTERED, NRF_RPC_PACKET_TYPE_CMD);
+		return;
+	}
+
+	history_transfer_start(transfer_id, level, since_us);
+
+	nrf_rpc_rsp_send_void(group);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(log_rpc_group, log_rpc_fetch_history_filtered_handler,
+			 LOG_RPC_CMD_FETCH_HISTORY_FILTERED, log_rpc_fetch_history_filtered_handler,
+			 NULL);
+
 static void log_rpc_stop_fetch_history_handler(const struct nrf_rpc_group *group,
 					       struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
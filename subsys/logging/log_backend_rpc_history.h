@@ -7,6 +7,8 @@
 #ifndef LOG_RPC_HISTORY_H_
 #define LOG_RPC_HISTORY_H_
 
+#include <logging/log_rpc.h>
+
 #include <zephyr/logging/log_msg.h>
 
 void log_rpc_history_init(void);
@@ -31,4 +33,18 @@ size_t log_rpc_history_get_max_size(void);
 void log_rpc_history_save_checksum(void);
 #endif
 
+#ifdef CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB
+/**
+ * Skip stored batches of log messages that contain no message with a level up to @p level or
+ * that only contain messages older than @p since_us. Applies to subsequent pops.
+ */
+void log_rpc_history_seek(enum log_rpc_level level, uint64_t since_us);
+
+/**
+ * Write the pending batch of log messages to the flash.
+ * Call from fatal/panic path, when no other thread accesses the history.
+ */
+void log_rpc_history_flush(void);
+#endif
+
 #endif /* LOG_RPC_HISTORY_H_ */
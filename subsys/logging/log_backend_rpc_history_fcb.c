@@ -7,10 +7,27 @@
 #include "log_backend_rpc_history.h"
 
 #include <zephyr/fs/fcb.h>
+#include <zephyr/logging/log_output.h>
 #include <zephyr/sys/util.h>
 
-#define LOG_HISTORY_MAGIC 0x7d2ac863
+#define LOG_HISTORY_MAGIC 0x7d2ac864
 #define LOG_HISTORY_AREA FIXED_PARTITION_ID(log_history)
+#define BATCH_SIZE CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_BATCH_SIZE
+#define FLUSH_TIMEOUT K_MSEC(CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_FLUSH_TIMEOUT_MS)
+
+/*
+ * Header of a batch of log messages stored in a single FCB entry.
+ *
+ * The header is followed by the log messages, stored back-to-back in the same format as in the
+ * logging buffer. The header is used to skip whole batches when the history is seeked.
+ */
+struct batch_hdr {
+	log_timestamp_t last_timestamp;
+	uint16_t msg_cnt;
+	uint8_t level_mask;
+} __aligned(Z_LOG_MSG_ALIGNMENT);
+
+BUILD_ASSERT(BATCH_SIZE % Z_LOG_MSG_ALIGNMENT == 0, "Batch size must be aligned to log message");
 
 static struct fcb fcb;
 static struct flash_sector fcb_sectors[CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_NUM_SECTORS];
@@ -18,44 +35,36 @@ static struct fcb_entry last_popped;
 static bool erase_oldest;
 static K_MUTEX_DEFINE(fcb_lock);
 
-void log_rpc_history_init(void)
-{
-	int rc;
-	uint32_t sector_cnt = ARRAY_SIZE(fcb_sectors);
+/* Batch of log messages that are not yet written to the flash. */
+static uint8_t __aligned(Z_LOG_MSG_ALIGNMENT) batch_buf[BATCH_SIZE];
+static size_t batch_len;
 
-	rc = flash_area_get_sectors(LOG_HISTORY_AREA, &sector_cnt, fcb_sectors);
+/* Batch of log messages read from the flash and not yet popped. */
+static uint8_t __aligned(Z_LOG_MSG_ALIGNMENT) read_buf[BATCH_SIZE];
+static size_t read_offset;
+static uint16_t read_msg_cnt;
 
-	if (rc) {
-		goto out;
-	}
-
-	fcb.f_magic = LOG_HISTORY_MAGIC;
-	fcb.f_sectors = fcb_sectors;
-	fcb.f_sector_cnt = (uint8_t)sector_cnt;
-	erase_oldest = true;
+static uint8_t seek_level_mask = UINT8_MAX;
+static uint64_t seek_since_us;
 
-	rc = fcb_init(LOG_HISTORY_AREA, &fcb);
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
 
-	if (rc) {
-		goto out;
-	}
-
-	rc = fcb_clear(&fcb);
-
-out:
-	__ASSERT_NO_MSG(rc == 0);
+static size_t msg_len(const union log_msg_generic *msg)
+{
+	return log_msg_generic_get_wlen(&msg->buf) * sizeof(uint32_t);
 }
 
-void log_rpc_history_push(const union log_msg_generic *msg)
+static int batch_flush(void)
 {
 	int rc;
-	size_t len;
 	struct fcb_entry entry;
 
-	len = log_msg_generic_get_wlen(&msg->buf) * sizeof(uint32_t);
+	if (batch_len == 0) {
+		return 0;
+	}
 
-	k_mutex_lock(&fcb_lock, K_FOREVER);
-	rc = fcb_append(&fcb, len, &entry);
+	rc = fcb_append(&fcb, batch_len, &entry);
 
 	if (rc == -ENOSPC && erase_oldest) {
 		/*
@@ -71,14 +80,14 @@ void log_rpc_history_push(const union log_msg_generic *msg)
 		}
 
 		memset(&last_popped, 0, sizeof(last_popped));
-		rc = fcb_append(&fcb, len, &entry);
+		rc = fcb_append(&fcb, batch_len, &entry);
 	}
 
 	if (rc) {
 		goto out;
 	}
 
-	rc = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), msg, len);
+	rc = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), batch_buf, batch_len);
 
 	if (rc) {
 		goto out;
@@ -87,58 +96,245 @@ void log_rpc_history_push(const union log_msg_generic *msg)
 	rc = fcb_append_finish(&fcb, &entry);
 
 out:
+	/* The batch is dropped on failure, in the same way as a message that does not fit. */
+	batch_len = 0;
+
+	return rc;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	int rc;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&fcb_lock, K_FOREVER);
+	rc = batch_flush();
 	k_mutex_unlock(&fcb_lock);
 
 #ifdef LOG_HISTORY_DEBUG
 	__ASSERT_NO_MSG(rc == 0);
+#else
+	ARG_UNUSED(rc);
 #endif
 }
 
-void log_rpc_history_set_overwriting(bool overwriting)
+static bool batch_matches(const struct batch_hdr *hdr)
 {
-	k_mutex_lock(&fcb_lock, K_FOREVER);
+	return (hdr->level_mask & seek_level_mask) &&
+	       (log_output_timestamp_to_us(hdr->last_timestamp) >= seek_since_us);
+}
 
-	erase_oldest = overwriting;
+static int batch_read(void)
+{
+	int rc;
+	bool flushed = false;
+	struct fcb_entry entry = last_popped;
+	struct batch_hdr hdr;
 
-	k_mutex_unlock(&fcb_lock);
+	while (true) {
+		rc = fcb_getnext(&fcb, &entry);
+
+		if (rc) {
+			if (flushed || batch_len == 0) {
+				/* No more log messages. */
+				return 0;
+			}
+
+			/* Write the pending batch so that the newest messages are transferred. */
+			rc = batch_flush();
+
+			if (rc) {
+				return rc;
+			}
+
+			flushed = true;
+			entry = last_popped;
+			continue;
+		}
+
+		if (entry.fe_data_len < sizeof(hdr) || entry.fe_data_len > sizeof(read_buf)) {
+			return -EINVAL;
+		}
+
+		rc = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), &hdr, sizeof(hdr));
+
+		if (rc) {
+			return rc;
+		}
+
+		last_popped = entry;
+
+		if (batch_matches(&hdr)) {
+			break;
+		}
+	}
+
+	rc = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), read_buf, entry.fe_data_len);
+
+	if (rc) {
+		return rc;
+	}
+
+	read_offset = sizeof(hdr);
+	read_msg_cnt = hdr.msg_cnt;
+
+	while (fcb.f_oldest != last_popped.fe_sector) {
+		rc = fcb_rotate(&fcb);
+
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
 }
 
-union log_msg_generic *log_rpc_history_pop(void)
+void log_rpc_history_init(void)
 {
 	int rc;
-	struct fcb_entry entry = last_popped;
-	union log_msg_generic *msg = NULL;
+	uint32_t sector_cnt = ARRAY_SIZE(fcb_sectors);
 
-	k_mutex_lock(&fcb_lock, K_FOREVER);
-	rc = fcb_getnext(&fcb, &entry);
+	rc = flash_area_get_sectors(LOG_HISTORY_AREA, &sector_cnt, fcb_sectors);
 
 	if (rc) {
-		rc = 0;
 		goto out;
 	}
 
-	msg = (union log_msg_generic *)k_malloc(entry.fe_data_len);
+	fcb.f_magic = LOG_HISTORY_MAGIC;
+	fcb.f_sectors = fcb_sectors;
+	fcb.f_sector_cnt = (uint8_t)sector_cnt;
+	erase_oldest = true;
+
+	k_work_cancel_delayable(&flush_work);
+	memset(&last_popped, 0, sizeof(last_popped));
+	batch_len = 0;
+	read_msg_cnt = 0;
+	seek_level_mask = UINT8_MAX;
+	seek_since_us = 0;
+
+	rc = fcb_init(LOG_HISTORY_AREA, &fcb);
 
-	if (!msg) {
+	if (rc) {
 		goto out;
 	}
 
-	rc = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), msg, entry.fe_data_len);
+	rc = fcb_clear(&fcb);
 
-	if (rc) {
+out:
+	__ASSERT_NO_MSG(rc == 0);
+}
+
+void log_rpc_history_push(const union log_msg_generic *msg)
+{
+	int rc = 0;
+	size_t len;
+	struct log_msg *log = (struct log_msg *)&msg->log;
+	struct batch_hdr *hdr = (struct batch_hdr *)batch_buf;
+
+	len = msg_len(msg);
+
+	k_mutex_lock(&fcb_lock, K_FOREVER);
+
+	if (len > sizeof(batch_buf) - sizeof(*hdr)) {
+		rc = -EMSGSIZE;
 		goto out;
 	}
 
-	last_popped = entry;
+	if (batch_len + len > sizeof(batch_buf)) {
+		rc = batch_flush();
+	}
 
-	while (fcb.f_oldest != last_popped.fe_sector) {
-		rc = fcb_rotate(&fcb);
+	if (batch_len == 0) {
+		memset(hdr, 0, sizeof(*hdr));
+		batch_len = sizeof(*hdr);
 
-		if (rc) {
+		if (CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_FLUSH_TIMEOUT_MS > 0) {
+			k_work_schedule(&flush_work, FLUSH_TIMEOUT);
+		}
+	}
+
+	memcpy(&batch_buf[batch_len], msg, len);
+	batch_len += len;
+
+	hdr->last_timestamp = log_msg_get_timestamp(log);
+	hdr->level_mask |= BIT(log_msg_get_level(log));
+	hdr->msg_cnt++;
+
+	if (batch_len == sizeof(batch_buf) ||
+	    CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_FLUSH_TIMEOUT_MS == 0) {
+		rc = batch_flush();
+	}
+
+out:
+	k_mutex_unlock(&fcb_lock);
+
+#ifdef LOG_HISTORY_DEBUG
+	__ASSERT_NO_MSG(rc == 0);
+#endif
+}
+
+void log_rpc_history_set_overwriting(bool overwriting)
+{
+	k_mutex_lock(&fcb_lock, K_FOREVER);
+
+	erase_oldest = overwriting;
+
+	k_mutex_unlock(&fcb_lock);
+}
+
+void log_rpc_history_seek(enum log_rpc_level level, uint64_t since_us)
+{
+	k_mutex_lock(&fcb_lock, K_FOREVER);
+
+	/* Messages with the level NONE are always included, see process() in the backend. */
+	seek_level_mask = BIT_MASK(level + 1);
+	seek_since_us = since_us;
+
+	k_mutex_unlock(&fcb_lock);
+}
+
+void log_rpc_history_flush(void)
+{
+	int rc;
+
+	/*
+	 * The lock is not taken as the function is called in the panic mode, which can be entered
+	 * in an interrupt context and with the lock held by an interrupted thread.
+	 */
+	(void)k_work_cancel_delayable(&flush_work);
+	rc = batch_flush();
+
+#ifdef LOG_HISTORY_DEBUG
+	__ASSERT_NO_MSG(rc == 0);
+#else
+	ARG_UNUSED(rc);
+#endif
+}
+
+union log_msg_generic *log_rpc_history_pop(void)
+{
+	int rc = 0;
+	union log_msg_generic *msg = NULL;
+
+	k_mutex_lock(&fcb_lock, K_FOREVER);
+
+	if (read_msg_cnt == 0) {
+		rc = batch_read();
+
+		if (rc || read_msg_cnt == 0) {
 			goto out;
 		}
 	}
 
+	/*
+	 * The message is returned from the read buffer, which is only refilled by the next pop,
+	 * after the message is processed by the caller.
+	 */
+	msg = (union log_msg_generic *)&read_buf[read_offset];
+	read_offset += msg_len(msg);
+	read_msg_cnt--;
+
 out:
 	k_mutex_unlock(&fcb_lock);
 
@@ -151,7 +347,8 @@ out:
 
 void log_rpc_history_free(const union log_msg_generic *msg)
 {
-	k_free((void *)msg);
+	/* Popped messages are stored in the read buffer. */
+	ARG_UNUSED(msg);
 }
 
 uint8_t log_rpc_history_get_usage(void)
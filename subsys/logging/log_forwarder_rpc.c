@@ -104,6 +104,28 @@ int log_rpc_fetch_history(log_rpc_history_handler_t handler)
 	return 0;
 }
 
+int log_rpc_fetch_history_filtered(log_rpc_history_handler_t handler, enum log_rpc_level level,
+				   uint64_t since_us)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	uint32_t transfer_id;
+
+	k_mutex_lock(&history_transfer_mtx, K_FOREVER);
+	transfer_id = ++history_transfer_id;
+	history_handler = handler;
+	k_mutex_unlock(&history_transfer_mtx);
+
+	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx,
+			   1 + sizeof(transfer_id) + 1 + sizeof(uint8_t) + 1 + sizeof(since_us));
+	nrf_rpc_encode_uint(&ctx, transfer_id);
+	nrf_rpc_encode_uint(&ctx, level);
+	nrf_rpc_encode_uint64(&ctx, since_us);
+	nrf_rpc_cbor_cmd_no_err(&log_rpc_group, LOG_RPC_CMD_FETCH_HISTORY_FILTERED, &ctx,
+				nrf_rpc_rsp_decode_void, NULL);
+
+	return 0;
+}
+
 void log_rpc_stop_fetch_history(bool pause)
 {
 	struct nrf_rpc_cbor_ctx ctx;
@@ -14,6 +14,8 @@
 #include <nrf_rpc/nrf_rpc_ipc.h>
 #elif defined(CONFIG_NRF_RPC_UART_TRANSPORT)
 #include <nrf_rpc/nrf_rpc_uart.h>
+#elif defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#include <mock_nrf_rpc_transport.h>
 #endif
 
 #ifdef __cplusplus
@@ -24,6 +26,8 @@ extern "C" {
 NRF_RPC_IPC_TRANSPORT(log_rpc_tr, DEVICE_DT_GET(DT_NODELABEL(ipc0)), "log_rpc_ept");
 #elif defined(CONFIG_NRF_RPC_UART_TRANSPORT)
 #define log_rpc_tr NRF_RPC_UART_TRANSPORT(DT_CHOSEN(nordic_rpc_uart))
+#elif defined(CONFIG_MOCK_NRF_RPC_TRANSPORT)
+#define log_rpc_tr mock_nrf_rpc_tr
 #endif
 NRF_RPC_GROUP_DEFINE(log_rpc_group, "log", &log_rpc_tr, NULL, NULL, NULL);
 
@@ -50,6 +54,7 @@ enum log_rpc_cmd_backend {
 	LOG_RPC_CMD_ECHO,
 	LOG_RPC_CMD_SET_TIME,
 	LOG_RPC_CMD_GET_CRASH_INFO,
+	LOG_RPC_CMD_FETCH_HISTORY_FILTERED,
 };
 
 #ifdef __cplusplus
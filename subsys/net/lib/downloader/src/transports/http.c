@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zephyr/kernel.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/__assert.h>
@@ -78,8 +79,25 @@ struct transport_params_http {
 	bool connection_close;
 	/** Is using ranged query. */
 	bool ranged;
-	/** Ranged progress */
-	size_t ranged_progress;
+	/** File offset one past the last byte of the range being received. */
+	size_t range_end;
+	/** File offset one past the last byte requested so far.
+	 * Larger than range_end when the next range request has been pipelined.
+	 */
+	size_t req_end;
+	/** Bytes of the next pipelined response already in the buffer. */
+	size_t carry_len;
+	/** Adaptive range sizing state */
+	struct {
+		/** Start of the current goodput measurement, in ms. */
+		int64_t ts;
+		/** File offset at the start of the current goodput measurement. */
+		size_t from;
+		/** Best goodput seen so far, in bytes per second. */
+		uint32_t best_rate;
+		/** Upper bound for the range size after an error, or 0. */
+		size_t ceiling;
+	} adapt;
 	/** HTTP header */
 	struct {
 		/** Header length */
@@ -144,22 +162,20 @@ extern char *strnstr(const char *haystack, const char *needle, size_t haystack_s
 
 static int parse_protocol(struct downloader *dl, const char *url);
 
-static int http_get_request_send(struct downloader *dl)
+/* nRF91 series has a limitation of decoding ~2k of data at once when using TLS */
+static bool http_tls_force_range(struct downloader *dl)
 {
-	int err;
-	int len;
-	size_t off = 0;
-	bool tls_force_range;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
 
-	http->header.has_end = false;
+	return (http->sock.proto == NET_IPPROTO_TLS_1_2 &&
+		!dl->host_cfg.set_native_tls && IS_ENABLED(CONFIG_SOC_SERIES_NRF91));
+}
 
-	/* nRF91 series has a limitation of decoding ~2k of data at once when using TLS */
-	tls_force_range = (http->sock.proto == NET_IPPROTO_TLS_1_2 &&
-			   !dl->host_cfg.set_native_tls && IS_ENABLED(CONFIG_SOC_SERIES_NRF91));
-	if (tls_force_range) {
+static void http_range_limit(struct downloader *dl)
+{
+	if (http_tls_force_range(dl)) {
 		if (dl->host_cfg.range_override > TLS_RANGE_MAX) {
 			LOG_WRN("Range override > TLS max range, setting to TLS max range");
 			dl->host_cfg.range_override = TLS_RANGE_MAX;
@@ -167,44 +183,141 @@ static int http_get_request_send(struct downloader *dl)
 			dl->host_cfg.range_override = TLS_RANGE_MAX;
 		}
 	}
+}
+
+#if defined(CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_ADAPTIVE)
+static size_t http_range_max(struct downloader *dl)
+{
+	size_t max = CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_MAX;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	if (http_tls_force_range(dl)) {
+		max = MIN(max, TLS_RANGE_MAX);
+	}
+
+	if (http->adapt.ceiling) {
+		max = MIN(max, http->adapt.ceiling);
+	}
+
+	return max;
+}
+
+/* Called when a range has been received completely.
+ * Grow the range while goodput keeps up, shrink it when goodput drops.
+ */
+static void http_range_adapt(struct downloader *dl)
+{
+	int64_t now = k_uptime_get();
+	size_t range = dl->host_cfg.range_override;
+	size_t len;
+	uint32_t rate;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	len = http->range_end - http->adapt.from;
+	rate = (uint32_t)MIN((uint64_t)len * MSEC_PER_SEC / MAX(now - http->adapt.ts, 1),
+			     UINT32_MAX);
+
+	http->adapt.ts = now;
+	http->adapt.from = http->range_end;
+
+	if (rate >= http->adapt.best_rate - http->adapt.best_rate / 8) {
+		http->adapt.best_rate = MAX(http->adapt.best_rate, rate);
+		range = MIN(range * 2, http_range_max(dl));
+	} else {
+		http->adapt.best_rate = rate;
+		range = MAX(range / 2, CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_MIN);
+	}
+
+	if (range != dl->host_cfg.range_override) {
+		LOG_DBG("Goodput %u B/s, range size %u -> %u", rate,
+			dl->host_cfg.range_override, range);
+		dl->host_cfg.range_override = range;
+	}
+}
+
+static void http_range_adapt_error(struct downloader *dl, bool hard_limit)
+{
+	size_t range = MAX(dl->host_cfg.range_override / 2,
+			   CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_MIN);
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	if (hard_limit) {
+		http->adapt.ceiling = dl->host_cfg.range_override;
+	} else {
+		dl->host_cfg.range_override = range;
+	}
+
+	http->adapt.best_rate = 0;
+	LOG_DBG("Range size %u after error", dl->host_cfg.range_override);
+}
+#else
+static void http_range_adapt(struct downloader *dl)
+{
+}
+
+static void http_range_adapt_error(struct downloader *dl, bool hard_limit)
+{
+}
+#endif /* CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_ADAPTIVE */
+
+/* Send a GET request starting at file offset @p from.
+ * The request is formatted into @p buf, which does not need to be the start of the
+ * download buffer, so that a pipelined request can be sent while received data is kept.
+ */
+static int http_get_request_send(struct downloader *dl, size_t from, char *buf, size_t buf_size)
+{
+	int err;
+	int len;
+	size_t off = 0;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	http_range_limit(dl);
 
 	if (dl->host_cfg.range_override) {
-		off = dl->progress + dl->host_cfg.range_override - 1;
+		off = from + dl->host_cfg.range_override - 1;
 
 		if (dl->file_size) {
 			/* Don't request bytes past the end of file */
 			off = MIN(off, dl->file_size - 1);
 		}
 
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_RANGE, dl->file,
-			       dl->hostname, dl->progress, off);
+		len = snprintf(buf, buf_size, HTTP_GET_RANGE, dl->file,
+			       dl->hostname, from, off);
 		http->ranged = true;
-		http->ranged_progress = 0;
+		http->req_end = off + 1;
 		LOG_DBG("Range request up to %d bytes", dl->host_cfg.range_override);
 		goto send;
-	} else if (dl->progress) {
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_OFFSET, dl->file,
-			       dl->hostname, dl->progress);
+	} else if (from) {
+		len = snprintf(buf, buf_size, HTTP_GET_OFFSET, dl->file,
+			       dl->hostname, from);
 		http->ranged = false;
 	} else {
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET, dl->file,
+		len = snprintf(buf, buf_size, HTTP_GET, dl->file,
 			       dl->hostname);
 		http->ranged = false;
 	}
 
 send:
-	if (len < 0 || len > dl->cfg.buf_size) {
+	if (len < 0 || len >= buf_size) {
 		LOG_ERR("Cannot create GET request, buffer too small");
 		return -ENOMEM;
 	}
 
 	if (IS_ENABLED(CONFIG_DOWNLOADER_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(dl->cfg.buf, len, "HTTP request");
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
 	}
 
-	LOG_DBG("http request:\n%s", dl->cfg.buf);
+	LOG_DBG("http request:\n%s", buf);
 
-	err = dl_socket_send(http->sock.fd, dl->cfg.buf, len);
+	err = dl_socket_send(http->sock.fd, buf, len);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
@@ -213,6 +326,35 @@ send:
 	return 0;
 }
 
+/* Request the next range while the body of the current one is still being received,
+ * so that the server can continue sending without waiting for a round-trip.
+ * The request is formatted into the unused tail of the download buffer, after the
+ * @p used bytes of received data. If the tail is too small, the range is requested
+ * once the current one has completed.
+ */
+static void http_get_request_pipeline(struct downloader *dl, size_t used)
+{
+	int err;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	/* Not with the nRF91 modem TLS stack, which cannot buffer a second response. */
+	if (!IS_ENABLED(CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE) || http_tls_force_range(dl) ||
+	    !http->ranged || !http->header.has_end || http->connection_close ||
+	    http->req_end != http->range_end || http->range_end >= dl->file_size) {
+		return;
+	}
+
+	err = http_get_request_send(dl, http->range_end, dl->cfg.buf + used,
+				    dl->cfg.buf_size - used);
+	if (err) {
+		/* Not fatal, the range is requested when the current one completes. */
+		LOG_DBG("Could not pipeline request, err %d", err);
+		http->req_end = http->range_end;
+	}
+}
+
 /* Returns:
  * Number of bytes parsed on success.
  * Negative errno on error.
@@ -583,8 +725,14 @@ static int dl_http_connect(struct downloader *dl)
 		return err;
 	}
 
+	if (http->adapt.ts && !dl->complete) {
+		/* Reconnecting in the middle of a download */
+		http_range_adapt_error(dl, false);
+	}
+
 	http->connection_close = false;
 	http->new_data_req = true;
+	http->carry_len = 0;
 
 	return err;
 }
@@ -609,6 +757,7 @@ static int dl_http_close(struct downloader *dl)
 static int dl_http_download(struct downloader *dl)
 {
 	int ret, recv_len, data_len, expected_len;
+	size_t excess = 0;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
@@ -616,23 +765,34 @@ static int dl_http_download(struct downloader *dl)
 	if (http->new_data_req) {
 		/* Request next fragment */
 		dl->buf_offset = 0;
-		ret = http_get_request_send(dl);
+		http->header.has_end = false;
+		http->header.status_code = 0;
+		ret = http_get_request_send(dl, dl->progress, dl->cfg.buf, dl->cfg.buf_size);
 		if (ret) {
 			LOG_DBG("data_req failed, err %d", ret);
 			/** Attempt reconnection. */
 			return -ECONNRESET;
 		}
 
+		http->range_end = http->req_end;
+		http->adapt.ts = k_uptime_get();
+		http->adapt.from = dl->progress;
 		http->new_data_req = false;
 	}
 
 	__ASSERT(dl->buf_offset < dl->cfg.buf_size, "Buffer overflow");
 
-	LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
-		(void *)(dl->cfg.buf + dl->buf_offset));
+	if (http->carry_len) {
+		/* The start of the next pipelined response is already in the buffer. */
+		recv_len = http->carry_len;
+		http->carry_len = 0;
+	} else {
+		LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
+			(void *)(dl->cfg.buf + dl->buf_offset));
 
-	recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
-			     dl->cfg.buf_size - dl->buf_offset);
+		recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
+				     dl->cfg.buf_size - dl->buf_offset);
+	}
 
 	if (recv_len < 0) {
 		if (recv_len == -EMSGSIZE && dl->host_cfg.range_override) {
@@ -644,6 +804,7 @@ static int dl_http_download(struct downloader *dl)
 			if (dl->host_cfg.range_override <= 8) {
 				return -EMSGSIZE;
 			}
+			http_range_adapt_error(dl, true);
 			LOG_DBG("Message size too big, reattempting with range size %d",
 				dl->host_cfg.range_override);
 			return -ECONNRESET;
@@ -660,7 +821,17 @@ static int dl_http_download(struct downloader *dl)
 		return data_len;
 	}
 
-	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, dl->file_size - dl->progress);
+	http_get_request_pipeline(dl, data_len);
+
+	if (http->ranged && dl->progress + data_len > http->range_end) {
+		/* The rest belongs to the response of the pipelined request */
+		excess = dl->progress + data_len - http->range_end;
+		data_len -= excess;
+	}
+
+	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF,
+			   (http->ranged ? MIN(http->range_end, dl->file_size) : dl->file_size) -
+			   dl->progress);
 
 	if (data_len < expected_len) {
 		/* Wait for more data after the HTTP headers,
@@ -674,10 +845,23 @@ static int dl_http_download(struct downloader *dl)
 	if (data_len) {
 		dl_transport_evt_data(dl, dl->cfg.buf, data_len);
 	}
-	if (http->ranged) {
-		http->ranged_progress += data_len;
-		if (http->ranged_progress < dl->host_cfg.range_override) {
-			/* Ranged query: read until a full fragment is received */
+	dl->buf_offset = 0;
+
+	if (http->ranged && dl->progress >= http->range_end) {
+		if (dl->progress < dl->file_size) {
+			http_range_adapt(dl);
+		}
+
+		if (excess) {
+			memmove(dl->cfg.buf, dl->cfg.buf + data_len, excess);
+			http->carry_len = excess;
+		}
+
+		if (http->req_end > http->range_end) {
+			/* Continue with the response to the pipelined request */
+			http->range_end = http->req_end;
+			http->header.has_end = false;
+			http->header.status_code = 0;
 		} else {
 			/* Ranged query: request next fragment */
 			http->new_data_req = true;
@@ -687,8 +871,8 @@ static int dl_http_download(struct downloader *dl)
 		/* A full file has been received */
 		dl->complete = true;
 		http->new_data_req = true;
+		http->carry_len = 0;
 	}
-	dl->buf_offset = 0;
 
 	if (dl->complete) {
 		return 0;
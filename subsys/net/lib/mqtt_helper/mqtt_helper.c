@@ -11,6 +11,10 @@
 #include <zephyr/net/mqtt.h>
 #include <zephyr/logging/log.h>
 
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST)
+#include <zephyr/settings/settings.h>
+#endif
+
 #if defined(CONFIG_MQTT_HELPER_PROVISION_CERTIFICATES)
 #include "mqtt-certs.h"
 #endif
@@ -36,6 +40,8 @@ MQTT_HELPER_STATIC char payload_buf[CONFIG_MQTT_HELPER_PAYLOAD_BUFFER_LEN];
 MQTT_HELPER_STATIC K_SEM_DEFINE(connection_poll_sem, 0, 1);
 static struct mqtt_helper_cfg current_cfg;
 MQTT_HELPER_STATIC enum mqtt_state mqtt_state = MQTT_STATE_UNINIT;
+/* Last message ID returned by mqtt_helper_msg_id_get() */
+MQTT_HELPER_STATIC uint16_t mqtt_helper_msg_id;
 
 static const char *state_name_get(enum mqtt_state state)
 {
@@ -301,6 +307,271 @@ MQTT_HELPER_STATIC void on_publish(const struct mqtt_evt *mqtt_evt)
 	}
 }
 
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE)
+/* Publish queue.
+ * Entries are kept in a fixed array and sent in order of their sequence number.
+ * A QoS 1 entry stays in the array until it has been acknowledged.
+ */
+
+#define PUBQ_SETTINGS_KEY "mqtt_helper/pq"
+
+enum pubq_entry_state {
+	PUBQ_ENTRY_FREE,
+	PUBQ_ENTRY_QUEUED,
+	PUBQ_ENTRY_IN_FLIGHT,
+};
+
+/* Stored as is when persisting, followed by topic_len + payload_len bytes of data. */
+struct pubq_record {
+	uint32_t seq;
+	uint16_t message_id;
+	uint16_t topic_len;
+	uint16_t payload_len;
+	uint8_t qos;
+	uint8_t retain;
+};
+
+struct pubq_entry {
+	enum pubq_entry_state state;
+	bool dup;
+	int64_t enqueued_at;
+	struct pubq_record rec;
+	uint8_t data[CONFIG_MQTT_HELPER_PUBLISH_QUEUE_ENTRY_SIZE];
+};
+
+MQTT_HELPER_STATIC struct pubq_entry pubq_entries[CONFIG_MQTT_HELPER_PUBLISH_QUEUE_LEN];
+static uint32_t pubq_seq;
+static uint32_t pubq_in_flight;
+static uint64_t pubq_latency_sum;
+static struct mqtt_helper_publish_queue_stats pubq_stats;
+static K_MUTEX_DEFINE(pubq_lock);
+
+static void pubq_persist(struct pubq_entry *entry)
+{
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST)
+	char key[sizeof(PUBQ_SETTINGS_KEY "/") + 2];
+	uint8_t buf[sizeof(struct pubq_record) + CONFIG_MQTT_HELPER_PUBLISH_QUEUE_ENTRY_SIZE];
+	size_t len = entry->rec.topic_len + entry->rec.payload_len;
+	int err;
+
+	if (entry->rec.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return;
+	}
+
+	snprintk(key, sizeof(key), PUBQ_SETTINGS_KEY "/%u",
+		 (unsigned int)(entry - pubq_entries));
+
+	memcpy(buf, &entry->rec, sizeof(entry->rec));
+	memcpy(buf + sizeof(entry->rec), entry->data, len);
+
+	err = settings_save_one(key, buf, sizeof(entry->rec) + len);
+	if (err) {
+		LOG_WRN("Failed to store queued message, error: %d", err);
+	}
+#endif
+}
+
+static void pubq_unpersist(struct pubq_entry *entry)
+{
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST)
+	char key[sizeof(PUBQ_SETTINGS_KEY "/") + 2];
+
+	if (entry->rec.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return;
+	}
+
+	snprintk(key, sizeof(key), PUBQ_SETTINGS_KEY "/%u",
+		 (unsigned int)(entry - pubq_entries));
+
+	(void)settings_delete(key);
+#endif
+}
+
+static void pubq_entry_complete(struct pubq_entry *entry)
+{
+	uint32_t latency = (uint32_t)(k_uptime_get() - entry->enqueued_at);
+
+	pubq_stats.completed++;
+	pubq_latency_sum += latency;
+	pubq_stats.latency_max_ms = MAX(pubq_stats.latency_max_ms, latency);
+	pubq_stats.depth--;
+
+	pubq_unpersist(entry);
+	entry->state = PUBQ_ENTRY_FREE;
+}
+
+static struct pubq_entry *pubq_next_get(void)
+{
+	struct pubq_entry *next = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+		struct pubq_entry *entry = &pubq_entries[i];
+
+		if (entry->state != PUBQ_ENTRY_QUEUED) {
+			continue;
+		}
+
+		/* Wrap-around safe comparison of sequence numbers */
+		if (!next || (int32_t)(entry->rec.seq - next->rec.seq) < 0) {
+			next = entry;
+		}
+	}
+
+	return next;
+}
+
+/* Send queued messages while connected and the in-flight window allows it. */
+static void pubq_drain(void)
+{
+	int err;
+	struct pubq_entry *entry;
+
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	while (mqtt_state_verify(MQTT_STATE_CONNECTED) &&
+	       pubq_in_flight < CONFIG_MQTT_HELPER_PUBLISH_QUEUE_INFLIGHT) {
+		struct mqtt_publish_param param = { 0 };
+
+		entry = pubq_next_get();
+		if (!entry) {
+			break;
+		}
+
+		param.message.topic.topic.utf8 = entry->data;
+		param.message.topic.topic.size = entry->rec.topic_len;
+		param.message.topic.qos = entry->rec.qos;
+		param.message.payload.data = entry->data + entry->rec.topic_len;
+		param.message.payload.len = entry->rec.payload_len;
+		param.message_id = entry->rec.message_id;
+		param.dup_flag = entry->dup;
+		param.retain_flag = entry->rec.retain;
+
+		err = mqtt_publish(&mqtt_client, &param);
+		if (err) {
+			/* Retried on the next enqueue, acknowledgment or connection. */
+			LOG_WRN("Failed to publish queued message, error: %d", err);
+			break;
+		}
+
+		LOG_DBG("Queued message %d sent%s", entry->rec.message_id,
+			entry->dup ? " (DUP)" : "");
+
+		if (entry->rec.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+			pubq_entry_complete(entry);
+		} else {
+			entry->state = PUBQ_ENTRY_IN_FLIGHT;
+			pubq_in_flight++;
+		}
+	}
+
+	k_mutex_unlock(&pubq_lock);
+}
+
+static void pubq_on_puback(uint16_t message_id)
+{
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+		struct pubq_entry *entry = &pubq_entries[i];
+
+		if (entry->state == PUBQ_ENTRY_IN_FLIGHT && entry->rec.message_id == message_id) {
+			pubq_entry_complete(entry);
+			pubq_in_flight--;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&pubq_lock);
+
+	pubq_drain();
+}
+
+/* Messages that were not acknowledged before the connection was lost are sent again.
+ * Only these messages were sent before, so only they are marked as duplicates.
+ */
+static void pubq_on_connack(void)
+{
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+		struct pubq_entry *entry = &pubq_entries[i];
+
+		if (entry->state == PUBQ_ENTRY_IN_FLIGHT) {
+			entry->state = PUBQ_ENTRY_QUEUED;
+			entry->dup = true;
+			pubq_stats.resent++;
+		}
+	}
+
+	pubq_in_flight = 0;
+
+	k_mutex_unlock(&pubq_lock);
+
+	pubq_drain();
+}
+
+/* Checks if the message ID is used by a queued or an in-flight message. */
+static bool pubq_msg_id_in_use(uint16_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+		if (pubq_entries[i].state != PUBQ_ENTRY_FREE &&
+		    pubq_entries[i].rec.message_id == message_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST)
+/* Restored messages are queued as new ones, as it is not known if they were sent
+ * before the reboot.
+ */
+MQTT_HELPER_STATIC int pubq_settings_set(const char *key, size_t len_rd,
+					 settings_read_cb read_cb, void *cb_arg)
+{
+	struct pubq_entry *entry;
+	uint8_t buf[sizeof(struct pubq_record) + CONFIG_MQTT_HELPER_PUBLISH_QUEUE_ENTRY_SIZE];
+	unsigned long idx;
+	ssize_t len;
+
+	idx = strtoul(key, NULL, 10);
+	if (idx >= ARRAY_SIZE(pubq_entries) || len_rd < sizeof(struct pubq_record) ||
+	    len_rd > sizeof(buf)) {
+		return -EINVAL;
+	}
+
+	len = read_cb(cb_arg, buf, len_rd);
+	if (len != len_rd) {
+		return -EIO;
+	}
+
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	entry = &pubq_entries[idx];
+	if (entry->state == PUBQ_ENTRY_FREE) {
+		memcpy(&entry->rec, buf, sizeof(entry->rec));
+		memcpy(entry->data, buf + sizeof(entry->rec), len - sizeof(entry->rec));
+		entry->state = PUBQ_ENTRY_QUEUED;
+		entry->dup = false;
+		entry->enqueued_at = k_uptime_get();
+		pubq_seq = MAX(pubq_seq, entry->rec.seq + 1);
+		/* New message IDs start after the restored ones. */
+		mqtt_helper_msg_id = MAX(mqtt_helper_msg_id, entry->rec.message_id);
+		pubq_stats.depth++;
+		pubq_stats.depth_max = MAX(pubq_stats.depth_max, pubq_stats.depth);
+	}
+
+	k_mutex_unlock(&pubq_lock);
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(mqtt_helper_pubq, PUBQ_SETTINGS_KEY, NULL,
+			       pubq_settings_set, NULL, NULL);
+#endif /* CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST */
+#endif /* CONFIG_MQTT_HELPER_PUBLISH_QUEUE */
+
 MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 					 const struct mqtt_evt *mqtt_evt)
 {
@@ -326,6 +597,12 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			current_cfg.cb.on_connack(mqtt_evt->param.connack.return_code,
 						  mqtt_evt->param.connack.session_present_flag);
 		}
+
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE)
+		if (mqtt_evt->param.connack.return_code == MQTT_CONNECTION_ACCEPTED) {
+			pubq_on_connack();
+		}
+#endif
 		break;
 	case MQTT_EVT_DISCONNECT:
 		LOG_DBG("MQTT_EVT_DISCONNECT: result = %d", mqtt_evt->result);
@@ -351,6 +628,10 @@ MQTT_HELPER_STATIC void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			current_cfg.cb.on_puback(mqtt_evt->param.puback.message_id,
 						 mqtt_evt->result);
 		}
+
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE)
+		pubq_on_puback(mqtt_evt->param.puback.message_id);
+#endif
 		break;
 	case MQTT_EVT_SUBACK:
 		LOG_DBG("MQTT_EVT_SUBACK: id = %d result = %d",
@@ -596,6 +877,8 @@ static int client_connect(struct mqtt_helper_conn_params *conn_params)
 
 int mqtt_helper_init(struct mqtt_helper_cfg *cfg)
 {
+	__maybe_unused int err;
+
 	__ASSERT_NO_MSG(cfg != NULL);
 
 	if (!mqtt_state_verify(MQTT_STATE_UNINIT) && !mqtt_state_verify(MQTT_STATE_DISCONNECTED)) {
@@ -610,6 +893,13 @@ int mqtt_helper_init(struct mqtt_helper_cfg *cfg)
 
 	mqtt_client_init(&mqtt_client);
 
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_PERSIST)
+	err = settings_load_subtree(PUBQ_SETTINGS_KEY);
+	if (err) {
+		LOG_WRN("Failed to load queued messages, error: %d", err);
+	}
+#endif
+
 	mqtt_state_set(MQTT_STATE_DISCONNECTED);
 
 	return 0;
@@ -723,17 +1013,145 @@ int mqtt_helper_publish(const struct mqtt_publish_param *param)
 	return mqtt_publish(&mqtt_client, param);
 }
 
-uint16_t mqtt_helper_msg_id_get(void)
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE)
+int mqtt_helper_publish_enqueue(const struct mqtt_publish_param *param, bool coalesce)
 {
-	static uint16_t id;
+	struct pubq_entry *entry = NULL;
+	const struct mqtt_utf8 *topic;
+	const struct mqtt_binstr *payload;
+
+	__ASSERT_NO_MSG(param != NULL);
 
-	id++;
+	topic = &param->message.topic.topic;
+	payload = &param->message.payload;
 
-	if (id == 0) {
-		id++;
+	if (topic->size + payload->len > CONFIG_MQTT_HELPER_PUBLISH_QUEUE_ENTRY_SIZE) {
+		LOG_ERR("Message too large for the publish queue");
+		return -EMSGSIZE;
 	}
 
+	if (param->message.topic.qos > MQTT_QOS_1_AT_LEAST_ONCE) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	if (coalesce) {
+		for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+			struct pubq_entry *e = &pubq_entries[i];
+
+			if (e->state == PUBQ_ENTRY_QUEUED && e->rec.topic_len == topic->size &&
+			    memcmp(e->data, topic->utf8, topic->size) == 0) {
+				LOG_DBG("Replacing queued message %d", e->rec.message_id);
+				pubq_unpersist(e);
+				entry = e;
+				pubq_stats.coalesced++;
+				break;
+			}
+		}
+	}
+
+	if (!entry) {
+		for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+			if (pubq_entries[i].state == PUBQ_ENTRY_FREE) {
+				entry = &pubq_entries[i];
+				break;
+			}
+		}
+
+		if (!entry) {
+			pubq_stats.rejected++;
+			k_mutex_unlock(&pubq_lock);
+			return -ENOMEM;
+		}
+
+		entry->rec.seq = pubq_seq++;
+		entry->enqueued_at = k_uptime_get();
+		pubq_stats.depth++;
+		pubq_stats.depth_max = MAX(pubq_stats.depth_max, pubq_stats.depth);
+	}
+
+	entry->dup = false;
+	entry->rec.message_id = param->message_id ? param->message_id : mqtt_helper_msg_id_get();
+	entry->state = PUBQ_ENTRY_QUEUED;
+	entry->rec.qos = param->message.topic.qos;
+	entry->rec.retain = param->retain_flag;
+	entry->rec.topic_len = topic->size;
+	entry->rec.payload_len = payload->len;
+	memcpy(entry->data, topic->utf8, topic->size);
+	memcpy(entry->data + topic->size, payload->data, payload->len);
+
+	pubq_persist(entry);
+
+	k_mutex_unlock(&pubq_lock);
+
+	pubq_drain();
+
+	return 0;
+}
+
+void mqtt_helper_publish_queue_stats_get(struct mqtt_helper_publish_queue_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	*stats = pubq_stats;
+	stats->in_flight = pubq_in_flight;
+	stats->latency_avg_ms = pubq_stats.completed ?
+				(uint32_t)(pubq_latency_sum / pubq_stats.completed) : 0;
+
+	k_mutex_unlock(&pubq_lock);
+}
+
+void mqtt_helper_publish_queue_clear(void)
+{
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pubq_entries); i++) {
+		if (pubq_entries[i].state != PUBQ_ENTRY_FREE) {
+			pubq_unpersist(&pubq_entries[i]);
+			pubq_entries[i].state = PUBQ_ENTRY_FREE;
+		}
+	}
+
+	pubq_in_flight = 0;
+	pubq_latency_sum = 0;
+	memset(&pubq_stats, 0, sizeof(pubq_stats));
+
+	k_mutex_unlock(&pubq_lock);
+}
+#endif /* CONFIG_MQTT_HELPER_PUBLISH_QUEUE */
+
+static uint16_t msg_id_next(void)
+{
+	mqtt_helper_msg_id++;
+
+	if (mqtt_helper_msg_id == 0) {
+		mqtt_helper_msg_id++;
+	}
+
+	return mqtt_helper_msg_id;
+}
+
+uint16_t mqtt_helper_msg_id_get(void)
+{
+#if defined(CONFIG_MQTT_HELPER_PUBLISH_QUEUE)
+	uint16_t id;
+
+	/* Skip the IDs of queued messages, they are not acknowledged yet. */
+	k_mutex_lock(&pubq_lock, K_FOREVER);
+
+	do {
+		id = msg_id_next();
+	} while (pubq_msg_id_in_use(id));
+
+	k_mutex_unlock(&pubq_lock);
+
 	return id;
+#else
+	return msg_id_next();
+#endif
 }
 
 int mqtt_helper_deinit(void)
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <cJSON.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_defs.h>
+#include <net/nrf_cloud_batch.h>
+#if defined(CONFIG_NRF_CLOUD_COAP)
+#include <net/nrf_cloud_coap.h>
+#endif
+#if defined(CONFIG_NRF_CLOUD_BATCH_FLUSH_ON_LTE)
+#include <modem/lte_lc.h>
+#endif
+
+LOG_MODULE_REGISTER(nrf_cloud_batch, CONFIG_NRF_CLOUD_LOG_LEVEL);
+
+/* The bulk message, a JSON array of device messages */
+static NRF_CLOUD_OBJ_JSON_DEFINE(batch);
+/* Number of messages and estimated encoded size of the bulk message */
+static size_t batch_cnt;
+static size_t batch_bytes;
+
+static struct nrf_cloud_batch_stats stats;
+static K_MUTEX_DEFINE(batch_lock);
+
+static void batch_age_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(batch_age_work, batch_age_work_fn);
+
+#if defined(CONFIG_NRF_CLOUD_BATCH_FLUSH_ON_LTE)
+static void batch_lte_work_fn(struct k_work *work);
+static K_WORK_DEFINE(batch_lte_work, batch_lte_work_fn);
+#endif
+
+static size_t item_len_get(const cJSON *item)
+{
+	char *str = cJSON_PrintUnformatted(item);
+	size_t len;
+
+	if (!str) {
+		return 0;
+	}
+
+	len = strlen(str);
+	cJSON_free(str);
+
+	return len;
+}
+
+static cJSON *coalesce_target_find(const cJSON *item)
+{
+	const cJSON *app_id = cJSON_GetObjectItem(item, NRF_CLOUD_JSON_APPID_KEY);
+	cJSON *queued;
+
+	if (!cJSON_IsString(app_id)) {
+		return NULL;
+	}
+
+	cJSON_ArrayForEach(queued, batch.json) {
+		const cJSON *queued_id = cJSON_GetObjectItem(queued, NRF_CLOUD_JSON_APPID_KEY);
+
+		if (cJSON_IsString(queued_id) &&
+		    strcmp(queued_id->valuestring, app_id->valuestring) == 0) {
+			return queued;
+		}
+	}
+
+	return NULL;
+}
+
+static int batch_send(void)
+{
+	int err;
+
+	/* Encode here so that the transports send this encoding and the size is known */
+	err = nrf_cloud_obj_cloud_encode(&batch);
+	if (err) {
+		return err;
+	}
+
+#if defined(CONFIG_NRF_CLOUD_COAP)
+	err = nrf_cloud_coap_obj_send(&batch, true);
+#else
+	struct nrf_cloud_tx_data msg = {
+		.obj = &batch,
+		.topic_type = NRF_CLOUD_TOPIC_BULK,
+		.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+	};
+
+	err = nrf_cloud_send(&msg);
+#endif
+	if (!err) {
+		stats.bytes_sent += batch.encoded_data.len;
+	}
+
+	(void)nrf_cloud_obj_cloud_encoded_free(&batch);
+
+	return err;
+}
+
+static int batch_flush(enum nrf_cloud_batch_flush_reason reason)
+{
+	int err;
+
+	if (batch_cnt == 0) {
+		return 0;
+	}
+
+	LOG_DBG("Sending %d messages, %d bytes, reason %d", batch_cnt, batch_bytes, reason);
+
+	err = batch_send();
+	if (err) {
+		LOG_WRN("Failed to send batch, error: %d", err);
+		stats.send_errors++;
+		return err;
+	}
+
+	stats.flushes++;
+	stats.flush_reasons[reason]++;
+
+	(void)nrf_cloud_obj_free(&batch);
+	batch_cnt = 0;
+	batch_bytes = 0;
+
+	(void)k_work_cancel_delayable(&batch_age_work);
+
+	return 0;
+}
+
+/* Drop the oldest message so that a new one fits when the batch cannot be sent. */
+static void batch_oldest_drop(void)
+{
+	cJSON *oldest = cJSON_DetachItemFromArray(batch.json, 0);
+
+	if (oldest) {
+		batch_bytes -= MIN(batch_bytes, item_len_get(oldest) + 1);
+		batch_cnt--;
+		stats.dropped++;
+		cJSON_Delete(oldest);
+	}
+}
+
+int nrf_cloud_batch_add(struct nrf_cloud_obj *const obj, bool coalesce)
+{
+	cJSON *queued = NULL;
+	size_t len;
+	int err = 0;
+
+	if (!obj || !obj->json) {
+		return -EINVAL;
+	}
+
+	if (obj->type != NRF_CLOUD_OBJ_TYPE_JSON || !cJSON_IsObject(obj->json)) {
+		return -ENOTSUP;
+	}
+
+	/* Elements of the JSON array are separated by a comma */
+	len = item_len_get(obj->json) + 1;
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	if (!batch.json) {
+		err = nrf_cloud_obj_bulk_init(&batch);
+		if (err) {
+			goto exit;
+		}
+	}
+
+	if (coalesce) {
+		queued = coalesce_target_find(obj->json);
+	}
+
+	if (queued) {
+		size_t queued_len = item_len_get(queued) + 1;
+
+		if (!cJSON_ReplaceItemViaPointer(batch.json, queued, obj->json)) {
+			err = -ENOMEM;
+			goto exit;
+		}
+
+		batch_bytes -= MIN(batch_bytes, queued_len);
+		stats.coalesced++;
+	} else {
+		if (batch_cnt >= CONFIG_NRF_CLOUD_BATCH_MAX_MSGS ||
+		    batch_bytes + len > CONFIG_NRF_CLOUD_BATCH_MAX_BYTES) {
+			/* A previous flush failed; make room */
+			batch_oldest_drop();
+		}
+
+		err = nrf_cloud_obj_bulk_add(&batch, obj);
+		if (err) {
+			goto exit;
+		}
+
+		batch_cnt++;
+	}
+
+	batch_bytes += len;
+	stats.added++;
+
+	/* The object now belongs to the batch */
+	obj->json = NULL;
+
+	if (batch_cnt == 1 && !queued) {
+		(void)k_work_schedule(&batch_age_work, K_SECONDS(CONFIG_NRF_CLOUD_BATCH_MAX_AGE));
+	}
+
+	if (batch_cnt >= CONFIG_NRF_CLOUD_BATCH_MAX_MSGS) {
+		(void)batch_flush(NRF_CLOUD_BATCH_FLUSH_COUNT);
+	} else if (batch_bytes + len > CONFIG_NRF_CLOUD_BATCH_MAX_BYTES) {
+		/* Another message of the same size would not fit */
+		(void)batch_flush(NRF_CLOUD_BATCH_FLUSH_SIZE);
+	}
+
+exit:
+	k_mutex_unlock(&batch_lock);
+
+	return err;
+}
+
+int nrf_cloud_batch_sensor_add(const char *const app_id, double value, int64_t ts_ms,
+			       bool coalesce)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg);
+	int err;
+
+	err = nrf_cloud_obj_msg_init(&msg, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (err) {
+		return err;
+	}
+
+	err = nrf_cloud_obj_num_add(&msg, NRF_CLOUD_JSON_DATA_KEY, value, false);
+	if (!err && ts_ms >= 0) {
+		err = nrf_cloud_obj_ts_add(&msg, ts_ms);
+	}
+
+	if (!err) {
+		err = nrf_cloud_batch_add(&msg, coalesce);
+	}
+
+	if (err) {
+		(void)nrf_cloud_obj_free(&msg);
+	}
+
+	return err;
+}
+
+int nrf_cloud_batch_flush(void)
+{
+	int err;
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	err = batch_flush(NRF_CLOUD_BATCH_FLUSH_REQUESTED);
+	k_mutex_unlock(&batch_lock);
+
+	return err;
+}
+
+void nrf_cloud_batch_stats_get(struct nrf_cloud_batch_stats *out)
+{
+	if (!out) {
+		return;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&batch_lock);
+}
+
+static void batch_age_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	if (batch_flush(NRF_CLOUD_BATCH_FLUSH_AGE)) {
+		/* Try again later, the messages are kept */
+		(void)k_work_schedule(&batch_age_work, K_SECONDS(CONFIG_NRF_CLOUD_BATCH_MAX_AGE));
+	}
+
+	k_mutex_unlock(&batch_lock);
+}
+
+#if defined(CONFIG_NRF_CLOUD_BATCH_FLUSH_ON_LTE)
+static void batch_lte_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	(void)batch_flush(NRF_CLOUD_BATCH_FLUSH_LTE);
+	k_mutex_unlock(&batch_lock);
+}
+
+/* Sending while the radio is active anyway avoids a separate wake-up for the batch. */
+static void batch_lte_handler(const struct lte_lc_evt *const evt)
+{
+	switch (evt->type) {
+	case LTE_LC_EVT_RRC_UPDATE:
+		if (evt->rrc_mode != LTE_LC_RRC_MODE_CONNECTED) {
+			return;
+		}
+		break;
+#if defined(CONFIG_LTE_LC_TAU_PRE_WARNING_MODULE)
+	case LTE_LC_EVT_TAU_PRE_WARNING:
+		break;
+#endif
+#if defined(CONFIG_LTE_LC_MODEM_SLEEP_MODULE)
+	case LTE_LC_EVT_MODEM_SLEEP_EXIT_PRE_WARNING:
+		break;
+#endif
+	default:
+		return;
+	}
+
+	(void)k_work_submit(&batch_lte_work);
+}
+
+static int nrf_cloud_batch_init(void)
+{
+	lte_lc_register_handler(batch_lte_handler);
+
+	return 0;
+}
+
+SYS_INIT(nrf_cloud_batch_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_NRF_CLOUD_BATCH_FLUSH_ON_LTE */
@@ -19,10 +19,14 @@
 
 #include <net/rest_client.h>
 
+#include "rest_client_pool.h"
+
 LOG_MODULE_REGISTER(rest_client, CONFIG_REST_CLIENT_LOG_LEVEL);
 
 #define HTTP_PROTOCOL "HTTP/1.1"
 
+#define POOL_IN_USE IS_ENABLED(CONFIG_REST_CLIENT_CONN_POOL)
+
 static int rest_client_http_response_cb(struct http_response *rsp,
 					enum http_final_call final_data,
 					void *user_data)
@@ -170,17 +174,13 @@ static int rest_client_sckt_timeouts_set(int fd, int32_t timeout_ms)
 	return 0;
 }
 
-/* The time taken in this function is deducted from the given timeout value. */
-static int rest_client_sckt_connect(int *const fd,
-				    const char *const hostname,
+static int rest_client_addr_resolve(const char *const hostname,
 				    const uint16_t port_num,
-				    const sec_tag_t sec_tag,
-				    int tls_peer_verify,
-				    int32_t *timeout_ms)
+				    struct sockaddr *addr,
+				    socklen_t *addrlen)
 {
 	int ret;
 	struct zsock_addrinfo *addr_info;
-	char peer_addr[INET6_ADDRSTRLEN];
 	char portstr[6] = { 0 };
 	struct zsock_addrinfo hints = {
 		.ai_flags = AI_NUMERICSERV, /* Let getaddrinfo() set port to addrinfo */
@@ -188,29 +188,70 @@ static int rest_client_sckt_connect(int *const fd,
 		.ai_socktype = SOCK_STREAM,
 		.ai_next = NULL,
 	};
-	struct sockaddr *sa;
-	int proto = 0;
-	int64_t sckt_connect_start_time;
-	int64_t time_used = 0;
-
-	sckt_connect_start_time = k_uptime_get();
 
-	/* Make sure fd is always initialized when this function is called */
-	*fd = -1;
+	if (POOL_IN_USE && !rest_client_pool_addr_get(hostname, port_num, addr, addrlen)) {
+		LOG_DBG("Using cached address for %s", hostname);
+		return 0;
+	}
 
 	snprintf(portstr, 6, "%d", port_num);
 
 	LOG_DBG("Doing getaddrinfo() with connect addr %s port %s", hostname, portstr);
 
+	if (POOL_IN_USE) {
+		rest_client_pool_stats_dns_query();
+	}
+
 	ret = zsock_getaddrinfo(hostname, portstr, &hints, &addr_info);
 	if (ret) {
 		LOG_ERR("getaddrinfo() failed, error: %d", ret);
 		return -EFAULT;
 	}
 
-	sa = addr_info->ai_addr;
-	zsock_inet_ntop(sa->sa_family,
-			(void *)&((struct sockaddr_in *)sa)->sin_addr,
+	if (addr_info->ai_addrlen > sizeof(*addr)) {
+		zsock_freeaddrinfo(addr_info);
+		return -EFAULT;
+	}
+
+	memcpy(addr, addr_info->ai_addr, addr_info->ai_addrlen);
+	*addrlen = addr_info->ai_addrlen;
+	zsock_freeaddrinfo(addr_info);
+
+	if (POOL_IN_USE) {
+		rest_client_pool_addr_put(hostname, port_num, addr, *addrlen);
+	}
+
+	return 0;
+}
+
+/* The time taken in this function is deducted from the given timeout value. */
+static int rest_client_sckt_connect(int *const fd,
+				    const char *const hostname,
+				    const uint16_t port_num,
+				    const sec_tag_t sec_tag,
+				    int tls_peer_verify,
+				    int32_t *timeout_ms)
+{
+	int ret;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	char peer_addr[INET6_ADDRSTRLEN];
+	int proto = 0;
+	int64_t sckt_connect_start_time;
+	int64_t time_used = 0;
+
+	sckt_connect_start_time = k_uptime_get();
+
+	/* Make sure fd is always initialized when this function is called */
+	*fd = -1;
+
+	ret = rest_client_addr_resolve(hostname, port_num, &addr, &addrlen);
+	if (ret) {
+		return ret;
+	}
+
+	zsock_inet_ntop(addr.sa_family,
+			(void *)&((struct sockaddr_in *)&addr)->sin_addr,
 			peer_addr,
 			INET6_ADDRSTRLEN);
 	LOG_DBG("getaddrinfo() %s", peer_addr);
@@ -228,7 +269,7 @@ static int rest_client_sckt_connect(int *const fd,
 	}
 
 	proto = (sec_tag == SEC_TAG_TLS_INVALID) ? IPPROTO_TCP : IPPROTO_TLS_1_2;
-	*fd = zsock_socket(addr_info->ai_family, SOCK_STREAM, proto);
+	*fd = zsock_socket(addr.sa_family, SOCK_STREAM, proto);
 	if (*fd == -1) {
 		LOG_ERR("Failed to open socket, error: %d", errno);
 		ret = -ENOTCONN;
@@ -250,9 +291,13 @@ static int rest_client_sckt_connect(int *const fd,
 		goto clean_up;
 	}
 
-	LOG_DBG("Connecting to %s port %s", hostname, portstr);
+	LOG_DBG("Connecting to %s port %d", hostname, port_num);
+
+	if (POOL_IN_USE) {
+		rest_client_pool_stats_connect();
+	}
 
-	ret = zsock_connect(*fd, addr_info->ai_addr, addr_info->ai_addrlen);
+	ret = zsock_connect(*fd, &addr, addrlen);
 	if (ret) {
 		LOG_ERR("Failed to connect socket, error: %d", errno);
 		if (errno == ETIMEDOUT) {
@@ -260,6 +305,11 @@ static int rest_client_sckt_connect(int *const fd,
 		} else {
 			ret = -ECONNREFUSED;
 		}
+
+		if (POOL_IN_USE) {
+			/* The cached address may be outdated, resolve it again next time */
+			rest_client_pool_addr_invalidate(hostname, port_num);
+		}
 		goto clean_up;
 	}
 
@@ -278,7 +328,6 @@ static int rest_client_sckt_connect(int *const fd,
 
 clean_up:
 
-	zsock_freeaddrinfo(addr_info);
 	if (ret) {
 		if (*fd > -1) {
 			(void)zsock_close(*fd);
@@ -322,13 +371,71 @@ static void rest_client_init_request(struct rest_client_req_context *const req_c
 	req->method = req_ctx->http_method;
 }
 
+static int rest_client_http_req_send(struct http_request *http_req,
+				     struct rest_client_req_context *const req_ctx,
+				     struct rest_client_resp_context *const resp_ctx)
+{
+	memset(req_ctx->resp_buff, 0, req_ctx->resp_buff_len);
+
+	resp_ctx->req_ctx = req_ctx;
+	resp_ctx->response = NULL;
+	resp_ctx->response_len = 0;
+	resp_ctx->total_response_len = 0;
+	resp_ctx->used_socket_id = req_ctx->connect_socket;
+	resp_ctx->http_status_code_str[0] = '\0';
+	resp_ctx->used_socket_is_alive = false;
+	resp_ctx->http_status_code = 0;
+
+	return http_client_req(req_ctx->connect_socket, http_req, req_ctx->timeout_ms, resp_ctx);
+}
+
+/* A pooled connection that the server has closed makes the send fail, or is closed or reset
+ * before the first byte of the response arrives. After a timeout the server may have
+ * processed the request, so it is not sent again.
+ */
+static bool rest_client_conn_was_stale(int err,
+				       const struct rest_client_resp_context *const resp_ctx)
+{
+	if (resp_ctx->total_response_len > 0) {
+		return false;
+	}
+
+	switch (err) {
+	case -EPIPE:
+	case -ECONNRESET:
+	case -ECONNABORTED:
+	case -ENOTCONN:
+		return true;
+	default:
+		/* Connection closed by the server */
+		return err >= 0;
+	}
+}
+
 static int rest_client_do_api_call(struct http_request *http_req,
 				   struct rest_client_req_context *const req_ctx,
-				   struct rest_client_resp_context *const resp_ctx)
+				   struct rest_client_resp_context *const resp_ctx,
+				   bool *const poolable)
 {
 	uint8_t http_recv_buf[128];
+	bool pool_eligible = POOL_IN_USE && !req_ctx->keep_alive && req_ctx->connect_socket < 0;
+	bool reused = false;
+	int64_t send_start_time;
 	int err = 0;
 
+	*poolable = false;
+
+	if (pool_eligible) {
+		req_ctx->connect_socket = rest_client_pool_conn_get(req_ctx);
+		if (req_ctx->connect_socket >= 0) {
+			reused = true;
+			(void)rest_client_sckt_timeouts_set(req_ctx->connect_socket,
+							    req_ctx->timeout_ms);
+		} else {
+			req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+		}
+	}
+
 	if (req_ctx->connect_socket < 0) {
 		err = rest_client_sckt_connect(&req_ctx->connect_socket,
 						http_req->host,
@@ -345,18 +452,41 @@ static int rest_client_do_api_call(struct http_request *http_req,
 	http_req->recv_buf = http_recv_buf;
 	http_req->recv_buf_len = sizeof(http_recv_buf);
 
-	memset(req_ctx->resp_buff, 0, req_ctx->resp_buff_len);
+	send_start_time = k_uptime_get();
 
-	resp_ctx->req_ctx = req_ctx;
-	resp_ctx->response = NULL;
-	resp_ctx->response_len = 0;
-	resp_ctx->total_response_len = 0;
-	resp_ctx->used_socket_id = req_ctx->connect_socket;
-	resp_ctx->http_status_code_str[0] = '\0';
-	resp_ctx->used_socket_is_alive = false;
-	resp_ctx->http_status_code = 0;
+	err = rest_client_http_req_send(http_req, req_ctx, resp_ctx);
+	if (reused && rest_client_conn_was_stale(err, resp_ctx)) {
+		/* The server closed the pooled connection before it could be detected as
+		 * stale. Nothing has been processed yet, so retry once on a new connection.
+		 */
+		LOG_DBG("Pooled socket %d was stale, reconnecting", req_ctx->connect_socket);
+		rest_client_pool_stats_stale_retry();
+		(void)zsock_close(req_ctx->connect_socket);
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+
+		if (req_ctx->timeout_ms != SYS_FOREVER_MS) {
+			/* Only the time left of the request timeout is used for the retry */
+			req_ctx->timeout_ms -= k_uptime_get() - send_start_time;
+			if (req_ctx->timeout_ms <= 0) {
+				LOG_WRN("Timeout occurred on a stale pooled socket");
+				return -ETIMEDOUT;
+			}
+		}
+
+		err = rest_client_sckt_connect(&req_ctx->connect_socket,
+						http_req->host,
+						req_ctx->port,
+						req_ctx->sec_tag,
+						req_ctx->tls_peer_verify,
+						&req_ctx->timeout_ms);
+		if (err) {
+			req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+			return err;
+		}
+
+		err = rest_client_http_req_send(http_req, req_ctx, resp_ctx);
+	}
 
-	err = http_client_req(req_ctx->connect_socket, http_req, req_ctx->timeout_ms, resp_ctx);
 	if (err < 0) {
 		LOG_ERR("http_client_req() error: %d", err);
 	} else if (resp_ctx->total_response_len >= req_ctx->resp_buff_len) {
@@ -366,6 +496,7 @@ static int rest_client_do_api_call(struct http_request *http_req,
 		err = -ENOBUFS;
 	} else {
 		err = 0;
+		*poolable = pool_eligible && http_should_keep_alive(&http_req->internal.parser);
 	}
 
 	return err;
@@ -396,6 +527,7 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 	__ASSERT_NO_MSG(req_ctx->resp_buff_len > 0);
 
 	struct http_request http_req;
+	bool poolable;
 	int ret;
 
 	rest_client_init_request(req_ctx, &http_req);
@@ -419,7 +551,7 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 		}
 	}
 
-	ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx);
+	ret = rest_client_do_api_call(&http_req, req_ctx, resp_ctx, &poolable);
 	if (ret) {
 		LOG_ERR("rest_client_do_api_call() failed, err %d", ret);
 		goto clean_up;
@@ -438,7 +570,10 @@ int rest_client_request(struct rest_client_req_context *req_ctx,
 		resp_ctx->response_len);
 
 clean_up:
-	if (req_ctx->connect_socket != REST_CLIENT_SCKT_CONNECT) {
+	if (!ret && poolable) {
+		rest_client_pool_conn_put(req_ctx, req_ctx->connect_socket);
+		req_ctx->connect_socket = REST_CLIENT_SCKT_CONNECT;
+	} else if (req_ctx->connect_socket != REST_CLIENT_SCKT_CONNECT) {
 		/* Socket was not closed yet: */
 		rest_client_close_connection(req_ctx, resp_ctx);
 	}
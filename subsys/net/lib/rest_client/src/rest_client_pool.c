@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/logging/log.h>
+
+#include <net/rest_client.h>
+
+#include "rest_client_pool.h"
+
+LOG_MODULE_DECLARE(rest_client, CONFIG_REST_CLIENT_LOG_LEVEL);
+
+#define HOST_MAX_LEN CONFIG_REST_CLIENT_CONN_POOL_HOST_MAX_LEN
+#define IDLE_TIMEOUT_MS (CONFIG_REST_CLIENT_CONN_POOL_IDLE_TIMEOUT * MSEC_PER_SEC)
+#define DNS_TTL_MS (CONFIG_REST_CLIENT_DNS_CACHE_TTL * MSEC_PER_SEC)
+
+struct pool_conn {
+	char host[HOST_MAX_LEN + 1];
+	uint16_t port;
+	int sec_tag;
+	int tls_peer_verify;
+	int fd;
+	int64_t last_used;
+};
+
+struct dns_entry {
+	char host[HOST_MAX_LEN + 1];
+	uint16_t port;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	int64_t resolved_at;
+};
+
+static struct pool_conn conns[CONFIG_REST_CLIENT_CONN_POOL_SIZE];
+#if CONFIG_REST_CLIENT_DNS_CACHE_SIZE > 0
+static struct dns_entry dns_cache[CONFIG_REST_CLIENT_DNS_CACHE_SIZE];
+#endif
+static struct rest_client_pool_stats stats;
+
+static K_MUTEX_DEFINE(pool_lock);
+
+static bool host_fits(const char *host)
+{
+	return strnlen(host, HOST_MAX_LEN + 1) <= HOST_MAX_LEN;
+}
+
+static void conn_close(struct pool_conn *conn)
+{
+	if (conn->fd < 0) {
+		return;
+	}
+
+	if (zsock_close(conn->fd)) {
+		LOG_WRN("Failed to close pooled socket, error: %d", errno);
+	}
+
+	conn->fd = -1;
+	conn->host[0] = '\0';
+}
+
+static bool conn_matches(const struct pool_conn *conn,
+			 const struct rest_client_req_context *req_ctx)
+{
+	return conn->fd >= 0 &&
+	       conn->port == req_ctx->port &&
+	       conn->sec_tag == req_ctx->sec_tag &&
+	       conn->tls_peer_verify == req_ctx->tls_peer_verify &&
+	       strcmp(conn->host, req_ctx->host) == 0;
+}
+
+/* An idle HTTP connection should have nothing to read. Readable data or a
+ * hang-up means the server has closed the connection or sent a TLS alert.
+ */
+static bool conn_is_stale(const struct pool_conn *conn, int64_t now)
+{
+	struct zsock_pollfd fds = {
+		.fd = conn->fd,
+		.events = ZSOCK_POLLIN,
+	};
+
+	if (now - conn->last_used >= IDLE_TIMEOUT_MS) {
+		return true;
+	}
+
+	if (zsock_poll(&fds, 1, 0) != 0) {
+		return true;
+	}
+
+	return false;
+}
+
+int rest_client_pool_conn_get(const struct rest_client_req_context *req_ctx)
+{
+	int64_t now = k_uptime_get();
+	int fd = -ENOENT;
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct pool_conn *conn = &conns[i];
+
+		if (!conn_matches(conn, req_ctx)) {
+			continue;
+		}
+
+		if (conn_is_stale(conn, now)) {
+			LOG_DBG("Dropping stale pooled socket %d", conn->fd);
+			conn_close(conn);
+			continue;
+		}
+
+		fd = conn->fd;
+		conn->fd = -1;
+		conn->host[0] = '\0';
+		stats.reuses++;
+		LOG_DBG("Reusing pooled socket %d for %s:%d", fd, req_ctx->host, req_ctx->port);
+		break;
+	}
+
+	k_mutex_unlock(&pool_lock);
+
+	return fd;
+}
+
+void rest_client_pool_conn_put(const struct rest_client_req_context *req_ctx, int fd)
+{
+	struct pool_conn *slot = NULL;
+
+	if (!host_fits(req_ctx->host)) {
+		(void)zsock_close(fd);
+		return;
+	}
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].fd < 0) {
+			slot = &conns[i];
+			break;
+		}
+
+		if (!slot || conns[i].last_used < slot->last_used) {
+			slot = &conns[i];
+		}
+	}
+
+	if (slot->fd >= 0) {
+		LOG_DBG("Pool full, evicting socket %d", slot->fd);
+		conn_close(slot);
+		stats.evictions++;
+	}
+
+	strcpy(slot->host, req_ctx->host);
+	slot->port = req_ctx->port;
+	slot->sec_tag = req_ctx->sec_tag;
+	slot->tls_peer_verify = req_ctx->tls_peer_verify;
+	slot->fd = fd;
+	slot->last_used = k_uptime_get();
+
+	k_mutex_unlock(&pool_lock);
+
+	LOG_DBG("Socket %d returned to pool", fd);
+}
+
+int rest_client_pool_addr_get(const char *host, uint16_t port,
+			      struct sockaddr *addr, socklen_t *addrlen)
+{
+	int err = -ENOENT;
+
+#if CONFIG_REST_CLIENT_DNS_CACHE_SIZE > 0
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_entry *entry = &dns_cache[i];
+
+		if (entry->addrlen == 0 || entry->port != port ||
+		    strcmp(entry->host, host) != 0) {
+			continue;
+		}
+
+		if (now - entry->resolved_at >= DNS_TTL_MS) {
+			entry->addrlen = 0;
+			break;
+		}
+
+		memcpy(addr, &entry->addr, entry->addrlen);
+		*addrlen = entry->addrlen;
+		stats.dns_cache_hits++;
+		err = 0;
+		break;
+	}
+
+	k_mutex_unlock(&pool_lock);
+#endif
+
+	return err;
+}
+
+void rest_client_pool_addr_put(const char *host, uint16_t port,
+			       const struct sockaddr *addr, socklen_t addrlen)
+{
+#if CONFIG_REST_CLIENT_DNS_CACHE_SIZE > 0
+	struct dns_entry *slot = NULL;
+
+	if (!host_fits(host) || addrlen > sizeof(slot->addr)) {
+		return;
+	}
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		struct dns_entry *entry = &dns_cache[i];
+
+		if (entry->addrlen == 0 ||
+		    (entry->port == port && strcmp(entry->host, host) == 0)) {
+			slot = entry;
+			break;
+		}
+
+		if (!slot || entry->resolved_at < slot->resolved_at) {
+			slot = entry;
+		}
+	}
+
+	strcpy(slot->host, host);
+	slot->port = port;
+	memcpy(&slot->addr, addr, addrlen);
+	slot->addrlen = addrlen;
+	slot->resolved_at = k_uptime_get();
+
+	k_mutex_unlock(&pool_lock);
+#endif
+}
+
+void rest_client_pool_addr_invalidate(const char *host, uint16_t port)
+{
+#if CONFIG_REST_CLIENT_DNS_CACHE_SIZE > 0
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		if (dns_cache[i].port == port && strcmp(dns_cache[i].host, host) == 0) {
+			dns_cache[i].addrlen = 0;
+		}
+	}
+
+	k_mutex_unlock(&pool_lock);
+#endif
+}
+
+void rest_client_pool_stats_connect(void)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	stats.connects++;
+	k_mutex_unlock(&pool_lock);
+}
+
+void rest_client_pool_stats_dns_query(void)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	stats.dns_queries++;
+	k_mutex_unlock(&pool_lock);
+}
+
+void rest_client_pool_stats_stale_retry(void)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	stats.stale_retries++;
+	k_mutex_unlock(&pool_lock);
+}
+
+void rest_client_pool_stats_get(struct rest_client_pool_stats *out)
+{
+	__ASSERT_NO_MSG(out != NULL);
+
+	k_mutex_lock(&pool_lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&pool_lock);
+}
+
+void rest_client_pool_flush(void)
+{
+	k_mutex_lock(&pool_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		conn_close(&conns[i]);
+	}
+
+#if CONFIG_REST_CLIENT_DNS_CACHE_SIZE > 0
+	for (size_t i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		dns_cache[i].addrlen = 0;
+	}
+#endif
+
+	k_mutex_unlock(&pool_lock);
+}
+
+static int rest_client_pool_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		conns[i].fd = -1;
+	}
+
+	return 0;
+}
+
+SYS_INIT(rest_client_pool_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
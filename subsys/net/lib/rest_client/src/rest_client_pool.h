@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef REST_CLIENT_POOL_H__
+#define REST_CLIENT_POOL_H__
+
+#include <zephyr/net/socket.h>
+#include <net/rest_client.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Look up a cached address for the given host and port.
+ * Returns 0 and fills addr and addrlen on a cache hit, -ENOENT otherwise.
+ */
+int rest_client_pool_addr_get(const char *host, uint16_t port,
+			      struct sockaddr *addr, socklen_t *addrlen);
+
+/* Store a resolved address for the given host and port. */
+void rest_client_pool_addr_put(const char *host, uint16_t port,
+			       const struct sockaddr *addr, socklen_t addrlen);
+
+/* Drop a cached address, for example after a failed connect. */
+void rest_client_pool_addr_invalidate(const char *host, uint16_t port);
+
+/* Take an idle connection matching the request out of the pool.
+ * Returns the socket descriptor or -ENOENT if no usable connection exists.
+ */
+int rest_client_pool_conn_get(const struct rest_client_req_context *req_ctx);
+
+/* Hand a connection that can be reused back to the pool. The pool takes
+ * ownership of the socket and closes it when it is evicted or expires.
+ */
+void rest_client_pool_conn_put(const struct rest_client_req_context *req_ctx, int fd);
+
+/* Statistics bookkeeping. */
+void rest_client_pool_stats_connect(void);
+void rest_client_pool_stats_dns_query(void);
+void rest_client_pool_stats_stale_retry(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REST_CLIENT_POOL_H__ */
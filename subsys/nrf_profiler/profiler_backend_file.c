@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <nrf_profiler.h>
+
+#include "profiler_nordic_backend.h"
+
+#define DATA_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_BACKEND_FILE_PATH ".data"
+#define INFO_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_BACKEND_FILE_PATH ".info"
+
+static FILE *data_file;
+static FILE *info_file;
+static uint16_t info_num_events;
+static bool started;
+
+static int file_init(void)
+{
+	data_file = fopen(DATA_FILE_PATH, "wb");
+	if (!data_file) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int file_data_send(const uint8_t *data, size_t len)
+{
+	size_t written = fwrite(data, 1, len, data_file);
+
+	fflush(data_file);
+
+	return written;
+}
+
+static int file_info_send(const char *data, size_t len)
+{
+	if (fwrite(data, 1, len, info_file) != len) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* There is no host to send the commands, so the profiling is started right away. The event
+ * descriptions are written again each time new event types are registered.
+ */
+static bool file_command_get(enum nrf_profiler_nordic_command *cmd)
+{
+	if (info_num_events != nrf_profiler_num_events) {
+		if (info_file) {
+			fclose(info_file);
+		}
+
+		info_file = fopen(INFO_FILE_PATH, "w");
+		if (!info_file) {
+			return false;
+		}
+
+		info_num_events = nrf_profiler_num_events;
+		*cmd = NRF_PROFILER_NORDIC_COMMAND_INFO;
+
+		return true;
+	}
+
+	if (info_file) {
+		fflush(info_file);
+	}
+
+	if (!started) {
+		started = true;
+		*cmd = NRF_PROFILER_NORDIC_COMMAND_START;
+
+		return true;
+	}
+
+	return false;
+}
+
+const struct nrf_profiler_nordic_backend nrf_profiler_nordic_backend = {
+	.init = file_init,
+	.data_send = file_data_send,
+	.info_send = file_info_send,
+	.command_get = file_command_get,
+};
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <nrf_profiler.h>
+
+#include "profiler_nordic_backend.h"
+
+/* The events stay in the ring buffer until the application reads them. */
+const struct nrf_profiler_nordic_backend nrf_profiler_nordic_backend;
+
+size_t nrf_profiler_ram_read(uint8_t *buf, size_t len)
+{
+	return nrf_profiler_nordic_data_get(buf, len);
+}
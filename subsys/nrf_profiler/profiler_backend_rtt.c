@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <SEGGER_RTT.h>
+
+#include "profiler_nordic_backend.h"
+
+static uint8_t buffer_data[CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE];
+static uint8_t buffer_info[CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE];
+static uint8_t buffer_commands[CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
+
+static int rtt_init(void)
+{
+	int ret;
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+		"Nordic nrf_profiler data",
+		buffer_data,
+		CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
+		"Nordic nrf_profiler info",
+		buffer_info,
+		CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	ret = SEGGER_RTT_ConfigDownBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
+		"Nordic nrf_profiler command",
+		buffer_commands,
+		CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	return 0;
+}
+
+static int rtt_data_send(const uint8_t *data, size_t len)
+{
+	/* In the skip mode, the chunk is either written whole or not at all */
+	return SEGGER_RTT_Write(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA, data, len);
+}
+
+static int rtt_info_send(const char *data, size_t len)
+{
+	uint8_t retry_cnt = 0;
+	static const uint8_t retry_cnt_max = 100;
+
+	size_t num_bytes_send;
+
+	num_bytes_send = SEGGER_RTT_Write(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO, data, len);
+
+	while (num_bytes_send != len) {
+		/* Give host time to read the data and free some space
+		 * in the buffer.
+		 */
+		k_sleep(K_MSEC(100));
+		num_bytes_send = SEGGER_RTT_Write(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
+						  data, len);
+
+		/* Avoid being blocked in while loop if host does not read
+		 * the RTT data.
+		 */
+		retry_cnt++;
+		if (retry_cnt > retry_cnt_max) {
+			return -ENOBUFS;
+		}
+	}
+
+	return 0;
+}
+
+static bool rtt_command_get(enum nrf_profiler_nordic_command *cmd)
+{
+	uint8_t read_data;
+
+	if (!SEGGER_RTT_Read(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS, &read_data,
+			     sizeof(read_data))) {
+		return false;
+	}
+
+	*cmd = (enum nrf_profiler_nordic_command)read_data;
+
+	return true;
+}
+
+const struct nrf_profiler_nordic_backend nrf_profiler_nordic_backend = {
+	.init = rtt_init,
+	.data_send = rtt_data_send,
+	.info_send = rtt_info_send,
+	.command_get = rtt_command_get,
+};
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+
+#include "profiler_nordic_backend.h"
+
+/* The event descriptions and the event records are sent over the same UART. The host requests
+ * the descriptions before it starts the profiling, so the text is never mixed with the records.
+ */
+static const struct device *const uart_dev = DEVICE_DT_GET(DT_CHOSEN(ncs_nrf_profiler_uart));
+
+static int uart_init(void)
+{
+	if (!device_is_ready(uart_dev)) {
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+static int uart_data_send(const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uart_poll_out(uart_dev, data[i]);
+	}
+
+	return len;
+}
+
+static int uart_info_send(const char *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		uart_poll_out(uart_dev, data[i]);
+	}
+
+	return 0;
+}
+
+static bool uart_command_get(enum nrf_profiler_nordic_command *cmd)
+{
+	unsigned char read_data;
+
+	if (uart_poll_in(uart_dev, &read_data)) {
+		return false;
+	}
+
+	*cmd = (enum nrf_profiler_nordic_command)read_data;
+
+	return true;
+}
+
+const struct nrf_profiler_nordic_backend nrf_profiler_nordic_backend = {
+	.init = uart_init,
+	.data_send = uart_data_send,
+	.info_send = uart_info_send,
+	.command_get = uart_command_get,
+};
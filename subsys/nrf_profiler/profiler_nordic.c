@@ -10,11 +10,22 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/kernel.h>
-#include <SEGGER_RTT.h>
+#include <zephyr/sys/barrier.h>
 #include <nrf_profiler.h>
 #include <string.h>
-#include <nrfx.h>
 
+#include "profiler_nordic_backend.h"
+
+#define RING_SIZE	CONFIG_NRF_PROFILER_NORDIC_RING_BUFFER_SIZE
+#define RECORD_HDR_SIZE	sizeof(uint32_t)
+#define EVENT_ID_SIZE	sizeof(uint16_t)
+/* Chunk of event records passed to the backend at once */
+#define DRAIN_CHUNK_SIZE MAX(256, CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_SIZE), "Ring buffer size must be a power of two");
+BUILD_ASSERT(RING_SIZE >= RECORD_HDR_SIZE + ROUND_UP(CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN,
+						      sizeof(uint32_t)),
+	     "Ring buffer too small for an event");
 
 enum state {
 	STATE_DISABLED,
@@ -28,14 +39,22 @@ struct nrf_profiler_event_enabled_bm _nrf_profiler_event_enabled_bm;
 
 static K_SEM_DEFINE(nrf_profiler_sem, 0, 1);
 static atomic_t nrf_profiler_state;
-static uint16_t fatal_error_event_id;
-static struct k_spinlock lock;
+static uint16_t dropped_event_id;
 
-enum nordic_command {
-	NORDIC_COMMAND_START	= 1,
-	NORDIC_COMMAND_STOP	= 2,
-	NORDIC_COMMAND_INFO	= 3
-};
+/* Lock-free ring buffer for the event records.
+ *
+ * Each record starts with a header word holding its length, and is padded to a multiple of
+ * 4 bytes. Producers reserve space by advancing ring_reserved, copy the record and publish it by
+ * writing the header word last. The only consumer copies the published records in order, clears
+ * them and releases the space by advancing ring_released. Both counters are free-running.
+ * An event that does not fit is dropped and counted, the count is sent as an event once there
+ * is space again.
+ */
+static uint32_t ring[RING_SIZE / sizeof(uint32_t)];
+static atomic_t ring_reserved;
+static atomic_t ring_released;
+static atomic_t dropped_cnt;
+static atomic_t dropped_total;
 
 char descr[NRF_PROFILER_MAX_NUMBER_OF_APPLICATION_AND_INTERNAL_EVENTS]
 	  [CONFIG_NRF_PROFILER_MAX_LENGTH_OF_CUSTOM_EVENTS_DESCRIPTIONS];
@@ -50,11 +69,7 @@ static char *arg_types_encodings[] = {
 					"t"    /* time */
 				     };
 
-uint8_t nrf_profiler_num_events;
-
-static uint8_t buffer_data[CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE];
-static uint8_t buffer_info[CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE];
-static uint8_t buffer_commands[CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
+uint16_t nrf_profiler_num_events;
 
 static k_tid_t protocol_thread_id;
 
@@ -64,33 +79,7 @@ static struct k_thread nrf_profiler_nordic_thread;
 
 static int send_info_data(const char *data, size_t data_len)
 {
-	uint8_t retry_cnt = 0;
-	static const uint8_t retry_cnt_max = 100;
-
-	size_t num_bytes_send;
-
-	num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
-
-	while (num_bytes_send != data_len) {
-		/* Give host time to read the data and free some space
-		 * in the buffer. */
-		k_sleep(K_MSEC(100));
-		num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
-
-		/* Avoid being blocked in while loop if host does not read
-		 * the RTT data.
-		 */
-		retry_cnt++;
-		if (retry_cnt > retry_cnt_max) {
-			return -ENOBUFS;
-		}
-	}
-
-	return 0;
+	return nrf_profiler_nordic_backend.info_send(data, data_len);
 }
 
 static int send_system_description(void)
@@ -99,12 +88,12 @@ static int send_system_description(void)
 	/* Memory barrier to make sure that data is visible
 	 * before being accessed
 	 */
-	uint8_t ne = nrf_profiler_num_events;
+	uint16_t ne = nrf_profiler_num_events;
 	static const char * const ev_info_start = "<ev_info_start>\n";
 	static const char * const ev_info_stop = "<ev_info_stop>\n";
 	static const char end_line = '\n';
 
-	__DMB();
+	barrier_dmem_fence_full();
 
 	err = send_info_data(ev_info_start, strlen(ev_info_start));
 	if (err) {
@@ -134,6 +123,7 @@ static int send_system_configuration(void)
 	static const char * const sys_config_start = "<sys_config_start>\n";
 	static const char * const sys_config_stop = "<sys_config_stop>\n";
 	static const char * const sys_clock_param_name = "sys_clock_hw_cycles_per_sec";
+	static const char * const event_id_size_param = "event_id_size,2\n";
 
 	temp_val = snprintf(sys_clock_buf,
 						sizeof(sys_clock_buf),
@@ -158,51 +148,211 @@ static int send_system_configuration(void)
 		return err;
 	}
 
+	err = send_info_data(event_id_size_param, strlen(event_id_size_param));
+	if (err) {
+		return err;
+	}
+
 	err = send_info_data(sys_config_stop, strlen(sys_config_stop));
 
 	return err;
 }
 
-static void nrf_profiler_nordic_thread_fn(void)
+static void ring_copy_in(uint32_t off, const uint8_t *data, size_t len)
+{
+	uint8_t *ring_bytes = (uint8_t *)ring;
+	size_t first = MIN(len, RING_SIZE - off);
+
+	memcpy(&ring_bytes[off], data, first);
+	memcpy(ring_bytes, data + first, len - first);
+}
+
+static void ring_copy_out(uint8_t *data, uint32_t off, size_t len)
+{
+	uint8_t *ring_bytes = (uint8_t *)ring;
+	size_t first = MIN(len, RING_SIZE - off);
+
+	memcpy(data, &ring_bytes[off], first);
+	memcpy(data + first, ring_bytes, len - first);
+}
+
+static void ring_clear(uint32_t off, size_t len)
+{
+	uint8_t *ring_bytes = (uint8_t *)ring;
+	size_t first = MIN(len, RING_SIZE - off);
+
+	memset(&ring_bytes[off], 0, first);
+	memset(ring_bytes, 0, len - first);
+}
+
+/* Safe to call from any context, including interrupts. */
+static bool ring_put(const uint8_t *data, size_t len)
+{
+	uint32_t size = RECORD_HDR_SIZE + ROUND_UP(len, sizeof(uint32_t));
+	atomic_val_t pos;
+	uint32_t off;
+
+	do {
+		pos = atomic_get(&ring_reserved);
+
+		if ((uint32_t)pos + size - (uint32_t)atomic_get(&ring_released) > RING_SIZE) {
+			return false;
+		}
+	} while (!atomic_cas(&ring_reserved, pos, (uint32_t)pos + size));
+
+	off = (uint32_t)pos & (RING_SIZE - 1);
+	ring_copy_in((off + RECORD_HDR_SIZE) & (RING_SIZE - 1), data, len);
+
+	/* The record must be complete before it is published */
+	barrier_dmem_fence_full();
+	*(volatile uint32_t *)&ring[off / sizeof(uint32_t)] = len;
+
+	return true;
+}
+
+static size_t ring_get(uint8_t *buf, size_t len)
+{
+	uint32_t rd = atomic_get(&ring_released);
+	size_t copied = 0;
+
+	while (true) {
+		uint32_t off = rd & (RING_SIZE - 1);
+		uint32_t rec_len = *(volatile uint32_t *)&ring[off / sizeof(uint32_t)];
+		uint32_t size = RECORD_HDR_SIZE + ROUND_UP(rec_len, sizeof(uint32_t));
+
+		/* Not published yet, or no space for the whole record */
+		if ((rec_len == 0) || (copied + rec_len > len)) {
+			break;
+		}
+
+		barrier_dmem_fence_full();
+		ring_copy_out(&buf[copied], (off + RECORD_HDR_SIZE) & (RING_SIZE - 1), rec_len);
+		copied += rec_len;
+
+		/* Stale data must not be taken for a published record when the space is reused */
+		ring_clear(off, size);
+		rd += size;
+	}
+
+	barrier_dmem_fence_full();
+	atomic_set(&ring_released, rd);
+
+	return copied;
+}
+
+static void dropped_report(void)
+{
+	atomic_val_t cnt = atomic_set(&dropped_cnt, 0);
+	struct log_event_buf buf;
+
+	if (cnt == 0) {
+		return;
+	}
+
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint32(&buf, cnt);
+	sys_put_le16(dropped_event_id, buf.payload_start);
+
+	if (!ring_put(buf.payload_start, buf.payload - buf.payload_start)) {
+		atomic_add(&dropped_cnt, cnt);
+	}
+}
+
+size_t nrf_profiler_nordic_data_get(uint8_t *buf, size_t len)
+{
+	size_t copied = ring_get(buf, len);
+
+	dropped_report();
+
+	return copied;
+}
+
+static void data_drain(void)
+{
+	static uint8_t chunk[DRAIN_CHUNK_SIZE];
+	static size_t chunk_len;
+	static size_t chunk_sent;
+	int ret;
+
+	while (true) {
+		if (chunk_sent == chunk_len) {
+			chunk_len = nrf_profiler_nordic_data_get(chunk, sizeof(chunk));
+			chunk_sent = 0;
+
+			if (chunk_len == 0) {
+				return;
+			}
+		}
+
+		ret = nrf_profiler_nordic_backend.data_send(&chunk[chunk_sent],
+							    chunk_len - chunk_sent);
+		if (ret <= 0) {
+			/* Backend busy, try again in the next period */
+			return;
+		}
+
+		chunk_sent += ret;
+	}
+}
+
+static void command_handle(enum nrf_profiler_nordic_command command)
 {
-	int ret_err;
-	uint8_t read_data;
-	enum nordic_command command;
 	static const char end_line = '\n';
+	int ret_err;
+
+	switch (command) {
+	case NRF_PROFILER_NORDIC_COMMAND_START:
+		atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
+		break;
+	case NRF_PROFILER_NORDIC_COMMAND_STOP:
+		atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
+		break;
+	case NRF_PROFILER_NORDIC_COMMAND_INFO:
+		ret_err = send_system_description();
+		if (ret_err) {
+			break;
+		}
+		ret_err = send_system_configuration();
+		if (!ret_err) {
+			(void)send_info_data(&end_line, 1);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void nrf_profiler_nordic_thread_fn(void)
+{
+	enum nrf_profiler_nordic_command command;
 
 	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
-		if (SEGGER_RTT_Read(
-		     CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		     &read_data, sizeof(read_data))) {
-			command = (enum nordic_command)read_data;
-			switch (command) {
-			case NORDIC_COMMAND_START:
-				atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
-				break;
-			case NORDIC_COMMAND_STOP:
-				atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
-				break;
-			case NORDIC_COMMAND_INFO:
-				ret_err = send_system_description();
-				if (ret_err) {
-					break;
-				}
-				ret_err = send_system_configuration();
-				if (!ret_err) {
-					(void)send_info_data(&end_line, 1);
-				}
-				break;
-			default:
-				break;
-			}
+		if (nrf_profiler_nordic_backend.command_get &&
+		    nrf_profiler_nordic_backend.command_get(&command)) {
+			command_handle(command);
+		}
+
+		if (nrf_profiler_nordic_backend.data_send) {
+			data_drain();
 		}
-		k_sleep(K_MSEC(500));
+
+		k_sleep(K_MSEC(CONFIG_NRF_PROFILER_NORDIC_DRAIN_PERIOD_MS));
+	}
+
+	/* Send the events logged before the termination */
+	if (nrf_profiler_nordic_backend.data_send) {
+		data_drain();
 	}
+
 	k_sem_give(&nrf_profiler_sem);
 }
 
 int nrf_profiler_init(void)
 {
+	static const char * const dropped_args[] = {"count"};
+	static const enum nrf_profiler_arg dropped_arg_types[] = {NRF_PROFILER_ARG_U32};
+	int ret;
+
 	k_sched_lock();
 
 	if (!atomic_cas(&nrf_profiler_state, STATE_DISABLED, STATE_INACTIVE)) {
@@ -221,31 +371,24 @@ int nrf_profiler_init(void)
 		atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
 	}
 
-	int ret;
+	if (nrf_profiler_nordic_backend.init) {
+		ret = nrf_profiler_nordic_backend.init();
+		if (ret) {
+			atomic_set(&nrf_profiler_state, STATE_DISABLED);
+			k_sched_unlock();
+			return ret;
+		}
+	}
 
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-		"Nordic nrf_profiler data",
-		buffer_data,
-		CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-		"Nordic nrf_profiler info",
-		buffer_info,
-		CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigDownBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		"Nordic nrf_profiler command",
-		buffer_commands,
-		CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
+	/* Registering event reporting the number of dropped events */
+	dropped_event_id = nrf_profiler_register_event_type("_nrf_profiler_dropped_events_",
+							    dropped_args, dropped_arg_types, 1);
+
+	if (!nrf_profiler_nordic_backend.command_get && !nrf_profiler_nordic_backend.data_send) {
+		/* The application reads the events, no thread is needed */
+		k_sched_unlock();
+		return 0;
+	}
 
 	protocol_thread_id =  k_thread_create(&nrf_profiler_nordic_thread,
 			nrf_profiler_nordic_stack,
@@ -254,10 +397,6 @@ int nrf_profiler_init(void)
 			NULL, NULL, NULL,
 			CONFIG_NRF_PROFILER_NORDIC_THREAD_PRIORITY, 0, K_NO_WAIT);
 
-	/* Registering fatal error event */
-	fatal_error_event_id = nrf_profiler_register_event_type("_nrf_profiler_fatal_error_event_",
-							    NULL, NULL, 0);
-
 	k_sched_unlock();
 	return 0;
 }
@@ -269,6 +408,10 @@ void nrf_profiler_term(void)
 		return;
 	}
 
+	if (!protocol_thread_id) {
+		return;
+	}
+
 	k_wakeup(protocol_thread_id);
 	k_sem_take(&nrf_profiler_sem, K_FOREVER);
 }
@@ -286,7 +429,7 @@ uint16_t nrf_profiler_register_event_type(const char *name, const char * const *
 	 * from multiple threads
 	 */
 	k_sched_lock();
-	uint8_t ne = nrf_profiler_num_events;
+	uint16_t ne = nrf_profiler_num_events;
 
 	__ASSERT_NO_MSG(ne + 1 <= NRF_PROFILER_MAX_NUMBER_OF_APPLICATION_AND_INTERNAL_EVENTS);
 	size_t temp = snprintf(descr[ne],
@@ -319,7 +462,7 @@ uint16_t nrf_profiler_register_event_type(const char *name, const char * const *
 	/* Memory barrier to make sure that data is visible
 	 * before being accessed
 	 */
-	__DMB();
+	barrier_dmem_fence_full();
 	nrf_profiler_num_events++;
 	k_sched_unlock();
 
@@ -328,8 +471,8 @@ uint16_t nrf_profiler_register_event_type(const char *name, const char * const *
 
 void nrf_profiler_log_start(struct log_event_buf *buf)
 {
-	/* Adding one to pointer to make space for event type ID */
-	buf->payload = buf->payload_start + sizeof(uint8_t);
+	/* Make space for event type ID */
+	buf->payload = buf->payload_start + EVENT_ID_SIZE;
 	nrf_profiler_log_encode_uint32(buf, k_cycle_get_32());
 }
 
@@ -397,43 +540,19 @@ void nrf_profiler_log_add_mem_address(struct log_event_buf *buf,
 	nrf_profiler_log_encode_uint32(buf, (uint32_t)mem_address);
 }
 
-static bool nrf_profiler_RTT_send(struct log_event_buf *buf, uint8_t type_id)
-{
-	buf->payload_start[0] = type_id;
-	size_t data_len = buf->payload - buf->payload_start;
-
-	size_t num_bytes_send = SEGGER_RTT_WriteNoLock(
-			CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-			buf->payload_start, data_len);
-	return (num_bytes_send == data_len);
-}
-
-static void nrf_profiler_fatal_error(void)
+void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
 {
-	struct log_event_buf buf;
+	if (atomic_get(&nrf_profiler_state) == STATE_ACTIVE) {
+		sys_put_le16(event_type_id, buf->payload_start);
 
-	nrf_profiler_log_start(&buf);
-	while (true) {
-		/* Sending Fatal Error event */
-		if (nrf_profiler_RTT_send(&buf, (uint8_t)fatal_error_event_id)) {
-			break;
+		if (!ring_put(buf->payload_start, buf->payload - buf->payload_start)) {
+			atomic_inc(&dropped_cnt);
+			atomic_inc(&dropped_total);
 		}
 	}
-	k_oops();
 }
 
-void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
+uint32_t nrf_profiler_dropped_count_get(void)
 {
-	__ASSERT_NO_MSG(event_type_id <= UINT8_MAX);
-
-	if (atomic_get(&nrf_profiler_state) == STATE_ACTIVE) {
-		uint8_t type_id = event_type_id & UINT8_MAX;
-
-		k_spinlock_key_t key = k_spin_lock(&lock);
-
-		if (!nrf_profiler_RTT_send(buf, type_id)) {
-			nrf_profiler_fatal_error();
-		}
-		k_spin_unlock(&lock, key);
-	}
+	return atomic_get(&dropped_total);
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PROFILER_NORDIC_BACKEND_H_
+#define _PROFILER_NORDIC_BACKEND_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Commands sent by the host tools. */
+enum nrf_profiler_nordic_command {
+	NRF_PROFILER_NORDIC_COMMAND_START = 1,
+	NRF_PROFILER_NORDIC_COMMAND_STOP = 2,
+	NRF_PROFILER_NORDIC_COMMAND_INFO = 3,
+};
+
+/**
+ * @brief Backend of the Nordic nrf_profiler, selected at compile time.
+ *
+ * All functions are called from the nrf_profiler thread. Events are buffered in a lock-free
+ * ring buffer before they are passed to the backend, so the backend does not need to be safe
+ * to use from interrupts. Functions that are not supported by the backend are set to NULL.
+ */
+struct nrf_profiler_nordic_backend {
+	/**
+	 * @brief Initialize the backend.
+	 *
+	 * @return 0 on success, negative error code otherwise.
+	 */
+	int (*init)(void);
+
+	/**
+	 * @brief Send event data.
+	 *
+	 * @param data Event records.
+	 * @param len Length of the data.
+	 *
+	 * @return Number of bytes sent, which may be less than @p len if the backend is busy.
+	 *         The remaining bytes are sent again in the next period.
+	 *         Negative error code on failure.
+	 */
+	int (*data_send)(const uint8_t *data, size_t len);
+
+	/**
+	 * @brief Send event descriptions and system configuration.
+	 *
+	 * @param data Text to send.
+	 * @param len Length of the text.
+	 *
+	 * @return 0 on success, negative error code otherwise.
+	 */
+	int (*info_send)(const char *data, size_t len);
+
+	/**
+	 * @brief Get a command from the host.
+	 *
+	 * @param cmd Command received.
+	 *
+	 * @return True if a command was received.
+	 */
+	bool (*command_get)(enum nrf_profiler_nordic_command *cmd);
+};
+
+/** The backend selected at compile time. */
+extern const struct nrf_profiler_nordic_backend nrf_profiler_nordic_backend;
+
+/**
+ * @brief Get event records from the ring buffer.
+ *
+ * Only whole records are copied. Must be called from a single context at a time.
+ *
+ * @param buf Buffer for the records.
+ * @param len Size of the buffer.
+ *
+ * @return Number of bytes copied.
+ */
+size_t nrf_profiler_nordic_data_get(uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PROFILER_NORDIC_BACKEND_H_ */
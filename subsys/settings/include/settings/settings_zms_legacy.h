@@ -42,9 +42,47 @@ struct settings_zms {
 		uint32_t name_id;
 	} cache[CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE];
 
-	uint32_t cache_next;
 	uint32_t cache_total;
+	/* The cache holds all names in ZMS */
 	bool loaded;
+	/* A name did not fit in the cache */
+	bool cache_ovfl;
+#endif
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+	struct {
+		/* Hash of the name up to the end of the node's component */
+		uint32_t hash;
+		/* Name ID of the setting with the node's name, or 0 */
+		uint32_t name_id;
+		uint16_t parent;
+		uint16_t child;
+		uint16_t sibling;
+		/* Number of names stored at the node and below it */
+		uint16_t refs;
+		bool used;
+		/* The node was freed, lookups continue past it */
+		bool removed;
+	} node[CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE];
+
+	/* A node did not fit in the index, or two names share a node */
+	bool index_ovfl;
+#endif
+#if CONFIG_SETTINGS_ZMS_BATCH
+	struct {
+		struct {
+			uint32_t name_id;
+			uint16_t name_off;
+			uint16_t val_off;
+			uint16_t val_len;
+			uint16_t val_size;
+		} entry[CONFIG_SETTINGS_ZMS_BATCH_ENTRIES];
+		/* Names, including the terminating '\0', and values of the entries */
+		uint8_t buf[CONFIG_SETTINGS_ZMS_BATCH_BUF_SIZE];
+
+		uint32_t entry_count;
+		size_t buf_used;
+		bool active;
+	} batch;
 #endif
 };
 
@@ -57,6 +95,27 @@ int settings_zms_dst(struct settings_zms *cf);
 /* Initialize a zms backend. */
 int settings_zms_backend_init(struct settings_zms *cf);
 
+#if CONFIG_SETTINGS_ZMS_BATCH
+/* Start a batch of saves to the zms settings destination.
+ *
+ * Until settings_zms_batch_commit() is called, saves from all threads are kept in
+ * RAM and a later save of the same name, including a delete, replaces the earlier
+ * one. The saved values are not visible to settings loads before the commit.
+ * If the batch gets full, the saves in it are written to ZMS and the batch continues.
+ *
+ * Returns 0 on success, -EALREADY if a batch is already started, or -ENOENT if zms
+ * is not the settings destination.
+ */
+int settings_zms_batch_begin(void);
+
+/* Write the saves of the batch to ZMS in one pass and end the batch.
+ *
+ * Returns 0 on success, -EINVAL if no batch is started, or a negative error code
+ * from ZMS. On error, the saves that were not written are dropped.
+ */
+int settings_zms_batch_commit(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,25 +64,331 @@ int settings_zms_dst(struct settings_zms *cf)
 }
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-#define SETTINGS_ZMS_CACHE_OVFL(cf) ((cf)->cache_total > ARRAY_SIZE((cf)->cache))
+/* The cache is an open addressing hash table of name hashes and name IDs.
+ * Free entries have a name ID of 0, removed entries a name ID of ZMS_NAMECNT_ID.
+ */
+#define SETTINGS_ZMS_CACHE_FREE         0
+#define SETTINGS_ZMS_CACHE_REMOVED      ZMS_NAMECNT_ID
+#define SETTINGS_ZMS_CACHE_NEXT(i)      (((i) + 1) % CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE)
+#define SETTINGS_ZMS_CACHE_COMPLETE(cf) ((cf)->loaded && !(cf)->cache_ovfl)
+
+static uint32_t settings_zms_name_hash(const char *name)
+{
+	return sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+}
+
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+/* The subtree index is a trie of the setting names, split at the name separator. Each node
+ * is identified by the hash of the name up to the end of its component and by its parent,
+ * and stored in an open addressing hash table. A node is freed when the last name stored at
+ * it or below it is deleted. Freed nodes are marked as removed, so that lookups of the
+ * nodes added after them still succeed.
+ */
+#define SETTINGS_ZMS_NODE_NONE    UINT16_MAX
+#define SETTINGS_ZMS_NODE_NEXT(i) (((i) + 1) % CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE)
+#define SETTINGS_ZMS_NODE_PREV(i)                                                                 \
+	(((i) + CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE - 1) % CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE)
+#define SETTINGS_ZMS_NODE_FREE(cf, i) (!(cf)->node[i].used && !(cf)->node[i].removed)
+
+static void settings_zms_index_clear(struct settings_zms *cf)
+{
+	memset(cf->node, 0, sizeof(cf->node));
+	cf->index_ovfl = false;
+}
+
+static uint16_t settings_zms_node_get(struct settings_zms *cf, uint32_t hash, uint16_t parent,
+				      bool add)
+{
+	uint16_t i = hash % CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE;
+	uint16_t free_idx = SETTINGS_ZMS_NODE_NONE;
+	typeof(cf->node[0]) *node;
+
+	for (int n = 0; n < CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE;
+	     n++, i = SETTINGS_ZMS_NODE_NEXT(i)) {
+		node = &cf->node[i];
+
+		if (node->used) {
+			if (node->hash == hash && node->parent == parent) {
+				return i;
+			}
+
+			continue;
+		}
+
+		if (free_idx == SETTINGS_ZMS_NODE_NONE) {
+			free_idx = i;
+		}
+
+		if (!node->removed) {
+			break;
+		}
+	}
+
+	if (!add || free_idx == SETTINGS_ZMS_NODE_NONE) {
+		return SETTINGS_ZMS_NODE_NONE;
+	}
+
+	node = &cf->node[free_idx];
+	node->used = true;
+	node->removed = false;
+	node->hash = hash;
+	node->name_id = 0;
+	node->refs = 0;
+	node->parent = parent;
+	node->child = SETTINGS_ZMS_NODE_NONE;
+	if (parent == SETTINGS_ZMS_NODE_NONE) {
+		node->sibling = SETTINGS_ZMS_NODE_NONE;
+	} else {
+		node->sibling = cf->node[parent].child;
+		cf->node[parent].child = free_idx;
+	}
+
+	return free_idx;
+}
+
+static void settings_zms_node_free(struct settings_zms *cf, uint16_t i)
+{
+	uint16_t parent = cf->node[i].parent;
+	uint16_t *link;
+
+	if (parent != SETTINGS_ZMS_NODE_NONE) {
+		link = &cf->node[parent].child;
+		while (*link != i) {
+			link = &cf->node[*link].sibling;
+		}
+
+		*link = cf->node[i].sibling;
+	}
+
+	cf->node[i].used = false;
+	cf->node[i].removed = true;
+
+	/* Removed nodes followed by a free entry do not need to be skipped by lookups */
+	while (cf->node[i].removed && SETTINGS_ZMS_NODE_FREE(cf, SETTINGS_ZMS_NODE_NEXT(i))) {
+		cf->node[i].removed = false;
+		i = SETTINGS_ZMS_NODE_PREV(i);
+	}
+}
+
+/* Find the node of a name, adding the missing nodes on the way if requested */
+static uint16_t settings_zms_node_find(struct settings_zms *cf, const char *name, bool add)
+{
+	size_t len = strnlen(name, SETTINGS_FULL_NAME_LEN);
+	uint16_t node = SETTINGS_ZMS_NODE_NONE;
+
+	for (size_t i = 1; i <= len; i++) {
+		if (i < len && name[i] != SETTINGS_NAME_SEPARATOR) {
+			continue;
+		}
+
+		node = settings_zms_node_get(cf, sys_hash32(name, i), node, add);
+		if (node == SETTINGS_ZMS_NODE_NONE) {
+			break;
+		}
+	}
+
+	return node;
+}
+
+/* Nodes are matched by hash only, so the name stored at a node is read back to make sure
+ * that it is the same name. Names that share a node cannot be indexed, subtree loads then
+ * use a full scan until the index is rebuilt.
+ */
+static void settings_zms_index_add(struct settings_zms *cf, const char *name, uint32_t name_id)
+{
+	char rdname[SETTINGS_FULL_NAME_LEN];
+	uint16_t node;
+	ssize_t rc;
+
+	if (cf->index_ovfl) {
+		return;
+	}
+
+	node = settings_zms_node_find(cf, name, true);
+	if (node == SETTINGS_ZMS_NODE_NONE) {
+		cf->index_ovfl = true;
+		return;
+	}
+
+	if (cf->node[node].name_id == name_id) {
+		return;
+	}
+
+	if (cf->node[node].name_id != 0) {
+		rc = zms_read(&cf->cf_zms, cf->node[node].name_id, &rdname, sizeof(rdname));
+		if (rc > 0) {
+			rdname[rc] = '\0';
+		}
+
+		if ((rc <= 0) || strcmp(name, rdname)) {
+			LOG_DBG("Hash collision in the subtree index, %s", name);
+			cf->index_ovfl = true;
+			return;
+		}
+
+		cf->node[node].name_id = name_id;
+		return;
+	}
+
+	cf->node[node].name_id = name_id;
+
+	for (; node != SETTINGS_ZMS_NODE_NONE; node = cf->node[node].parent) {
+		cf->node[node].refs++;
+	}
+}
+
+static void settings_zms_index_remove(struct settings_zms *cf, const char *name, uint32_t name_id)
+{
+	uint16_t node;
+	uint16_t parent;
+
+	if (cf->index_ovfl) {
+		return;
+	}
+
+	node = settings_zms_node_find(cf, name, false);
+	if (node == SETTINGS_ZMS_NODE_NONE || cf->node[node].name_id != name_id) {
+		return;
+	}
+
+	cf->node[node].name_id = 0;
+
+	/* Free the nodes that no longer lead to a name */
+	for (; node != SETTINGS_ZMS_NODE_NONE; node = parent) {
+		parent = cf->node[node].parent;
+
+		if (--cf->node[node].refs == 0) {
+			settings_zms_node_free(cf, node);
+		}
+	}
+}
+
+/* Load the settings of a subtree, reading only the names in the subtree */
+static int settings_zms_index_load(struct settings_zms *cf, const struct settings_load_arg *arg)
+{
+	struct settings_zms_read_fn_arg read_fn_arg;
+	char name[SETTINGS_FULL_NAME_LEN];
+	uint16_t root = settings_zms_node_find(cf, arg->subtree, false);
+	uint16_t node = root;
+	ssize_t rc1, rc2;
+	int ret;
+
+	while (node != SETTINGS_ZMS_NODE_NONE) {
+		uint32_t name_id = cf->node[node].name_id;
+
+		if (name_id != 0) {
+			rc1 = zms_read(&cf->cf_zms, name_id, &name, sizeof(name));
+			rc2 = zms_get_data_length(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET);
+
+			/* Names that are not stored correctly are cleaned by a full load */
+			if ((rc1 > 0) && (rc2 > 0)) {
+				name[rc1] = '\0';
+				read_fn_arg.fs = &cf->cf_zms;
+				read_fn_arg.id = name_id + ZMS_NAME_ID_OFFSET;
+
+				ret = settings_call_set_handler(name, rc2, settings_zms_read_fn,
+								&read_fn_arg, (void *)arg);
+				if (ret) {
+					return ret;
+				}
+			}
+		}
+
+		/* Depth-first walk of the nodes below the root */
+		if (cf->node[node].child != SETTINGS_ZMS_NODE_NONE) {
+			node = cf->node[node].child;
+			continue;
+		}
+
+		while (node != root && cf->node[node].sibling == SETTINGS_ZMS_NODE_NONE) {
+			node = cf->node[node].parent;
+		}
+
+		node = (node == root) ? SETTINGS_ZMS_NODE_NONE : cf->node[node].sibling;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_ZMS_SUBTREE_INDEX */
+
+static void settings_zms_cache_clear(struct settings_zms *cf)
+{
+	memset(cf->cache, 0, sizeof(cf->cache));
+	cf->cache_total = 0;
+	cf->cache_ovfl = false;
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+	settings_zms_index_clear(cf);
+#endif
+}
 
 static void settings_zms_cache_add(struct settings_zms *cf, const char *name, uint32_t name_id)
 {
-	uint32_t name_hash = sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+	uint32_t name_hash = settings_zms_name_hash(name);
+	uint32_t i = name_hash % CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE;
+	int free_idx = -1;
+
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+	settings_zms_index_add(cf, name, name_id);
+#endif
+
+	for (int n = 0; n < CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE; n++, i = SETTINGS_ZMS_CACHE_NEXT(i)) {
+		if (cf->cache[i].name_id == name_id) {
+			/* Already cached */
+			return;
+		}
+
+		if (cf->cache[i].name_id <= ZMS_NAMECNT_ID && free_idx < 0) {
+			free_idx = i;
+		}
+
+		if (cf->cache[i].name_id == SETTINGS_ZMS_CACHE_FREE) {
+			break;
+		}
+	}
+
+	if (free_idx < 0) {
+		cf->cache_ovfl = true;
+		return;
+	}
+
+	cf->cache[free_idx].name_hash = name_hash;
+	cf->cache[free_idx].name_id = name_id;
+	cf->cache_total++;
+}
+
+static void settings_zms_cache_remove(struct settings_zms *cf, const char *name, uint32_t name_id)
+{
+	uint32_t i = settings_zms_name_hash(name) % CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE;
+
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+	settings_zms_index_remove(cf, name, name_id);
+#endif
 
-	cf->cache[cf->cache_next].name_hash = name_hash;
-	cf->cache[cf->cache_next++].name_id = name_id;
+	for (int n = 0; n < CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE; n++, i = SETTINGS_ZMS_CACHE_NEXT(i)) {
+		if (cf->cache[i].name_id == SETTINGS_ZMS_CACHE_FREE) {
+			return;
+		}
 
-	cf->cache_next %= CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE;
+		if (cf->cache[i].name_id == name_id) {
+			cf->cache[i].name_id = SETTINGS_ZMS_CACHE_REMOVED;
+			cf->cache_total--;
+			return;
+		}
+	}
 }
 
 static uint32_t settings_zms_cache_match(struct settings_zms *cf, const char *name, char *rdname,
 					 size_t len)
 {
-	uint32_t name_hash = sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+	uint32_t name_hash = settings_zms_name_hash(name);
+	uint32_t i = name_hash % CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE;
 	int rc;
 
-	for (int i = 0; i < CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE; i++) {
+	for (int n = 0; n < CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE; n++, i = SETTINGS_ZMS_CACHE_NEXT(i)) {
+		if (cf->cache[i].name_id == SETTINGS_ZMS_CACHE_FREE) {
+			break;
+		}
+
 		if (cf->cache[i].name_hash != name_hash) {
 			continue;
 		}
@@ -107,6 +413,27 @@ static uint32_t settings_zms_cache_match(struct settings_zms *cf, const char *na
 
 	return ZMS_NAMECNT_ID;
 }
+
+/* Add all names in ZMS to the cache, so that lookups do not have to scan ZMS */
+static void settings_zms_cache_build(struct settings_zms *cf)
+{
+	char name[SETTINGS_FULL_NAME_LEN];
+	ssize_t rc;
+
+	settings_zms_cache_clear(cf);
+
+	for (uint32_t name_id = cf->last_name_id; name_id > ZMS_NAMECNT_ID; name_id--) {
+		rc = zms_read(&cf->cf_zms, name_id, &name, sizeof(name));
+		if (rc <= 0) {
+			continue;
+		}
+
+		name[rc] = '\0';
+		settings_zms_cache_add(cf, name, name_id);
+	}
+
+	cf->loaded = true;
+}
 #endif /* CONFIG_SETTINGS_ZMS_NAME_CACHE */
 
 static int settings_zms_load(struct settings_store *cs, const struct settings_load_arg *arg)
@@ -118,10 +445,15 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 	ssize_t rc1, rc2;
 	uint32_t name_id = ZMS_NAMECNT_ID;
 
-#if CONFIG_SETTINGS_ZMS_NAME_CACHE
-	uint32_t cached = 0;
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+	if (arg && arg->subtree && SETTINGS_ZMS_CACHE_COMPLETE(cf) && !cf->index_ovfl) {
+		return settings_zms_index_load(cf, arg);
+	}
+#endif
 
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
 	cf->loaded = false;
+	settings_zms_cache_clear(cf);
 #endif
 
 	name_id = cf->last_name_id + 1;
@@ -132,7 +464,6 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		if (name_id == ZMS_NAMECNT_ID) {
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
 			cf->loaded = true;
-			cf->cache_total = cached;
 #endif
 			break;
 		}
@@ -185,7 +516,6 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
 		settings_zms_cache_add(cf, name, name_id);
-		cached++;
 #endif
 
 		ret = settings_call_set_handler(name, rc2, settings_zms_read_fn, &read_fn_arg,
@@ -197,112 +527,147 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 	return ret;
 }
 
-static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
-			     size_t val_len)
+/* Find the name ID of a setting. If the setting is not found, ZMS_NAMECNT_ID is
+ * returned and free_id is set to the ID to store a new setting with.
+ */
+static uint32_t settings_zms_name_id_find(struct settings_zms *cf, const char *name,
+					  uint32_t *free_id)
 {
-	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
 	char rdname[SETTINGS_FULL_NAME_LEN];
-	uint32_t name_id, write_name_id;
-	bool delete, write_name;
-	int rc = 0;
-
-	if (!name) {
-		return -EINVAL;
-	}
+	uint32_t name_id;
+	int rc;
 
-	/* Find out if we are doing a delete */
-	delete = ((value == NULL) || (val_len == 0));
+	*free_id = cf->last_name_id + 1;
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-	bool name_in_cache = false;
-
-	name_id = settings_zms_cache_match(cf, name, rdname, sizeof(rdname));
-	if (name_id != ZMS_NAMECNT_ID) {
-		write_name_id = name_id;
-		write_name = false;
-		name_in_cache = true;
-		goto found;
+	if (!cf->loaded) {
+		settings_zms_cache_build(cf);
 	}
-#endif
 
-	/* No entry with "name" is in cache, let's find if it exists in the storage */
-	name_id = cf->last_name_id + 1;
-	write_name_id = cf->last_name_id + 1;
-	write_name = true;
+	name_id = settings_zms_cache_match(cf, name, rdname, sizeof(rdname));
 
-#if CONFIG_SETTINGS_ZMS_NAME_CACHE
 	/* We can skip reading ZMS if we know that the cache wasn't overflowed. */
-	if (cf->loaded && !SETTINGS_ZMS_CACHE_OVFL(cf)) {
-		goto found;
+	if (name_id != ZMS_NAMECNT_ID || SETTINGS_ZMS_CACHE_COMPLETE(cf)) {
+		return name_id;
 	}
 #endif
 
 	/* Let's find if we already have an ID within storage */
-	while (1) {
-		name_id--;
-		if (name_id == ZMS_NAMECNT_ID) {
-			break;
-		}
-
+	for (name_id = cf->last_name_id; name_id > ZMS_NAMECNT_ID; name_id--) {
 		rc = zms_read(&cf->cf_zms, name_id, &rdname, sizeof(rdname));
 
 		if (rc < 0) {
 			/* Error or entry not found */
 			if (rc == -ENOENT) {
 				/* This is a free ID let's keep it */
-				write_name_id = name_id;
+				*free_id = name_id;
 			}
 			continue;
 		}
 
 		rdname[rc] = '\0';
 
-		if (strcmp(name, rdname)) {
-			/* ID exists but the name is different, that's not the ID
-			 * we are looking for.
-			 */
-			continue;
+		if (!strcmp(name, rdname)) {
+			return name_id;
 		}
+	}
+
+	return ZMS_NAMECNT_ID;
+}
+
+static int settings_zms_last_name_id_write(struct settings_zms *cf)
+{
+	int rc;
 
-		/* At this step we found the ID that corresponds to name */
-		if (!delete) {
-			write_name_id = name_id;
-			write_name = false;
+	rc = zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id, sizeof(uint32_t));
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int settings_zms_entry_delete(struct settings_zms *cf, const char *name, uint32_t name_id)
+{
+	int rc;
+
+	rc = zms_delete(&cf->cf_zms, name_id);
+	if (rc >= 0) {
+		rc = zms_delete(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET);
+	}
+
+	if (rc < 0) {
+		return rc;
+	}
+
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	settings_zms_cache_remove(cf, name, name_id);
+#endif
+
+	return 0;
+}
+
+/* Write the value and, for a new setting, the name. The largest name ID in use must
+ * already cover name_id.
+ */
+static int settings_zms_entry_write(struct settings_zms *cf, const char *name, uint32_t name_id,
+				    bool write_name, const void *value, size_t val_len)
+{
+	int rc;
+
+	/* write the value */
+	rc = zms_write(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET, value, val_len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* write the name if required */
+	if (write_name) {
+		rc = zms_write(&cf->cf_zms, name_id, name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+		if (rc < 0) {
+			return rc;
 		}
 
-		goto found;
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+		settings_zms_cache_add(cf, name, name_id);
+#endif
 	}
 
-found:
+	return 0;
+}
+
+static int settings_zms_save_direct(struct settings_zms *cf, const char *name, const char *value,
+				    size_t val_len)
+{
+	uint32_t name_id, write_name_id;
+	bool delete;
+	int rc;
+
+	/* Find out if we are doing a delete */
+	delete = ((value == NULL) || (val_len == 0));
+
+	name_id = settings_zms_name_id_find(cf, name, &write_name_id);
+
 	if (delete) {
 		if (name_id == ZMS_NAMECNT_ID) {
 			return 0;
 		}
 
-		rc = zms_delete(&cf->cf_zms, name_id);
-		if (rc >= 0) {
-			rc = zms_delete(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET);
-		}
-
+		rc = settings_zms_entry_delete(cf, name, name_id);
 		if (rc < 0) {
 			return rc;
 		}
 
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
-			rc = zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id,
-				       sizeof(uint32_t));
-			if (rc < 0) {
-				/* Error: can't to store
-				 * the largest name ID in use.
-				 */
-				return rc;
-			}
+			/* Error: can't to store the largest name ID in use. */
+			return settings_zms_last_name_id_write(cf);
 		}
 
 		return 0;
 	}
 
+	if (name_id != ZMS_NAMECNT_ID) {
+		return settings_zms_entry_write(cf, name, name_id, false, value, val_len);
+	}
+
 	/* No free IDs left. */
 	if (write_name_id == ZMS_NAMECNT_ID + ZMS_NAME_ID_OFFSET - 1) {
 		return -ENOMEM;
@@ -311,39 +676,236 @@ found:
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
 		cf->last_name_id = write_name_id;
-		rc = zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id, sizeof(uint32_t));
+		rc = settings_zms_last_name_id_write(cf);
 		if (rc < 0) {
 			return rc;
 		}
 	}
 
-	/* write the value */
-	rc = zms_write(&cf->cf_zms, write_name_id + ZMS_NAME_ID_OFFSET, value, val_len);
-	if (rc < 0) {
-		return rc;
+	return settings_zms_entry_write(cf, name, write_name_id, true, value, val_len);
+}
+
+#if CONFIG_SETTINGS_ZMS_BATCH
+#define SETTINGS_ZMS_BATCH_NAME(cf, e) ((const char *)&(cf)->batch.buf[(e)->name_off])
+#define SETTINGS_ZMS_BATCH_VAL(cf, e)  (&(cf)->batch.buf[(e)->val_off])
+
+static struct settings_zms *settings_zms_dst_get(void)
+{
+	void *storage = NULL;
+
+	if (settings_storage_get(&storage) || storage == NULL) {
+		return NULL;
 	}
 
-	/* write the name if required */
-	if (write_name) {
-		rc = zms_write(&cf->cf_zms, write_name_id, name,
-			       strnlen(name, SETTINGS_FULL_NAME_LEN));
+	return CONTAINER_OF(storage, struct settings_zms, cf_zms);
+}
+
+/* Write all saves of the batch to ZMS and empty the batch, which stays active. */
+static int settings_zms_batch_flush(struct settings_zms *cf)
+{
+	uint32_t prev_last_name_id = cf->last_name_id;
+	uint32_t last_name_id = cf->last_name_id;
+	uint32_t free_id;
+	bool top_deleted = false;
+	int rc = 0;
+
+	/* Look up all names first, so that the largest name ID in use is written once.
+	 * New settings are stored after the largest name ID in use.
+	 */
+	for (uint32_t i = 0; i < cf->batch.entry_count; i++) {
+		typeof(cf->batch.entry[0]) *e = &cf->batch.entry[i];
+
+		e->name_id = settings_zms_name_id_find(cf, SETTINGS_ZMS_BATCH_NAME(cf, e),
+						       &free_id);
+		if (e->name_id != ZMS_NAMECNT_ID || e->val_len == 0) {
+			continue;
+		}
+
+		/* No free IDs left. */
+		if (last_name_id == ZMS_NAMECNT_ID + ZMS_NAME_ID_OFFSET - 2) {
+			rc = -ENOMEM;
+			goto exit;
+		}
+
+		e->name_id = ++last_name_id;
+	}
+
+	if (last_name_id > cf->last_name_id) {
+		cf->last_name_id = last_name_id;
+		rc = settings_zms_last_name_id_write(cf);
+		if (rc < 0) {
+			goto exit;
+		}
+	}
+
+	for (uint32_t i = 0; i < cf->batch.entry_count; i++) {
+		typeof(cf->batch.entry[0]) *e = &cf->batch.entry[i];
+		const char *name = SETTINGS_ZMS_BATCH_NAME(cf, e);
+
+		if (e->name_id == ZMS_NAMECNT_ID) {
+			/* Delete of a setting that is not stored */
+			continue;
+		}
+
+		if (e->val_len == 0) {
+			rc = settings_zms_entry_delete(cf, name, e->name_id);
+			top_deleted |= (e->name_id == cf->last_name_id);
+		} else {
+			/* The names of new settings must be written */
+			rc = settings_zms_entry_write(cf, name, e->name_id,
+						      e->name_id > prev_last_name_id,
+						      SETTINGS_ZMS_BATCH_VAL(cf, e), e->val_len);
+		}
+
+		if (rc < 0) {
+			goto exit;
+		}
+	}
+
+	if (top_deleted) {
+		cf->last_name_id--;
+		rc = settings_zms_last_name_id_write(cf);
+	}
+
+exit:
+	cf->batch.entry_count = 0;
+	cf->batch.buf_used = 0;
+
+	return rc;
+}
+
+static int settings_zms_batch_add(struct settings_zms *cf, const char *name, const char *value,
+				  size_t val_len)
+{
+	typeof(cf->batch.entry[0]) *e = NULL;
+	size_t name_len = strnlen(name, SETTINGS_FULL_NAME_LEN - 1) + 1;
+	int rc;
+
+	/* A delete is kept as an entry without a value */
+	if (value == NULL) {
+		val_len = 0;
+	}
+
+	if (name_len + val_len > sizeof(cf->batch.buf)) {
+		rc = settings_zms_batch_flush(cf);
 		if (rc < 0) {
 			return rc;
 		}
+
+		return settings_zms_save_direct(cf, name, value, val_len);
 	}
 
-#if CONFIG_SETTINGS_ZMS_NAME_CACHE
-	if (!name_in_cache) {
-		settings_zms_cache_add(cf, name, write_name_id);
-		if (cf->loaded && !SETTINGS_ZMS_CACHE_OVFL(cf)) {
-			cf->cache_total++;
+	for (uint32_t i = 0; i < cf->batch.entry_count; i++) {
+		if (!strncmp(SETTINGS_ZMS_BATCH_NAME(cf, &cf->batch.entry[i]), name, name_len)) {
+			e = &cf->batch.entry[i];
+			break;
 		}
 	}
-#endif
+
+	if (e && val_len <= e->val_size) {
+		/* Replace the earlier save of the same name in place */
+		if (val_len) {
+			memcpy(SETTINGS_ZMS_BATCH_VAL(cf, e), value, val_len);
+		}
+		e->val_len = val_len;
+		return 0;
+	}
+
+	if ((!e && cf->batch.entry_count == ARRAY_SIZE(cf->batch.entry)) ||
+	    cf->batch.buf_used + (e ? 0 : name_len) + val_len > sizeof(cf->batch.buf)) {
+		rc = settings_zms_batch_flush(cf);
+		if (rc < 0) {
+			return rc;
+		}
+
+		e = NULL;
+	}
+
+	if (!e) {
+		e = &cf->batch.entry[cf->batch.entry_count++];
+		e->name_off = cf->batch.buf_used;
+		memcpy(&cf->batch.buf[cf->batch.buf_used], name, name_len - 1);
+		cf->batch.buf[cf->batch.buf_used + name_len - 1] = '\0';
+		cf->batch.buf_used += name_len;
+	}
+
+	e->val_off = cf->batch.buf_used;
+	e->val_len = val_len;
+	e->val_size = val_len;
+	if (val_len) {
+		memcpy(SETTINGS_ZMS_BATCH_VAL(cf, e), value, val_len);
+	}
+	cf->batch.buf_used += val_len;
 
 	return 0;
 }
 
+int settings_zms_batch_begin(void)
+{
+	struct settings_zms *cf = settings_zms_dst_get();
+	int rc = 0;
+
+	if (!cf) {
+		return -ENOENT;
+	}
+
+	settings_lock_take();
+
+	if (cf->batch.active) {
+		rc = -EALREADY;
+	} else {
+		cf->batch.entry_count = 0;
+		cf->batch.buf_used = 0;
+		cf->batch.active = true;
+	}
+
+	settings_lock_release();
+
+	return rc;
+}
+
+int settings_zms_batch_commit(void)
+{
+	struct settings_zms *cf = settings_zms_dst_get();
+	int rc;
+
+	if (!cf) {
+		return -ENOENT;
+	}
+
+	settings_lock_take();
+
+	if (!cf->batch.active) {
+		rc = -EINVAL;
+	} else {
+		rc = settings_zms_batch_flush(cf);
+		cf->batch.active = false;
+	}
+
+	settings_lock_release();
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_ZMS_BATCH */
+
+static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
+			     size_t val_len)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+#if CONFIG_SETTINGS_ZMS_BATCH
+	if (cf->batch.active) {
+		return settings_zms_batch_add(cf, name, value, val_len);
+	}
+#endif
+
+	return settings_zms_save_direct(cf, name, value, val_len);
+}
+
 /* Initialize the zms backend. */
 int settings_zms_backend_init(struct settings_zms *cf)
 {
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <mbedtls/platform_util.h>
+
+#include "aead_key.h"
+
+/*
+ * Cache of derived AEAD keys.
+ *
+ * Deriving a key is done for every access to an asset. The most recently used keys are kept
+ * in RAM instead, and zeroized when evicted.
+ */
+
+struct key_cache_entry {
+	psa_storage_uid_t uid;
+	uint32_t last_used;
+	bool valid;
+	uint8_t key[AEAD_KEY_SIZE];
+};
+
+static struct key_cache_entry key_cache[CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_SIZE];
+static uint32_t use_counter;
+static K_MUTEX_DEFINE(key_cache_lock);
+
+static void key_cache_entry_clear(struct key_cache_entry *entry)
+{
+	mbedtls_platform_zeroize(entry, sizeof(*entry));
+}
+
+psa_status_t trusted_storage_get_key_cached(psa_storage_uid_t uid, uint8_t *key_buf,
+					    size_t key_length)
+{
+	struct key_cache_entry *entry = NULL;
+	psa_status_t status = PSA_SUCCESS;
+
+	if (key_length < AEAD_KEY_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	k_mutex_lock(&key_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].valid && key_cache[i].uid == uid) {
+			entry = &key_cache[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		/* Use a free entry or the least recently used one */
+		entry = &key_cache[0];
+
+		for (int i = 1; i < ARRAY_SIZE(key_cache) && entry->valid; i++) {
+			if (!key_cache[i].valid ||
+			    (use_counter - key_cache[i].last_used) >
+				    (use_counter - entry->last_used)) {
+				entry = &key_cache[i];
+			}
+		}
+
+		key_cache_entry_clear(entry);
+
+		status = trusted_storage_get_key(uid, entry->key, sizeof(entry->key));
+		if (status != PSA_SUCCESS) {
+			key_cache_entry_clear(entry);
+			goto exit;
+		}
+
+		entry->uid = uid;
+		entry->valid = true;
+	}
+
+	entry->last_used = ++use_counter;
+	memcpy(key_buf, entry->key, AEAD_KEY_SIZE);
+
+exit:
+	k_mutex_unlock(&key_cache_lock);
+
+	return status;
+}
+
+void trusted_storage_key_cache_evict(psa_storage_uid_t uid)
+{
+	k_mutex_lock(&key_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].valid && key_cache[i].uid == uid) {
+			key_cache_entry_clear(&key_cache[i]);
+		}
+	}
+
+	k_mutex_unlock(&key_cache_lock);
+}
@@ -0,0 +1,593 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <mbedtls/platform_util.h>
+LOG_MODULE_REGISTER(internal_trusted_aead_chunked, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
+
+#include <string.h>
+
+#include "../trusted_storage_backend.h"
+#include "../storage_backend.h"
+#include "aead_key.h"
+#include "aead_nonce.h"
+#include "aead_crypt.h"
+
+/*
+ * Chunked AEAD based Authenticated Encrypted trust implementation
+ *
+ * An asset is stored as a header object and a number of data chunks:
+ * - The header holds the flags, size, capacity and the nonce of each data chunk. It is
+ *   authenticated together with the UID by a tag over an empty plaintext.
+ * - Each data chunk is encrypted separately with the UID, chunk index and chunk length as
+ *   additional data. The tag is left at the end of the chunk.
+ * - A chunk is decrypted with the nonce recorded in the header, so a chunk cannot be replaced
+ *   by an older version of itself without the header.
+ * - Each chunk has two storage locations. Writes go to the location not in use and the header
+ *   is written last, so an interrupted write leaves the previous version of the asset intact.
+ *
+ * Reading or writing part of an asset only decrypts, encrypts and accesses the chunks involved.
+ */
+
+#define AEAD_NONCE_SIZE 12
+#define AEAD_TAG_SIZE	16
+
+#define STORAGE_MAX_ASSET_SIZE CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE
+#define CHUNK_SIZE	       CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE
+#define CHUNK_COUNT	       DIV_ROUND_UP(STORAGE_MAX_ASSET_SIZE, CHUNK_SIZE)
+
+/* Storage chunk 0 is the header, data chunk n is stored as chunk 1 + n or 1 + CHUNK_COUNT + n */
+BUILD_ASSERT(2 * CHUNK_COUNT < UINT8_MAX,
+	     "Too many chunks, increase CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE");
+
+#define INVALID_UID 0U
+
+/** Header of stored object. Authenticated, but not encrypted. */
+typedef struct chunked_object_header {
+	psa_storage_create_flags_t create_flags;
+	uint32_t data_size;
+	uint32_t capacity;
+	/* Storage location in use for each chunk, one bit per chunk */
+	uint8_t chunk_bank[DIV_ROUND_UP(CHUNK_COUNT, 8)];
+	uint8_t chunk_nonce[CHUNK_COUNT][AEAD_NONCE_SIZE];
+	uint8_t nonce[AEAD_NONCE_SIZE];
+} chunked_object_header;
+
+typedef struct chunked_object {
+	chunked_object_header header;
+	uint8_t tag[AEAD_TAG_SIZE];
+} chunked_object;
+
+/** Additional data of the header. */
+typedef struct header_add_data {
+	psa_storage_uid_t uid;
+	chunked_object_header header;
+} header_add_data;
+
+/** Additional data of a chunk. */
+typedef struct chunk_add_data {
+	psa_storage_uid_t uid;
+	uint32_t chunk;
+	uint32_t length;
+} chunk_add_data;
+
+static size_t chunk_length(size_t data_size, size_t chunk)
+{
+	size_t start = chunk * CHUNK_SIZE;
+
+	return (data_size > start) ? MIN(CHUNK_SIZE, data_size - start) : 0;
+}
+
+static uint8_t chunk_location(const uint8_t *chunk_bank, size_t chunk)
+{
+	bool bank = chunk_bank[chunk / 8] & BIT(chunk % 8);
+
+	return 1 + chunk + (bank ? CHUNK_COUNT : 0);
+}
+
+static psa_status_t header_tag_compute(const psa_storage_uid_t uid, const uint8_t *key_buf,
+				       chunked_object *object, bool verify)
+{
+	psa_status_t status;
+	header_add_data add_data;
+	size_t out_length;
+	uint8_t unused;
+
+	memset(&add_data, 0, sizeof(add_data));
+	add_data.uid = uid;
+	memcpy(&add_data.header, &object->header, sizeof(add_data.header));
+
+	if (verify) {
+		status = trusted_storage_aead_decrypt(
+			key_buf, AEAD_KEY_SIZE, object->header.nonce, AEAD_NONCE_SIZE, &add_data,
+			sizeof(add_data), object->tag, AEAD_TAG_SIZE, &unused, 0, &out_length);
+	} else {
+		status = trusted_storage_aead_encrypt(
+			key_buf, AEAD_KEY_SIZE, object->header.nonce, AEAD_NONCE_SIZE, &add_data,
+			sizeof(add_data), NULL, 0, object->tag, AEAD_TAG_SIZE, &out_length);
+		if (status == PSA_SUCCESS && out_length != AEAD_TAG_SIZE) {
+			status = PSA_ERROR_CORRUPTION_DETECTED;
+		}
+	}
+
+	return status;
+}
+
+/* Reads the header, and authenticates it if a key is given. */
+static psa_status_t header_read(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, chunked_object *object)
+{
+	psa_status_t status;
+	size_t out_length;
+
+	status = storage_get_object(uid, prefix, object, sizeof(*object), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length != sizeof(*object)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if (key_buf == NULL) {
+		return PSA_SUCCESS;
+	}
+
+	return header_tag_compute(uid, key_buf, object, true);
+}
+
+static psa_status_t header_write(const psa_storage_uid_t uid, const char *prefix,
+				 const uint8_t *key_buf, chunked_object *object)
+{
+	psa_status_t status;
+
+	status = trusted_storage_get_nonce(object->header.nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = header_tag_compute(uid, key_buf, object, false);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return storage_set_object(uid, prefix, object, sizeof(*object));
+}
+
+static psa_status_t chunk_read(const psa_storage_uid_t uid, const char *prefix,
+			       const uint8_t *key_buf, const chunked_object_header *header,
+			       size_t chunk, uint8_t *p_data)
+{
+	psa_status_t status;
+	uint8_t buf[CHUNK_SIZE + AEAD_TAG_SIZE];
+	chunk_add_data add_data = {
+		.uid = uid,
+		.chunk = chunk,
+		.length = chunk_length(header->data_size, chunk),
+	};
+	size_t out_length;
+
+	status = storage_get_object_chunk(uid, prefix, chunk_location(header->chunk_bank, chunk),
+					  buf, sizeof(buf), &out_length);
+	if (status == PSA_ERROR_DOES_NOT_EXIST) {
+		/* The header refers to this chunk */
+		return PSA_ERROR_DATA_CORRUPT;
+	} else if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length != add_data.length + AEAD_TAG_SIZE) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	return trusted_storage_aead_decrypt(key_buf, AEAD_KEY_SIZE, header->chunk_nonce[chunk],
+					    AEAD_NONCE_SIZE, &add_data, sizeof(add_data), buf,
+					    out_length, p_data, CHUNK_SIZE, &out_length);
+}
+
+/* Writes a chunk to its unused location and records the location and nonce in the header. */
+static psa_status_t chunk_write(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, chunked_object_header *header,
+				size_t chunk, const uint8_t *p_data, size_t data_length)
+{
+	psa_status_t status;
+	uint8_t buf[CHUNK_SIZE + AEAD_TAG_SIZE];
+	chunk_add_data add_data = {
+		.uid = uid,
+		.chunk = chunk,
+		.length = data_length,
+	};
+	size_t out_length;
+
+	status = trusted_storage_get_nonce(header->chunk_nonce[chunk], AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, header->chunk_nonce[chunk],
+					      AEAD_NONCE_SIZE, &add_data, sizeof(add_data), p_data,
+					      data_length, buf, sizeof(buf), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	header->chunk_bank[chunk / 8] ^= BIT(chunk % 8);
+
+	return storage_set_object_chunk(uid, prefix, chunk_location(header->chunk_bank, chunk),
+					buf, out_length);
+}
+
+/*
+ * Writes data to the asset, reading back the chunks that are only partially overwritten,
+ * then commits the new header. The previous locations of the rewritten chunks are removed.
+ */
+static psa_status_t object_write(const psa_storage_uid_t uid, const char *prefix,
+				 const uint8_t *key_buf, chunked_object *object,
+				 size_t data_offset, size_t data_length, const uint8_t *p_data)
+{
+	psa_status_t status = PSA_SUCCESS;
+	chunked_object_header *header = &object->header;
+	uint8_t old_bank[sizeof(header->chunk_bank)];
+	uint8_t plain[CHUNK_SIZE];
+	size_t data_end = data_offset + data_length;
+	size_t new_size = MAX(header->data_size, data_end);
+	size_t first = data_offset / CHUNK_SIZE;
+	size_t last = DIV_ROUND_UP(data_end, CHUNK_SIZE);
+
+	memcpy(old_bank, header->chunk_bank, sizeof(old_bank));
+
+	for (size_t i = first; i < last; i++) {
+		size_t chunk_start = i * CHUNK_SIZE;
+		size_t old_length = chunk_length(header->data_size, i);
+		size_t from = MAX(chunk_start, data_offset);
+		size_t to = MIN(chunk_start + CHUNK_SIZE, data_end);
+
+		/* Keep the existing data of the chunk that is not overwritten */
+		if (old_length > 0 && (from > chunk_start || to < chunk_start + old_length)) {
+			status = chunk_read(uid, prefix, key_buf, header, i, plain);
+			if (status != PSA_SUCCESS) {
+				goto cleanup;
+			}
+		}
+
+		memcpy(plain + (from - chunk_start), p_data + (from - data_offset), to - from);
+
+		status = chunk_write(uid, prefix, key_buf, header, i, plain,
+				     chunk_length(new_size, i));
+		if (status != PSA_SUCCESS) {
+			goto cleanup;
+		}
+	}
+
+	header->data_size = new_size;
+
+	status = header_write(uid, prefix, key_buf, object);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	for (size_t i = first; i < last; i++) {
+		(void)storage_remove_object_chunk(uid, prefix, chunk_location(old_bank, i));
+	}
+
+cleanup:
+	mbedtls_platform_zeroize(plain, sizeof(plain));
+
+	return status;
+}
+
+/* Removes the chunks from the given one to the end of the asset. */
+static void object_chunks_remove(const psa_storage_uid_t uid, const char *prefix,
+				 const chunked_object_header *header, size_t first)
+{
+	/* The header may not be authenticated here */
+	size_t count = MIN(DIV_ROUND_UP(header->data_size, CHUNK_SIZE), CHUNK_COUNT);
+
+	for (size_t i = first; i < count; i++) {
+		(void)storage_remove_object_chunk(uid, prefix, chunk_location(header->chunk_bank, i));
+	}
+}
+
+psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
+			      struct psa_storage_info_t *p_info)
+{
+	psa_status_t status;
+	chunked_object object;
+
+	if (p_info == NULL || uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get size & flags */
+	status = header_read(uid, prefix, NULL, &object);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	p_info->capacity = object.header.capacity;
+	p_info->size = object.header.data_size;
+	p_info->flags = object.header.create_flags;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t data_offset,
+			 size_t data_length, void *p_data, size_t *p_data_length)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t plain[CHUNK_SIZE];
+	chunked_object object;
+	size_t out_length;
+	size_t data_end;
+
+	if ((p_data == NULL && data_length != 0) || p_data_length == NULL || uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (data_length == 0) {
+		*p_data_length = 0;
+		return PSA_SUCCESS;
+	}
+
+	if ((data_offset + data_length) > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = header_read(uid, prefix, key_buf, &object);
+	if (status != PSA_SUCCESS) {
+		goto clean_up;
+	}
+
+	if (data_offset > object.header.data_size) {
+		*p_data_length = 0;
+		status = PSA_ERROR_INVALID_ARGUMENT;
+		goto clean_up;
+	}
+
+	out_length = MIN(data_length, object.header.data_size - data_offset);
+	data_end = data_offset + out_length;
+
+	/* Only decrypt the chunks overlapping the requested range */
+	for (size_t i = data_offset / CHUNK_SIZE; i < DIV_ROUND_UP(data_end, CHUNK_SIZE); i++) {
+		size_t chunk_start = i * CHUNK_SIZE;
+		size_t from = MAX(chunk_start, data_offset);
+		size_t to = MIN(chunk_start + CHUNK_SIZE, data_end);
+
+		status = chunk_read(uid, prefix, key_buf, &object.header, i, plain);
+		if (status != PSA_SUCCESS) {
+			goto clean_up;
+		}
+
+		memcpy((uint8_t *)p_data + (from - data_offset), plain + (from - chunk_start),
+		       to - from);
+	}
+
+	*p_data_length = out_length;
+
+clean_up:
+	/* Clean up */
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(plain, sizeof(plain));
+
+	return status;
+}
+
+psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t data_length,
+			 const void *p_data, psa_storage_create_flags_t create_flags)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	chunked_object object;
+	chunked_object_header old_header;
+	bool exists;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE && create_flags != PSA_STORAGE_FLAG_WRITE_ONCE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (data_length > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get flags */
+	status = header_read(uid, prefix, NULL, &object);
+	if (status != PSA_SUCCESS && status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	exists = (status == PSA_SUCCESS);
+
+	/* Do not allow to write new values if WRITE_ONCE flag is set */
+	if (exists && (object.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	if (exists) {
+		old_header = object.header;
+	} else {
+		memset(&old_header, 0, sizeof(old_header));
+	}
+
+	/* Start from an empty asset, writing the chunks to the locations not in use */
+	memset(&object, 0, sizeof(object));
+	memcpy(object.header.chunk_bank, old_header.chunk_bank, sizeof(old_header.chunk_bank));
+	object.header.create_flags = create_flags;
+	object.header.capacity = data_length;
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	status = object_write(uid, prefix, key_buf, &object, 0, data_length, p_data);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	/* Remove the chunks of a previous, larger version of the asset */
+	object_chunks_remove(uid, prefix, &old_header, DIV_ROUND_UP(data_length, CHUNK_SIZE));
+
+cleanup:
+	if (status != PSA_SUCCESS) {
+		LOG_DBG("trusted_set failed. status %d", status);
+	}
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+
+psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	chunked_object object;
+
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get flags */
+	status = header_read(uid, prefix, NULL, &object);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if ((object.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	trusted_storage_key_cache_evict(uid);
+
+	object_chunks_remove(uid, prefix, &object.header, 0);
+
+	return storage_remove_object(uid, prefix);
+}
+
+uint32_t trusted_get_support(void)
+{
+	return PSA_STORAGE_SUPPORT_SET_EXTENDED;
+}
+
+#if defined(CONFIG_PSA_PROTECTED_STORAGE)
+psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+			    psa_storage_create_flags_t create_flags)
+{
+	const char *prefix = CONFIG_PSA_PROTECTED_STORAGE_PREFIX;
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	chunked_object object;
+
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (capacity > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	status = header_read(uid, prefix, NULL, &object);
+	if (status == PSA_SUCCESS) {
+		return PSA_ERROR_ALREADY_EXISTS;
+	} else if (status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	memset(&object, 0, sizeof(object));
+	object.header.create_flags = create_flags;
+	object.header.capacity = capacity;
+
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status == PSA_SUCCESS) {
+		status = header_write(uid, prefix, key_buf, &object);
+	}
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
+				  size_t data_length, const void *p_data)
+{
+	const char *prefix = CONFIG_PSA_PROTECTED_STORAGE_PREFIX;
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	chunked_object object;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = header_read(uid, prefix, key_buf, &object);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	if ((object.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		status = PSA_ERROR_NOT_PERMITTED;
+		goto cleanup;
+	}
+
+	/* Writes may extend the asset up to its capacity, but not leave a gap */
+	if (data_offset > object.header.data_size ||
+	    data_length > object.header.capacity - data_offset) {
+		status = PSA_ERROR_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	if (data_length == 0) {
+		goto cleanup;
+	}
+
+	status = object_write(uid, prefix, key_buf, &object, data_offset, data_length, p_data);
+
+cleanup:
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+#else
+psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+			    psa_storage_create_flags_t create_flags)
+{
+	ARG_UNUSED(uid);
+	ARG_UNUSED(capacity);
+	ARG_UNUSED(create_flags);
+	return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
+				  size_t data_length, const void *p_data)
+{
+	ARG_UNUSED(uid);
+	ARG_UNUSED(data_offset);
+	ARG_UNUSED(data_length);
+	ARG_UNUSED(p_data);
+	return PSA_ERROR_NOT_SUPPORTED;
+}
+#endif /* CONFIG_PSA_PROTECTED_STORAGE */
@@ -21,4 +21,23 @@ psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
 /* Deletes an object */
 psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix);
 
+/*
+ * Chunk access, used by backends that store an asset as several objects under one UID.
+ * Chunk 0 is the object accessed by the functions above.
+ */
+
+/* Gets a chunk of an object up to object_size size */
+psa_status_t storage_get_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, void *object_data, const size_t object_size,
+				      size_t *object_length);
+
+/* Writes a chunk of an object */
+psa_status_t storage_set_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, const void *object_data,
+				      const size_t object_size);
+
+/* Deletes a chunk of an object */
+psa_status_t storage_remove_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+					 uint8_t chunk);
+
 #endif /* __STORAGE_BACKEND_H_*/
@@ -19,6 +19,10 @@ LOG_MODULE_REGISTER(internal_trusted_storage_settings, CONFIG_TRUSTED_STORAGE_LO
 /* Storage pattern: prefix, uid low, uid high, suffix */
 #define TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_PATTERN "%s/%08x%08x"
 
+/* Chunks other than chunk 0 are stored as children of the object */
+#define TRUSTED_STORAGE_SETTINGS_BACKEND_CHUNK_PATTERN \
+	TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_PATTERN "/%x"
+
 /* Max filename length aligned with Settings File backend max length */
 #define TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH 32
 
@@ -30,12 +34,20 @@ struct load_object_info {
 
 /* Helper to fill filename with a suffix */
 static psa_status_t create_filename(char *filename, const size_t filename_size, const char *prefix,
-				    const psa_storage_uid_t uid)
+				    const psa_storage_uid_t uid, uint8_t chunk)
 {
 	int ret;
 
-	ret = snprintf(filename, filename_size, TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_PATTERN,
-		       prefix, (unsigned int)((uid) >> 32), (unsigned int)((uid) & 0xffffffff));
+	if (chunk == 0) {
+		ret = snprintf(filename, filename_size,
+			       TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_PATTERN, prefix,
+			       (unsigned int)((uid) >> 32), (unsigned int)((uid) & 0xffffffff));
+	} else {
+		ret = snprintf(filename, filename_size,
+			       TRUSTED_STORAGE_SETTINGS_BACKEND_CHUNK_PATTERN, prefix,
+			       (unsigned int)((uid) >> 32), (unsigned int)((uid) & 0xffffffff),
+			       chunk);
+	}
 	/* snprintf doc:
 	 * Notice that only when this returned value is non-negative and less than n, the string has
 	 * been completely written
@@ -55,6 +67,11 @@ static int storage_settings_load_object(const char *key, size_t len, settings_re
 {
 	struct load_object_info *info = param;
 
+	/* Skip the chunks stored below the requested object */
+	if (key != NULL) {
+		return 0;
+	}
+
 	info->ret = read_cb(cb_arg, info->data, MIN(info->size, len));
 
 	/*
@@ -81,8 +98,9 @@ static psa_status_t error_to_psa_error(int errorno)
 	}
 }
 
-psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
-				const size_t object_size, size_t *object_length)
+psa_status_t storage_get_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, void *object_data, const size_t object_size,
+				      size_t *object_length)
 {
 	char path[TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1];
 	struct load_object_info info;
@@ -94,7 +112,7 @@ psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix,
 	}
 
 	status = create_filename(path, TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1,
-				 prefix, uid);
+				 prefix, uid, chunk);
 
 	if (status != PSA_SUCCESS) {
 		return status;
@@ -123,8 +141,9 @@ psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix,
 	return PSA_SUCCESS;
 }
 
-psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
-				const void *object_data, const size_t object_size)
+psa_status_t storage_set_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, const void *object_data,
+				      const size_t object_size)
 {
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	char path[TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1];
@@ -134,7 +153,7 @@ psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
 	}
 
 	status = create_filename(path, TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1,
-				 prefix, uid);
+				 prefix, uid, chunk);
 
 	LOG_DBG("Set object with filename %s. Size: %zd", path, object_size);
 
@@ -145,7 +164,8 @@ psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
 	return error_to_psa_error(settings_save_one(path, object_data, object_size));
 }
 
-psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+psa_status_t storage_remove_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+					 uint8_t chunk)
 {
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	char path[TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1];
@@ -155,7 +175,7 @@ psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *pref
 	}
 
 	status = create_filename(path, TRUSTED_STORAGE_SETTINGS_BACKEND_FILENAME_MAX_LENGTH + 1,
-				 prefix, uid);
+				 prefix, uid, chunk);
 
 	if (status != PSA_SUCCESS) {
 		return status;
@@ -167,3 +187,20 @@ psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *pref
 
 	return status;
 }
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	return storage_get_object_chunk(uid, prefix, 0, object_data, object_size, object_length);
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	return storage_set_object_chunk(uid, prefix, 0, object_data, object_size);
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	return storage_remove_object_chunk(uid, prefix, 0);
+}
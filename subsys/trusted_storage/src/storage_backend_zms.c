@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/zms.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+
+#include "storage_backend.h"
+
+LOG_MODULE_REGISTER(internal_trusted_storage_zms, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
+
+/*
+ * Objects are stored directly in ZMS, without a name lookup.
+ *
+ * ZMS ID layout: object slot in the upper 24 bits, chunk in the lower 8 bits.
+ * The slot is a hash of the prefix and UID. To detect hash collisions, the slot also holds a
+ * tag entry with the full UID and a hash of the prefix. On a collision, the following slots are
+ * probed. Lookups always probe all slots up to SLOT_PROBE_MAX, so that removing an object
+ * never hides an object stored in a later slot.
+ */
+
+/* The partition must not be shared with the settings or NVS, as ZMS would overwrite them. */
+#if !FIXED_PARTITION_EXISTS(trusted_storage_partition)
+#error "ZMS storage backend requires the trusted_storage_partition partition"
+#endif
+
+#define TRUSTED_STORAGE_PARTITION trusted_storage_partition
+
+#define SLOT_SHIFT     8
+/* The last slot is not used, as its tag ID would be the ZMS head ID */
+#define SLOT_COUNT     (BIT(32 - SLOT_SHIFT) - 1)
+#define SLOT_PROBE_MAX 4
+#define CHUNK_TAG      0xffU
+
+#define ZMS_ID(slot, chunk) (((uint32_t)(slot) << SLOT_SHIFT) | (chunk))
+
+struct slot_tag {
+	psa_storage_uid_t uid;
+	uint32_t prefix_crc;
+	uint32_t reserved;
+};
+
+static struct zms_fs fs;
+static bool fs_mounted;
+static K_MUTEX_DEFINE(fs_lock);
+
+static psa_status_t error_to_psa_error(int errorno)
+{
+
+	switch (errorno) {
+	case 0:
+		return PSA_SUCCESS;
+	case -ENOSPC:
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	case -ENOENT:
+		return PSA_ERROR_DOES_NOT_EXIST;
+	case -ENODATA:
+		return PSA_ERROR_DATA_CORRUPT;
+	default:
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+}
+
+static int storage_zms_mount(void)
+{
+	struct flash_pages_info info;
+	int ret = 0;
+
+	k_mutex_lock(&fs_lock, K_FOREVER);
+
+	if (fs_mounted) {
+		goto exit;
+	}
+
+	fs.flash_device = FIXED_PARTITION_DEVICE(TRUSTED_STORAGE_PARTITION);
+	if (!device_is_ready(fs.flash_device)) {
+		ret = -ENODEV;
+		goto exit;
+	}
+
+	fs.offset = FIXED_PARTITION_OFFSET(TRUSTED_STORAGE_PARTITION);
+
+	ret = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (ret) {
+		goto exit;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = FIXED_PARTITION_SIZE(TRUSTED_STORAGE_PARTITION) / info.size;
+
+	ret = zms_mount(&fs);
+	if (ret) {
+		LOG_ERR("Failed to mount ZMS, error: %d", ret);
+		goto exit;
+	}
+
+	fs_mounted = true;
+
+exit:
+	k_mutex_unlock(&fs_lock);
+
+	return ret;
+}
+
+static void slot_tag_init(struct slot_tag *tag, const psa_storage_uid_t uid, const char *prefix)
+{
+	memset(tag, 0, sizeof(*tag));
+	tag->uid = uid;
+	tag->prefix_crc = crc32_ieee((const uint8_t *)prefix, strlen(prefix));
+}
+
+/*
+ * Finds the slot of an object. Returns 0 if found, -ENOENT with a free slot if not found,
+ * or -ENOSPC if neither the object nor a free slot was found.
+ */
+static int slot_find(const psa_storage_uid_t uid, const char *prefix, uint32_t *slot)
+{
+	struct slot_tag tag;
+	struct slot_tag stored;
+	uint32_t hash;
+	bool free_found = false;
+	ssize_t ret;
+
+	slot_tag_init(&tag, uid, prefix);
+	hash = crc32_ieee_update(tag.prefix_crc, (const uint8_t *)&uid, sizeof(uid));
+
+	for (int i = 0; i < SLOT_PROBE_MAX; i++) {
+		uint32_t candidate = (hash + i) % SLOT_COUNT;
+
+		ret = zms_read(&fs, ZMS_ID(candidate, CHUNK_TAG), &stored, sizeof(stored));
+		if (ret == sizeof(stored) && memcmp(&stored, &tag, sizeof(tag)) == 0) {
+			*slot = candidate;
+			return 0;
+		}
+
+		if (ret == -ENOENT) {
+			if (!free_found) {
+				*slot = candidate;
+				free_found = true;
+			}
+		} else if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return free_found ? -ENOENT : -ENOSPC;
+}
+
+psa_status_t storage_get_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, void *object_data, const size_t object_size,
+				      size_t *object_length)
+{
+	uint32_t slot;
+	ssize_t ret;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL || chunk == CHUNK_TAG) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_zms_mount();
+	if (ret) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	ret = slot_find(uid, prefix, &slot);
+	if (ret == -ENOSPC) {
+		return PSA_ERROR_DOES_NOT_EXIST;
+	} else if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	ret = zms_read(&fs, ZMS_ID(slot, chunk), object_data, object_size);
+
+	LOG_DBG("Get object %08x%08x/%x in slot %06x (max_size: %zd), ret: %d",
+		(unsigned int)(uid >> 32), (unsigned int)(uid & 0xffffffff), chunk, slot,
+		object_size, (int)ret);
+
+	if (ret < 0) {
+		return error_to_psa_error(ret);
+	}
+
+	/* ZMS returns the full length of the entry, which may exceed the buffer */
+	*object_length = MIN((size_t)ret, object_size);
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_set_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+				      uint8_t chunk, const void *object_data,
+				      const size_t object_size)
+{
+	struct slot_tag tag;
+	uint32_t slot;
+	ssize_t ret;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL || chunk == CHUNK_TAG) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_zms_mount();
+	if (ret) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	ret = slot_find(uid, prefix, &slot);
+	if (ret == -ENOENT) {
+		/* Claim the free slot for this object */
+		slot_tag_init(&tag, uid, prefix);
+		ret = zms_write(&fs, ZMS_ID(slot, CHUNK_TAG), &tag, sizeof(tag));
+		ret = (ret < 0) ? ret : 0;
+	}
+
+	if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	LOG_DBG("Set object %08x%08x/%x in slot %06x. Size: %zd", (unsigned int)(uid >> 32),
+		(unsigned int)(uid & 0xffffffff), chunk, slot, object_size);
+
+	ret = zms_write(&fs, ZMS_ID(slot, chunk), object_data, object_size);
+
+	return error_to_psa_error((ret < 0) ? ret : 0);
+}
+
+psa_status_t storage_remove_object_chunk(const psa_storage_uid_t uid, const char *prefix,
+					 uint8_t chunk)
+{
+	uint32_t slot;
+	int ret;
+
+	if (prefix == NULL || chunk == CHUNK_TAG) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_zms_mount();
+	if (ret) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	ret = slot_find(uid, prefix, &slot);
+	if (ret == -ENOENT || ret == -ENOSPC) {
+		return PSA_SUCCESS;
+	} else if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	ret = zms_delete(&fs, ZMS_ID(slot, chunk));
+	if (ret == 0 && chunk == 0) {
+		/* The object is gone, release the slot */
+		ret = zms_delete(&fs, ZMS_ID(slot, CHUNK_TAG));
+	}
+
+	LOG_DBG("Remove object %08x%08x/%x in slot %06x, ret %d", (unsigned int)(uid >> 32),
+		(unsigned int)(uid & 0xffffffff), chunk, slot, ret);
+
+	return error_to_psa_error(ret);
+}
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	return storage_get_object_chunk(uid, prefix, 0, object_data, object_size, object_length);
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	return storage_set_object_chunk(uid, prefix, 0, object_data, object_size);
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	return storage_remove_object_chunk(uid, prefix, 0);
+}
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <stddef.h>
+
+#include "bs_tracing.h"
+#include "bs_types.h"
+#include "bstests.h"
+#include "time_machine.h"
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+#include <zephyr/logging/log.h>
+
+#include <bluetooth/gatt_dm.h>
+#include <bluetooth/services/nus.h>
+#include <bluetooth/services/nus_client.h>
+
+#include "babblekit/testcase.h"
+#include "babblekit/flags.h"
+
+LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
+
+/* Length of the small writes, as done by an application forwarding UART data. */
+#define CHUNK_LEN	  20
+#define BENCH_DURATION_MS 2000
+#define LATENCY_CNT	  20
+#define LATENCY_PERIOD_MS 100
+#define LATENCY_MAX_MS	  100
+
+/* Idle time between the phases of the test, used by the central to tell them apart. */
+#define PHASE_IDLE_MS	  1000
+#define PHASE_GAP_MS	  300
+
+#define CONN_PARAM	  BT_LE_CONN_PARAM(24, 24, 0, 400)
+
+enum test_phase {
+	PHASE_NUS_SEND,
+	PHASE_STREAM,
+	PHASE_LATENCY,
+
+	PHASE_CNT
+};
+
+struct phase_stats {
+	int64_t start;
+	int64_t end;
+	uint32_t notif_cnt;
+	uint32_t bytes;
+};
+
+DEFINE_FLAG(flag_is_connected);
+DEFINE_FLAG(flag_is_disconnected);
+DEFINE_FLAG(flag_mtu_exchanged);
+DEFINE_FLAG(flag_discovered);
+DEFINE_FLAG(flag_subscribed);
+
+static struct bt_conn *default_conn;
+static struct bt_nus_client nus_client;
+
+static struct phase_stats phase_stats[PHASE_CNT];
+static enum test_phase rx_phase;
+static int64_t last_rx_time;
+static uint8_t rx_seq;
+static uint32_t latency_sum;
+static uint32_t latency_max;
+
+static uint8_t tx_seq;
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	TEST_ASSERT(err == 0, "Connection attempt failed with %d", err);
+
+	LOG_INF("Connected");
+
+	if (!default_conn) {
+		default_conn = bt_conn_ref(conn);
+	}
+
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	LOG_INF("Disconnected (reason 0x%02x)", reason);
+
+	SET_FLAG(flag_is_disconnected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static uint8_t nus_received(struct bt_nus_client *nus, const uint8_t *data, uint16_t len)
+{
+	int64_t now = k_uptime_get();
+	struct phase_stats *stats;
+
+	if ((last_rx_time != 0) && ((now - last_rx_time) > PHASE_GAP_MS)) {
+		rx_phase++;
+	}
+
+	last_rx_time = now;
+
+	TEST_ASSERT(rx_phase < PHASE_CNT, "Data received after the last phase");
+
+	stats = &phase_stats[rx_phase];
+	if (stats->notif_cnt == 0) {
+		stats->start = now;
+	}
+
+	stats->end = now;
+	stats->notif_cnt++;
+	stats->bytes += len;
+
+	if (rx_phase == PHASE_LATENCY) {
+		/* The simulated devices boot at the same time, so their uptime is the same. */
+		uint32_t latency;
+
+		TEST_ASSERT(len == sizeof(uint32_t), "Timestamp of invalid length %u", len);
+
+		latency = (uint32_t)now - sys_get_le32(data);
+		latency_sum += latency;
+		latency_max = MAX(latency_max, latency);
+
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	for (uint16_t i = 0; i < len; i++) {
+		TEST_ASSERT(data[i] == rx_seq, "Byte %u of %u bytes lost, expected %u received %u",
+			    stats->bytes - len + i, stats->bytes, rx_seq, data[i]);
+		rx_seq++;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void discovery_complete(struct bt_gatt_dm *dm, void *context)
+{
+	int err;
+
+	err = bt_nus_handles_assign(dm, &nus_client);
+	TEST_ASSERT(!err, "bt_nus_handles_assign failed (%d).", err);
+
+	err = bt_gatt_dm_data_release(dm);
+	TEST_ASSERT(!err, "bt_gatt_dm_data_release failed (%d).", err);
+
+	SET_FLAG(flag_discovered);
+}
+
+static void discovery_service_not_found(struct bt_conn *conn, void *context)
+{
+	TEST_FAIL("NUS not found");
+}
+
+static void discovery_error(struct bt_conn *conn, int err, void *context)
+{
+	TEST_FAIL("Discovery failed (%d)", err);
+}
+
+static const struct bt_gatt_dm_cb discovery_cb = {
+	.completed = discovery_complete,
+	.service_not_found = discovery_service_not_found,
+	.error_found = discovery_error,
+};
+
+static void mtu_exchange_cb(struct bt_conn *conn, uint8_t att_err,
+			    struct bt_gatt_exchange_params *params)
+{
+	TEST_ASSERT(att_err == 0, "MTU exchange failed (%u)", att_err);
+
+	SET_FLAG(flag_mtu_exchanged);
+}
+
+static void scan_cb(const bt_addr_le_t *addr, int8_t rssi,
+		    uint8_t type, struct net_buf_simple *ad)
+{
+	struct bt_conn *conn;
+	int err;
+
+	/* We're only interested in connectable events */
+	if (type != BT_HCI_ADV_IND && type != BT_HCI_ADV_DIRECT_IND) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	TEST_ASSERT(!err, "Err bt_le_scan_stop %d", err);
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, CONN_PARAM, &conn);
+	TEST_ASSERT(!err, "Err bt_conn_le_create %d", err);
+
+	bt_conn_unref(conn);
+}
+
+static uint32_t phase_throughput(const struct phase_stats *stats)
+{
+	int64_t duration = stats->end - stats->start;
+
+	if (duration <= 0) {
+		return 0;
+	}
+
+	return (uint32_t)((stats->bytes * 8ULL * MSEC_PER_SEC) / duration);
+}
+
+static void phase_print(const char *name, const struct phase_stats *stats)
+{
+	LOG_INF("%s: %u bytes in %u notifications (%u bytes per notification), %u bps", name,
+		stats->bytes, stats->notif_cnt, stats->bytes / MAX(stats->notif_cnt, 1),
+		phase_throughput(stats));
+}
+
+void central_nus_stream_test(void)
+{
+	int err;
+	const struct phase_stats *send_stats = &phase_stats[PHASE_NUS_SEND];
+	const struct phase_stats *stream_stats = &phase_stats[PHASE_STREAM];
+	const struct phase_stats *latency_stats = &phase_stats[PHASE_LATENCY];
+	struct bt_nus_client_init_param init = {
+		.cb = {
+			.received = nus_received,
+		},
+	};
+	static struct bt_gatt_exchange_params exchange_params = {
+		.func = mtu_exchange_cb,
+	};
+
+	err = bt_enable(NULL);
+	TEST_ASSERT(!err, "bt_enable failed.");
+
+	err = bt_nus_client_init(&nus_client, &init);
+	TEST_ASSERT(!err, "bt_nus_client_init failed (%d).", err);
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, scan_cb);
+	TEST_ASSERT(!err, "Err bt_le_scan_start %d", err);
+
+	WAIT_FOR_FLAG(flag_is_connected);
+
+	err = bt_conn_le_data_len_update(default_conn, BT_LE_DATA_LEN_PARAM_MAX);
+	TEST_ASSERT(!err, "Err bt_conn_le_data_len_update %d", err);
+
+	err = bt_gatt_exchange_mtu(default_conn, &exchange_params);
+	TEST_ASSERT(!err, "Err bt_gatt_exchange_mtu %d", err);
+	WAIT_FOR_FLAG(flag_mtu_exchanged);
+
+	err = bt_gatt_dm_start(default_conn, BT_UUID_NUS_SERVICE, &discovery_cb, NULL);
+	TEST_ASSERT(!err, "Err bt_gatt_dm_start %d", err);
+	WAIT_FOR_FLAG(flag_discovered);
+
+	err = bt_nus_subscribe_receive(&nus_client);
+	TEST_ASSERT(!err, "Err bt_nus_subscribe_receive %d", err);
+
+	WAIT_FOR_FLAG(flag_is_disconnected);
+
+	phase_print("bt_nus_send", send_stats);
+	phase_print("bt_nus_stream_send", stream_stats);
+	LOG_INF("Stream latency: %u ms average, %u ms maximum",
+		latency_sum / MAX(latency_stats->notif_cnt, 1), latency_max);
+
+	TEST_ASSERT(rx_phase == PHASE_LATENCY, "Phases missing, last phase %d", rx_phase);
+	TEST_ASSERT(send_stats->bytes > 0, "No data received from bt_nus_send");
+	TEST_ASSERT(stream_stats->bytes > 0, "No data received from bt_nus_stream_send");
+
+	/* Small writes are packed in the stream notifications. */
+	TEST_ASSERT(stream_stats->notif_cnt < (stream_stats->bytes / CHUNK_LEN),
+		    "Stream data not packed");
+	TEST_ASSERT(phase_throughput(stream_stats) >= phase_throughput(send_stats),
+		    "Stream throughput lower than bt_nus_send throughput");
+
+	/* Single writes are not delayed by packing. */
+	TEST_ASSERT(latency_stats->notif_cnt == LATENCY_CNT, "Received %u of %u timestamps",
+		    latency_stats->notif_cnt, LATENCY_CNT);
+	TEST_ASSERT(latency_max <= LATENCY_MAX_MS, "Stream latency too high: %u ms",
+		    latency_max);
+
+	bt_conn_unref(default_conn);
+	default_conn = NULL;
+
+	TEST_PASS("PASS");
+}
+
+static void send_enabled(enum bt_nus_send_status status)
+{
+	if (status == BT_NUS_SEND_STATUS_ENABLED) {
+		SET_FLAG(flag_subscribed);
+	}
+}
+
+static struct bt_nus_cb nus_cb = {
+	.send_enabled = send_enabled,
+};
+
+static void chunk_fill(uint8_t *chunk)
+{
+	for (size_t i = 0; i < CHUNK_LEN; i++) {
+		chunk[i] = tx_seq++;
+	}
+}
+
+static void nus_send_bench(void)
+{
+	int err;
+	uint8_t chunk[CHUNK_LEN];
+	int64_t end = k_uptime_get() + BENCH_DURATION_MS;
+
+	while (k_uptime_get() < end) {
+		chunk_fill(chunk);
+
+		/* The application retries when no TX buffer is available. */
+		do {
+			err = bt_nus_send(default_conn, chunk, sizeof(chunk));
+			if (err == -ENOMEM) {
+				k_sleep(K_MSEC(1));
+			}
+		} while (err == -ENOMEM);
+
+		TEST_ASSERT(!err, "Err bt_nus_send %d", err);
+	}
+}
+
+static void nus_stream_bench(void)
+{
+	int ret;
+	uint8_t chunk[CHUNK_LEN];
+	int64_t end = k_uptime_get() + BENCH_DURATION_MS;
+
+	while (k_uptime_get() < end) {
+		chunk_fill(chunk);
+
+		ret = bt_nus_stream_send(default_conn, chunk, sizeof(chunk), K_FOREVER);
+		TEST_ASSERT(ret == sizeof(chunk), "Err bt_nus_stream_send %d", ret);
+	}
+}
+
+static void nus_stream_latency(void)
+{
+	int ret;
+	uint8_t timestamp[sizeof(uint32_t)];
+
+	for (size_t i = 0; i < LATENCY_CNT; i++) {
+		sys_put_le32(k_uptime_get_32(), timestamp);
+
+		ret = bt_nus_stream_send(default_conn, timestamp, sizeof(timestamp), K_FOREVER);
+		TEST_ASSERT(ret == sizeof(timestamp), "Err bt_nus_stream_send %d", ret);
+
+		k_sleep(K_MSEC(LATENCY_PERIOD_MS));
+	}
+}
+
+void peripheral_nus_stream_test(void)
+{
+	int err;
+	struct bt_le_adv_param param = {};
+
+	err = bt_enable(NULL);
+	TEST_ASSERT(!err, "bt_enable failed.");
+
+	err = bt_nus_init(&nus_cb);
+	TEST_ASSERT(!err, "bt_nus_init failed (%d).", err);
+
+	param.id = BT_ID_DEFAULT;
+	param.interval_min = 0x0020;
+	param.interval_max = 0x4000;
+	param.options |= BT_LE_ADV_OPT_CONN;
+
+	err = bt_le_adv_start(&param, ad, ARRAY_SIZE(ad), NULL, 0);
+	TEST_ASSERT(err == 0, "Advertising failed to start (err %d)", err);
+
+	WAIT_FOR_FLAG(flag_is_connected);
+	WAIT_FOR_FLAG(flag_subscribed);
+
+	/* Give the central time to update the data length. */
+	k_sleep(K_MSEC(PHASE_IDLE_MS));
+
+	nus_send_bench();
+	k_sleep(K_MSEC(PHASE_IDLE_MS));
+
+	nus_stream_bench();
+	k_sleep(K_MSEC(PHASE_IDLE_MS));
+
+	nus_stream_latency();
+	k_sleep(K_MSEC(PHASE_IDLE_MS));
+
+	err = bt_conn_disconnect(default_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+	TEST_ASSERT(!err, "Err bt_conn_disconnect %d", err);
+
+	WAIT_FOR_FLAG(flag_is_disconnected);
+
+	bt_conn_unref(default_conn);
+	default_conn = NULL;
+
+	TEST_PASS("PASS");
+}
+
+static const struct bst_test_instance test_to_add[] = {
+	{
+		.test_id = "central_nus_stream_test",
+		.test_main_f = central_nus_stream_test,
+	},
+	{
+		.test_id = "peripheral_nus_stream_test",
+		.test_main_f = peripheral_nus_stream_test,
+	},
+	BSTEST_END_MARKER,
+};
+
+static struct bst_test_list *install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_to_add);
+}
+
+bst_test_install_t test_installers[] = {install, NULL};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
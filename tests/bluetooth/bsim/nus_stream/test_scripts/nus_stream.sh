@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor ASA
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+set -eu
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+verbosity_level=2
+simulation_id="nus_stream"
+exe_name=./bs_${BOARD_TS}_tests_bluetooth_bsim_nus_stream_prj_conf
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute "$exe_name" -v=${verbosity_level} \
+    -s="${simulation_id}" -d=0 -testid=central_nus_stream_test
+
+Execute "$exe_name" -v=${verbosity_level} \
+    -s="${simulation_id}" -d=1 -testid=peripheral_nus_stream_test
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s="${simulation_id}" -D=2 -sim_length=30e6 $@
+
+wait_for_background_jobs
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <stddef.h>
+
+#include "bs_tracing.h"
+#include "bs_types.h"
+#include "bstests.h"
+#include "time_machine.h"
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+#include <zephyr/logging/log.h>
+
+#include <bluetooth/gatt_dm.h>
+#include <bluetooth/services/throughput.h>
+
+#include "babblekit/testcase.h"
+#include "babblekit/flags.h"
+
+LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
+
+#define PERIPHERAL_CNT	   CONFIG_BT_MAX_CONN
+#define STREAM_DURATION_MS 5000
+#define CONN_PARAM	   BT_LE_CONN_PARAM(40, 40, 0, 400)
+
+DEFINE_FLAG(flag_is_connected);
+DEFINE_FLAG(flag_is_disconnected);
+DEFINE_FLAG(flag_mtu_exchanged);
+DEFINE_FLAG(flag_discovered);
+DEFINE_FLAG(flag_metrics_read);
+
+static struct bt_conn *pending_conn;
+static struct bt_conn *conns[PERIPHERAL_CNT];
+static struct bt_throughput throughput[PERIPHERAL_CNT];
+static struct bt_throughput *throughput_list[PERIPHERAL_CNT];
+static struct bt_throughput_metrics peer_metrics;
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_THROUGHPUT_VAL),
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	TEST_ASSERT(err == 0, "Connection attempt failed with %d", err);
+
+	LOG_INF("Connected");
+
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	LOG_INF("Disconnected (reason 0x%02x)", reason);
+
+	SET_FLAG(flag_is_disconnected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static uint8_t throughput_read(const struct bt_throughput_metrics *met)
+{
+	peer_metrics = *met;
+	SET_FLAG(flag_metrics_read);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static const struct bt_throughput_cb throughput_cb = {
+	.data_read = throughput_read,
+};
+
+static void discovery_complete(struct bt_gatt_dm *dm, void *context)
+{
+	int err;
+	struct bt_throughput *instance = context;
+
+	err = bt_throughput_handles_assign(dm, instance);
+	TEST_ASSERT(!err, "bt_throughput_handles_assign failed (%d).", err);
+
+	err = bt_gatt_dm_data_release(dm);
+	TEST_ASSERT(!err, "bt_gatt_dm_data_release failed (%d).", err);
+
+	SET_FLAG(flag_discovered);
+}
+
+static void discovery_service_not_found(struct bt_conn *conn, void *context)
+{
+	TEST_FAIL("Throughput service not found");
+}
+
+static void discovery_error(struct bt_conn *conn, int err, void *context)
+{
+	TEST_FAIL("Discovery failed (%d)", err);
+}
+
+static const struct bt_gatt_dm_cb discovery_cb = {
+	.completed = discovery_complete,
+	.service_not_found = discovery_service_not_found,
+	.error_found = discovery_error,
+};
+
+static void mtu_exchange_cb(struct bt_conn *conn, uint8_t att_err,
+			    struct bt_gatt_exchange_params *params)
+{
+	TEST_ASSERT(att_err == 0, "MTU exchange failed (%u)", att_err);
+
+	SET_FLAG(flag_mtu_exchanged);
+}
+
+static void scan_cb(const bt_addr_le_t *addr, int8_t rssi,
+		    uint8_t type, struct net_buf_simple *ad)
+{
+	struct bt_conn *conn;
+	int err;
+
+	if (pending_conn != NULL) {
+		return;
+	}
+
+	/* We're only interested in connectable events */
+	if (type != BT_HCI_ADV_IND && type != BT_HCI_ADV_DIRECT_IND) {
+		return;
+	}
+
+	/* Skip the peripherals that are already connected. */
+	conn = bt_conn_lookup_addr_le(BT_ID_DEFAULT, addr);
+	if (conn) {
+		bt_conn_unref(conn);
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	TEST_ASSERT(!err, "Err bt_le_scan_stop %d", err);
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, CONN_PARAM, &pending_conn);
+	TEST_ASSERT(!err, "Err bt_conn_le_create %d", err);
+}
+
+static void connect_and_discover(size_t idx)
+{
+	int err;
+	static struct bt_gatt_exchange_params exchange_params = {
+		.func = mtu_exchange_cb,
+	};
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, scan_cb);
+	TEST_ASSERT(!err, "Err bt_le_scan_start %d", err);
+
+	TAKE_FLAG(flag_is_connected);
+	conns[idx] = pending_conn;
+	pending_conn = NULL;
+
+	err = bt_conn_le_data_len_update(conns[idx], BT_LE_DATA_LEN_PARAM_MAX);
+	TEST_ASSERT(!err, "Err bt_conn_le_data_len_update %d", err);
+
+	err = bt_gatt_exchange_mtu(conns[idx], &exchange_params);
+	TEST_ASSERT(!err, "Err bt_gatt_exchange_mtu %d", err);
+	TAKE_FLAG(flag_mtu_exchanged);
+
+	err = bt_gatt_dm_start(conns[idx], BT_UUID_THROUGHPUT, &discovery_cb, &throughput[idx]);
+	TEST_ASSERT(!err, "Err bt_gatt_dm_start %d", err);
+	TAKE_FLAG(flag_discovered);
+
+	throughput_list[idx] = &throughput[idx];
+}
+
+static void peer_metrics_check(size_t idx)
+{
+	int err;
+	const struct bt_throughput_stream_stats *stats = &throughput[idx].stream;
+
+	err = bt_throughput_read(&throughput[idx]);
+	TEST_ASSERT(!err, "Err bt_throughput_read %d", err);
+	TAKE_FLAG(flag_metrics_read);
+
+	LOG_INF("Peripheral %zu received %u writes, %u bytes", idx, peer_metrics.write_count,
+		peer_metrics.write_len);
+
+	TEST_ASSERT(peer_metrics.write_count == stats->write_count,
+		    "Peripheral %zu received %u writes, %u sent", idx, peer_metrics.write_count,
+		    stats->write_count);
+	TEST_ASSERT(peer_metrics.write_len == stats->write_len,
+		    "Peripheral %zu received %u bytes, %u sent", idx, peer_metrics.write_len,
+		    stats->write_len);
+}
+
+static void test_setup(void)
+{
+	int err;
+
+	err = bt_enable(NULL);
+	TEST_ASSERT(!err, "bt_enable failed.");
+
+	err = bt_throughput_init(&throughput[0], &throughput_cb);
+	TEST_ASSERT(!err, "bt_throughput_init failed (%d).", err);
+}
+
+void central_stream_test(void)
+{
+	int err;
+	uint16_t write_len = UINT16_MAX;
+	uint32_t write_len_sum = 0;
+	struct bt_throughput_stream_report report;
+
+	test_setup();
+
+	for (size_t i = 0; i < PERIPHERAL_CNT; i++) {
+		connect_and_discover(i);
+		write_len = MIN(write_len, bt_gatt_get_mtu(conns[i]) - 3);
+	}
+
+	err = bt_throughput_stream_run(throughput_list, PERIPHERAL_CNT, write_len,
+				       STREAM_DURATION_MS, &report);
+	TEST_ASSERT(!err, "Err bt_throughput_stream_run %d", err);
+
+	for (size_t i = 0; i < PERIPHERAL_CNT; i++) {
+		const struct bt_throughput_stream_stats *stats = &throughput[i].stream;
+
+		LOG_INF("Connection %zu: %u writes, %u bytes, %u bps, %u TX starvations", i,
+			stats->write_count, stats->write_len, stats->goodput, stats->tx_starved);
+
+		/* Each connection gets a fair share of the aggregate goodput. */
+		TEST_ASSERT(stats->goodput > 0, "No data sent on connection %zu", i);
+		TEST_ASSERT(stats->goodput >= (report.goodput / (2 * PERIPHERAL_CNT)),
+			    "Connection %zu starved: %u bps of %u bps", i, stats->goodput,
+			    report.goodput);
+
+		write_len_sum += stats->write_len;
+	}
+
+	LOG_INF("Aggregate: %u writes, %u bytes in %u ms, %u bps, %u TX starvations, "
+		"CPU load %d", report.write_count, report.write_len, report.duration,
+		report.goodput, report.tx_starved, report.cpu_load);
+
+	TEST_ASSERT(report.write_len == write_len_sum, "Aggregate bytes do not match");
+	TEST_ASSERT(report.duration >= STREAM_DURATION_MS, "Stream too short");
+
+	for (size_t i = 0; i < PERIPHERAL_CNT; i++) {
+		peer_metrics_check(i);
+	}
+
+	for (size_t i = 0; i < PERIPHERAL_CNT; i++) {
+		err = bt_conn_disconnect(conns[i], BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		TEST_ASSERT(!err, "Err bt_conn_disconnect %d", err);
+
+		TAKE_FLAG(flag_is_disconnected);
+		bt_conn_unref(conns[i]);
+		conns[i] = NULL;
+	}
+
+	TEST_PASS("PASS");
+}
+
+void peripheral_stream_test(void)
+{
+	int err;
+	struct bt_le_adv_param param = {};
+
+	test_setup();
+
+	param.id = BT_ID_DEFAULT;
+	param.interval_min = 0x0020;
+	param.interval_max = 0x4000;
+	param.options |= BT_LE_ADV_OPT_CONN;
+
+	err = bt_le_adv_start(&param, ad, ARRAY_SIZE(ad), NULL, 0);
+	TEST_ASSERT(err == 0, "Advertising failed to start (err %d)", err);
+
+	WAIT_FOR_FLAG(flag_is_connected);
+	WAIT_FOR_FLAG(flag_is_disconnected);
+
+	TEST_PASS("PASS");
+}
+
+static const struct bst_test_instance test_to_add[] = {
+	{
+		.test_id = "central_stream_test",
+		.test_main_f = central_stream_test,
+	},
+	{
+		.test_id = "peripheral_stream_test",
+		.test_main_f = peripheral_stream_test,
+	},
+	BSTEST_END_MARKER,
+};
+
+static struct bst_test_list *install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_to_add);
+}
+
+bst_test_install_t test_installers[] = {install, NULL};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# Copyright 2025 Nordic Semiconductor ASA
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+set -eu
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+verbosity_level=2
+simulation_id="throughput_multi_conn"
+exe_name=./bs_${BOARD_TS}_tests_bluetooth_bsim_throughput_multi_conn_prj_conf
+
+cd ${BSIM_OUT_PATH}/bin
+
+# The central streams to three peripherals at the same time
+Execute "$exe_name" -v=${verbosity_level} \
+    -s="${simulation_id}" -d=0 -testid=central_stream_test
+
+for device in 1 2 3; do
+    Execute "$exe_name" -v=${verbosity_level} \
+        -s="${simulation_id}" -d=${device} -testid=peripheral_stream_test
+done
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s="${simulation_id}" -D=4 -sim_length=30e6 $@
+
+wait_for_background_jobs
@@ -82,6 +82,11 @@ static int location_cb_expected_2;
 K_SEM_DEFINE(event_handler_called_sem, 0, 1);
 K_SEM_DEFINE(event_handler_called_sem_2, 0, 1);
 
+#if defined(CONFIG_LOCATION_DATA_DETAILS) && defined(CONFIG_LOCATION_CACHE)
+/* Location cache details of the latest cellular location event */
+static struct location_data_details_cache test_cache_details;
+#endif
+
 /* Strings for GNSS positioning */
 #if !defined(CONFIG_LOCATION_TEST_AGNSS)
 static const char xmonitor_resp[] =
@@ -160,6 +165,10 @@ void setUp(void)
 	net_mgmt_NET_REQUEST_WIFI_SCAN_occurred = false;
 #endif
 	mock_nrf_modem_at_Init();
+
+#if defined(CONFIG_LOCATION_CACHE)
+	location_cache_clear();
+#endif
 }
 
 void tearDown(void)
@@ -290,6 +299,12 @@ static void location_event_data_verify(
 			TEST_ASSERT_EQUAL(
 				expected->location.details.cellular.gci_cells_count,
 				event_data->location.details.cellular.gci_cells_count);
+#if defined(CONFIG_LOCATION_CACHE)
+			TEST_ASSERT_EQUAL(
+				expected->location.details.cache.hit,
+				event_data->location.details.cache.hit);
+			test_cache_details = event_data->location.details.cache;
+#endif
 		}
 
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
@@ -1047,6 +1062,113 @@ void test_location_cellular(void)
 #endif
 }
 
+#if defined(CONFIG_LOCATION_CACHE) && defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+/* Test that a second cellular request in the same cell is served from the location cache
+ * without an external cloud location request.
+ */
+void test_location_cellular_cache(void)
+{
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR};
+	struct location_data location_data = {
+		.latitude = 61.50375,
+		.longitude = 23.896979,
+		.accuracy = 750.0,
+		.datetime.valid = false
+	};
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	struct location_data_details_cache first;
+#endif
+
+	location_config_defaults_set(&config, 1, methods);
+
+	config.methods[0].cellular.cell_count = 1;
+
+	for (int i = 0; i < 2; i++) {
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+		test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+		test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+		location_cb_expected++;
+#endif
+		if (i == 0) {
+			test_location_event_data[location_cb_expected].id =
+				LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+			test_location_event_data[location_cb_expected].method =
+				LOCATION_METHOD_CELLULAR;
+			location_cb_expected++;
+		}
+
+		test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+		test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+		test_location_event_data[location_cb_expected].location = location_data;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+		test_location_event_data[location_cb_expected].location.details.cellular
+			.ncells_count = 1;
+		/* Only the second request is served from the cache */
+		test_location_event_data[location_cb_expected].location.details.cache.hit =
+			(i == 1);
+#endif
+		location_cb_expected++;
+	}
+
+	/* First request goes to the cloud */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS, &location_data);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	first = test_cache_details;
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, first.misses);
+#endif
+
+	/* Second request in the same cell is resolved from the cache */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* One more hit and no more misses */
+	TEST_ASSERT_EQUAL(first.hits + 1, test_cache_details.hits);
+	TEST_ASSERT_EQUAL(first.misses, test_cache_details.misses);
+#endif
+}
+#endif
+
 /* Test cancelling cellular location request during NCELLMEAS. */
 void test_location_cellular_cancel_during_ncellmeas(void)
 {
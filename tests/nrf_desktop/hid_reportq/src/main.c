@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * HID report queue of the nRF Desktop application.
+ *
+ * The test acts as the HID subscriber. Submitted HID reports are recorded by an application
+ * event listener and the test thread confirms them with hid_reportq_report_sent_info. The first
+ * byte of every report carries a sequence number used to verify the order of reports.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "hid_reportq.h"
+#include "hid_event.h"
+
+#define MAX_ENQUEUED_REPORTS	CONFIG_DESKTOP_HID_REPORTQ_MAX_ENQUEUED_REPORTS
+#define IN_FLIGHT_MAX		CONFIG_DESKTOP_HID_REPORTQ_LATENCY_IN_FLIGHT_MAX
+#define RECEIVED_MAX		16
+#define REPORT_WAIT_TIME	K_MSEC(100)
+#define LATENCY_DELAY_MS	20
+
+struct report {
+	uint8_t rep_id;
+	uint8_t seq;
+};
+
+static const int sub;
+static const int src_a;
+static const int src_b;
+
+static struct hid_reportq *q;
+
+static struct report received[RECEIVED_MAX];
+static size_t received_cnt;
+static K_SEM_DEFINE(report_sem, 0, RECEIVED_MAX);
+
+static void report_add(const void *src_id, uint8_t rep_id, uint8_t seq)
+{
+	uint8_t data[MAX(REPORT_SIZE_MOUSE, REPORT_SIZE_KEYBOARD_KEYS)] = {seq};
+	size_t size = (rep_id == REPORT_ID_MOUSE) ? REPORT_SIZE_MOUSE : REPORT_SIZE_KEYBOARD_KEYS;
+
+	zassert_ok(hid_reportq_report_add(q, src_id, rep_id, data, size));
+}
+
+static void report_sent(struct hid_reportq_report_info *info)
+{
+	struct hid_reportq_report_info tmp;
+
+	/* Reports are confirmed in the order they were submitted. */
+	hid_reportq_report_sent_info(q, REPORT_ID_MOUSE, false, info ? info : &tmp);
+}
+
+static void reports_check(const struct report *expected, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_ok(k_sem_take(&report_sem, REPORT_WAIT_TIME), "Missing report %zu", i);
+	}
+
+	/* No other report may be submitted. */
+	zassert_equal(k_sem_take(&report_sem, REPORT_WAIT_TIME), -EAGAIN);
+	zassert_equal(received_cnt, cnt);
+
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_equal(received[i].rep_id, expected[i].rep_id, "Wrong report %zu", i);
+		zassert_equal(received[i].seq, expected[i].seq, "Wrong report %zu", i);
+	}
+
+	received_cnt = 0;
+}
+
+static void queue_alloc(uint8_t report_max)
+{
+	q = hid_reportq_alloc(&sub, report_max);
+	zassert_not_null(q);
+	zassert_ok(hid_reportq_subscribe(q, REPORT_ID_MOUSE));
+	zassert_ok(hid_reportq_subscribe(q, REPORT_ID_KEYBOARD_KEYS));
+}
+
+ZTEST(hid_reportq, test_unsubscribed)
+{
+	uint8_t data[REPORT_SIZE_MOUSE] = {0};
+
+	q = hid_reportq_alloc(&sub, 1);
+	zassert_not_null(q);
+
+	zassert_equal(hid_reportq_report_add(q, &src_a, REPORT_ID_MOUSE, data, sizeof(data)),
+		      -EACCES);
+	zassert_equal(hid_reportq_report_add(q, &src_a, REPORT_ID_SYSTEM_CTRL, data, sizeof(data)),
+		      -ENOTSUP);
+
+	reports_check(NULL, 0);
+}
+
+ZTEST(hid_reportq, test_order)
+{
+	static const struct report expected[] = {
+		{REPORT_ID_MOUSE, 0},
+		{REPORT_ID_KEYBOARD_KEYS, 0},
+		{REPORT_ID_MOUSE, 1},
+		{REPORT_ID_KEYBOARD_KEYS, 1},
+		{REPORT_ID_MOUSE, 2},
+	};
+
+	queue_alloc(1);
+
+	report_add(&src_a, REPORT_ID_MOUSE, 0);
+	report_add(&src_a, REPORT_ID_MOUSE, 1);
+	report_add(&src_a, REPORT_ID_MOUSE, 2);
+	report_add(&src_a, REPORT_ID_KEYBOARD_KEYS, 0);
+	report_add(&src_a, REPORT_ID_KEYBOARD_KEYS, 1);
+
+	/* Reports with different IDs are sent in turns, each report ID keeps its order. */
+	for (size_t i = 0; i < ARRAY_SIZE(expected) - 1; i++) {
+		report_sent(NULL);
+	}
+
+	reports_check(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(hid_reportq, test_ring_wrap)
+{
+	static const struct report expected[] = {
+		{REPORT_ID_MOUSE, 0},
+		{REPORT_ID_MOUSE, 1},
+		{REPORT_ID_MOUSE, 2},
+		{REPORT_ID_MOUSE, 3},
+		{REPORT_ID_MOUSE, 4},
+	};
+
+	BUILD_ASSERT(MAX_ENQUEUED_REPORTS == 3);
+
+	queue_alloc(1);
+
+	report_add(&src_a, REPORT_ID_MOUSE, 0);
+	report_add(&src_a, REPORT_ID_MOUSE, 1);
+	report_add(&src_a, REPORT_ID_MOUSE, 2);
+	report_sent(NULL);
+
+	/* Reports 3 and 4 are stored after the end of the ring, at its beginning. */
+	report_add(&src_a, REPORT_ID_MOUSE, 3);
+	report_add(&src_a, REPORT_ID_MOUSE, 4);
+
+	for (size_t i = 0; i < ARRAY_SIZE(expected) - 1; i++) {
+		report_sent(NULL);
+	}
+
+	reports_check(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(hid_reportq, test_drop_on_full)
+{
+	static const struct report expected[] = {
+		{REPORT_ID_MOUSE, 0},
+		{REPORT_ID_KEYBOARD_KEYS, 0},
+		{REPORT_ID_MOUSE, 2},
+		{REPORT_ID_MOUSE, 3},
+		{REPORT_ID_MOUSE, 4},
+	};
+
+	queue_alloc(1);
+
+	report_add(&src_a, REPORT_ID_MOUSE, 0);
+
+	/* Report 1 is the oldest enqueued report, it is dropped when report 4 is added. */
+	for (uint8_t seq = 1; seq <= MAX_ENQUEUED_REPORTS + 1; seq++) {
+		report_add(&src_a, REPORT_ID_MOUSE, seq);
+	}
+
+	/* A full ring does not affect reports with other IDs. */
+	report_add(&src_a, REPORT_ID_KEYBOARD_KEYS, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(expected) - 1; i++) {
+		report_sent(NULL);
+	}
+
+	reports_check(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(hid_reportq, test_latency)
+{
+	static const struct report expected[] = {
+		{REPORT_ID_MOUSE, 0},
+		{REPORT_ID_MOUSE, 1},
+	};
+	struct hid_reportq_report_info info;
+
+	queue_alloc(1);
+
+	report_add(&src_a, REPORT_ID_MOUSE, 0);
+	report_add(&src_b, REPORT_ID_MOUSE, 1);
+
+	k_sleep(K_MSEC(LATENCY_DELAY_MS));
+	report_sent(&info);
+	zassert_equal_ptr(info.src_id, &src_a);
+	zassert_true(info.latency_us >= LATENCY_DELAY_MS * USEC_PER_MSEC);
+	zassert_true(info.latency_us < 2 * LATENCY_DELAY_MS * USEC_PER_MSEC);
+
+	/* The latency of an enqueued report includes the time spent in the queue. */
+	k_sleep(K_MSEC(LATENCY_DELAY_MS));
+	report_sent(&info);
+	zassert_equal_ptr(info.src_id, &src_b);
+	zassert_true(info.latency_us >= 2 * LATENCY_DELAY_MS * USEC_PER_MSEC);
+
+	reports_check(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(hid_reportq, test_in_flight_limit)
+{
+	static const struct report expected[] = {
+		{REPORT_ID_MOUSE, 0},
+		{REPORT_ID_MOUSE, 1},
+		{REPORT_ID_MOUSE, 2},
+	};
+	struct hid_reportq_report_info info;
+
+	BUILD_ASSERT(IN_FLIGHT_MAX == 2);
+
+	/* Subscriber can handle more reports than the queue tracks for the latency. */
+	queue_alloc(IN_FLIGHT_MAX + 1);
+
+	report_add(&src_a, REPORT_ID_MOUSE, 0);
+	report_add(&src_b, REPORT_ID_MOUSE, 1);
+	report_add(&src_a, REPORT_ID_MOUSE, 2);
+
+	/* Only IN_FLIGHT_MAX reports are submitted at a time. */
+	reports_check(expected, IN_FLIGHT_MAX);
+
+	report_sent(&info);
+	zassert_equal_ptr(info.src_id, &src_a);
+	reports_check(&expected[2], 1);
+
+	report_sent(&info);
+	zassert_equal_ptr(info.src_id, &src_b);
+	report_sent(&info);
+	zassert_equal_ptr(info.src_id, &src_a);
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_hid_report_event(aeh)) {
+		const struct hid_report_event *event = cast_hid_report_event(aeh);
+
+		zassert_true(received_cnt < ARRAY_SIZE(received));
+		zassert_equal_ptr(event->subscriber, &sub);
+
+		received[received_cnt].rep_id = event->dyndata.data[0];
+		received[received_cnt].seq = event->dyndata.data[1];
+		received_cnt++;
+
+		k_sem_give(&report_sem);
+
+		return false;
+	}
+
+	/* Event unhandled */
+	zassert_unreachable("Wrong event type");
+	return false;
+}
+
+APP_EVENT_LISTENER(test_main, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_main, hid_report_event);
+
+static void *hid_reportq_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+
+	return NULL;
+}
+
+static void hid_reportq_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	received_cnt = 0;
+	k_sem_reset(&report_sem);
+}
+
+static void hid_reportq_after(void *f)
+{
+	ARG_UNUSED(f);
+
+	if (q) {
+		hid_reportq_free(q);
+		q = NULL;
+	}
+}
+
+ZTEST_SUITE(hid_reportq, NULL, hid_reportq_setup, hid_reportq_before, hid_reportq_after, NULL);
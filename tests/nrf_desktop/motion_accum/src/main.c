@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Motion accumulator of the nRF Desktop application.
+ *
+ * The benchmark compares the motion pipeline that submits an event per sensor sample with the
+ * pipeline that coalesces the samples in the motion accumulator. Sensor samples and HID report
+ * slots are generated by kernel timers (interrupt context). Events and HID reports are handled
+ * by the test thread in order, as done by the application event manager. Each sample carries
+ * one unit of motion, so the latency of every sample is measured from the time it is generated
+ * to the time it is put in a HID report.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "motion_accum.h"
+
+#define REPORT_AXIS_MAX	  254
+#define BENCH_DURATION_US 200000
+#define EVENT_CNT_MAX	  64
+#define SAMPLE_CNT_MAX	  1024
+
+enum item_type {
+	ITEM_MOTION,
+	ITEM_REPORT,
+};
+
+struct item {
+	void *fifo_reserved;
+	enum item_type type;
+	int32_t delta;
+};
+
+struct bench_result {
+	uint32_t samples;
+	uint32_t events;
+	uint32_t reports;
+	uint64_t latency_sum;
+	uint32_t latency_max;
+};
+
+K_FIFO_DEFINE(item_fifo);
+K_MEM_SLAB_DEFINE_STATIC(item_slab, sizeof(struct item), EVENT_CNT_MAX, 4);
+
+static struct motion_accum accum;
+static bool coalescing;
+static uint32_t dropped;
+
+/* Timestamps of the samples that were not yet put in a HID report. */
+static int64_t sample_ts[SAMPLE_CNT_MAX];
+static uint32_t sample_wr;
+static uint32_t sample_rd;
+
+/* Motion data of the HID report provider. */
+static int32_t provider_axis;
+
+static struct bench_result result;
+
+static void item_submit(enum item_type type, int32_t delta)
+{
+	struct item *item;
+
+	if (k_mem_slab_alloc(&item_slab, (void **)&item, K_NO_WAIT)) {
+		dropped++;
+		return;
+	}
+
+	item->type = type;
+	item->delta = delta;
+	k_fifo_put(&item_fifo, item);
+}
+
+static void sample_fn(struct k_timer *timer)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {
+		[MOTION_ACCUM_AXIS_WHEEL] = 1,
+	};
+
+	__ASSERT_NO_MSG(sample_wr - sample_rd < SAMPLE_CNT_MAX);
+	sample_ts[sample_wr++ % SAMPLE_CNT_MAX] = k_uptime_ticks();
+	result.samples++;
+
+	if (!coalescing) {
+		item_submit(ITEM_MOTION, 1);
+	} else if (motion_accum_add(&accum, delta)) {
+		item_submit(ITEM_MOTION, 0);
+	}
+}
+
+static void report_fn(struct k_timer *timer)
+{
+	item_submit(ITEM_REPORT, 0);
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_fn, NULL);
+static K_TIMER_DEFINE(report_timer, report_fn, NULL);
+
+static void report_create(void)
+{
+	int64_t now = k_uptime_ticks();
+
+	if (coalescing) {
+		int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+		(void)motion_accum_take(&accum, res, -REPORT_AXIS_MAX, REPORT_AXIS_MAX);
+		provider_axis += res[MOTION_ACCUM_AXIS_WHEEL];
+	}
+
+	int32_t value = MIN(provider_axis, REPORT_AXIS_MAX);
+
+	provider_axis -= value;
+	result.reports++;
+
+	for (int32_t i = 0; i < value; i++) {
+		uint32_t latency = k_ticks_to_us_floor32(now - sample_ts[sample_rd++ %
+									  SAMPLE_CNT_MAX]);
+
+		result.latency_sum += latency;
+		result.latency_max = MAX(result.latency_max, latency);
+	}
+}
+
+static void item_handle(struct item *item)
+{
+	switch (item->type) {
+	case ITEM_MOTION:
+		result.events++;
+		provider_axis += item->delta;
+		break;
+
+	case ITEM_REPORT:
+		report_create();
+		break;
+
+	default:
+		zassert_unreachable();
+		break;
+	}
+
+	k_mem_slab_free(&item_slab, item);
+}
+
+static void bench_run(uint32_t sample_period_us, uint32_t report_period_us, bool coalesce,
+		      struct bench_result *res)
+{
+	struct item *item;
+
+	memset(&result, 0, sizeof(result));
+	motion_accum_reset(&accum);
+	provider_axis = 0;
+	sample_rd = sample_wr;
+	dropped = 0;
+	coalescing = coalesce;
+
+	/* Report slots are offset from the samples to avoid simultaneous expiry. */
+	k_timer_start(&report_timer, K_USEC(report_period_us + 1), K_USEC(report_period_us));
+	k_timer_start(&sample_timer, K_USEC(sample_period_us), K_USEC(sample_period_us));
+
+	int64_t end = k_uptime_ticks() + k_us_to_ticks_ceil64(BENCH_DURATION_US);
+
+	while (k_uptime_ticks() < end) {
+		item = k_fifo_get(&item_fifo, K_USEC(report_period_us));
+		if (item) {
+			item_handle(item);
+		}
+	}
+
+	k_timer_stop(&sample_timer);
+
+	/* Send reports until all of the motion is reported. */
+	while ((sample_rd != sample_wr) || !k_fifo_is_empty(&item_fifo)) {
+		item = k_fifo_get(&item_fifo, K_USEC(2 * report_period_us));
+		zassert_not_null(item, "Motion was lost");
+		item_handle(item);
+	}
+
+	k_timer_stop(&report_timer);
+
+	while ((item = k_fifo_get(&item_fifo, K_NO_WAIT)) != NULL) {
+		k_mem_slab_free(&item_slab, item);
+	}
+
+	zassert_equal(dropped, 0, "Events dropped");
+	zassert_equal(provider_axis, 0);
+
+	*res = result;
+}
+
+static void bench_print(const char *name, uint32_t sample_period_us, uint32_t report_period_us,
+			const struct bench_result *res)
+{
+	TC_PRINT("%-10s sample %4u us, report %4u us: %6u events/s, %6u reports/s, "
+		 "latency avg %4u us, max %4u us\n",
+		 name, sample_period_us, report_period_us,
+		 (uint32_t)((uint64_t)res->events * USEC_PER_SEC / BENCH_DURATION_US),
+		 (uint32_t)((uint64_t)res->reports * USEC_PER_SEC / BENCH_DURATION_US),
+		 (uint32_t)(res->latency_sum / MAX(res->samples, 1)), res->latency_max);
+}
+
+static void motion_accum_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	motion_accum_reset(&accum);
+}
+
+ZTEST_SUITE(motion_accum, NULL, NULL, motion_accum_before, NULL, NULL);
+
+ZTEST(motion_accum, test_notify_once)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {1, -2, 3};
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+	/* Only the first sample requests a notification */
+	zassert_true(motion_accum_add(&accum, delta));
+	zassert_false(motion_accum_add(&accum, delta));
+	zassert_false(motion_accum_add(&accum, delta));
+
+	zassert_false(motion_accum_take(&accum, res, INT32_MIN, INT32_MAX));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], 3);
+	zassert_equal(res[MOTION_ACCUM_AXIS_Y], -6);
+	zassert_equal(res[MOTION_ACCUM_AXIS_WHEEL], 9);
+
+	/* No motion left, the next sample requests a notification */
+	zassert_false(motion_accum_take(&accum, res, INT32_MIN, INT32_MAX));
+	zassert_equal(res[MOTION_ACCUM_AXIS_WHEEL], 0);
+	zassert_true(motion_accum_add(&accum, delta));
+}
+
+ZTEST(motion_accum, test_no_motion)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {0};
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+	zassert_false(motion_accum_add(&accum, delta));
+
+	/* Motion that cancels out does not need to be taken */
+	delta[MOTION_ACCUM_AXIS_X] = 5;
+	zassert_true(motion_accum_add(&accum, delta));
+	delta[MOTION_ACCUM_AXIS_X] = -5;
+	zassert_false(motion_accum_add(&accum, delta));
+	zassert_false(motion_accum_take(&accum, res, INT32_MIN, INT32_MAX));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], 0);
+}
+
+ZTEST(motion_accum, test_take_clamped)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {300, -300, 0};
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+	zassert_true(motion_accum_add(&accum, delta));
+
+	/* The remainder is kept and no notification is requested for it */
+	zassert_true(motion_accum_take(&accum, res, -127, 127));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], 127);
+	zassert_equal(res[MOTION_ACCUM_AXIS_Y], -127);
+	zassert_false(motion_accum_add(&accum, delta));
+
+	zassert_true(motion_accum_take(&accum, res, -127, 127));
+	zassert_true(motion_accum_take(&accum, res, -127, 127));
+	zassert_true(motion_accum_take(&accum, res, -127, 127));
+	zassert_false(motion_accum_take(&accum, res, -127, 127));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], 600 - 4 * 127);
+	zassert_equal(res[MOTION_ACCUM_AXIS_Y], -(600 - 4 * 127));
+}
+
+ZTEST(motion_accum, test_saturation)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {INT32_MAX, INT32_MIN, 0};
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+	zassert_true(motion_accum_add(&accum, delta));
+	zassert_false(motion_accum_add(&accum, delta));
+
+	zassert_false(motion_accum_take(&accum, res, INT32_MIN, INT32_MAX));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], INT32_MAX);
+	zassert_equal(res[MOTION_ACCUM_AXIS_Y], INT32_MIN);
+}
+
+ZTEST(motion_accum, test_reset)
+{
+	int32_t delta[MOTION_ACCUM_AXIS_COUNT] = {1, 1, 1};
+	int32_t res[MOTION_ACCUM_AXIS_COUNT];
+
+	zassert_true(motion_accum_add(&accum, delta));
+	motion_accum_reset(&accum);
+
+	zassert_false(motion_accum_take(&accum, res, INT32_MIN, INT32_MAX));
+	zassert_equal(res[MOTION_ACCUM_AXIS_X], 0);
+	zassert_true(motion_accum_add(&accum, delta));
+}
+
+ZTEST(motion_accum, test_benchmark)
+{
+	/* USB High-Speed (8 kHz) and Bluetooth LE with 1 ms connection interval */
+	static const uint32_t report_periods_us[] = {125, 1000};
+	static const uint32_t sample_periods_us[] = {500, 125, 62};
+
+	struct bench_result per_sample;
+	struct bench_result coalesced;
+
+	ARRAY_FOR_EACH(report_periods_us, i) {
+		ARRAY_FOR_EACH(sample_periods_us, j) {
+			uint32_t report_us = report_periods_us[i];
+			uint32_t sample_us = sample_periods_us[j];
+
+			bench_run(sample_us, report_us, false, &per_sample);
+			bench_print("per-sample", sample_us, report_us, &per_sample);
+
+			bench_run(sample_us, report_us, true, &coalesced);
+			bench_print("coalesced", sample_us, report_us, &coalesced);
+
+			/* Latencies depend on the timer scheduling, so they are only printed. */
+			zassert_true(per_sample.samples > 0);
+			zassert_equal(per_sample.events, per_sample.samples);
+
+			/* At most one event per sample and per HID report slot */
+			zassert_true(coalesced.samples > 0);
+			zassert_true(coalesced.events <= coalesced.samples);
+			zassert_true(coalesced.events <= coalesced.reports);
+		}
+	}
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include <bluetooth/adv_prov.h>
+
+#define AD_CNT		1
+#define SD_CNT		2
+
+/* Benchmark: the advertising data is refreshed every second and the counter provided in the
+ * scan response data changes every 10 seconds.
+ */
+#define BENCH_UPDATES		300
+#define BENCH_CHANGE_PERIOD	10
+
+static uint8_t cached_val;
+static uint32_t cached_calls;
+static uint32_t counter_calls;
+static uint32_t absent_calls;
+static uint8_t counter_val;
+
+static int cached_get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *state,
+			   struct bt_le_adv_prov_feedback *fb)
+{
+	static uint8_t data;
+
+	cached_calls++;
+	data = cached_val;
+
+	ad->type = BT_DATA_MANUFACTURER_DATA;
+	ad->data_len = sizeof(data);
+	ad->data = &data;
+
+	fb->grace_period_s = state->pairing_mode ? 30 : 0;
+
+	return 0;
+}
+
+static int counter_get_data(struct bt_data *sd, const struct bt_le_adv_prov_adv_state *state,
+			    struct bt_le_adv_prov_feedback *fb)
+{
+	ARG_UNUSED(state);
+	ARG_UNUSED(fb);
+
+	counter_calls++;
+
+	sd->type = BT_DATA_SVC_DATA16;
+	sd->data_len = sizeof(counter_val);
+	sd->data = &counter_val;
+
+	return 0;
+}
+
+static int absent_get_data(struct bt_data *sd, const struct bt_le_adv_prov_adv_state *state,
+			   struct bt_le_adv_prov_feedback *fb)
+{
+	ARG_UNUSED(sd);
+	ARG_UNUSED(state);
+	ARG_UNUSED(fb);
+
+	absent_calls++;
+
+	return -ENOENT;
+}
+
+BT_LE_ADV_PROV_AD_PROVIDER_REGISTER_CACHED(cached, cached_get_data);
+BT_LE_ADV_PROV_SD_PROVIDER_REGISTER(counter, counter_get_data);
+BT_LE_ADV_PROV_SD_PROVIDER_REGISTER_CACHED(absent, absent_get_data);
+
+struct payload {
+	struct bt_data ad[AD_CNT];
+	struct bt_data sd[SD_CNT];
+	size_t ad_len;
+	size_t sd_len;
+	struct bt_le_adv_prov_feedback fb;
+};
+
+static void payload_get(struct payload *p, const struct bt_le_adv_prov_adv_state *state)
+{
+	p->ad_len = ARRAY_SIZE(p->ad);
+	p->sd_len = ARRAY_SIZE(p->sd);
+
+	zassert_ok(bt_le_adv_prov_get_ad(p->ad, &p->ad_len, state, &p->fb));
+	zassert_ok(bt_le_adv_prov_get_sd(p->sd, &p->sd_len, state, &p->fb));
+}
+
+static bool payload_changed(const struct payload *p, const struct bt_le_adv_prov_adv_state *state)
+{
+	return bt_le_adv_prov_payload_changed(state, p->ad, p->ad_len, p->sd, p->sd_len);
+}
+
+static void before_fn(void *f)
+{
+	ARG_UNUSED(f);
+
+	struct bt_le_adv_prov_adv_state state = {
+		.new_adv_session = true,
+	};
+	struct payload p;
+
+	cached_val = 0;
+	counter_val = 0;
+
+	/* Start every test with a refreshed provider cache and a stored payload. */
+	payload_get(&p, &state);
+	zassert_true(payload_changed(&p, &state));
+
+	cached_calls = 0;
+	counter_calls = 0;
+	absent_calls = 0;
+}
+
+ZTEST(suite_bt_adv_prov, test_provider_cache)
+{
+	struct bt_le_adv_prov_adv_state state = {0};
+	struct bt_le_adv_prov_stats before;
+	struct bt_le_adv_prov_stats after;
+	struct payload p;
+
+	zassert_equal(bt_le_adv_prov_get_ad_prov_cnt(), AD_CNT);
+	zassert_equal(bt_le_adv_prov_get_sd_prov_cnt(), SD_CNT);
+
+	bt_le_adv_prov_stats_get(&before);
+
+	/* Data of the cached providers is reused. */
+	payload_get(&p, &state);
+	payload_get(&p, &state);
+	zassert_equal(cached_calls, 0);
+	zassert_equal(absent_calls, 0);
+	zassert_equal(counter_calls, 2);
+	zassert_equal(p.ad_len, 1);
+	zassert_equal(p.sd_len, 1);
+	zassert_equal(p.ad[0].data[0], 0);
+
+	bt_le_adv_prov_stats_get(&after);
+	zassert_equal(after.provider_cache_hits - before.provider_cache_hits, 4);
+
+	/* Invalidation refreshes only the given provider. */
+	cached_val = 1;
+	bt_le_adv_prov_invalidate(cached_get_data);
+	payload_get(&p, &state);
+	zassert_equal(cached_calls, 1);
+	zassert_equal(absent_calls, 0);
+	zassert_equal(p.ad[0].data[0], 1);
+
+	/* Change of the advertising state refreshes the cached providers. */
+	state.pairing_mode = true;
+	payload_get(&p, &state);
+	zassert_equal(cached_calls, 2);
+	zassert_equal(absent_calls, 1);
+	zassert_equal(p.fb.grace_period_s, 30);
+
+	/* Feedback is cached together with the data. */
+	payload_get(&p, &state);
+	zassert_equal(cached_calls, 2);
+	zassert_equal(p.fb.grace_period_s, 30);
+
+	state.rpa_rotated = true;
+	payload_get(&p, &state);
+	zassert_equal(cached_calls, 3);
+	zassert_equal(absent_calls, 2);
+}
+
+ZTEST(suite_bt_adv_prov, test_payload_changed)
+{
+	struct bt_le_adv_prov_adv_state state = {0};
+	struct bt_le_adv_prov_stats before;
+	struct bt_le_adv_prov_stats after;
+	struct payload p;
+	uint8_t big_data[CONFIG_BT_ADV_PROV_PAYLOAD_CACHE_SIZE] = {0};
+	struct bt_data big = BT_DATA(BT_DATA_MANUFACTURER_DATA, big_data, sizeof(big_data));
+
+	bt_le_adv_prov_stats_get(&before);
+
+	payload_get(&p, &state);
+	zassert_false(payload_changed(&p, &state));
+
+	bt_le_adv_prov_stats_get(&after);
+	zassert_equal(after.payload_update_skips - before.payload_update_skips, 1);
+
+	/* Change of a single byte. */
+	counter_val++;
+	payload_get(&p, &state);
+	zassert_true(payload_changed(&p, &state));
+	zassert_false(payload_changed(&p, &state));
+
+	/* The same elements swapped between the advertising data and the scan response data. */
+	zassert_true(bt_le_adv_prov_payload_changed(&state, p.sd, p.sd_len, p.ad, p.ad_len));
+	zassert_true(payload_changed(&p, &state));
+
+	/* The payload is sent after a failed update. */
+	bt_le_adv_prov_payload_invalidate(state.adv_handle);
+	zassert_true(payload_changed(&p, &state));
+
+	/* The payload is always sent in a new advertising session. */
+	state.new_adv_session = true;
+	zassert_true(payload_changed(&p, &state));
+	state.new_adv_session = false;
+
+	/* The payload that does not fit in the cache cannot be compared. */
+	zassert_true(bt_le_adv_prov_payload_changed(&state, &big, 1, NULL, 0));
+	zassert_true(bt_le_adv_prov_payload_changed(&state, &big, 1, NULL, 0));
+	zassert_true(payload_changed(&p, &state));
+
+	/* Advertising sets have separate caches. */
+	state.adv_handle = COND_CODE_1(CONFIG_BT_EXT_ADV, (CONFIG_BT_EXT_ADV_MAX_ADV_SET), (1));
+	zassert_true(payload_changed(&p, &state));
+	zassert_true(payload_changed(&p, &state));
+}
+
+ZTEST(suite_bt_adv_prov, test_benchmark)
+{
+	struct bt_le_adv_prov_adv_state state = {0};
+	struct bt_le_adv_prov_stats before;
+	struct bt_le_adv_prov_stats after;
+	struct payload p;
+	uint32_t sent = 0;
+	uint32_t skipped;
+	uint32_t provider_calls;
+
+	bt_le_adv_prov_stats_get(&before);
+
+	for (uint32_t i = 1; i <= BENCH_UPDATES; i++) {
+		if ((i % BENCH_CHANGE_PERIOD) == 0) {
+			counter_val++;
+		}
+
+		payload_get(&p, &state);
+
+		if (payload_changed(&p, &state)) {
+			sent++;
+		}
+	}
+
+	bt_le_adv_prov_stats_get(&after);
+
+	skipped = after.payload_update_skips - before.payload_update_skips;
+	provider_calls = cached_calls + counter_calls + absent_calls;
+
+	TC_PRINT("%u updates: %u payloads sent, %u skipped, %u of %u provider calls\n",
+		 BENCH_UPDATES, sent, skipped, provider_calls, BENCH_UPDATES * (AD_CNT + SD_CNT));
+
+	zassert_equal(sent, BENCH_UPDATES / BENCH_CHANGE_PERIOD);
+	zassert_equal(sent + skipped, BENCH_UPDATES);
+	zassert_equal(provider_calls, BENCH_UPDATES);
+	zassert_equal(after.provider_cache_hits - before.provider_cache_hits,
+		      BENCH_UPDATES * (AD_CNT + SD_CNT - 1));
+}
+
+ZTEST_SUITE(suite_bt_adv_prov, NULL, NULL, before_fn, NULL, NULL);
@@ -9,6 +9,8 @@
 #include <string.h>
 #include <math.h>
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
 #include <bluetooth/cs_de.h>
 
 #define NUM_CHANNELS (75)
@@ -16,6 +18,9 @@
 #define PI (3.14159265358979f)
 #define SPEED_OF_LIGHT_M_PER_S (299792458.0f)
 
+/* Number of generated IQ vectors in the IFFT benchmark. */
+#define BENCHMARK_VECTOR_COUNT (200)
+
 /* The unity_main is not declared in any header file. It is only defined in the generated test
  * runner because of ncs' unity configuration. It is therefore declared here to avoid a compiler
  * warning.
@@ -35,6 +40,46 @@ static void generate_ideal_iq_data(float distance, cs_de_iq_tones_t *iq_tones)
 	}
 }
 
+/* Deterministic pseudo random number in the range [0, 1). */
+static float test_random(void)
+{
+	static uint32_t state = 1;
+
+	state = state * 1664525u + 1013904223u;
+
+	return (state >> 8) / 16777216.0f;
+}
+
+static float test_random_range(float min, float max)
+{
+	return min + (max - min) * test_random();
+}
+
+/* Generate combined IQ data of a direct path at a given distance in meters, a weaker reflected
+ * path and noise.
+ */
+static void generate_multipath_iq_data(float distance, float iq_tones_comb[2 * NUM_CHANNELS])
+{
+	float reflection_distance = distance + test_random_range(2.0f, 15.0f);
+	float reflection_amplitude = test_random_range(0.2f, 0.6f);
+	float reflection_phase = test_random_range(0.0f, 2 * PI);
+	float rotation_per_channel =
+		4 * PI * CHANNEL_SPACING_HZ * distance / SPEED_OF_LIGHT_M_PER_S;
+	float reflection_rotation_per_channel =
+		4 * PI * CHANNEL_SPACING_HZ * reflection_distance / SPEED_OF_LIGHT_M_PER_S;
+
+	for (int i = 0; i < NUM_CHANNELS; i++) {
+		float reflection_angle = reflection_phase - reflection_rotation_per_channel * i;
+
+		iq_tones_comb[2 * i] = cosf(-rotation_per_channel * i) +
+				       reflection_amplitude * cosf(reflection_angle) +
+				       test_random_range(-0.15f, 0.15f);
+		iq_tones_comb[2 * i + 1] = sinf(-rotation_per_channel * i) +
+					   reflection_amplitude * sinf(reflection_angle) +
+					   test_random_range(-0.15f, 0.15f);
+	}
+}
+
 void test_cs_de_calc_empty_report(void)
 {
 	cs_de_report_t test_report;
@@ -125,6 +170,77 @@ void test_cs_de_calc_with_ideal_iq_data(void)
 	}
 }
 
+void test_cs_de_ifft_zoom_with_ideal_iq_data(void)
+{
+	static float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+
+	for (float distance = 0.0f; distance < 74.5f; distance += 0.1f) {
+		cs_de_iq_tones_t iq_tones;
+
+		generate_ideal_iq_data(distance, &iq_tones);
+		cs_de_combined_iq_calculate(&iq_tones, iq_tones_comb);
+
+		/* Verify that the estimated distance is within 1 cm of the distance used to
+		 * generate the ideal IQ data.
+		 */
+		TEST_ASSERT_FLOAT_WITHIN(0.01f, distance, cs_de_ifft_zoom(iq_tones_comb));
+	}
+}
+
+void test_cs_de_ifft_zoom_benchmark(void)
+{
+	static float iq_tones_ifft[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+	static float iq_tones_zoom[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+	uint64_t cycles_ifft = 0;
+	uint64_t cycles_zoom = 0;
+	float error_ifft = 0.0f;
+	float error_zoom = 0.0f;
+
+	for (uint32_t i = 0; i < BENCHMARK_VECTOR_COUNT; i++) {
+		float distance = test_random_range(1.0f, 40.0f);
+		float estimate_ifft;
+		float estimate_zoom;
+		uint32_t start;
+
+		memset(iq_tones_ifft, 0, sizeof(iq_tones_ifft));
+		generate_multipath_iq_data(distance, iq_tones_ifft);
+		memcpy(iq_tones_zoom, iq_tones_ifft, sizeof(iq_tones_zoom));
+
+		start = k_cycle_get_32();
+		estimate_ifft = cs_de_ifft(iq_tones_ifft);
+		cycles_ifft += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		estimate_zoom = cs_de_ifft_zoom(iq_tones_zoom);
+		cycles_zoom += k_cycle_get_32() - start;
+
+		TEST_ASSERT_TRUE(isfinite(estimate_ifft));
+		TEST_ASSERT_TRUE(isfinite(estimate_zoom));
+
+		error_ifft += fabsf(estimate_ifft - distance);
+		error_zoom += fabsf(estimate_zoom - distance);
+	}
+
+	error_ifft /= BENCHMARK_VECTOR_COUNT;
+	error_zoom /= BENCHMARK_VECTOR_COUNT;
+
+	/* The cycle count is only meaningful on hardware, simulated time does not advance while
+	 * the estimators run on native_sim.
+	 */
+	printk("NFFT %d, %d vectors\n", CONFIG_BT_CS_DE_NFFT_SIZE, BENCHMARK_VECTOR_COUNT);
+	printk("cs_de_ifft:      mean error %d mm, %llu cycles\n", (int)(error_ifft * 1000.0f),
+	       cycles_ifft / BENCHMARK_VECTOR_COUNT);
+	printk("cs_de_ifft_zoom: mean error %d mm, %llu cycles\n", (int)(error_zoom * 1000.0f),
+	       cycles_zoom / BENCHMARK_VECTOR_COUNT);
+
+	/* The zoomed IFFT has the resolution of the full IFFT. */
+	TEST_ASSERT_FLOAT_WITHIN(0.02f, error_ifft, error_zoom);
+
+	if (!IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		TEST_ASSERT_TRUE(cycles_zoom < cycles_ifft);
+	}
+}
+
 /* Main test entry point */
 int main(void)
 {
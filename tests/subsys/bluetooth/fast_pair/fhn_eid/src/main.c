@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Ephemeral Identifier (EID) calculation of the FHN extension.
+ *
+ * The EID of the next rotation period is precomputed in the background. The test verifies that
+ * the precomputed EID matches the EID calculated synchronously and compares the time needed to
+ * get the EID on rotation in both cases.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "fp_fhn_eid.h"
+#include "fp_storage_eik.h"
+
+#define FHN_CLOCK_START		0x12345
+/* Upper limit for the precomputation, long enough for the slowest supported target. */
+#define PRECOMPUTE_WAIT_MS	1000
+
+static uint8_t eik[FP_STORAGE_EIK_LEN];
+static uint32_t eik_get_cnt;
+
+int fp_storage_eik_get(uint8_t *out)
+{
+	eik_get_cnt++;
+	memcpy(out, eik, sizeof(eik));
+
+	return 0;
+}
+
+static void eik_set(uint8_t seed)
+{
+	for (size_t i = 0; i < sizeof(eik); i++) {
+		eik[i] = seed + i;
+	}
+
+	fp_fhn_eid_invalidate();
+}
+
+static uint32_t eid_get_timed(uint32_t fhn_clock, uint8_t *eid, uint8_t *xor_operand)
+{
+	uint32_t start = k_cycle_get_32();
+
+	zassert_ok(fp_fhn_eid_get(fhn_clock, eid, xor_operand));
+
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static void fhn_eid_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	eik_set(0x10);
+	eik_get_cnt = 0;
+}
+
+ZTEST_SUITE(fhn_eid, NULL, NULL, fhn_eid_before, NULL, NULL);
+
+ZTEST(fhn_eid, test_clock_align)
+{
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t eid_period_end[FP_FHN_EID_LEN];
+	uint8_t eid_next[FP_FHN_EID_LEN];
+	uint8_t xor_operand;
+	uint32_t fhn_clock = fp_fhn_eid_clock_align(FHN_CLOCK_START);
+
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid, &xor_operand));
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock + FP_FHN_EID_ROT_PERIOD - 1, eid_period_end,
+					&xor_operand));
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock + FP_FHN_EID_ROT_PERIOD, eid_next,
+					&xor_operand));
+
+	zassert_mem_equal(eid, eid_period_end, sizeof(eid));
+	zassert_true(memcmp(eid, eid_next, sizeof(eid)) != 0, "EID not rotated");
+}
+
+ZTEST(fhn_eid, test_rotation)
+{
+	uint8_t eid_expected[FP_FHN_EID_LEN];
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand_expected;
+	uint8_t xor_operand;
+	uint32_t fhn_clock = FHN_CLOCK_START + FP_FHN_EID_ROT_PERIOD;
+	uint32_t sync_us;
+	uint32_t rotation_us;
+
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid_expected, &xor_operand_expected));
+
+	/* The EID is calculated on rotation if it was not precomputed. */
+	eik_get_cnt = 0;
+	sync_us = eid_get_timed(fhn_clock, eid, &xor_operand);
+	zassert_equal(eik_get_cnt, 1);
+	zassert_mem_equal(eid, eid_expected, sizeof(eid));
+	zassert_equal(xor_operand, xor_operand_expected);
+
+	/* Precompute the EID during the previous rotation period. */
+	fp_fhn_eid_precompute(fhn_clock);
+	k_sleep(K_MSEC(PRECOMPUTE_WAIT_MS));
+
+	eik_get_cnt = 0;
+	rotation_us = eid_get_timed(fhn_clock, eid, &xor_operand);
+	zassert_mem_equal(eid, eid_expected, sizeof(eid));
+	zassert_equal(xor_operand, xor_operand_expected);
+
+	TC_PRINT("EID on rotation: %u us synchronous, %u us with precompute %s\n", sync_us,
+		 rotation_us, IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE) ? "on" : "off");
+
+	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_FHN_EID_PRECOMPUTE)) {
+		zassert_equal(eik_get_cnt, 0, "EID calculated on rotation");
+		zassert_true(rotation_us < sync_us);
+	} else {
+		zassert_equal(eik_get_cnt, 1);
+	}
+}
+
+ZTEST(fhn_eid, test_precompute_other_period)
+{
+	uint8_t eid_expected[FP_FHN_EID_LEN];
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand_expected;
+	uint8_t xor_operand;
+	uint32_t fhn_clock = FHN_CLOCK_START;
+
+	fp_fhn_eid_precompute(fhn_clock + FP_FHN_EID_ROT_PERIOD);
+	k_sleep(K_MSEC(PRECOMPUTE_WAIT_MS));
+
+	/* The precomputed EID is not used for a different rotation period. */
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid_expected, &xor_operand_expected));
+	zassert_ok(fp_fhn_eid_get(fhn_clock, eid, &xor_operand));
+	zassert_mem_equal(eid, eid_expected, sizeof(eid));
+	zassert_equal(xor_operand, xor_operand_expected);
+}
+
+ZTEST(fhn_eid, test_invalidate)
+{
+	uint8_t eid_old[FP_FHN_EID_LEN];
+	uint8_t eid_expected[FP_FHN_EID_LEN];
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand_expected;
+	uint8_t xor_operand;
+	uint32_t fhn_clock = FHN_CLOCK_START;
+
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid_old, &xor_operand));
+
+	fp_fhn_eid_precompute(fhn_clock);
+	k_sleep(K_MSEC(PRECOMPUTE_WAIT_MS));
+
+	/* The EID precomputed with the previous EIK is dropped. */
+	eik_set(0x80);
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid_expected, &xor_operand_expected));
+	zassert_true(memcmp(eid_old, eid_expected, sizeof(eid_old)) != 0, "EID not changed");
+
+	eik_get_cnt = 0;
+	zassert_ok(fp_fhn_eid_get(fhn_clock, eid, &xor_operand));
+	zassert_equal(eik_get_cnt, 1);
+	zassert_mem_equal(eid, eid_expected, sizeof(eid));
+	zassert_equal(xor_operand, xor_operand_expected);
+}
+
+ZTEST(fhn_eid, test_invalidate_ongoing)
+{
+	uint8_t eid_expected[FP_FHN_EID_LEN];
+	uint8_t eid[FP_FHN_EID_LEN];
+	uint8_t xor_operand_expected;
+	uint8_t xor_operand;
+	uint32_t fhn_clock = FHN_CLOCK_START;
+
+	/* The EIK changes before the precomputation is done. */
+	fp_fhn_eid_precompute(fhn_clock);
+	eik_set(0x80);
+	k_sleep(K_MSEC(PRECOMPUTE_WAIT_MS));
+
+	zassert_ok(fp_fhn_eid_calculate(fhn_clock, eid_expected, &xor_operand_expected));
+	zassert_ok(fp_fhn_eid_get(fhn_clock, eid, &xor_operand));
+	zassert_mem_equal(eid, eid_expected, sizeof(eid));
+	zassert_equal(xor_operand, xor_operand_expected);
+}
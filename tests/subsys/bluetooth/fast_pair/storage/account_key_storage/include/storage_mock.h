@@ -16,6 +16,8 @@
  * @{
  */
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,6 +28,14 @@ extern "C" {
  */
 void storage_mock_clear(void);
 
+/** Get the number of save operations.
+ *
+ * The number includes the delete operations. It is reset by @ref storage_mock_clear.
+ *
+ * @return Number of save operations performed on the mocked storage.
+ */
+uint32_t storage_mock_save_cnt_get(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,7 +19,7 @@ struct settings_data {
 };
 
 static sys_slist_t settings_list;
-
+static uint32_t save_cnt;
 
 void storage_mock_clear(void)
 {
@@ -31,6 +31,13 @@ void storage_mock_clear(void)
 		k_free(data->name);
 		k_free(data);
 	}
+
+	save_cnt = 0;
+}
+
+uint32_t storage_mock_save_cnt_get(void)
+{
+	return save_cnt;
 }
 
 static ssize_t settings_mock_read_fn(void *back_end, void *data, size_t len)
@@ -75,6 +82,8 @@ static int settings_mock_save(struct settings_store *cs, const char *name, const
 
 	zassert_not_equal(name_len, max_name_len, "Too long settings key");
 
+	save_cnt++;
+
 	sys_snode_t *cur_node;
 
 	/* Update record if exists. */
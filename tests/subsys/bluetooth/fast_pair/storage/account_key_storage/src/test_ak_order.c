@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+
+#include "fp_storage_ak.h"
+#include "fp_storage.h"
+#include "fp_storage_ak_priv.h"
+#include "fp_storage_manager_priv.h"
+#include "fp_common.h"
+
+#include "storage_mock.h"
+#include "common_utils.h"
+
+#define ACCOUNT_KEY_MAX_CNT	CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX
+#define ORDER_SAVE_DELAY_MS	CONFIG_BT_FAST_PAIR_STORAGE_AK_ORDER_SAVE_DELAY
+#define ORDER_SAVE_WAIT_MS	(ORDER_SAVE_DELAY_MS + 50)
+
+/* Benchmark: each peer performs the Key-based Pairing procedure a few times in a row. */
+#define BENCH_ROUNDS		4
+#define BENCH_REPEATS		3
+
+struct ak_find_context {
+	uint8_t seed;
+	uint32_t check_cnt;
+};
+
+static bool ak_find_cb(const struct fp_account_key *account_key, void *context)
+{
+	struct ak_find_context *ctx = context;
+
+	ctx->check_cnt++;
+
+	return cu_check_account_key_seed(ctx->seed, account_key);
+}
+
+/* Find the Account Key and return the number of checked keys. */
+static uint32_t ak_find(uint8_t seed)
+{
+	struct ak_find_context ctx = {
+		.seed = seed,
+	};
+
+	zassert_ok(fp_storage_ak_find(NULL, ak_find_cb, &ctx), "Failed to find Account Key");
+
+	return ctx.check_cnt;
+}
+
+static void before_fn(void *f)
+{
+	ARG_UNUSED(f);
+
+	int err;
+
+	cu_account_keys_validate_uninitialized();
+
+	err = settings_load();
+	zassert_ok(err, "Settings load failed");
+
+	err = fp_storage_init();
+	zassert_ok(err, "Failed to initialize module");
+
+	cu_account_keys_generate_and_store(0, ACCOUNT_KEY_MAX_CNT);
+}
+
+static void after_fn(void *f)
+{
+	ARG_UNUSED(f);
+
+	fp_storage_ak_ram_clear();
+	fp_storage_manager_ram_clear();
+	storage_mock_clear();
+	cu_account_keys_validate_uninitialized();
+}
+
+ZTEST(suite_fast_pair_storage_ak_order, test_recently_used_first)
+{
+	/* The last stored Account Key is the most recently used one. */
+	zassert_equal(ak_find(ACCOUNT_KEY_MAX_CNT - 1), 1);
+
+	/* The first stored Account Key is the least recently used one. */
+	zassert_equal(ak_find(0), ACCOUNT_KEY_MAX_CNT);
+	zassert_equal(ak_find(0), 1);
+	zassert_equal(ak_find(ACCOUNT_KEY_MAX_CNT - 1), 2);
+	zassert_equal(ak_find(0), 2);
+}
+
+ZTEST(suite_fast_pair_storage_ak_order, test_order_save_deferred)
+{
+	uint32_t save_cnt = storage_mock_save_cnt_get();
+
+	/* No save if the most recently used Account Key is found. */
+	ak_find(ACCOUNT_KEY_MAX_CNT - 1);
+	zassert_equal(storage_mock_save_cnt_get(), save_cnt);
+
+	ak_find(0);
+	ak_find(1);
+
+	if (ORDER_SAVE_DELAY_MS == 0) {
+		zassert_equal(storage_mock_save_cnt_get(), save_cnt + 2);
+		return;
+	}
+
+	/* Order updates are saved together after the delay. */
+	zassert_equal(storage_mock_save_cnt_get(), save_cnt);
+	k_sleep(K_MSEC(ORDER_SAVE_WAIT_MS));
+	zassert_equal(storage_mock_save_cnt_get(), save_cnt + 1);
+
+	ak_find(1);
+	k_sleep(K_MSEC(ORDER_SAVE_WAIT_MS));
+	zassert_equal(storage_mock_save_cnt_get(), save_cnt + 1);
+}
+
+ZTEST(suite_fast_pair_storage_ak_order, test_order_save_on_uninit)
+{
+	struct fp_account_key account_key;
+	struct ak_find_context ctx = {
+		.seed = 1,
+	};
+	int err;
+
+	/* The second stored Account Key becomes the least recently used one. */
+	ak_find(0);
+
+	err = fp_storage_uninit();
+	zassert_ok(err, "Failed to uninitialize module");
+
+	err = fp_storage_init();
+	zassert_ok(err, "Failed to initialize module");
+
+	/* The least recently used Account Key is overwritten. */
+	cu_generate_account_key(ACCOUNT_KEY_MAX_CNT, &account_key);
+	err = fp_storage_ak_save(&account_key, NULL);
+	zassert_ok(err, "Failed to store Account Key");
+
+	zassert_true(ak_find(0) > 0);
+	zassert_equal(fp_storage_ak_find(NULL, ak_find_cb, &ctx), -ESRCH,
+		      "Account Key order lost on uninit");
+}
+
+ZTEST(suite_fast_pair_storage_ak_order, test_benchmark)
+{
+	uint32_t lookups = 0;
+	uint32_t checks = 0;
+	uint32_t checks_index_order = 0;
+	uint32_t save_cnt = storage_mock_save_cnt_get();
+	uint32_t order_saves;
+
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint8_t seed = 0; seed < ACCOUNT_KEY_MAX_CNT; seed++) {
+			for (uint8_t i = 0; i < BENCH_REPEATS; i++) {
+				checks += ak_find(seed);
+				/* Keys are checked in storage order without the usage order. */
+				checks_index_order += seed + 1;
+				lookups++;
+			}
+		}
+
+		k_sleep(K_MSEC(ORDER_SAVE_WAIT_MS));
+	}
+
+	order_saves = storage_mock_save_cnt_get() - save_cnt;
+
+	TC_PRINT("%u keys, %u lookups: %u.%02u checks/lookup (%u.%02u in storage order), "
+		 "%u order saves (%u without deferral)\n",
+		 ACCOUNT_KEY_MAX_CNT, lookups,
+		 checks / lookups, (checks * 100 / lookups) % 100,
+		 checks_index_order / lookups, (checks_index_order * 100 / lookups) % 100,
+		 order_saves, lookups);
+
+	zassert_true(checks < checks_index_order);
+	zassert_true(order_saves < lookups);
+	if (ORDER_SAVE_DELAY_MS > 0) {
+		zassert_true(order_saves <= BENCH_ROUNDS);
+	}
+}
+
+ZTEST_SUITE(suite_fast_pair_storage_ak_order, NULL, NULL, before_fn, after_fn, NULL);
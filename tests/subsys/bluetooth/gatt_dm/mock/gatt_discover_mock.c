@@ -5,29 +5,78 @@
  */
 #include <stdbool.h>
 #include <inttypes.h>
+#include <zephyr/bluetooth/att.h>
 #include <zephyr/bluetooth/gatt.h>
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/sys/util.h>
+#include "gatt_discover_mock.h"
 
 
+/* Number of GATT procedures that can be simulated at the same time */
+#define MOCK_REQ_CNT (2 * CONFIG_BT_GATT_DM_MAX_INSTANCES)
+
 /* Settings of the discover mock */
 static struct bt_discover_mock {
 	const struct bt_gatt_attr *attr;
 	size_t len;
+	const uint8_t *db_hash;
+	size_t discover_cnt;
+	size_t read_cnt;
+} discover_mock_data;
+
+/* Simulated GATT procedure */
+static struct bt_discover_mock_req {
 	struct bt_conn *conn;
 	struct bt_gatt_discover_params *params;
+	struct bt_gatt_read_params *read_params;
 	struct k_work_delayable work;
-} discover_mock_data;
+} discover_mock_reqs[MOCK_REQ_CNT];
 
 static void bt_gatt_discover_work(struct k_work *work);
+static void bt_gatt_read_work(struct k_work *work);
 
 void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len)
 {
-	k_work_init_delayable(&discover_mock_data.work, bt_gatt_discover_work);
+	for (size_t i = 0; i < ARRAY_SIZE(discover_mock_reqs); i++) {
+		(void)k_work_cancel_delayable(&discover_mock_reqs[i].work);
+	}
+
 	discover_mock_data.attr = attr;
 	discover_mock_data.len  = len;
+	discover_mock_data.discover_cnt = 0;
+	discover_mock_data.read_cnt = 0;
+}
+
+void bt_gatt_discover_mock_db_hash_set(const uint8_t *db_hash)
+{
+	discover_mock_data.db_hash = db_hash;
+}
+
+size_t bt_gatt_discover_mock_discover_cnt(void)
+{
+	return discover_mock_data.discover_cnt;
+}
+
+size_t bt_gatt_discover_mock_read_cnt(void)
+{
+	return discover_mock_data.read_cnt;
+}
+
+static struct bt_discover_mock_req *bt_gatt_mock_req_alloc(k_work_handler_t handler)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(discover_mock_reqs); i++) {
+		struct bt_discover_mock_req *req = &discover_mock_reqs[i];
+
+		if (!k_work_delayable_busy_get(&req->work)) {
+			k_work_init_delayable(&req->work, handler);
+			return req;
+		}
+	}
+
+	zassert_unreachable("Too many simulated GATT procedures");
+	return NULL;
 }
 
 static bool bt_gatt_primary_check(const struct bt_gatt_attr *attr_cur,
@@ -46,8 +95,8 @@ static bool bt_gatt_primary_check(const struct bt_gatt_attr *attr_cur,
 static void bt_gatt_discover_work(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-	struct bt_discover_mock *mock_data =
-		CONTAINER_OF(dwork, struct bt_discover_mock, work);
+	struct bt_discover_mock_req *mock_data =
+		CONTAINER_OF(dwork, struct bt_discover_mock_req, work);
 	const struct bt_gatt_attr *const attr_end =
 		discover_mock_data.attr + discover_mock_data.len;
 	const struct bt_gatt_attr *attr_cur;
@@ -125,10 +174,47 @@ static void bt_gatt_discover_work(struct k_work *work)
 int bt_gatt_discover(struct bt_conn *conn,
 		     struct bt_gatt_discover_params *params)
 {
+	struct bt_discover_mock_req *req = bt_gatt_mock_req_alloc(bt_gatt_discover_work);
+
+	printk("Running %s mock\n", __func__);
+	discover_mock_data.discover_cnt++;
+	req->conn = conn;
+	req->params = params;
+
+	k_work_schedule(&req->work, K_MSEC(5));
+	return 0;
+}
+
+static void bt_gatt_read_work(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_discover_mock_req *req =
+		CONTAINER_OF(dwork, struct bt_discover_mock_req, work);
+
+	zassert_equal(0, req->read_params->handle_count, "Only read by UUID is simulated");
+	zassert_true(!bt_uuid_cmp(BT_UUID_GATT_DB_HASH, req->read_params->by_uuid.uuid),
+		     "Unexpected UUID");
+
+	if (discover_mock_data.db_hash) {
+		(void)req->read_params->func(req->conn, 0, req->read_params,
+					     discover_mock_data.db_hash,
+					     BT_GATT_DISCOVER_MOCK_DB_HASH_LEN);
+	} else {
+		(void)req->read_params->func(req->conn, BT_ATT_ERR_ATTRIBUTE_NOT_FOUND,
+					     req->read_params, NULL, 0);
+	}
+}
+
+/* Mocked version of the bt_gatt_read, only the Database Hash read is simulated */
+int bt_gatt_read(struct bt_conn *conn, struct bt_gatt_read_params *params)
+{
+	struct bt_discover_mock_req *req = bt_gatt_mock_req_alloc(bt_gatt_read_work);
+
 	printk("Running %s mock\n", __func__);
-	discover_mock_data.conn = conn;
-	discover_mock_data.params = params;
+	discover_mock_data.read_cnt++;
+	req->conn = conn;
+	req->read_params = params;
 
-	k_work_schedule(&discover_mock_data.work, K_MSEC(5));
+	k_work_schedule(&req->work, K_MSEC(5));
 	return 0;
 }
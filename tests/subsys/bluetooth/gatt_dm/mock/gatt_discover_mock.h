@@ -90,5 +90,33 @@
  */
 void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len);
 
+/** @brief Length of the GATT Database Hash. */
+#define BT_GATT_DISCOVER_MOCK_DB_HASH_LEN 16
+
+/**
+ * @brief GATT Database Hash setup
+ *
+ * This function sets the value returned by the @ref bt_gatt_read mock
+ * when the GATT Database Hash is read.
+ *
+ * @param db_hash The hash of @ref BT_GATT_DISCOVER_MOCK_DB_HASH_LEN bytes
+ *                or NULL if the characteristic should not be found.
+ */
+void bt_gatt_discover_mock_db_hash_set(const uint8_t *db_hash);
+
+/**
+ * @brief Get the number of discovery procedures
+ *
+ * @return The number of @ref bt_gatt_discover calls since the mock setup.
+ */
+size_t bt_gatt_discover_mock_discover_cnt(void);
+
+/**
+ * @brief Get the number of read procedures
+ *
+ * @return The number of @ref bt_gatt_read calls since the mock setup.
+ */
+size_t bt_gatt_discover_mock_read_cnt(void);
+
 /** @} */
 #endif /* #define BT_GATT_DISCOVERY_MOCK_H_ */
@@ -8,6 +8,9 @@
 #include <stddef.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/bluetooth/uuid.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/sys/iterable_sections.h>
 #include <bluetooth/gatt_dm.h>
 #include "../mock/gatt_discover_mock.h"
 
@@ -20,6 +23,9 @@
 static char dummy_conn;
 K_SEM_DEFINE(discovery_finished, 0, 1);
 
+static const uint8_t db_hash_1[BT_GATT_DISCOVER_MOCK_DB_HASH_LEN] = {0x01};
+static const uint8_t db_hash_2[BT_GATT_DISCOVER_MOCK_DB_HASH_LEN] = {0x02};
+
 
 const struct bt_gatt_attr discover_sim[] = {
 	/* HIDS */
@@ -93,6 +99,7 @@ void test_before(void *fixture)
 
 	k_sem_reset(&discovery_finished);
 	bt_gatt_discover_mock_setup(discover_sim, ARRAY_SIZE(discover_sim));
+	bt_gatt_discover_mock_db_hash_set(db_hash_1);
 }
 
 struct bt_gatt_dm *run_dm(const struct bt_uuid *svc_uuid)
@@ -476,3 +483,210 @@ ZTEST(gatt_tests, test_gatt_many_serv_by_uuid)
 	zassert_equal(0, bt_gatt_dm_attr_cnt(dm), "Parameter count after clearing: %d",
 		      bt_gatt_dm_attr_cnt(dm));
 }
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+
+static char dummy_conn_2;
+static bt_addr_le_t peer_addr;
+K_SEM_DEFINE(concurrent_finished, 0, 2);
+
+/* Connection information of the peer, used by the discovery cache */
+int __wrap_bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
+{
+	memset(info, 0, sizeof(*info));
+	info->type = BT_CONN_TYPE_LE;
+	info->le.dst = &peer_addr;
+
+	return 0;
+}
+
+static void hids_check_release(struct bt_gatt_dm *dm)
+{
+	const struct bt_gatt_dm_attr *attr;
+	const struct bt_gatt_chrc *chrc_val;
+
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(11, bt_gatt_dm_attr_cnt(dm), "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+	zassert_true(!bt_uuid_cmp(BT_UUID_HIDS,
+				  bt_gatt_dm_attr_service_val(bt_gatt_dm_service_get(dm))->uuid),
+		     "Invalid service detected");
+	zassert_equal(11, bt_gatt_dm_attr_service_val(bt_gatt_dm_service_get(dm))->end_handle);
+
+	attr = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_REPORT);
+	zassert_not_null(attr, "Unexpected NULL");
+	zassert_equal(6, attr->handle, "Unexpected handle: %d", attr->handle);
+	chrc_val = bt_gatt_dm_attr_chrc_val(attr);
+	zassert_equal(BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY, chrc_val->properties,
+		      "Unexpected HIDS_REPORT properties");
+
+	attr = bt_gatt_dm_desc_by_uuid(dm, attr, BT_UUID_GATT_CCC);
+	zassert_not_null(attr, "Unexpected NULL");
+	zassert_equal(8, attr->handle, "Unexpected handle: %d", attr->handle);
+
+	zassert_ok(bt_gatt_dm_data_release(dm));
+}
+
+static void cache_before(void *fixture)
+{
+	static uint8_t peer_id;
+
+	test_before(fixture);
+
+	/* Each test uses a different peer with a static random address. */
+	peer_addr.type = BT_ADDR_LE_RANDOM;
+	memset(peer_addr.a.val, 0, sizeof(peer_addr.a.val));
+	peer_addr.a.val[0] = ++peer_id;
+	peer_addr.a.val[5] = 0xc0;
+}
+
+static void cache_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_addr_le_copy(&peer_addr, BT_ADDR_LE_ANY);
+}
+
+ZTEST_SUITE(gatt_cache_tests, NULL, NULL, cache_before, cache_after, NULL);
+
+ZTEST(gatt_cache_tests, test_cache_hit)
+{
+	size_t discover_cnt;
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	discover_cnt = bt_gatt_discover_mock_discover_cnt();
+	zassert_true(discover_cnt > 0, "Service was not discovered");
+	zassert_equal(1, bt_gatt_discover_mock_read_cnt());
+
+	/* The Database Hash is read at every start, the result is taken from the cache. */
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	zassert_equal(discover_cnt, bt_gatt_discover_mock_discover_cnt());
+	zassert_equal(2, bt_gatt_discover_mock_read_cnt());
+}
+
+ZTEST(gatt_cache_tests, test_cache_db_changed)
+{
+	size_t discover_cnt;
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	discover_cnt = bt_gatt_discover_mock_discover_cnt();
+
+	/* The database changed during the connection, as after a Service Changed indication. */
+	bt_gatt_discover_mock_db_hash_set(db_hash_2);
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	zassert_equal(2 * discover_cnt, bt_gatt_discover_mock_discover_cnt(),
+		      "Service was not discovered again");
+	zassert_equal(2, bt_gatt_discover_mock_read_cnt());
+
+	/* The result discovered with the new hash is cached. */
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	zassert_equal(2 * discover_cnt, bt_gatt_discover_mock_discover_cnt());
+}
+
+ZTEST(gatt_cache_tests, test_cache_no_db_hash)
+{
+	size_t discover_cnt;
+
+	bt_gatt_discover_mock_db_hash_set(NULL);
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	discover_cnt = bt_gatt_discover_mock_discover_cnt();
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	zassert_equal(2 * discover_cnt, bt_gatt_discover_mock_discover_cnt());
+	zassert_equal(2, bt_gatt_discover_mock_read_cnt());
+}
+
+ZTEST(gatt_cache_tests, test_cache_rpa)
+{
+	size_t discover_cnt;
+
+	/* Resolvable private address */
+	peer_addr.a.val[5] = 0x40;
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	discover_cnt = bt_gatt_discover_mock_discover_cnt();
+
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	zassert_equal(2 * discover_cnt, bt_gatt_discover_mock_discover_cnt());
+	zassert_equal(0, bt_gatt_discover_mock_read_cnt());
+}
+
+ZTEST(gatt_cache_tests, test_cache_not_found)
+{
+	size_t discover_cnt;
+
+	zassert_is_null(run_dm(BT_UUID_BAS), "Detected service that should be inviable");
+	discover_cnt = bt_gatt_discover_mock_discover_cnt();
+
+	zassert_is_null(run_dm(BT_UUID_BAS), "Detected service that should be inviable");
+	zassert_equal(discover_cnt, bt_gatt_discover_mock_discover_cnt());
+}
+
+ZTEST(gatt_cache_tests, test_cache_reconnect_time)
+{
+	int64_t start;
+	uint32_t discovery_ms;
+	uint32_t cache_ms;
+
+	start = k_uptime_get();
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	discovery_ms = k_uptime_delta(&start);
+
+	/* Discovery started again after a reconnection. */
+	start = k_uptime_get();
+	hids_check_release(run_dm(BT_UUID_HIDS));
+	cache_ms = k_uptime_delta(&start);
+
+	TC_PRINT("Reconnect-to-ready time: discovery %u ms, cache %u ms\n", discovery_ms,
+		 cache_ms);
+	zassert_true(cache_ms < discovery_ms, "Cache did not reduce the reconnect-to-ready time");
+}
+
+static void concurrent_cb_completed(struct bt_gatt_dm *dm, void *context)
+{
+	*(struct bt_gatt_dm **)context = dm;
+	k_sem_give(&concurrent_finished);
+}
+
+static const struct bt_gatt_dm_cb concurrent_cb = {
+	.completed         = concurrent_cb_completed,
+	.service_not_found = test_cb_service_not_found,
+	.error_found       = test_cb_error_found
+};
+
+ZTEST(gatt_cache_tests, test_concurrent)
+{
+	struct bt_gatt_dm *dm_hids = NULL;
+	struct bt_gatt_dm *dm_dis = NULL;
+	struct bt_gatt_dm *dm_none;
+
+	if (CONFIG_BT_GATT_DM_MAX_INSTANCES != 2) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&concurrent_finished);
+
+	zassert_ok(bt_gatt_dm_start((struct bt_conn *)&dummy_conn, BT_UUID_HIDS, &concurrent_cb,
+				    &dm_hids));
+	zassert_ok(bt_gatt_dm_start((struct bt_conn *)&dummy_conn_2, BT_UUID_DIS, &concurrent_cb,
+				    &dm_dis));
+	zassert_equal(-EALREADY, bt_gatt_dm_start((struct bt_conn *)&dummy_conn, BT_UUID_HRS,
+						  &concurrent_cb, &dm_none),
+		      "All instances should be in use");
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(k_sem_take(&concurrent_finished, K_MSEC(SERVICE_DISCOVERY_TIMEOUT)));
+	}
+
+	zassert_not_equal(dm_hids, dm_dis, "Discoveries share the same instance");
+	zassert_equal_ptr((struct bt_conn *)&dummy_conn, bt_gatt_dm_conn_get(dm_hids));
+	zassert_equal_ptr((struct bt_conn *)&dummy_conn_2, bt_gatt_dm_conn_get(dm_dis));
+	zassert_equal(5, bt_gatt_dm_attr_cnt(dm_dis), "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm_dis));
+	zassert_ok(bt_gatt_dm_data_release(dm_dis));
+	hids_check_release(dm_hids);
+}
+
+#endif /* CONFIG_BT_GATT_DM_CACHE */
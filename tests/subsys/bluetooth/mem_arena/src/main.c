@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#include <bluetooth/conn_ctx.h>
+#include <bluetooth/gatt_pool.h>
+#include <bluetooth/mem_arena.h>
+
+#define CONN_CNT	CONFIG_BT_MAX_CONN
+#define CTX_SIZE	40
+#define CTX_MAX_CLIENTS	2
+
+/* Benchmark: connections of a multi-role product come and go. */
+#define BENCH_ROUNDS	16
+#define BENCH_ACTIVE	2
+
+BUILD_ASSERT(CTX_MAX_CLIENTS < CONN_CNT);
+BUILD_ASSERT(BENCH_ACTIVE <= CTX_MAX_CLIENTS);
+
+BT_CONN_CTX_DEF(ctx_small, CTX_MAX_CLIENTS, CTX_SIZE);
+BT_CONN_CTX_DEF(ctx_full, CONN_CNT, CTX_SIZE);
+
+/* Connection objects are only compared, so any memory can be used. */
+static uint8_t conn_mem[CONN_CNT][sizeof(void *)];
+
+#define CONN(_i) ((struct bt_conn *)conn_mem[_i])
+
+static struct bt_gatt_pool gp = BT_GATT_POOL_INIT(6);
+static struct bt_gatt_ccc_managed_user_data ccc;
+
+uint8_t __wrap_bt_conn_index(const struct bt_conn *conn)
+{
+	size_t index = ((const uint8_t *)conn - &conn_mem[0][0]) / sizeof(conn_mem[0]);
+
+	__ASSERT(index < CONN_CNT, "Unknown connection object");
+
+	return index;
+}
+
+static size_t user_used_get(enum bt_mem_arena_user user)
+{
+	struct bt_mem_arena_stats stats;
+
+	zassert_ok(bt_mem_arena_stats_get(user, &stats));
+
+	return stats.used;
+}
+
+static size_t total_used_get(void)
+{
+	struct bt_mem_arena_stats stats;
+
+	bt_mem_arena_stats_total_get(&stats);
+
+	return stats.used;
+}
+
+static void *ctx_alloc(struct bt_conn_ctx_lib *ctx_lib, uint8_t index)
+{
+	void *data = bt_conn_ctx_alloc(ctx_lib, CONN(index));
+
+	if (data) {
+		bt_conn_ctx_release(ctx_lib, data);
+	}
+
+	return data;
+}
+
+static void *ctx_get(struct bt_conn_ctx_lib *ctx_lib, uint8_t index)
+{
+	void *data = bt_conn_ctx_get(ctx_lib, CONN(index));
+
+	if (data) {
+		bt_conn_ctx_release(ctx_lib, data);
+	}
+
+	return data;
+}
+
+static void before_fn(void *f)
+{
+	ARG_UNUSED(f);
+
+	zassert_equal(total_used_get(), 0, "Memory arena not empty");
+}
+
+static void after_fn(void *f)
+{
+	ARG_UNUSED(f);
+
+	bt_conn_ctx_free_all(&ctx_small_ctx_lib);
+	bt_conn_ctx_free_all(&ctx_full_ctx_lib);
+}
+
+ZTEST(suite_bt_mem_arena, test_conn_ctx_lookup)
+{
+	void *data[CONN_CNT];
+	const struct bt_conn_ctx *ctx;
+
+	/* Contexts are stored at the index of the connection. */
+	for (int i = CONN_CNT - 1; i >= 0; i--) {
+		data[i] = ctx_alloc(&ctx_full_ctx_lib, i);
+		zassert_not_null(data[i]);
+	}
+
+	for (uint8_t i = 0; i < CONN_CNT; i++) {
+		zassert_equal_ptr(ctx_get(&ctx_full_ctx_lib, i), data[i]);
+
+		ctx = bt_conn_ctx_get_by_id(&ctx_full_ctx_lib, i);
+		zassert_not_null(ctx);
+		zassert_equal_ptr(ctx->conn, CONN(i));
+		bt_conn_ctx_release(&ctx_full_ctx_lib, ctx->data);
+	}
+
+	zassert_ok(bt_conn_ctx_free(&ctx_full_ctx_lib, CONN(1)));
+	zassert_is_null(ctx_get(&ctx_full_ctx_lib, 1));
+	zassert_is_null(bt_conn_ctx_get_by_id(&ctx_full_ctx_lib, 1));
+	zassert_equal(bt_conn_ctx_free(&ctx_full_ctx_lib, CONN(1)), -EINVAL);
+
+	/* A context is allocated only once for a connection. */
+	zassert_is_null(ctx_alloc(&ctx_full_ctx_lib, 0));
+}
+
+ZTEST(suite_bt_mem_arena, test_conn_ctx_budget)
+{
+	size_t block_size = bt_conn_ctx_block_size_get(&ctx_small_ctx_lib);
+	struct bt_mem_arena_stats stats;
+
+	zassert_equal(block_size, ROUND_UP(CTX_SIZE, CONFIG_BT_CONN_CTX_MEM_BUF_ALIGN));
+
+	/* The memory is used only by the connected clients. */
+	zassert_not_null(ctx_alloc(&ctx_small_ctx_lib, 0));
+	if (IS_ENABLED(CONFIG_BT_CONN_CTX_MEM_ARENA)) {
+		zassert_equal(user_used_get(BT_MEM_ARENA_USER_CONN_CTX), block_size);
+	}
+
+	/* The maximum number of clients of the instance limits the allocations. */
+	zassert_not_null(ctx_alloc(&ctx_small_ctx_lib, CONN_CNT - 1));
+	zassert_is_null(ctx_alloc(&ctx_small_ctx_lib, 1));
+	if (IS_ENABLED(CONFIG_BT_CONN_CTX_MEM_ARENA)) {
+		zassert_equal(user_used_get(BT_MEM_ARENA_USER_CONN_CTX), 2 * block_size);
+	}
+
+	zassert_ok(bt_conn_ctx_free(&ctx_small_ctx_lib, CONN(0)));
+	zassert_not_null(ctx_alloc(&ctx_small_ctx_lib, 1));
+	zassert_not_null(ctx_get(&ctx_small_ctx_lib, 1));
+	zassert_is_null(ctx_get(&ctx_small_ctx_lib, 0));
+
+	bt_conn_ctx_free_all(&ctx_small_ctx_lib);
+
+	zassert_ok(bt_mem_arena_stats_get(BT_MEM_ARENA_USER_CONN_CTX, &stats));
+	zassert_equal(stats.used, 0);
+	if (IS_ENABLED(CONFIG_BT_CONN_CTX_MEM_ARENA)) {
+		zassert_true(stats.max_used >= 2 * block_size);
+	} else {
+		/* The memory slabs are used instead of the arena. */
+		zassert_equal(stats.max_used, 0);
+	}
+}
+
+ZTEST(suite_bt_mem_arena, test_gatt_pool)
+{
+	struct bt_uuid_128 svc_uuid = BT_UUID_INIT_128(BT_UUID_128_ENCODE(
+		0x12345678, 0x1234, 0x5678, 0x1234, 0x56789abcdef0));
+	struct bt_uuid_128 chrc_uuid = BT_UUID_INIT_128(BT_UUID_128_ENCODE(
+		0x12345678, 0x1234, 0x5678, 0x1234, 0x56789abcdef1));
+	size_t expected_used = 2 * sizeof(struct bt_uuid_128) +
+			       sizeof(struct bt_gatt_chrc) +
+			       sizeof(struct bt_uuid_16);
+	struct bt_mem_arena_stats stats;
+
+	BT_GATT_POOL_SVC(&gp, &svc_uuid.uuid);
+	BT_GATT_POOL_CHRC(&gp, &chrc_uuid.uuid, BT_GATT_CHRC_NOTIFY, BT_GATT_PERM_NONE,
+			  NULL, NULL, NULL);
+	BT_GATT_POOL_CCC(&gp, ccc, NULL, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE);
+	BT_GATT_POOL_DESC(&gp, BT_UUID_GATT_CUD, BT_GATT_PERM_READ, NULL, NULL, NULL);
+
+	zassert_equal(gp.svc.attr_count, 5);
+	zassert_equal(bt_uuid_cmp(gp.svc.attrs[0].user_data, &svc_uuid.uuid), 0);
+	zassert_equal(bt_uuid_cmp(gp.svc.attrs[2].uuid, &chrc_uuid.uuid), 0);
+	zassert_equal(bt_uuid_cmp(gp.svc.attrs[4].uuid, BT_UUID_GATT_CUD), 0);
+	zassert_equal(user_used_get(BT_MEM_ARENA_USER_GATT_POOL), expected_used);
+
+	bt_gatt_pool_stats_print();
+	bt_gatt_pool_free(&gp);
+
+	zassert_ok(bt_mem_arena_stats_get(BT_MEM_ARENA_USER_GATT_POOL, &stats));
+	zassert_equal(stats.used, 0);
+	zassert_true(stats.max_used >= expected_used);
+}
+
+ZTEST(suite_bt_mem_arena, test_arena_full)
+{
+	void *blocks[CONFIG_BT_MEM_ARENA_SIZE / CTX_SIZE];
+	size_t cnt = 0;
+	struct bt_mem_arena_stats before;
+	struct bt_mem_arena_stats after;
+
+	bt_mem_arena_stats_total_get(&before);
+
+	while (cnt < ARRAY_SIZE(blocks)) {
+		blocks[cnt] = bt_mem_arena_alloc(BT_MEM_ARENA_USER_GATT_POOL, CTX_SIZE,
+						 sizeof(void *));
+		if (!blocks[cnt]) {
+			break;
+		}
+
+		cnt++;
+	}
+
+	zassert_true(cnt > 0);
+	zassert_true(cnt < ARRAY_SIZE(blocks), "Arena larger than its budget");
+
+	if (IS_ENABLED(CONFIG_BT_CONN_CTX_MEM_ARENA)) {
+		/* Connection contexts share the budget with the attributes. */
+		zassert_is_null(ctx_alloc(&ctx_full_ctx_lib, 0));
+
+		bt_mem_arena_stats_total_get(&after);
+		zassert_equal(after.alloc_failed, before.alloc_failed + 2);
+	} else {
+		/* Connection contexts use their own memory slabs. */
+		zassert_not_null(ctx_alloc(&ctx_full_ctx_lib, 0));
+		zassert_ok(bt_conn_ctx_free(&ctx_full_ctx_lib, CONN(0)));
+
+		bt_mem_arena_stats_total_get(&after);
+		zassert_equal(after.alloc_failed, before.alloc_failed + 1);
+	}
+
+	zassert_true(after.max_used >= cnt * CTX_SIZE);
+
+	for (size_t i = 0; i < cnt; i++) {
+		bt_mem_arena_free(BT_MEM_ARENA_USER_GATT_POOL, blocks[i], CTX_SIZE);
+	}
+
+	zassert_not_null(ctx_alloc(&ctx_full_ctx_lib, 0));
+}
+
+ZTEST(suite_bt_mem_arena, test_benchmark)
+{
+	size_t block_size = bt_conn_ctx_block_size_get(&ctx_full_ctx_lib);
+	size_t used;
+	size_t peak = 0;
+	size_t fixed;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_BT_CONN_CTX_MEM_ARENA);
+
+	/* A few clients are connected at a time to each of the two instances. */
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++) {
+		uint8_t index = round % CONN_CNT;
+
+		zassert_not_null(ctx_alloc(&ctx_full_ctx_lib, index));
+		zassert_not_null(ctx_alloc(&ctx_small_ctx_lib, index));
+
+		used = total_used_get();
+		peak = MAX(peak, used);
+
+		if (round >= (BENCH_ACTIVE - 1)) {
+			uint8_t oldest = (round - (BENCH_ACTIVE - 1)) % CONN_CNT;
+
+			zassert_ok(bt_conn_ctx_free(&ctx_full_ctx_lib, CONN(oldest)));
+			zassert_ok(bt_conn_ctx_free(&ctx_small_ctx_lib, CONN(oldest)));
+		}
+	}
+
+	/* Memory slabs of the instances are sized for the maximum number of clients. */
+	fixed = (CONN_CNT + CTX_MAX_CLIENTS) * block_size;
+
+	TC_PRINT("%u connections, %u active: %zu bytes used at peak, "
+		 "%zu bytes in memory slabs\n", CONN_CNT, BENCH_ACTIVE, peak, fixed);
+
+	zassert_equal(peak, 2 * BENCH_ACTIVE * block_size);
+	zassert_true(peak < fixed);
+}
+
+ZTEST_SUITE(suite_bt_mem_arena, NULL, NULL, before_fn, after_fn, NULL);
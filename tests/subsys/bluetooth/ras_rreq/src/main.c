@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Ranging data parser of the RAS RREQ.
+ *
+ * The peer ranging data is fed to the parser in segments of different sizes, as done when the
+ * ranging data is parsed while it is received. The steps reported by the parser must match the
+ * steps reported when the complete ranging data is parsed at once.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <bluetooth/services/ras.h>
+
+#define SUBEVENT_CNT	   3
+#define STEPS_PER_SUBEVENT 10
+#define STEP_CNT	   (SUBEVENT_CNT * STEPS_PER_SUBEVENT)
+#define STEP_DATA_LEN	   6
+
+/* Mode 0 steps of the peer (reflector) have a different length than the local steps. */
+#define PEER_MODE_0_LEN	   sizeof(struct bt_hci_le_cs_step_data_mode_0_reflector)
+#define LOCAL_MODE_0_LEN   sizeof(struct bt_hci_le_cs_step_data_mode_0_initiator)
+
+#define PEER_DATA_SIZE                                                                             \
+	(BT_RAS_RANGING_HEADER_LEN + SUBEVENT_CNT * BT_RAS_SUBEVENT_HEADER_LEN +                    \
+	 STEP_CNT * (1 + MAX(STEP_DATA_LEN, PEER_MODE_0_LEN)))
+#define LOCAL_DATA_SIZE (STEP_CNT * (3 + MAX(STEP_DATA_LEN, LOCAL_MODE_0_LEN)))
+
+struct parsed_step {
+	uint8_t mode;
+	uint8_t channel;
+	uint8_t local_data;
+	uint8_t peer_data;
+	uint8_t peer_data_len;
+};
+
+struct parse_result {
+	uint8_t antenna_paths_mask;
+	uint8_t subevent_cnt;
+	uint8_t step_cnt;
+	uint8_t stop_at_step;
+	struct parsed_step steps[STEP_CNT];
+};
+
+static uint8_t peer_data[PEER_DATA_SIZE];
+static uint16_t peer_data_len;
+static uint8_t local_data[LOCAL_DATA_SIZE];
+static uint16_t local_data_len;
+
+NET_BUF_SIMPLE_DEFINE_STATIC(peer_buf, PEER_DATA_SIZE);
+NET_BUF_SIMPLE_DEFINE_STATIC(local_buf, LOCAL_DATA_SIZE);
+
+static struct parse_result expected;
+static struct parse_result result;
+
+static bool ranging_header_cb(struct ras_ranging_header *ranging_header, void *user_data)
+{
+	struct parse_result *res = user_data;
+
+	res->antenna_paths_mask = ranging_header->antenna_paths_mask;
+
+	return true;
+}
+
+static bool subevent_header_cb(struct ras_subevent_header *subevent_header, void *user_data)
+{
+	struct parse_result *res = user_data;
+
+	res->subevent_cnt++;
+
+	return true;
+}
+
+static bool step_data_cb(struct bt_le_cs_subevent_step *local_step,
+			 struct bt_le_cs_subevent_step *peer_step, void *user_data)
+{
+	struct parse_result *res = user_data;
+
+	zassert_true(res->step_cnt < STEP_CNT);
+
+	res->steps[res->step_cnt] = (struct parsed_step) {
+		.mode = local_step->mode,
+		.channel = local_step->channel,
+		.local_data = local_step->data[local_step->data_len - 1],
+		.peer_data = peer_step->data[peer_step->data_len - 1],
+		.peer_data_len = peer_step->data_len,
+	};
+	res->step_cnt++;
+
+	return res->step_cnt != res->stop_at_step;
+}
+
+/* Generate ranging data of the initiator, with a mode 0 step at the start of each subevent. */
+static void ranging_data_generate(void)
+{
+	struct ras_ranging_header ranging_header = {
+		.ranging_counter = 1,
+		.antenna_paths_mask = BIT(0),
+	};
+	struct ras_subevent_header subevent_header = {
+		.num_steps_reported = STEPS_PER_SUBEVENT,
+	};
+	uint8_t step = 0;
+
+	peer_data_len = 0;
+	local_data_len = 0;
+
+	memcpy(&peer_data[peer_data_len], &ranging_header, sizeof(ranging_header));
+	peer_data_len += sizeof(ranging_header);
+
+	for (uint8_t i = 0; i < SUBEVENT_CNT; i++) {
+		memcpy(&peer_data[peer_data_len], &subevent_header, sizeof(subevent_header));
+		peer_data_len += sizeof(subevent_header);
+
+		for (uint8_t j = 0; j < STEPS_PER_SUBEVENT; j++) {
+			uint8_t mode = (j == 0) ? 0 : 1;
+			uint8_t local_len = (mode == 0) ? LOCAL_MODE_0_LEN : STEP_DATA_LEN;
+			uint8_t peer_len = (mode == 0) ? PEER_MODE_0_LEN : STEP_DATA_LEN;
+
+			local_data[local_data_len++] = mode;
+			local_data[local_data_len++] = 2 + step;
+			local_data[local_data_len++] = local_len;
+			memset(&local_data[local_data_len], step, local_len);
+			local_data_len += local_len;
+
+			peer_data[peer_data_len++] = mode;
+			memset(&peer_data[peer_data_len], 0x80 | step, peer_len);
+			peer_data_len += peer_len;
+
+			step++;
+		}
+	}
+}
+
+static void buffers_reset(void)
+{
+	net_buf_simple_reset(&peer_buf);
+	net_buf_simple_reset(&local_buf);
+	memset(&result, 0, sizeof(result));
+}
+
+static void *ras_rreq_setup(void)
+{
+	ranging_data_generate();
+
+	/* Parse the complete ranging data at once. */
+	net_buf_simple_add_mem(&peer_buf, peer_data, peer_data_len);
+	net_buf_simple_add_mem(&local_buf, local_data, local_data_len);
+
+	bt_ras_rreq_rd_subevent_data_parse(&peer_buf, &local_buf, BT_CONN_LE_CS_ROLE_INITIATOR,
+					   ranging_header_cb, subevent_header_cb, step_data_cb,
+					   &expected);
+
+	zassert_equal(peer_buf.len, 0);
+	zassert_equal(local_buf.len, 0);
+
+	return NULL;
+}
+
+static void ras_rreq_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	buffers_reset();
+}
+
+ZTEST_SUITE(ras_rreq, NULL, ras_rreq_setup, ras_rreq_before, NULL, NULL);
+
+ZTEST(ras_rreq, test_parse_complete)
+{
+	zassert_equal(expected.antenna_paths_mask, BIT(0));
+	zassert_equal(expected.subevent_cnt, SUBEVENT_CNT);
+	zassert_equal(expected.step_cnt, STEP_CNT);
+
+	for (uint8_t i = 0; i < STEP_CNT; i++) {
+		zassert_equal(expected.steps[i].channel, 2 + i);
+		zassert_equal(expected.steps[i].local_data, i);
+		zassert_equal(expected.steps[i].peer_data, 0x80 | i);
+		zassert_equal(expected.steps[i].peer_data_len,
+			      expected.steps[i].mode == 0 ? PEER_MODE_0_LEN : STEP_DATA_LEN);
+	}
+}
+
+ZTEST(ras_rreq, test_parse_segments)
+{
+	struct bt_ras_rreq_rd_parser parser;
+
+	for (uint16_t segment_len = 1; segment_len <= 40; segment_len++) {
+		buffers_reset();
+		net_buf_simple_add_mem(&local_buf, local_data, local_data_len);
+		bt_ras_rreq_rd_parser_init(&parser, BT_CONN_LE_CS_ROLE_INITIATOR,
+					   ranging_header_cb, subevent_header_cb, step_data_cb,
+					   &result);
+
+		for (uint16_t offset = 0; offset < peer_data_len; offset += segment_len) {
+			uint16_t len = MIN(segment_len, peer_data_len - offset);
+
+			net_buf_simple_add_mem(&peer_buf, &peer_data[offset], len);
+			zassert_ok(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf));
+		}
+
+		zassert_equal(peer_buf.len, 0);
+		zassert_equal(local_buf.len, 0);
+		zassert_equal(parser.steps_parsed, STEP_CNT);
+		zassert_mem_equal(&result, &expected, sizeof(result), "Segment length %u",
+				  segment_len);
+	}
+}
+
+ZTEST(ras_rreq, test_parse_local_data_late)
+{
+	struct bt_ras_rreq_rd_parser parser;
+	uint16_t local_offset = 0;
+
+	bt_ras_rreq_rd_parser_init(&parser, BT_CONN_LE_CS_ROLE_INITIATOR, ranging_header_cb,
+				   subevent_header_cb, step_data_cb, &result);
+
+	/* The complete peer data is received before the local step data. */
+	net_buf_simple_add_mem(&peer_buf, peer_data, peer_data_len);
+	zassert_ok(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf));
+	zassert_equal(parser.steps_parsed, 0);
+
+	while (local_offset < local_data_len) {
+		uint16_t len = MIN(7, local_data_len - local_offset);
+
+		net_buf_simple_add_mem(&local_buf, &local_data[local_offset], len);
+		local_offset += len;
+		zassert_ok(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf));
+	}
+
+	zassert_equal(peer_buf.len, 0);
+	zassert_equal(local_buf.len, 0);
+	zassert_mem_equal(&result, &expected, sizeof(result));
+}
+
+ZTEST(ras_rreq, test_parse_stopped)
+{
+	struct bt_ras_rreq_rd_parser parser;
+
+	result.stop_at_step = 5;
+
+	bt_ras_rreq_rd_parser_init(&parser, BT_CONN_LE_CS_ROLE_INITIATOR, ranging_header_cb,
+				   subevent_header_cb, step_data_cb, &result);
+
+	net_buf_simple_add_mem(&peer_buf, peer_data, peer_data_len);
+	net_buf_simple_add_mem(&local_buf, local_data, local_data_len);
+
+	zassert_equal(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf), -ECANCELED);
+	zassert_equal(result.step_cnt, 5);
+
+	/* The parser does not continue after it was stopped. */
+	zassert_equal(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf), -ECANCELED);
+	zassert_equal(result.step_cnt, 5);
+}
+
+ZTEST(ras_rreq, test_parse_peer_step_aborted)
+{
+	struct bt_ras_rreq_rd_parser parser;
+	uint16_t step_offset = BT_RAS_RANGING_HEADER_LEN + BT_RAS_SUBEVENT_HEADER_LEN;
+
+	bt_ras_rreq_rd_parser_init(&parser, BT_CONN_LE_CS_ROLE_INITIATOR, ranging_header_cb,
+				   subevent_header_cb, step_data_cb, &result);
+
+	net_buf_simple_add_mem(&peer_buf, peer_data, peer_data_len);
+	net_buf_simple_add_mem(&local_buf, local_data, local_data_len);
+
+	/* Abort the second step of the first subevent. */
+	step_offset += 1 + PEER_MODE_0_LEN;
+	peer_buf.data[step_offset] |= BIT(7);
+
+	zassert_equal(bt_ras_rreq_rd_parser_feed(&parser, &peer_buf, &local_buf), -ECONNABORTED);
+	zassert_equal(result.step_cnt, 1);
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Ranging data reassembly of the RAS RREQ.
+ *
+ * Ranging data segments are stored with injected reordering and duplicates. The reassembled
+ * ranging data must match the data sent by the peer.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+
+#include "ras_internal.h"
+
+#define REORDER_WINDOW	 CONFIG_BT_RAS_RREQ_REORDER_WINDOW
+
+/* Ranging data is longer than 64 segments to check the rolling segment counter. */
+#define RD_LEN		 1000
+#define SEGMENT_LEN	 12
+#define SEGMENT_CNT	 DIV_ROUND_UP(RD_LEN, SEGMENT_LEN)
+#define LAST_SEGMENT_LEN (RD_LEN - (SEGMENT_CNT - 1) * SEGMENT_LEN)
+
+BUILD_ASSERT(SEGMENT_CNT > 64);
+BUILD_ASSERT(LAST_SEGMENT_LEN < SEGMENT_LEN);
+
+static uint8_t rd[RD_LEN];
+static uint8_t rd_pulled[RD_LEN];
+static uint16_t rd_pulled_len;
+static uint16_t order[2 * SEGMENT_CNT];
+
+NET_BUF_SIMPLE_DEFINE_STATIC(rd_buf, RD_LEN);
+
+static struct ras_rd_reassembly reasm;
+
+static int segment_store(uint16_t index)
+{
+	struct ras_seg_header header = {
+		.first_seg = (index == 0),
+		.last_seg = (index == SEGMENT_CNT - 1),
+		.seg_counter = index & BIT_MASK(6),
+	};
+	uint16_t len = header.last_seg ? LAST_SEGMENT_LEN : SEGMENT_LEN;
+
+	return ras_rd_reassembly_segment_store(&reasm, &rd_buf, header, &rd[index * SEGMENT_LEN],
+					       len);
+}
+
+/* Store the segments and pull the appended data, as done by the ranging data parser. */
+static int segments_store(const uint16_t *indexes, size_t cnt)
+{
+	int ret;
+
+	for (size_t i = 0; i < cnt; i++) {
+		ret = segment_store(indexes[i]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		zassert_equal(ret, rd_buf.len);
+		memcpy(&rd_pulled[rd_pulled_len], net_buf_simple_pull_mem(&rd_buf, ret), ret);
+		rd_pulled_len += ret;
+	}
+
+	return 0;
+}
+
+static void rd_validate(void)
+{
+	zassert_true(reasm.complete, "Ranging data not complete");
+	zassert_equal(rd_pulled_len, RD_LEN);
+	zassert_mem_equal(rd_pulled, rd, RD_LEN);
+}
+
+/* Reverse the order of the segments in blocks of the given size. */
+static size_t order_reversed_blocks(uint16_t block_size)
+{
+	size_t cnt = 0;
+
+	for (uint16_t start = 0; start < SEGMENT_CNT; start += block_size) {
+		uint16_t end = MIN(start + block_size, SEGMENT_CNT);
+
+		for (uint16_t index = end; index > start; index--) {
+			order[cnt++] = index - 1;
+		}
+	}
+
+	return cnt;
+}
+
+static void *reassembly_setup(void)
+{
+	for (size_t i = 0; i < sizeof(rd); i++) {
+		rd[i] = (i * 7) ^ (i >> 8);
+	}
+
+	return NULL;
+}
+
+static void reassembly_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	net_buf_simple_reset(&rd_buf);
+	ras_rd_reassembly_reset(&reasm);
+	memset(rd_pulled, 0, sizeof(rd_pulled));
+	rd_pulled_len = 0;
+}
+
+ZTEST_SUITE(ras_rreq_reassembly, NULL, reassembly_setup, reassembly_before, NULL, NULL);
+
+ZTEST(ras_rreq_reassembly, test_in_order)
+{
+	size_t cnt = order_reversed_blocks(1);
+
+	zassert_ok(segments_store(order, cnt));
+	rd_validate();
+}
+
+ZTEST(ras_rreq_reassembly, test_duplicates)
+{
+	size_t cnt = 0;
+
+	for (uint16_t index = 0; index < SEGMENT_CNT; index++) {
+		order[cnt++] = index;
+		order[cnt++] = index;
+	}
+
+	zassert_ok(segments_store(order, cnt));
+	rd_validate();
+
+	/* Segments received after the last segment are ignored. */
+	zassert_equal(segment_store(SEGMENT_CNT - 1), 0);
+	zassert_equal(rd_buf.len, 0);
+}
+
+ZTEST(ras_rreq_reassembly, test_reordered)
+{
+	size_t cnt = order_reversed_blocks(REORDER_WINDOW + 1);
+
+	if (REORDER_WINDOW == 0) {
+		ztest_test_skip();
+	}
+
+	/* Each block is appended at once, when its first segment is received last. */
+	zassert_ok(segments_store(order, cnt));
+	rd_validate();
+}
+
+ZTEST(ras_rreq_reassembly, test_reordered_duplicates)
+{
+	uint16_t block_size = REORDER_WINDOW + 1;
+	size_t cnt = order_reversed_blocks(block_size);
+
+	if (REORDER_WINDOW == 0) {
+		ztest_test_skip();
+	}
+
+	/* Every segment is received again after the segments of the next block. */
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_ok(segments_store(&order[i], 1));
+		if (i >= block_size) {
+			zassert_ok(segments_store(&order[i - block_size], 1));
+		}
+	}
+
+	rd_validate();
+}
+
+ZTEST(ras_rreq_reassembly, test_outside_window)
+{
+	uint16_t indexes[] = {0, 1, REORDER_WINDOW + 3};
+
+	zassert_equal(segments_store(indexes, ARRAY_SIZE(indexes)), -ENODATA);
+	zassert_false(reasm.complete);
+	zassert_equal(rd_pulled_len, 2 * SEGMENT_LEN);
+}
+
+ZTEST(ras_rreq_reassembly, test_segment_len_mismatch)
+{
+	struct ras_seg_header header = {
+		.seg_counter = 2,
+	};
+
+	if (REORDER_WINDOW < 2) {
+		ztest_test_skip();
+	}
+
+	/* Segment 2 is placed ahead, assuming that segments 0 and 1 have its length. */
+	zassert_equal(ras_rd_reassembly_segment_store(&reasm, &rd_buf, header, rd, SEGMENT_LEN),
+		      0);
+
+	header.seg_counter = 1;
+	zassert_equal(ras_rd_reassembly_segment_store(&reasm, &rd_buf, header, rd,
+						      SEGMENT_LEN + 1), -EINVAL);
+
+	header.first_seg = true;
+	header.seg_counter = 0;
+	zassert_equal(ras_rd_reassembly_segment_store(&reasm, &rd_buf, header, rd,
+						      SEGMENT_LEN - 1), -EINVAL);
+}
+
+ZTEST(ras_rreq_reassembly, test_buffer_too_small)
+{
+	NET_BUF_SIMPLE_DEFINE(small_buf, 2 * SEGMENT_LEN);
+	struct ras_seg_header header = {
+		.first_seg = true,
+	};
+
+	zassert_equal(ras_rd_reassembly_segment_store(&reasm, &small_buf, header, rd,
+						      SEGMENT_LEN), SEGMENT_LEN);
+
+	if (REORDER_WINDOW >= 2) {
+		/* Segment 3 does not fit behind the missing segments 1 and 2. */
+		header.first_seg = false;
+		header.seg_counter = 3;
+		zassert_equal(ras_rd_reassembly_segment_store(&reasm, &small_buf, header, rd,
+							      SEGMENT_LEN), -ENOMEM);
+	}
+}
+
+ZTEST(ras_rreq_reassembly, test_benchmark)
+{
+	uint32_t procedures = 0;
+	uint32_t failed = 0;
+	size_t cnt;
+
+	/* Each procedure has one pair of swapped segments. */
+	for (uint16_t swap = 0; swap < SEGMENT_CNT - 1; swap++) {
+		cnt = order_reversed_blocks(1);
+		order[swap] = swap + 1;
+		order[swap + 1] = swap;
+
+		reassembly_before(NULL);
+		procedures++;
+		if (segments_store(order, cnt)) {
+			failed++;
+			continue;
+		}
+
+		rd_validate();
+	}
+
+	TC_PRINT("Reorder window %d: %u of %u procedures with a swapped segment pair failed\n",
+		 REORDER_WINDOW, failed, procedures);
+
+	if (REORDER_WINDOW > 0) {
+		zassert_equal(failed, 0);
+	} else {
+		zassert_equal(failed, procedures);
+	}
+}
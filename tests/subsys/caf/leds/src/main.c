@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * CAF LEDs module.
+ *
+ * LED effects are advanced by the system workqueue. Wake ups of the system workqueue are counted
+ * using the user tracing hooks, so that the number of wake ups per second can be compared
+ * between the test configurations (with and without CONFIG_CAF_LEDS_TICK_MS).
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <app_event_manager.h>
+#include <caf/events/led_event.h>
+
+#define MODULE main
+#include <caf/events/module_state_event.h>
+
+#define LED_CNT			DT_NUM_INST_STATUS_OKAY(gpio_leds)
+#define EFFECT_SETTLE_MS	50
+#define WAKE_UP_MEASURE_MS	1000
+
+#define ON_TIME_MS		100
+#define OFF_DELAY_MS		200
+
+static const struct led_effect effect_on = LED_EFFECT_LED_ON(LED_COLOR(255, 255, 255));
+static const struct led_effect effect_red = LED_EFFECT_LED_ON(LED_COLOR(255, 0, 0));
+static const struct led_effect effect_off = LED_EFFECT_LED_OFF();
+static const struct led_effect effect_on_go_off =
+	LED_EFFECT_LED_ON_GO_OFF(LED_COLOR(255, 255, 255), ON_TIME_MS, OFF_DELAY_MS);
+
+/* Looped effect that does not take time. */
+static const struct led_effect effect_blink_no_time =
+	LED_EFFECT_LED_BLINK(0, LED_COLOR(255, 255, 255));
+
+/* Breath effects with substeps of 7, 11 and 13 ms. */
+static const struct led_effect effect_breath[] = {
+	LED_EFFECT_LED_BREATH(105, LED_COLOR(255, 255, 255)),
+	LED_EFFECT_LED_BREATH(165, LED_COLOR(255, 255, 255)),
+	LED_EFFECT_LED_BREATH(195, LED_COLOR(255, 255, 255)),
+};
+
+static const struct device *const gpio_dev = DEVICE_DT_GET(DT_NODELABEL(gpio0));
+
+static K_SEM_DEFINE(led_ready_sem, 0, 1);
+static const struct led_effect *ready_effect;
+static int64_t ready_uptime;
+
+static atomic_t workq_wake_up_cnt;
+
+void sys_trace_thread_switched_in_user(void)
+{
+	if (k_current_get() == &k_sys_work_q.thread) {
+		atomic_inc(&workq_wake_up_cnt);
+	}
+}
+
+static void led_effect_set(size_t led_id, const struct led_effect *effect)
+{
+	struct led_event *event = new_led_event();
+
+	event->led_id = led_id;
+	event->led_effect = effect;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void led_effect_set_all(const struct led_effect *effect)
+{
+	for (size_t i = 0; i < LED_CNT; i++) {
+		led_effect_set(i, effect);
+	}
+
+	k_sleep(K_MSEC(EFFECT_SETTLE_MS));
+}
+
+static void *leds_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	module_set_state(MODULE_STATE_READY);
+
+	return NULL;
+}
+
+static void leds_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	led_effect_set_all(&effect_off);
+	k_sem_reset(&led_ready_sem);
+}
+
+ZTEST_SUITE(caf_leds, NULL, leds_setup, leds_before, NULL, NULL);
+
+ZTEST(caf_leds, test_colors)
+{
+	led_effect_set_all(&effect_on);
+	for (gpio_pin_t pin = 10; pin <= 16; pin++) {
+		zassert_equal(gpio_emul_output_get(gpio_dev, pin), 1, "Pin %u not set", pin);
+	}
+
+	/* The red channel is not changed, the other channels are turned off. */
+	led_effect_set_all(&effect_red);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 10), 1);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 11), 0);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 12), 0);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 13), 1);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 14), 0);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 15), 0);
+	zassert_equal(gpio_emul_output_get(gpio_dev, 16), 1);
+
+	led_effect_set_all(&effect_off);
+	for (gpio_pin_t pin = 10; pin <= 16; pin++) {
+		zassert_equal(gpio_emul_output_get(gpio_dev, pin), 0, "Pin %u set", pin);
+	}
+}
+
+ZTEST(caf_leds, test_effect_duration)
+{
+	int64_t start = k_uptime_get();
+
+	led_effect_set(0, &effect_on_go_off);
+	zassert_ok(k_sem_take(&led_ready_sem, K_MSEC(2 * (ON_TIME_MS + OFF_DELAY_MS))));
+	zassert_equal_ptr(ready_effect, &effect_on_go_off);
+
+	/* Substeps are delayed by at most a tick, the effect does not drift. */
+	zassert_between_inclusive(ready_uptime - start, ON_TIME_MS + OFF_DELAY_MS,
+				  ON_TIME_MS + OFF_DELAY_MS + CONFIG_CAF_LEDS_TICK_MS + 1,
+				  "Wrong effect duration");
+}
+
+ZTEST(caf_leds, test_looped_effect_no_time)
+{
+	led_effect_set_all(&effect_blink_no_time);
+
+	/* The effect is rejected and the LEDs can still be updated. */
+	for (gpio_pin_t pin = 10; pin <= 16; pin++) {
+		zassert_equal(gpio_emul_output_get(gpio_dev, pin), 0, "Pin %u set", pin);
+	}
+
+	led_effect_set_all(&effect_on);
+	for (gpio_pin_t pin = 10; pin <= 16; pin++) {
+		zassert_equal(gpio_emul_output_get(gpio_dev, pin), 1, "Pin %u not set", pin);
+	}
+}
+
+ZTEST(caf_leds, test_wake_ups)
+{
+	for (size_t i = 0; i < LED_CNT; i++) {
+		led_effect_set(i, &effect_breath[i % ARRAY_SIZE(effect_breath)]);
+	}
+
+	k_sleep(K_MSEC(EFFECT_SETTLE_MS));
+	atomic_set(&workq_wake_up_cnt, 0);
+	k_sleep(K_MSEC(WAKE_UP_MEASURE_MS));
+
+	uint32_t wake_ups = atomic_get(&workq_wake_up_cnt) * MSEC_PER_SEC / WAKE_UP_MEASURE_MS;
+
+	TC_PRINT("%u LEDs, tick %d ms: %u wake ups/s\n", LED_CNT, CONFIG_CAF_LEDS_TICK_MS,
+		 wake_ups);
+
+	zassert_true(wake_ups > 0);
+	if (CONFIG_CAF_LEDS_TICK_MS > 0) {
+		zassert_true(wake_ups <= (MSEC_PER_SEC / CONFIG_CAF_LEDS_TICK_MS) + 1,
+			     "LED updates not aligned to the tick");
+	}
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_led_ready_event(aeh)) {
+		const struct led_ready_event *event = cast_led_ready_event(aeh);
+
+		ready_effect = event->led_effect;
+		ready_uptime = k_uptime_get();
+		k_sem_give(&led_ready_sem);
+
+		return false;
+	}
+
+	zassert_unreachable("Wrong event type received");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_main, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_main, led_ready_event);
@@ -96,6 +96,40 @@ ZTEST(caf_sensor_aggregator_tests, test_order)
 	zassert_ok(err, "Test execution hanged");
 }
 
+ZTEST(caf_sensor_aggregator_tests, test_batch)
+{
+	cur_test_id = TEST_BATCH;
+	struct test_start_event *ts = new_test_start_event();
+
+	zassert_not_null(ts, "Failed to allocate event");
+	ts->test_id = cur_test_id;
+	APP_EVENT_SUBMIT(ts);
+
+	/* Batches of samples do not need to be aligned to the aggregator buffers. */
+	BUILD_ASSERT((SAMPLES_IN_AGG_BUF * BATCH_TEST_AGG_EVENTS) %
+		     BATCH_TEST_SAMPLES_IN_EVENT == 0);
+	size_t i = SAMPLES_IN_AGG_BUF * BATCH_TEST_AGG_EVENTS;
+
+	while (i > 0) {
+		struct sensor_event *se = new_sensor_event(sizeof(struct sensor_value) *
+				BATCH_TEST_SAMPLES_IN_EVENT);
+
+		zassert_not_null(se, "Failed to allocate event");
+
+		struct sensor_value *data = sensor_event_get_data_ptr(se);
+
+		se->descr = BATCH_TEST_AGG_DESCR;
+		for (size_t j = 0; j < BATCH_TEST_SAMPLES_IN_EVENT; j++) {
+			data[j].val1 = i--;
+		}
+		APP_EVENT_SUBMIT(se);
+	}
+
+	int err = k_sem_take(&test_end_sem, K_SECONDS(30));
+
+	zassert_ok(err, "Test execution hanged");
+}
+
 ZTEST(caf_sensor_aggregator_tests, test_status)
 {
 	test_start(TEST_STATUS);
@@ -15,6 +15,9 @@
  */
 const struct {} sensor_manager_def_include_once;
 
+/* Simulated sensor FIFO provided by the test. */
+int sensor_fifo_sim_read(const struct device *dev, struct sensor_value *data,
+			 size_t sample_cnt);
 
 static const struct caf_sampled_channel accel_chan[] = {
 	{
@@ -56,4 +59,23 @@ static const struct sm_sensor_config sensor_configs[] = {
 		.sampling_period_ms = 33000,
 		.active_events_limit = 3,
 	},
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_4)),
+		.event_descr = "Simulated sensor 4",
+		.chans = accel_chan,
+		.chan_cnt = ARRAY_SIZE(accel_chan),
+		.sampling_period_ms = 33000,
+		.active_events_limit = 3,
+		.batch_size = 4,
+		.fifo_read = sensor_fifo_sim_read,
+	},
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_5)),
+		.event_descr = "Simulated sensor 5",
+		.chans = accel_chan,
+		.chan_cnt = ARRAY_SIZE(accel_chan),
+		.sampling_period_ms = 33000,
+		.active_events_limit = 3,
+		.batch_size = 4,
+	},
 };
@@ -9,9 +9,12 @@
 #include <app_event_manager.h>
 #include "test_events.h"
 #include <caf/events/sensor_event.h>
+#include <caf/sensor_manager.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 
+#include "sensor_fifo_sim.h"
+
 #define MODULE main
 
 #include <caf/events/module_state_event.h>
@@ -21,6 +24,10 @@ LOG_MODULE_REGISTER(MODULE);
 #define PRE_CHANGE_SAMPLING_PERIOD 20
 #define SAMPLING_PERIOD 40
 #define SAMPLING_PERIOD_LONG 33000
+#define BATCH_SAMPLING_PERIOD 10
+#define BATCH_SIZE 4
+#define BATCH_EVENT_CNT 5
+#define SAMPLE_DATA_CNT 3
 
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
@@ -28,6 +35,9 @@ static K_SEM_DEFINE(test_init_sem, 0, 1);
 int64_t first_event_uptime;
 uint8_t sensors_tested;
 uint8_t sensors_tested_mask;
+uint8_t batch_event_cnt;
+uint32_t batch_sample_seq;
+static enum sensor_state no_fifo_sensor_state;
 
 static void test_start(enum test_id test_id)
 {
@@ -56,6 +66,7 @@ static void test_before(void *f)
 	struct set_sensor_period_event *event_sensor1 = new_set_sensor_period_event();
 	struct set_sensor_period_event *event_sensor2 = new_set_sensor_period_event();
 	struct set_sensor_period_event *event_sensor3 = new_set_sensor_period_event();
+	struct set_sensor_period_event *event_sensor4 = new_set_sensor_period_event();
 	struct test_initialization_done_event *event_init_done =
 						new_test_initialization_done_event();
 
@@ -71,6 +82,10 @@ static void test_before(void *f)
 	event_sensor3->descr = "Simulated sensor 3";
 	APP_EVENT_SUBMIT(event_sensor3);
 
+	event_sensor4->sampling_period = SAMPLING_PERIOD_LONG;
+	event_sensor4->descr = "Simulated sensor 4";
+	APP_EVENT_SUBMIT(event_sensor4);
+
 	APP_EVENT_SUBMIT(event_init_done);
 
 	int err = k_sem_take(&test_init_sem, K_SECONDS(30));
@@ -122,6 +137,51 @@ ZTEST(caf_sensor_manager_tests, test_multiple_sensors)
 	test_start(TEST_MULTIPLE_SENSORS);
 }
 
+ZTEST(caf_sensor_manager_tests, test_batch)
+{
+	struct set_sensor_period_event *event = new_set_sensor_period_event();
+	struct sm_stats stats_before;
+	struct sm_stats stats_after;
+	struct sm_stats stats_all;
+
+	zassert_ok(sensor_manager_stats_get("Simulated sensor 4", &stats_before));
+
+	batch_sample_seq = 0;
+	sensor_fifo_sim_start(BATCH_SAMPLING_PERIOD);
+
+	event->sampling_period = BATCH_SAMPLING_PERIOD;
+	event->descr = "Simulated sensor 4";
+	APP_EVENT_SUBMIT(event);
+
+	test_start(TEST_BATCH);
+	sensor_fifo_sim_stop();
+
+	zassert_ok(sensor_manager_stats_get("Simulated sensor 4", &stats_after));
+	zassert_ok(sensor_manager_stats_get(NULL, &stats_all));
+	zassert_equal(sensor_manager_stats_get("Unknown sensor", &stats_all), -ENOENT);
+
+	uint32_t wake_up_cnt = stats_after.wake_up_cnt - stats_before.wake_up_cnt;
+
+	/* One wake up and one event per batch of samples. */
+	zassert_true(wake_up_cnt >= BATCH_EVENT_CNT);
+	zassert_equal(stats_after.sample_cnt - stats_before.sample_cnt,
+		      wake_up_cnt * BATCH_SIZE);
+	zassert_equal(stats_after.event_cnt - stats_before.event_cnt, wake_up_cnt);
+	zassert_true(stats_all.wake_up_cnt >= stats_after.wake_up_cnt);
+	zassert_true(stats_all.sample_cnt >= stats_after.sample_cnt);
+}
+
+ZTEST(caf_sensor_manager_tests, test_batch_no_fifo)
+{
+	struct sm_stats stats;
+
+	/* A batch cannot be read from the sensor without FIFO. */
+	zassert_equal(no_fifo_sensor_state, SENSOR_STATE_ERROR);
+	zassert_ok(sensor_manager_stats_get("Simulated sensor 5", &stats));
+	zassert_equal(stats.wake_up_cnt, 0);
+	zassert_equal(stats.sample_cnt, 0);
+}
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
 	if (is_test_end_event(aeh)) {
@@ -217,6 +277,43 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			}
 
 			zassert_unreachable("Expected sensor event from different sensor");
+			break;
+
+		case TEST_BATCH:
+			if (strcmp(ev->descr, "Simulated sensor 4")) {
+				zassert_unreachable("Expected sensor 4 event");
+			}
+			zassert_equal(sensor_event_get_data_cnt(ev), BATCH_SIZE * SAMPLE_DATA_CNT,
+				      "Wrong number of samples in batch");
+
+			const struct sensor_value *samples = sensor_event_get_data_ptr(ev);
+
+			/* Every sample stored in the FIFO is delivered once. */
+			for (size_t i = 0; i < BATCH_SIZE; i++) {
+				zassert_equal(samples[i * SAMPLE_DATA_CNT].val1, batch_sample_seq,
+					      "Wrong sample in batch");
+				batch_sample_seq++;
+			}
+
+			if (first_event_uptime == 0) {
+				first_event_uptime = k_uptime_get();
+				break;
+			}
+
+			int64_t batch_period = k_uptime_get() - first_event_uptime;
+
+			zassert_between_inclusive(batch_period,
+						  BATCH_SIZE * BATCH_SAMPLING_PERIOD - 1,
+						  BATCH_SIZE * BATCH_SAMPLING_PERIOD + 1,
+						  "Wrong batch period");
+			first_event_uptime = k_uptime_get();
+			batch_event_cnt++;
+			if (batch_event_cnt == BATCH_EVENT_CNT) {
+				first_event_uptime = 0;
+				cur_test_id = TEST_IDLE;
+				k_sem_give(&test_end_sem);
+			}
+			break;
 
 		default:
 			break;
@@ -225,6 +322,16 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		return false;
 	}
 
+	if (is_sensor_state_event(aeh)) {
+		const struct sensor_state_event *ev = cast_sensor_state_event(aeh);
+
+		if (!strcmp(ev->descr, "Simulated sensor 5")) {
+			no_fifo_sensor_state = ev->state;
+		}
+
+		return false;
+	}
+
 	if (is_test_initialization_done_event(aeh)) {
 		k_sem_give(&test_init_sem);
 
@@ -239,4 +346,5 @@ ZTEST_SUITE(caf_sensor_manager_tests, NULL, test_init, test_before, NULL, NULL);
 APP_EVENT_LISTENER(test_main, app_event_handler);
 APP_EVENT_SUBSCRIBE(test_main, test_end_event);
 APP_EVENT_SUBSCRIBE(test_main, sensor_event);
+APP_EVENT_SUBSCRIBE(test_main, sensor_state_event);
 APP_EVENT_SUBSCRIBE(test_main, test_initialization_done_event);
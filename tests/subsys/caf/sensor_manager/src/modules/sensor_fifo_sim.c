@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#include "sensor_fifo_sim.h"
+
+/* Simulated sensor FIFO. A sample is stored at every timer tick and its value is the sequence
+ * number of the sample, so the sensor output does not change between the ticks.
+ */
+
+#define FIFO_SIZE	8
+#define SAMPLE_DATA_CNT	3
+
+static atomic_t stored_cnt;
+static uint32_t read_cnt;
+
+static void fifo_timer_handler(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	atomic_inc(&stored_cnt);
+}
+
+static K_TIMER_DEFINE(fifo_timer, fifo_timer_handler, NULL);
+
+void sensor_fifo_sim_start(uint32_t sampling_period_ms)
+{
+	atomic_set(&stored_cnt, 0);
+	read_cnt = 0;
+
+	/* Samples are stored in the middle of the sampling period to avoid a race with the
+	 * sensor manager waking up at the end of the period.
+	 */
+	k_timer_start(&fifo_timer, K_MSEC(sampling_period_ms / 2), K_MSEC(sampling_period_ms));
+}
+
+void sensor_fifo_sim_stop(void)
+{
+	k_timer_stop(&fifo_timer);
+}
+
+int sensor_fifo_sim_read(const struct device *dev, struct sensor_value *data,
+			 size_t sample_cnt)
+{
+	uint32_t cnt = atomic_get(&stored_cnt);
+	size_t i;
+
+	ARG_UNUSED(dev);
+
+	if ((cnt - read_cnt) > FIFO_SIZE) {
+		/* FIFO overflow, the oldest samples are lost. */
+		read_cnt = cnt - FIFO_SIZE;
+	}
+
+	for (i = 0; (i < sample_cnt) && (read_cnt < cnt); i++, read_cnt++) {
+		for (size_t j = 0; j < SAMPLE_DATA_CNT; j++) {
+			data[i * SAMPLE_DATA_CNT + j].val1 = read_cnt;
+			data[i * SAMPLE_DATA_CNT + j].val2 = 0;
+		}
+	}
+
+	return i;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SENSOR_FIFO_SIM_H_
+#define _SENSOR_FIFO_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/types.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+
+/** Start storing samples in the simulated FIFO, one sample per sampling period. */
+void sensor_fifo_sim_start(uint32_t sampling_period_ms);
+
+/** Stop storing samples in the simulated FIFO. */
+void sensor_fifo_sim_stop(void);
+
+/** Read samples from the simulated FIFO. Used as sm_sensor_config.fifo_read. */
+int sensor_fifo_sim_read(const struct device *dev, struct sensor_value *data,
+			 size_t sample_cnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SENSOR_FIFO_SIM_H_ */
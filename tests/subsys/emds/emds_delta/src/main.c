@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Incremental snapshots of the emergency data storage.
+ *
+ * The data writes of the library are wrapped at link time to count the bytes written by the
+ * store, see CMakeLists.txt. The store time is reported as the estimate of the library next to
+ * the number of bytes written.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/flash_map.h>
+#include <emds/emds.h>
+#include <emds_flash.h>
+
+#define D_ENTRY_COUNT 8
+#define D_ENTRY_LEN   32
+#define S_ENTRY_LEN   256
+
+#define ENTRY_SIZE(len) ((len) + sizeof(struct emds_data_entry))
+#define METADATA_SIZE   offsetof(struct emds_snapshot_metadata, reserved)
+#define STORE_SIZE      (ENTRY_SIZE(S_ENTRY_LEN) + D_ENTRY_COUNT * ENTRY_SIZE(D_ENTRY_LEN))
+
+static uint32_t write_bytes;
+
+void __real_emds_flash_write_data(const struct emds_partition *partition, off_t data_off,
+				  void *data_chunk, size_t data_size);
+
+void __wrap_emds_flash_write_data(const struct emds_partition *partition, off_t data_off,
+				  void *data_chunk, size_t data_size)
+{
+	write_bytes += data_size;
+
+	__real_emds_flash_write_data(partition, data_off, data_chunk, data_size);
+}
+
+static uint8_t s_data[S_ENTRY_LEN];
+static uint8_t d_data[D_ENTRY_COUNT][D_ENTRY_LEN];
+static struct emds_dynamic_entry d_entries[D_ENTRY_COUNT];
+
+/* The content of the entries before a power loss */
+static uint8_t expect_s_data[S_ENTRY_LEN];
+static uint8_t expect_d_data[D_ENTRY_COUNT][D_ENTRY_LEN];
+
+EMDS_STATIC_ENTRY_DEFINE(s_entry, 0x100, s_data, sizeof(s_data));
+
+static void d_entry_change(int i, uint8_t value)
+{
+	memset(d_data[i], value, D_ENTRY_LEN);
+	memset(expect_d_data[i], value, D_ENTRY_LEN);
+}
+
+static void s_entry_change(uint8_t value)
+{
+	memset(s_data, value, S_ENTRY_LEN);
+	memset(expect_s_data, value, S_ENTRY_LEN);
+}
+
+/* Simulate a reboot: the RAM content is lost and restored from the storage */
+static void reboot(void)
+{
+	int rc;
+
+	memset(s_data, 0, sizeof(s_data));
+	memset(d_data, 0, sizeof(d_data));
+
+	rc = emds_load();
+	zassert_true(rc == 0 || rc == -ENOENT, "Load failed: %d", rc);
+	zassert_ok(emds_prepare());
+}
+
+static void store(void)
+{
+	write_bytes = 0;
+	zassert_ok(emds_store());
+}
+
+static void restored_check(void)
+{
+	reboot();
+
+	zassert_mem_equal(s_data, expect_s_data, S_ENTRY_LEN);
+	zassert_mem_equal(d_data, expect_d_data, sizeof(d_data));
+}
+
+static void *emds_delta_setup(void)
+{
+	zassert_ok(emds_init(NULL));
+
+	for (int i = 0; i < D_ENTRY_COUNT; i++) {
+		d_entries[i].entry.id = 0x1000 + i;
+		d_entries[i].entry.data = d_data[i];
+		d_entries[i].entry.len = D_ENTRY_LEN;
+		zassert_ok(emds_entry_add(&d_entries[i]));
+	}
+
+	return NULL;
+}
+
+static void emds_delta_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(emds_clear());
+	memset(expect_s_data, 0, sizeof(expect_s_data));
+	memset(expect_d_data, 0, sizeof(expect_d_data));
+
+	/* The first snapshot holds all entries */
+	reboot();
+	s_entry_change(0xAA);
+	for (int i = 0; i < D_ENTRY_COUNT; i++) {
+		d_entry_change(i, i + 1);
+	}
+
+	store();
+	zassert_equal(write_bytes, STORE_SIZE + METADATA_SIZE);
+}
+
+ZTEST_SUITE(emds_delta, NULL, emds_delta_setup, emds_delta_before, NULL, NULL);
+
+ZTEST(emds_delta, test_changed_entries_stored)
+{
+	reboot();
+	d_entry_change(3, 0x33);
+	store();
+	zassert_equal(write_bytes, ENTRY_SIZE(D_ENTRY_LEN) + METADATA_SIZE);
+
+	reboot();
+	s_entry_change(0xBB);
+	d_entry_change(0, 0x30);
+	store();
+	zassert_equal(write_bytes, ENTRY_SIZE(S_ENTRY_LEN) + ENTRY_SIZE(D_ENTRY_LEN) +
+					   METADATA_SIZE);
+
+	/* Restored from the full snapshot and two incremental snapshots */
+	restored_check();
+}
+
+ZTEST(emds_delta, test_no_change)
+{
+	reboot();
+	store();
+	zassert_equal(write_bytes, 0);
+
+	/* An entry changed back to its loaded content is not stored */
+	reboot();
+	d_data[2][0] ^= 0xff;
+	d_data[2][0] ^= 0xff;
+	store();
+	zassert_equal(write_bytes, 0);
+
+	restored_check();
+}
+
+ZTEST(emds_delta, test_chain_max)
+{
+	for (int i = 1; i < CONFIG_EMDS_DELTA_CHAIN_MAX; i++) {
+		reboot();
+		d_entry_change(i, 0x40 + i);
+		store();
+		zassert_equal(write_bytes, ENTRY_SIZE(D_ENTRY_LEN) + METADATA_SIZE);
+	}
+
+	/* Too many snapshots to restore, all entries are stored again */
+	reboot();
+	d_entry_change(0, 0x50);
+	store();
+	zassert_equal(write_bytes, STORE_SIZE + METADATA_SIZE);
+
+	reboot();
+	d_entry_change(1, 0x51);
+	store();
+	zassert_equal(write_bytes, ENTRY_SIZE(D_ENTRY_LEN) + METADATA_SIZE);
+
+	restored_check();
+}
+
+ZTEST(emds_delta, test_store_time)
+{
+	uint32_t time_all;
+	uint32_t time_changed;
+
+	for (int dirty = 0; dirty <= D_ENTRY_COUNT; dirty++) {
+		/* Start each measurement from a snapshot with all entries */
+		emds_delta_before(NULL);
+		reboot();
+
+		for (int i = 0; i < dirty; i++) {
+			d_entry_change(i, 0x60 + dirty);
+		}
+
+		zassert_ok(emds_store_time_get(&time_all));
+		zassert_ok(emds_store_time_changed_get(&time_changed));
+		zassert_true(time_changed <= time_all);
+
+		store();
+
+		TC_PRINT("%d dirty entries: %4u bytes written, %5u us estimated, %5u us worst case\n",
+			 dirty, write_bytes, time_changed, time_all);
+
+		zassert_equal(write_bytes,
+			      dirty ? dirty * ENTRY_SIZE(D_ENTRY_LEN) + METADATA_SIZE : 0);
+	}
+
+	restored_check();
+}
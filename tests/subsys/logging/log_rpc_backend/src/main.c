@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Log history transfer of the nRF RPC logging backend.
+ *
+ * Commands are received over the mock nRF RPC transport. The log history chunks sent by the
+ * backend are captured before they reach the transport and decoded by the test. The chunks are
+ * small, so log messages that do not fit in a chunk are rolled back and sent in the next one.
+ */
+
+#include <mock_nrf_rpc_transport.h>
+#include <logging/log_rpc.h>
+#include <nrf_rpc_cbor.h>
+#include <zcbor_decode.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(log_rpc_test, LOG_LEVEL_DBG);
+
+/* Command IDs defined in log_rpc_group.h, which cannot be included as it defines the group. */
+#define LOG_RPC_CMD_PUT_HISTORY_CHUNK	   0
+#define LOG_RPC_CMD_SET_HISTORY_LEVEL	   1
+#define LOG_RPC_CMD_FETCH_HISTORY	   6
+#define LOG_RPC_CMD_FETCH_HISTORY_FILTERED 13
+
+#define CHUNK_SIZE	 CONFIG_LOG_BACKEND_RPC_HISTORY_UPLOAD_CHUNK_SIZE
+#define CHUNK_WAIT_TIME	 K_SECONDS(1)
+#define TRANSFER_ID	 0x05
+#define MSG_CNT_MAX	 32
+#define MSG_PREFIX	 "log_rpc_test: msg "
+
+/* Macros for constructing nRF RPC packets for the logging command group. */
+
+#define CBOR_UINT64(value) 0x1B, BT_BYTES_LIST_LE64(BSWAP_64(value))
+
+#define RPC_PKT(bytes...)                                                                          \
+	(mock_nrf_rpc_pkt_t)                                                                       \
+	{                                                                                          \
+		.data = (uint8_t[]){bytes}, .len = sizeof((uint8_t[]){bytes}),                     \
+	}
+
+#define RPC_INIT_REQ RPC_PKT(0x04, 0x00, 0xff, 0x00, 0xff, 0x00, 'l', 'o', 'g')
+#define RPC_INIT_RSP RPC_PKT(0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 'l', 'o', 'g')
+#define RPC_CMD(cmd, ...) RPC_PKT(0x80, cmd, 0xff, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define RPC_RSP(...)	  RPC_PKT(0x01, 0xff, 0x00, 0x00, 0x00 __VA_OPT__(,) __VA_ARGS__, 0xf6)
+#define NO_RSP		  RPC_PKT()
+
+struct history_msg {
+	uint32_t level;
+	uint32_t seq;
+};
+
+static struct history_msg received[MSG_CNT_MAX];
+static size_t received_cnt;
+static size_t chunk_cnt;
+static bool transfer_done;
+static K_SEM_DEFINE(chunk_sem, 0, 1);
+
+static void msg_add(uint32_t level, const uint8_t *text, size_t len)
+{
+	char buf[CHUNK_SIZE + 1];
+	const char *seq_str;
+	char *end;
+
+	zassert_true(len < sizeof(buf));
+	memcpy(buf, text, len);
+	buf[len] = '\0';
+
+	seq_str = strstr(buf, MSG_PREFIX);
+
+	if (!seq_str) {
+		/* Message not logged by the test. */
+		return;
+	}
+
+	zassert_true(received_cnt < ARRAY_SIZE(received));
+	received[received_cnt].level = level;
+	received[received_cnt].seq = strtoul(seq_str + strlen(MSG_PREFIX), &end, 10);
+	received_cnt++;
+
+	/* The message is not truncated. */
+	zassert_equal(end, &buf[len], "Truncated message: %s", buf);
+}
+
+static void chunk_decode(const uint8_t *data, size_t len)
+{
+	ZCBOR_STATE_D(zs, 0, data, len, SIZE_MAX, 0);
+	uint32_t transfer_id;
+	uint32_t level;
+	struct zcbor_string text;
+	size_t msg_cnt = 0;
+
+	zassert_true(zcbor_uint32_decode(zs, &transfer_id));
+	zassert_equal(transfer_id, TRANSFER_ID);
+
+	/* A rolled back message leaves no partially encoded items in the chunk. */
+	while (zs->payload < zs->payload_end) {
+		zassert_true(zcbor_uint32_decode(zs, &level), "Malformed chunk");
+		zassert_true(zcbor_bstr_decode(zs, &text), "Malformed chunk");
+		msg_add(level, text.value, text.len);
+		msg_cnt++;
+	}
+
+	/* The transfer is finished with an empty chunk. */
+	transfer_done = (msg_cnt == 0);
+	chunk_cnt++;
+}
+
+void __wrap_nrf_rpc_cbor_cmd_no_err(const struct nrf_rpc_group *group, uint8_t cmd,
+				    struct nrf_rpc_cbor_ctx *ctx, nrf_rpc_cbor_handler_t handler,
+				    void *handler_data)
+{
+	ARG_UNUSED(handler);
+	ARG_UNUSED(handler_data);
+
+	zassert_equal(cmd, LOG_RPC_CMD_PUT_HISTORY_CHUNK);
+
+	chunk_decode(ctx->out_packet, ctx->zs[0].payload_mut - ctx->out_packet);
+	NRF_RPC_CBOR_DISCARD(group, *ctx);
+
+	k_sem_give(&chunk_sem);
+}
+
+static void logs_process(void)
+{
+	log_thread_trigger();
+
+	while (log_data_pending()) {
+		k_sleep(K_MSEC(10));
+	}
+
+	/* Let the logging thread pass the last message to the backend. */
+	k_sleep(K_MSEC(10));
+}
+
+static void history_fetch(mock_nrf_rpc_pkt_t cmd)
+{
+	received_cnt = 0;
+	chunk_cnt = 0;
+	transfer_done = false;
+
+	mock_nrf_rpc_tr_expect_add(RPC_RSP(), NO_RSP);
+	mock_nrf_rpc_tr_receive(cmd);
+	mock_nrf_rpc_tr_expect_done();
+
+	while (!transfer_done) {
+		zassert_ok(k_sem_take(&chunk_sem, CHUNK_WAIT_TIME), "History transfer not finished");
+	}
+}
+
+static void nrf_rpc_err_handler(const struct nrf_rpc_err_report *report)
+{
+	zassert_ok(report->code);
+}
+
+static void tc_setup(void *f)
+{
+	ARG_UNUSED(f);
+
+	mock_nrf_rpc_tr_expect_add(RPC_INIT_REQ, RPC_INIT_RSP);
+	zassert_ok(nrf_rpc_init(nrf_rpc_err_handler));
+	mock_nrf_rpc_tr_expect_reset();
+
+	mock_nrf_rpc_tr_expect_add(RPC_RSP(), NO_RSP);
+	mock_nrf_rpc_tr_receive(RPC_CMD(LOG_RPC_CMD_SET_HISTORY_LEVEL, LOG_RPC_LEVEL_DBG));
+	mock_nrf_rpc_tr_expect_done();
+
+	/* Start every test with an empty history. */
+	logs_process();
+	history_fetch(RPC_CMD(LOG_RPC_CMD_FETCH_HISTORY, TRANSFER_ID));
+}
+
+ZTEST(log_rpc_backend, test_fetch_history_filtered)
+{
+	static const uint32_t expected[] = {4, 6, 8, 10};
+	uint64_t since_us;
+
+	for (uint32_t i = 0; i < 4; i++) {
+		LOG_ERR("msg %u", i);
+	}
+
+	logs_process();
+	k_sleep(K_MSEC(20));
+	since_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	k_sleep(K_MSEC(20));
+
+	for (uint32_t i = 4; i < 12; i++) {
+		if (i % 2) {
+			LOG_INF("msg %u", i);
+		} else {
+			LOG_ERR("msg %u", i);
+		}
+	}
+
+	logs_process();
+
+	/* Only the errors logged after the given time are transferred. */
+	history_fetch(RPC_CMD(LOG_RPC_CMD_FETCH_HISTORY_FILTERED, TRANSFER_ID, LOG_RPC_LEVEL_WRN,
+			      CBOR_UINT64(since_us)));
+
+	zassert_equal(received_cnt, ARRAY_SIZE(expected));
+
+	for (size_t i = 0; i < ARRAY_SIZE(expected); i++) {
+		zassert_equal(received[i].seq, expected[i]);
+		zassert_equal(received[i].level, LOG_RPC_LEVEL_ERR);
+	}
+
+	/* The filtered out messages are not left in the history. */
+	history_fetch(RPC_CMD(LOG_RPC_CMD_FETCH_HISTORY, TRANSFER_ID));
+	zassert_equal(received_cnt, 0);
+}
+
+ZTEST(log_rpc_backend, test_fetch_history_chunks)
+{
+	const uint32_t msg_cnt = 16;
+
+	for (uint32_t i = 0; i < msg_cnt; i++) {
+		LOG_INF("msg %u", i);
+	}
+
+	logs_process();
+
+	history_fetch(RPC_CMD(LOG_RPC_CMD_FETCH_HISTORY, TRANSFER_ID));
+
+	/* The message that did not fit in a chunk is sent at the start of the next chunk. */
+	zassert_equal(received_cnt, msg_cnt);
+	zassert_true(chunk_cnt > 2, "Messages not split between chunks");
+
+	for (uint32_t i = 0; i < msg_cnt; i++) {
+		zassert_equal(received[i].seq, i);
+		zassert_equal(received[i].level, LOG_RPC_LEVEL_INF);
+	}
+}
+
+ZTEST_SUITE(log_rpc_backend, NULL, NULL, tc_setup, NULL, NULL);
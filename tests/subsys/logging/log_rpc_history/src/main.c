@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Flash-backed log history of the nRF RPC logging backend.
+ *
+ * Log messages are stored in batches, one FCB entry per batch. The test checks the order of the
+ * popped messages, flushing of the pending batch on panic and seeking by level and timestamp,
+ * and reports the history capacity and the flash operations needed to store and to transfer
+ * 1000 log messages.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/logging/log_output.h>
+
+#include "log_backend_rpc_history.h"
+
+#define MSG_CNT		 1000
+#define MSG_DATA_LEN	 32
+#define MSG_WLEN_MAX	 32
+#define FLUSH_TIMEOUT_MS CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_FLUSH_TIMEOUT_MS
+
+struct flash_stats {
+	uint32_t write_cnt;
+	uint32_t write_bytes;
+	uint32_t read_cnt;
+	uint32_t read_bytes;
+};
+
+static struct flash_stats stats;
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT) msg_buf[MSG_WLEN_MAX];
+
+int __real_flash_area_write(const struct flash_area *fa, off_t off, const void *src, size_t len);
+int __real_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len);
+
+int __wrap_flash_area_write(const struct flash_area *fa, off_t off, const void *src, size_t len)
+{
+	stats.write_cnt++;
+	stats.write_bytes += len;
+
+	return __real_flash_area_write(fa, off, src, len);
+}
+
+int __wrap_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len)
+{
+	stats.read_cnt++;
+	stats.read_bytes += len;
+
+	return __real_flash_area_read(fa, off, dst, len);
+}
+
+static const union log_msg_generic *msg_create(uint8_t level, log_timestamp_t timestamp,
+					       uint32_t seq)
+{
+	struct log_msg *msg = (struct log_msg *)msg_buf;
+
+	memset(msg_buf, 0, sizeof(msg_buf));
+	msg->hdr.desc.type = Z_LOG_MSG_LOG;
+	msg->hdr.desc.level = level;
+	msg->hdr.desc.data_len = MSG_DATA_LEN;
+	msg->hdr.timestamp = timestamp;
+	memcpy(msg->data, &seq, sizeof(seq));
+
+	__ASSERT_NO_MSG(log_msg_generic_get_wlen((union mpsc_pbuf_generic *)msg) <= MSG_WLEN_MAX);
+
+	return (const union log_msg_generic *)msg;
+}
+
+static size_t msg_size(void)
+{
+	return log_msg_generic_get_wlen((union mpsc_pbuf_generic *)msg_create(0, 0, 0)) *
+	       sizeof(uint32_t);
+}
+
+static uint32_t msg_seq(union log_msg_generic *msg)
+{
+	size_t len;
+	uint32_t seq;
+
+	memcpy(&seq, log_msg_get_data(&msg->log, &len), sizeof(seq));
+	zassert_equal(len, MSG_DATA_LEN);
+
+	return seq;
+}
+
+static uint32_t history_drain(void)
+{
+	union log_msg_generic *msg;
+	uint32_t cnt = 0;
+
+	while ((msg = log_rpc_history_pop()) != NULL) {
+		log_rpc_history_free(msg);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static void history_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	log_rpc_history_init();
+	memset(&stats, 0, sizeof(stats));
+}
+
+ZTEST_SUITE(log_rpc_history, NULL, NULL, history_before, NULL, NULL);
+
+ZTEST(log_rpc_history, test_order)
+{
+	union log_msg_generic *msg;
+	struct flash_stats store_stats;
+
+	for (uint32_t i = 0; i < MSG_CNT; i++) {
+		log_rpc_history_push(msg_create(LOG_LEVEL_DBG - (i % 4), i, i));
+	}
+
+	store_stats = stats;
+	memset(&stats, 0, sizeof(stats));
+
+	/* Messages that are not yet written to the flash are popped too. */
+	for (uint32_t i = 0; i < MSG_CNT; i++) {
+		msg = log_rpc_history_pop();
+		zassert_not_null(msg, "Message %u not popped", i);
+		zassert_equal(msg_seq(msg), i);
+		zassert_equal(log_msg_get_level(&msg->log), LOG_LEVEL_DBG - (i % 4));
+		log_rpc_history_free(msg);
+	}
+
+	zassert_is_null(log_rpc_history_pop());
+
+	TC_PRINT("Batch %u B, %u messages of %zu B: store %u writes (%u B), "
+		 "transfer %u reads (%u B)\n",
+		 CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_BATCH_SIZE, MSG_CNT, msg_size(),
+		 store_stats.write_cnt, store_stats.write_bytes, stats.read_cnt, stats.read_bytes);
+
+	/* A flash entry is written per batch rather than per message. */
+	zassert_true(store_stats.write_cnt < MSG_CNT);
+	zassert_true(stats.read_cnt < MSG_CNT);
+}
+
+ZTEST(log_rpc_history, test_flush_timeout)
+{
+	log_rpc_history_push(msg_create(LOG_LEVEL_INF, 0, 0));
+	zassert_equal(stats.write_cnt, 0, "Message not batched");
+
+	k_sleep(K_MSEC(FLUSH_TIMEOUT_MS + 10));
+	zassert_true(stats.write_cnt > 0, "Batch not flushed");
+
+	zassert_equal(history_drain(), 1);
+}
+
+ZTEST(log_rpc_history, test_panic_flush)
+{
+	uint32_t write_cnt;
+
+	log_rpc_history_push(msg_create(LOG_LEVEL_ERR, 0, 0));
+	zassert_equal(stats.write_cnt, 0, "Message not batched");
+
+	/* The pending batch is written at once and the flush work is cancelled. */
+	log_rpc_history_flush();
+	write_cnt = stats.write_cnt;
+	zassert_true(write_cnt > 0, "Batch not flushed");
+
+	k_sleep(K_MSEC(FLUSH_TIMEOUT_MS + 10));
+	zassert_equal(stats.write_cnt, write_cnt, "Batch flushed twice");
+
+	zassert_equal(history_drain(), 1);
+}
+
+ZTEST(log_rpc_history, test_seek)
+{
+	union log_msg_generic *msg;
+	uint32_t err_cnt = 0;
+	uint32_t popped = 0;
+	uint32_t seq;
+
+	for (uint32_t i = 0; i < MSG_CNT; i++) {
+		log_rpc_history_push(msg_create(LOG_LEVEL_INF, i * 1000, i));
+	}
+
+	for (uint32_t i = MSG_CNT; i < MSG_CNT + 10; i++) {
+		log_rpc_history_push(msg_create(LOG_LEVEL_ERR, i * 1000, i));
+	}
+
+	/* Batches with informational messages only are skipped. */
+	log_rpc_history_seek(LOG_RPC_LEVEL_ERR, 0);
+	memset(&stats, 0, sizeof(stats));
+
+	while ((msg = log_rpc_history_pop()) != NULL) {
+		if (log_msg_get_level(&msg->log) == LOG_LEVEL_ERR) {
+			zassert_equal(msg_seq(msg), MSG_CNT + err_cnt);
+			err_cnt++;
+		}
+
+		log_rpc_history_free(msg);
+		popped++;
+	}
+
+	TC_PRINT("Seek by level: %u of %u messages popped, %u reads (%u B)\n", popped,
+		 MSG_CNT + 10, stats.read_cnt, stats.read_bytes);
+
+	zassert_equal(err_cnt, 10);
+	zassert_true(popped < MSG_CNT / 2);
+
+	/* Batches with messages older than the given timestamp are skipped. */
+	log_rpc_history_init();
+
+	for (uint32_t i = 0; i < MSG_CNT; i++) {
+		log_rpc_history_push(msg_create(LOG_LEVEL_INF, i * 1000, i));
+	}
+
+	log_rpc_history_seek(LOG_RPC_LEVEL_DBG, log_output_timestamp_to_us(900 * 1000));
+
+	msg = log_rpc_history_pop();
+	zassert_not_null(msg);
+	seq = msg_seq(msg);
+	log_rpc_history_free(msg);
+
+	/* Only the batch with the given timestamp and the newer batches are popped. */
+	zassert_true((seq <= 900) && (seq > 800));
+	zassert_equal(history_drain(), MSG_CNT - 1 - seq);
+}
+
+ZTEST(log_rpc_history, test_capacity)
+{
+	const struct flash_area *fa;
+	uint32_t capacity;
+	uint32_t pushed;
+
+	zassert_ok(flash_area_open(FIXED_PARTITION_ID(log_history), &fa));
+	pushed = fa->fa_size / msg_size();
+	flash_area_close(fa);
+
+	/* Fill the history without overwriting to find out how many messages fit. */
+	log_rpc_history_set_overwriting(false);
+
+	for (uint32_t i = 0; i < pushed; i++) {
+		log_rpc_history_push(msg_create(LOG_LEVEL_INF, i, i));
+	}
+
+	capacity = history_drain();
+	log_rpc_history_set_overwriting(true);
+
+	zassert_true(capacity > 0);
+	zassert_true(capacity <= pushed);
+
+	TC_PRINT("Batch %u B: %u of %u messages of %zu B stored, %u writes per 1000 messages\n",
+		 CONFIG_LOG_BACKEND_RPC_HISTORY_STORAGE_FCB_BATCH_SIZE, capacity, pushed,
+		 msg_size(), stats.write_cnt * 1000 / capacity);
+}
@@ -206,6 +206,14 @@ struct downloader_cfg dl_cfg_small_buffer = {
 	.buf_size = 32,
 };
 
+static int dl_callback_range_server(const struct downloader_evt *event);
+
+struct downloader_cfg dl_cfg_range_server = {
+	.callback = dl_callback_range_server,
+	.buf = dl_buf,
+	.buf_size = sizeof(dl_buf),
+};
+
 struct downloader_cfg dl_cfg_cb_abort = {
 	.callback = dl_callback_abort,
 	.buf = dl_buf,
@@ -928,6 +936,91 @@ static ssize_t z_impl_zsock_recvfrom_https_partial_content_partial_2nd_header(
 	return 0;
 }
 
+/* Minimal HTTP server serving range requests for a file of RANGE_SERVER_FILE_SIZE bytes.
+ * Each request is answered immediately by queuing the response, so pipelined requests
+ * result in several responses being received back to back. Responses are received in
+ * pieces of up to RANGE_SERVER_RECV_MAX bytes, so that a request can be sent while the
+ * response to the previous one is still being received.
+ */
+#define RANGE_SERVER_FILE_SIZE 4096
+#define RANGE_SERVER_FIXED_RANGE 32
+#define RANGE_SERVER_RECV_MAX 16
+
+static struct {
+	char tx[4096];
+	size_t len;
+	size_t off;
+	unsigned int requests;
+	/* Requests sent before the previous response was fully received */
+	unsigned int pipelined;
+	size_t received;
+} range_server;
+
+static ssize_t z_impl_zsock_sendto_range_server(int sock, const void *buf, size_t len, int flags,
+						const struct net_sockaddr *dest_addr,
+						net_socklen_t addrlen)
+{
+	char req[512];
+	const char *range;
+	unsigned int first, last;
+	int hdr_len;
+
+	TEST_ASSERT_EQUAL(FD, sock);
+	TEST_ASSERT(len < sizeof(req));
+
+	memcpy(req, buf, len);
+	req[len] = '\0';
+
+	range = strstr(req, "Range: bytes=");
+	TEST_ASSERT_NOT_NULL(range);
+	TEST_ASSERT_EQUAL(2, sscanf(range, "Range: bytes=%u-%u", &first, &last));
+	TEST_ASSERT(first <= last);
+	TEST_ASSERT(last < RANGE_SERVER_FILE_SIZE);
+
+	range_server.requests++;
+
+	if (range_server.off < range_server.len) {
+		range_server.pipelined++;
+	}
+
+	if (range_server.off) {
+		memmove(range_server.tx, range_server.tx + range_server.off,
+			range_server.len - range_server.off);
+		range_server.len -= range_server.off;
+		range_server.off = 0;
+	}
+
+	hdr_len = snprintf(range_server.tx + range_server.len,
+			   sizeof(range_server.tx) - range_server.len,
+			   "HTTP/1.1 206 Partial Content\r\n"
+			   "Content-Length: %u\r\n"
+			   "Connection: keep-alive\r\n"
+			   "Content-Range: bytes %u-%u/%u\r\n\r\n",
+			   last - first + 1, first, last, RANGE_SERVER_FILE_SIZE);
+	TEST_ASSERT(range_server.len + hdr_len + (last - first + 1) <= sizeof(range_server.tx));
+	range_server.len += hdr_len;
+
+	for (unsigned int i = first; i <= last; i++) {
+		range_server.tx[range_server.len++] = (char)(i & 0xff);
+	}
+
+	return len;
+}
+
+static ssize_t z_impl_zsock_recvfrom_range_server(
+	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
+	net_socklen_t *addrlen)
+{
+	size_t len = MIN(MIN(max_len, RANGE_SERVER_RECV_MAX), range_server.len - range_server.off);
+
+	TEST_ASSERT_EQUAL(FD, sock);
+
+	memcpy(buf, range_server.tx + range_server.off, len);
+	range_server.off += len;
+
+	return len;
+}
+
 static ssize_t z_impl_zsock_recvfrom_http_header_and_payload(
 	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
 	net_socklen_t *addrlen)
@@ -1371,6 +1464,26 @@ static int dl_callback(const struct downloader_evt *event)
 	return 0;
 }
 
+/* Verifies fragments from the range server without queuing them as events. */
+static int dl_callback_range_server(const struct downloader_evt *event)
+{
+	TEST_ASSERT(event != NULL);
+
+	if (event->id == DOWNLOADER_EVT_FRAGMENT) {
+		const uint8_t *data = event->fragment.buf;
+
+		for (size_t i = 0; i < event->fragment.len; i++) {
+			TEST_ASSERT_EQUAL((range_server.received + i) & 0xff, data[i]);
+		}
+		range_server.received += event->fragment.len;
+		return 0;
+	}
+
+	pipe_put(&event_pipe, event);
+
+	return 0;
+}
+
 static int dl_callback_abort(const struct downloader_evt *event)
 {
 	TEST_ASSERT(event != NULL);
@@ -1632,6 +1745,55 @@ void test_downloader_get_https_partial_content_partial_2nd_header(void)
 	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
 }
 
+void test_downloader_get_https_range_server(void)
+{
+	int err;
+	struct downloader_evt evt;
+	struct downloader_host_cfg host_cfg = dl_host_conf_w_sec_tags;
+
+	host_cfg.range_override = RANGE_SERVER_FIXED_RANGE;
+	memset(&range_server, 0, sizeof(range_server));
+
+	err = downloader_init(&dl, &dl_cfg_range_server);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_https_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_https_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_range_server;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_range_server;
+
+	err = downloader_get(&dl, &host_cfg, HTTPS_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	TEST_ASSERT_EQUAL(RANGE_SERVER_FILE_SIZE, range_server.received);
+
+	printk("Range requests: %u, pipelined: %u (fixed range: %u)\n", range_server.requests,
+	       range_server.pipelined, RANGE_SERVER_FILE_SIZE / RANGE_SERVER_FIXED_RANGE);
+
+	if (IS_ENABLED(CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE)) {
+		/* Every range but the first is requested while the previous one is received */
+		TEST_ASSERT_EQUAL(range_server.requests - 1, range_server.pipelined);
+	} else {
+		TEST_ASSERT_EQUAL(0, range_server.pipelined);
+	}
+
+	if (IS_ENABLED(CONFIG_DOWNLOADER_TRANSPORT_HTTP_RANGE_ADAPTIVE)) {
+		TEST_ASSERT_LESS_THAN(RANGE_SERVER_FILE_SIZE / RANGE_SERVER_FIXED_RANGE,
+				      range_server.requests);
+	} else {
+		TEST_ASSERT_EQUAL(RANGE_SERVER_FILE_SIZE / RANGE_SERVER_FIXED_RANGE,
+				  range_server.requests);
+	}
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
 void test_downloader_https_unlimited_redirect(void)
 {
 	int err;
@@ -9,6 +9,7 @@
 #include <string.h>
 #include <zephyr/init.h>
 #include <net/mqtt_helper.h>
+#include <zephyr/settings/settings.h>
 
 #include "zephyr/net/cmock_socket.h"
 #include "cmock_mqtt.h"
@@ -50,6 +51,20 @@ extern void mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 extern void mqtt_helper_poll_loop(void);
 extern void on_publish(const struct mqtt_evt *mqtt_evt);
 extern char payload_buf[];
+extern uint16_t mqtt_helper_msg_id;
+extern int pubq_settings_set(const char *key, size_t len_rd, settings_read_cb read_cb,
+			     void *cb_arg);
+
+/* Layout of a publish queue message stored in the settings. */
+struct pubq_record {
+	uint32_t seq;
+	uint16_t message_id;
+	uint16_t topic_len;
+	uint16_t payload_len;
+	uint8_t qos;
+	uint8_t retain;
+	uint8_t data[TEST_TOPIC_1_LEN + TEST_PAYLOAD_LEN];
+};
 
 /* Fake addrinfo entries returned from the mocked zsock_getaddrinfo(). */
 static struct net_sockaddr_in test_sockaddr_in = {
@@ -71,6 +86,15 @@ static K_SEM_DEFINE(suback_sem, 0, 1);
 static K_SEM_DEFINE(publish_sem, 0, 1);
 static K_SEM_DEFINE(error_msg_size_sem, 0, 1);
 
+/* Messages sent through the mocked mqtt_publish(), used by the publish queue tests. */
+static struct {
+	uint16_t message_id;
+	bool dup;
+	uint8_t payload[TEST_PAYLOAD_LEN];
+	size_t payload_len;
+} published[8];
+static int publish_stub_count;
+
 void setUp(void)
 {
 	__cmock_mqtt_keepalive_time_left_IgnoreAndReturn(0);
@@ -81,6 +105,9 @@ void setUp(void)
 	/* Force all tests to start in uninitialized state. */
 	mqtt_state = MQTT_STATE_UNINIT;
 
+	mqtt_helper_publish_queue_clear();
+	publish_stub_count = 0;
+
 	/* Reset mqtt_helper_msg_id_get() internal counter */
 	while (UINT16_MAX != mqtt_helper_msg_id_get()) {
 		/* Do nothing */
@@ -128,8 +155,74 @@ static int poll_stub_pollerr(struct zsock_pollfd *fds, int nfds, int timeout, in
 	return num_calls == 0 ? 1 : -1;
 }
 
+static int mqtt_publish_stub(struct mqtt_client *client, const struct mqtt_publish_param *param,
+			     int num_calls)
+{
+	TEST_ASSERT_TRUE(publish_stub_count < ARRAY_SIZE(published));
+	TEST_ASSERT_EQUAL(TEST_TOPIC_1_LEN, param->message.topic.topic.size);
+	TEST_ASSERT_EQUAL_MEMORY(TEST_TOPIC_1, param->message.topic.topic.utf8,
+				 TEST_TOPIC_1_LEN);
+	TEST_ASSERT_TRUE(param->message.payload.len <= TEST_PAYLOAD_LEN);
+
+	published[publish_stub_count].message_id = param->message_id;
+	published[publish_stub_count].dup = param->dup_flag;
+	published[publish_stub_count].payload_len = param->message.payload.len;
+	memcpy(published[publish_stub_count].payload, param->message.payload.data,
+	       param->message.payload.len);
+	publish_stub_count++;
+
+	return 0;
+}
 
 /* Helper functions */
+static void publish_enqueue(uint16_t message_id, const char *payload, bool coalesce)
+{
+	struct mqtt_publish_param pub_param = {
+		.message = {
+			.payload = {
+				.data = (uint8_t *)payload,
+				.len = strlen(payload),
+			},
+			.topic = {
+				.topic = {
+					.utf8 = TEST_TOPIC_1,
+					.size = TEST_TOPIC_1_LEN,
+				},
+				.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+			},
+		},
+		.message_id = message_id,
+	};
+
+	TEST_ASSERT_EQUAL(0, mqtt_helper_publish_enqueue(&pub_param, coalesce));
+}
+
+static ssize_t pubq_record_read(void *cb_arg, void *data, size_t len)
+{
+	memcpy(data, cb_arg, len);
+
+	return len;
+}
+
+/* Restores a message of the publish queue, as done by the settings subsystem at boot. */
+static void pubq_record_restore(const char *key, uint32_t seq, uint16_t message_id,
+				const char *payload)
+{
+	struct pubq_record rec = {
+		.seq = seq,
+		.message_id = message_id,
+		.topic_len = TEST_TOPIC_1_LEN,
+		.payload_len = strlen(payload),
+		.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+	};
+	size_t len = offsetof(struct pubq_record, data) + rec.topic_len + rec.payload_len;
+
+	memcpy(rec.data, TEST_TOPIC_1, rec.topic_len);
+	memcpy(rec.data + rec.topic_len, payload, rec.payload_len);
+
+	TEST_ASSERT_EQUAL(0, pubq_settings_set(key, len, pubq_record_read, &rec));
+}
+
 static void send_publish_event(int message_id)
 {
 	struct mqtt_evt evt = {
@@ -526,6 +619,190 @@ void test_mqtt_helper_publish_invalid_message_id(void)
 	TEST_ASSERT_EQUAL(-EINVAL, mqtt_helper_publish(&pub_param_dummy));
 }
 
+void test_mqtt_helper_publish_enqueue_when_disconnected(void)
+{
+	struct mqtt_helper_publish_queue_stats stats;
+
+	__cmock_mqtt_publish_Stub(mqtt_publish_stub);
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+
+	publish_enqueue(1, "a", false);
+	publish_enqueue(2, "b", false);
+
+	TEST_ASSERT_EQUAL(0, publish_stub_count);
+
+	mqtt_state = MQTT_STATE_CONNECTING;
+
+	send_mqtt_event(MQTT_EVT_CONNACK, MQTT_CONNECTION_ACCEPTED);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&connack_success_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(2, publish_stub_count);
+	TEST_ASSERT_EQUAL(1, published[0].message_id);
+	TEST_ASSERT_EQUAL(2, published[1].message_id);
+	TEST_ASSERT_FALSE(published[0].dup);
+
+	mqtt_helper_publish_queue_stats_get(&stats);
+	TEST_ASSERT_EQUAL(2, stats.depth);
+	TEST_ASSERT_EQUAL(2, stats.in_flight);
+}
+
+void test_mqtt_helper_publish_enqueue_inflight_window(void)
+{
+	struct mqtt_helper_publish_queue_stats stats;
+
+	__cmock_mqtt_publish_Stub(mqtt_publish_stub);
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	publish_enqueue(1, "a", false);
+	publish_enqueue(2, "b", false);
+	publish_enqueue(3, "c", false);
+
+	/* Only two messages may be unacknowledged at a time. */
+	TEST_ASSERT_EQUAL(2, publish_stub_count);
+
+	send_mqtt_event(MQTT_EVT_PUBACK, 1);
+
+	TEST_ASSERT_EQUAL(3, publish_stub_count);
+	TEST_ASSERT_EQUAL(3, published[2].message_id);
+
+	send_mqtt_event(MQTT_EVT_PUBACK, 2);
+	send_mqtt_event(MQTT_EVT_PUBACK, 3);
+
+	mqtt_helper_publish_queue_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.depth);
+	TEST_ASSERT_EQUAL(0, stats.in_flight);
+	TEST_ASSERT_EQUAL(3, stats.completed);
+}
+
+void test_mqtt_helper_publish_enqueue_coalesce(void)
+{
+	struct mqtt_helper_publish_queue_stats stats;
+
+	__cmock_mqtt_publish_Stub(mqtt_publish_stub);
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+
+	publish_enqueue(1, "old", true);
+	publish_enqueue(2, "new", true);
+
+	mqtt_helper_publish_queue_stats_get(&stats);
+	TEST_ASSERT_EQUAL(1, stats.depth);
+	TEST_ASSERT_EQUAL(1, stats.coalesced);
+
+	mqtt_state = MQTT_STATE_CONNECTING;
+
+	send_mqtt_event(MQTT_EVT_CONNACK, MQTT_CONNECTION_ACCEPTED);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&connack_success_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(1, publish_stub_count);
+	TEST_ASSERT_EQUAL(2, published[0].message_id);
+	TEST_ASSERT_EQUAL(3, published[0].payload_len);
+	TEST_ASSERT_EQUAL_MEMORY("new", published[0].payload, 3);
+}
+
+void test_mqtt_helper_publish_enqueue_full(void)
+{
+	struct mqtt_helper_publish_queue_stats stats;
+	struct mqtt_publish_param pub_param = {
+		.message.topic = {
+			.topic = {
+				.utf8 = TEST_TOPIC_1,
+				.size = TEST_TOPIC_1_LEN,
+			},
+			.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		},
+		.message_id = TEST_MESSAGE_ID,
+	};
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+
+	for (int i = 0; i < CONFIG_MQTT_HELPER_PUBLISH_QUEUE_LEN; i++) {
+		TEST_ASSERT_EQUAL(0, mqtt_helper_publish_enqueue(&pub_param, false));
+	}
+
+	TEST_ASSERT_EQUAL(-ENOMEM, mqtt_helper_publish_enqueue(&pub_param, false));
+
+	pub_param.message.payload.len = CONFIG_MQTT_HELPER_PUBLISH_QUEUE_ENTRY_SIZE;
+	TEST_ASSERT_EQUAL(-EMSGSIZE, mqtt_helper_publish_enqueue(&pub_param, false));
+
+	mqtt_helper_publish_queue_stats_get(&stats);
+	TEST_ASSERT_EQUAL(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_LEN, stats.depth);
+	TEST_ASSERT_EQUAL(CONFIG_MQTT_HELPER_PUBLISH_QUEUE_LEN, stats.depth_max);
+	TEST_ASSERT_EQUAL(1, stats.rejected);
+
+	mqtt_helper_publish_queue_clear();
+
+	mqtt_helper_publish_queue_stats_get(&stats);
+	TEST_ASSERT_EQUAL(0, stats.depth);
+	TEST_ASSERT_EQUAL(0, stats.depth_max);
+	TEST_ASSERT_EQUAL(0, stats.rejected);
+}
+
+void test_mqtt_helper_publish_enqueue_resend_after_reconnect(void)
+{
+	__cmock_mqtt_publish_Stub(mqtt_publish_stub);
+
+	mqtt_state = MQTT_STATE_CONNECTED;
+
+	publish_enqueue(1, "a", false);
+	TEST_ASSERT_EQUAL(1, publish_stub_count);
+
+	send_mqtt_event(MQTT_EVT_DISCONNECT, 0);
+	TEST_ASSERT_EQUAL(0, k_sem_take(&disconnect_sem, K_SECONDS(1)));
+
+	mqtt_state = MQTT_STATE_CONNECTING;
+
+	send_mqtt_event(MQTT_EVT_CONNACK, MQTT_CONNECTION_ACCEPTED);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&connack_success_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(2, publish_stub_count);
+	TEST_ASSERT_EQUAL(1, published[1].message_id);
+	TEST_ASSERT_TRUE(published[1].dup);
+}
+
+void test_mqtt_helper_publish_enqueue_restore(void)
+{
+	__cmock_mqtt_publish_Stub(mqtt_publish_stub);
+
+	mqtt_state = MQTT_STATE_DISCONNECTED;
+
+	/* Message ID counter starts from the beginning after a reboot. */
+	mqtt_helper_msg_id = 0;
+
+	pubq_record_restore("0", 7, 3, "a");
+	pubq_record_restore("1", 8, 1, "b");
+
+	/* New message IDs start after the restored ones. */
+	TEST_ASSERT_EQUAL(4, mqtt_helper_msg_id_get());
+
+	/* IDs of the queued messages are skipped. */
+	mqtt_helper_msg_id = 0;
+	TEST_ASSERT_EQUAL(2, mqtt_helper_msg_id_get());
+	TEST_ASSERT_EQUAL(4, mqtt_helper_msg_id_get());
+
+	publish_enqueue(0, "c", false);
+
+	mqtt_state = MQTT_STATE_CONNECTING;
+
+	send_mqtt_event(MQTT_EVT_CONNACK, MQTT_CONNECTION_ACCEPTED);
+
+	/* Restored messages were not sent in this connection, they are not duplicates. */
+	TEST_ASSERT_EQUAL(0, k_sem_take(&connack_success_sem, K_SECONDS(1)));
+	TEST_ASSERT_EQUAL(2, publish_stub_count);
+	TEST_ASSERT_EQUAL(3, published[0].message_id);
+	TEST_ASSERT_FALSE(published[0].dup);
+	TEST_ASSERT_EQUAL(1, published[1].message_id);
+	TEST_ASSERT_FALSE(published[1].dup);
+
+	send_mqtt_event(MQTT_EVT_PUBACK, 3);
+
+	TEST_ASSERT_EQUAL(3, publish_stub_count);
+	TEST_ASSERT_EQUAL(5, published[2].message_id);
+	TEST_ASSERT_EQUAL_MEMORY("c", published[2].payload, 1);
+}
+
 void test_mqtt_helper_deinit_when_disconnected(void)
 {
 	mqtt_state = MQTT_STATE_DISCONNECTED;
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Fakes required to link nrf_cloud_codec.c and nrf_cloud_batch.c in the test
+ * environment.
+ *
+ * The codec helpers and memory wrappers are the same as in the codec/json
+ * test. nrf_cloud_send() replaces the MQTT transport and records what would
+ * have been sent.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <cJSON.h>
+#include <errno.h>
+#include <nrf_cloud_codec_internal.h>
+#include <nrf_cloud_mem.h>
+#include <net/nrf_cloud.h>
+
+#include "fakes.h"
+
+/*
+ * cJSON helper fakes (mirrors of nrf_cloud_codec_internal.c).
+ *
+ * The real implementations live in nrf_cloud_codec_internal.c, which cannot
+ * be compiled here because it pulls in modem_info, alerts, logging, and other
+ * subsystems unavailable in this minimal test config.
+ *
+ * Signature correctness is enforced at compile time via the
+ * nrf_cloud_codec_internal.h include above.  Behavioral divergence (e.g. a
+ * changed error code) would not be caught here; if the real implementations
+ * change materially, these fakes must be updated to match.
+ */
+
+int get_string_from_obj(const cJSON *const obj, const char *const key, char **string_out)
+{
+	if (!obj) {
+		return -ENOENT;
+	}
+
+	cJSON *item = cJSON_GetObjectItem(obj, key);
+
+	if (!cJSON_IsString(item)) {
+		return item ? -ENOMSG : -ENODEV;
+	}
+
+	*string_out = item->valuestring;
+	return 0;
+}
+
+int get_num_from_obj(const cJSON *const obj, const char *const key, double *num_out)
+{
+	if (!obj) {
+		return -ENOENT;
+	}
+
+	cJSON *item = cJSON_GetObjectItem(obj, key);
+
+	if (!cJSON_IsNumber(item)) {
+		return item ? -ENOMSG : -ENODEV;
+	}
+
+	*num_out = item->valuedouble;
+	return 0;
+}
+
+int get_bool_from_obj(const cJSON *const obj, const char *const key, bool *bool_out)
+{
+	if (!obj) {
+		return -ENOENT;
+	}
+
+	cJSON *item = cJSON_GetObjectItem(obj, key);
+
+	if (!cJSON_IsBool(item)) {
+		return item ? -ENOMSG : -ENODEV;
+	}
+
+	*bool_out = (bool)cJSON_IsTrue(item);
+	return 0;
+}
+
+/* Memory wrapper fakes (mirrors of nrf_cloud_mem.c) */
+
+void *nrf_cloud_calloc(size_t count, size_t size)
+{
+	return calloc(count, size);
+}
+
+void *nrf_cloud_malloc(size_t size)
+{
+	return malloc(size);
+}
+
+void nrf_cloud_free(void *ptr)
+{
+	free(ptr);
+}
+
+/* Transport fake */
+
+int fake_send_err;
+uint32_t fake_send_cnt;
+uint32_t fake_send_bytes;
+
+int nrf_cloud_send(const struct nrf_cloud_tx_data *msg)
+{
+	if (fake_send_err) {
+		return fake_send_err;
+	}
+
+	if (!msg || !msg->obj || msg->topic_type != NRF_CLOUD_TOPIC_BULK ||
+	    msg->obj->enc_src != NRF_CLOUD_ENC_SRC_CLOUD_ENCODED) {
+		return -EINVAL;
+	}
+
+	fake_send_cnt++;
+	fake_send_bytes += msg->obj->encoded_data.len;
+
+	return 0;
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FAKES_H__
+#define FAKES_H__
+
+#include <stdint.h>
+
+/* Error returned by the fake nrf_cloud_send(), 0 for success */
+extern int fake_send_err;
+/* Number of messages and bytes passed to nrf_cloud_send() */
+extern uint32_t fake_send_cnt;
+extern uint32_t fake_send_bytes;
+
+#endif /* FAKES_H__ */
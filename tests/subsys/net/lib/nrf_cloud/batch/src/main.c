@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Unit tests for nRF Cloud message batching, <net/nrf_cloud_batch.h>.
+ *
+ * The batching module is compiled together with the JSON codec. The MQTT
+ * transport is replaced by the nrf_cloud_send() fake in src/fakes.c, which
+ * counts the bulk messages and their encoded size.
+ *
+ * Limits (see CMakeLists.txt): 8 messages, 1024 bytes, 1 second age.
+ */
+
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud_batch.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_defs.h>
+#include <cJSON.h>
+#include <string.h>
+
+#include "fakes.h"
+
+#define MAX_MSGS 8
+
+/* Timestamp of the first sample of the simulated hour */
+#define TS_START_MS 1700000000000LL
+
+/* Estimated MQTT, TLS, TCP and IP overhead of one publish, in bytes */
+#define PUBLISH_OVERHEAD 100
+
+static struct nrf_cloud_batch_stats stats_get(void)
+{
+	struct nrf_cloud_batch_stats stats;
+
+	nrf_cloud_batch_stats_get(&stats);
+
+	return stats;
+}
+
+static void batch_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	fake_send_err = 0;
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+
+	fake_send_cnt = 0;
+	fake_send_bytes = 0;
+}
+
+ZTEST_SUITE(nrf_cloud_batch, NULL, NULL, batch_before, NULL, NULL);
+
+ZTEST(nrf_cloud_batch, test_add_invalid)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(arr);
+
+	zassert_equal(nrf_cloud_batch_add(NULL, false), -EINVAL);
+	zassert_equal(nrf_cloud_batch_add(&arr, false), -EINVAL);
+
+	zassert_equal(nrf_cloud_obj_bulk_init(&arr), 0);
+	zassert_equal(nrf_cloud_batch_add(&arr, false), -ENOTSUP);
+	nrf_cloud_obj_free(&arr);
+}
+
+ZTEST(nrf_cloud_batch, test_add_takes_ownership)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg);
+
+	zassert_equal(nrf_cloud_obj_msg_init(&msg, NRF_CLOUD_JSON_APPID_VAL_TEMP,
+					     NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA), 0);
+	zassert_equal(nrf_cloud_batch_add(&msg, false), 0);
+	zassert_is_null(msg.json);
+
+	zassert_equal(fake_send_cnt, 0);
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+	zassert_equal(fake_send_cnt, 1);
+
+	/* Nothing left to send */
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+	zassert_equal(fake_send_cnt, 1);
+}
+
+ZTEST(nrf_cloud_batch, test_flush_on_count)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+
+	for (int i = 0; i < MAX_MSGS - 1; i++) {
+		zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, i,
+							 TS_START_MS + i, false), 0);
+	}
+	zassert_equal(fake_send_cnt, 0);
+
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, 0,
+						 TS_START_MS, false), 0);
+	zassert_equal(fake_send_cnt, 1);
+
+	after = stats_get();
+	zassert_equal(after.added - before.added, MAX_MSGS);
+	zassert_equal(after.flush_reasons[NRF_CLOUD_BATCH_FLUSH_COUNT] -
+		      before.flush_reasons[NRF_CLOUD_BATCH_FLUSH_COUNT], 1);
+	zassert_equal(after.bytes_sent - before.bytes_sent, fake_send_bytes);
+}
+
+ZTEST(nrf_cloud_batch, test_flush_on_size)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+	char value[300];
+
+	memset(value, 'x', sizeof(value) - 1);
+	value[sizeof(value) - 1] = '\0';
+
+	/* Each message is about 350 bytes, so the batch is sent when a third one would not fit */
+	for (int i = 0; i < 3; i++) {
+		NRF_CLOUD_OBJ_JSON_DEFINE(msg);
+
+		zassert_equal(nrf_cloud_obj_msg_init(&msg, "LOG",
+						     NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA), 0);
+		zassert_equal(nrf_cloud_obj_str_add(&msg, NRF_CLOUD_JSON_DATA_KEY, value,
+						    false), 0);
+		zassert_equal(nrf_cloud_batch_add(&msg, false), 0);
+	}
+
+	zassert_equal(fake_send_cnt, 1);
+	zassert_true(fake_send_bytes <= 1024);
+
+	after = stats_get();
+	zassert_equal(after.flush_reasons[NRF_CLOUD_BATCH_FLUSH_SIZE] -
+		      before.flush_reasons[NRF_CLOUD_BATCH_FLUSH_SIZE], 1);
+}
+
+ZTEST(nrf_cloud_batch, test_coalesce)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_HUMID, 40.0,
+						 TS_START_MS, true), 0);
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, 21.0,
+						 TS_START_MS, true), 0);
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_HUMID, 42.0,
+						 TS_START_MS + 1000, true), 0);
+
+	after = stats_get();
+	zassert_equal(after.added - before.added, 3);
+	zassert_equal(after.coalesced - before.coalesced, 1);
+
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+	zassert_equal(fake_send_cnt, 1);
+
+	/* Only the latest humidity value and the temperature are sent */
+	zassert_true(fake_send_bytes < 2 * 100);
+}
+
+ZTEST(nrf_cloud_batch, test_flush_on_age)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, 21.0,
+						 TS_START_MS, false), 0);
+	zassert_equal(fake_send_cnt, 0);
+
+	k_sleep(K_MSEC(1500));
+
+	zassert_equal(fake_send_cnt, 1);
+
+	after = stats_get();
+	zassert_equal(after.flush_reasons[NRF_CLOUD_BATCH_FLUSH_AGE] -
+		      before.flush_reasons[NRF_CLOUD_BATCH_FLUSH_AGE], 1);
+}
+
+ZTEST(nrf_cloud_batch, test_send_failure_keeps_messages)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+
+	zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, 21.0,
+						 TS_START_MS, false), 0);
+
+	fake_send_err = -ENOTCONN;
+	zassert_equal(nrf_cloud_batch_flush(), -ENOTCONN);
+
+	fake_send_err = 0;
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+	zassert_equal(fake_send_cnt, 1);
+
+	after = stats_get();
+	zassert_equal(after.send_errors - before.send_errors, 1);
+	zassert_equal(after.dropped - before.dropped, 0);
+}
+
+ZTEST(nrf_cloud_batch, test_oldest_dropped_when_unsent)
+{
+	struct nrf_cloud_batch_stats before = stats_get();
+	struct nrf_cloud_batch_stats after;
+
+	fake_send_err = -ENOTCONN;
+
+	for (int i = 0; i < MAX_MSGS + 2; i++) {
+		zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, i,
+							 TS_START_MS + i, false), 0);
+	}
+
+	after = stats_get();
+	zassert_equal(after.dropped - before.dropped, 2);
+
+	fake_send_err = 0;
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+	zassert_equal(fake_send_cnt, 1);
+}
+
+/* Size of a single, unbatched device message as it would be sent with nrf_cloud_send() */
+static size_t single_msg_size(const char *app_id, double value, int64_t ts_ms)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg);
+	size_t len;
+
+	zassert_equal(nrf_cloud_obj_msg_init(&msg, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA), 0);
+	zassert_equal(nrf_cloud_obj_num_add(&msg, NRF_CLOUD_JSON_DATA_KEY, value, false), 0);
+	zassert_equal(nrf_cloud_obj_ts_add(&msg, ts_ms), 0);
+	zassert_equal(nrf_cloud_obj_cloud_encode(&msg), 0);
+
+	len = msg.encoded_data.len;
+
+	nrf_cloud_obj_cloud_encoded_free(&msg);
+	nrf_cloud_obj_free(&msg);
+
+	return len;
+}
+
+/* Temperature and humidity sampled every 10 seconds for one hour. */
+ZTEST(nrf_cloud_batch, test_sensor_hour)
+{
+	const int samples = 3600 / 10;
+	uint32_t single_cnt = 0;
+	uint32_t single_bytes = 0;
+	uint32_t batch_air;
+	uint32_t single_air;
+
+	for (int i = 0; i < samples; i++) {
+		int64_t ts = TS_START_MS + i * 10 * MSEC_PER_SEC;
+		double temp = 20.0 + (i % 7) * 0.1;
+		double humid = 40.0 + (i % 5) * 0.5;
+
+		single_bytes += single_msg_size(NRF_CLOUD_JSON_APPID_VAL_TEMP, temp, ts);
+		single_bytes += single_msg_size(NRF_CLOUD_JSON_APPID_VAL_HUMID, humid, ts);
+		single_cnt += 2;
+
+		/* Every temperature sample is kept, only the latest humidity is of interest */
+		zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_TEMP, temp,
+							 ts, false), 0);
+		zassert_equal(nrf_cloud_batch_sensor_add(NRF_CLOUD_JSON_APPID_VAL_HUMID, humid,
+							 ts, true), 0);
+	}
+
+	zassert_equal(nrf_cloud_batch_flush(), 0);
+
+	single_air = single_bytes + single_cnt * PUBLISH_OVERHEAD;
+	batch_air = fake_send_bytes + fake_send_cnt * PUBLISH_OVERHEAD;
+
+	TC_PRINT("Unbatched: %u messages, %u bytes, ~%u bytes on air\n",
+		 single_cnt, single_bytes, single_air);
+	TC_PRINT("Batched:   %u messages, %u bytes, ~%u bytes on air\n",
+		 fake_send_cnt, fake_send_bytes, batch_air);
+
+	zassert_true(fake_send_cnt * 4 <= single_cnt);
+	zassert_true(fake_send_bytes < single_bytes);
+	zassert_true(batch_air < single_air);
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <net/rest_client.h>
+
+#include "zephyr/net/cmock_socket.h"
+#include "zephyr/net/http/cmock_client.h"
+
+#define TEST_HOST		"rest.example.com"
+#define TEST_PORT		80
+#define TEST_URL		"/test"
+#define TEST_TIMEOUT_MS		5000
+
+#define TEST_BODY		"ok"
+#define TEST_RESPONSE		"HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n" TEST_BODY
+
+/* Time taken by a failing request */
+#define TEST_FAIL_DELAY_MS	100
+
+/* First socket descriptor returned by the mocked zsock_socket() */
+#define TEST_SOCK_FIRST		10
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+/* Fake addrinfo entry returned from the mocked zsock_getaddrinfo(). */
+static struct net_sockaddr_in test_sockaddr_in = {
+	.sin_family = NET_AF_INET,
+};
+static struct zsock_addrinfo test_addrinfo = {
+	.ai_family = NET_AF_INET,
+	.ai_addr = (struct net_sockaddr *)&test_sockaddr_in,
+	.ai_addrlen = sizeof(test_sockaddr_in),
+	.ai_next = NULL,
+};
+
+static char resp_buf[256];
+
+static int sockets_opened;
+static int sockets_closed;
+static int last_closed_sock;
+
+/* Requests passed to the mocked http_client_req() */
+static struct {
+	int sock;
+	int32_t timeout;
+} http_reqs[4];
+static int http_req_count;
+
+/* Result of each request, 0 for a successful response or a negative error code */
+static int http_req_results[ARRAY_SIZE(http_reqs)];
+
+/* The HTTP parser is not built, all responses allow the connection to be kept alive. */
+int http_should_keep_alive(const struct http_parser *parser)
+{
+	ARG_UNUSED(parser);
+
+	return 1;
+}
+
+/* Stubs */
+static int zsock_getaddrinfo_stub(const char *host, const char *service,
+				  const struct zsock_addrinfo *hints,
+				  struct zsock_addrinfo **res, int num_calls)
+{
+	*res = &test_addrinfo;
+
+	return 0;
+}
+
+static int zsock_socket_stub(int family, int type, int proto, int num_calls)
+{
+	return TEST_SOCK_FIRST + sockets_opened++;
+}
+
+static int zsock_connect_stub(int sock, const struct net_sockaddr *addr, net_socklen_t addrlen,
+			      int num_calls)
+{
+	return 0;
+}
+
+static int zsock_close_stub(int sock, int num_calls)
+{
+	sockets_closed++;
+	last_closed_sock = sock;
+
+	return 0;
+}
+
+/* Pooled connections have nothing to read, so they are not detected as stale by the pool. */
+static int zsock_poll_stub(struct zsock_pollfd *fds, int nfds, int timeout, int num_calls)
+{
+	return 0;
+}
+
+static int http_client_req_stub(int sock, struct http_request *req, int32_t timeout,
+				void *user_data, int num_calls)
+{
+	static const char response[] = TEST_RESPONSE;
+	struct http_response rsp = {
+		.recv_buf = (uint8_t *)response,
+		.data_len = sizeof(response) - 1,
+		.body_found = 1,
+		.body_frag_start = (uint8_t *)strstr(response, "\r\n\r\n") + 4,
+		.http_status_code = 200,
+		.processed = sizeof(TEST_BODY) - 1,
+	};
+	int result;
+
+	TEST_ASSERT_LESS_THAN(ARRAY_SIZE(http_reqs), http_req_count);
+
+	http_reqs[http_req_count].sock = sock;
+	http_reqs[http_req_count].timeout = timeout;
+	result = http_req_results[http_req_count];
+	http_req_count++;
+
+	if (result < 0) {
+		/* No response data before the failure */
+		k_sleep(K_MSEC(TEST_FAIL_DELAY_MS));
+		return result;
+	}
+
+	strcpy(rsp.http_status, "OK");
+	req->response(&rsp, HTTP_DATA_FINAL, user_data);
+
+	return rsp.data_len;
+}
+
+void setUp(void)
+{
+	__cmock_zsock_getaddrinfo_Stub(zsock_getaddrinfo_stub);
+	__cmock_zsock_freeaddrinfo_Ignore();
+	__cmock_zsock_inet_ntop_IgnoreAndReturn(NULL);
+	__cmock_zsock_socket_Stub(zsock_socket_stub);
+	__cmock_zsock_setsockopt_IgnoreAndReturn(0);
+	__cmock_zsock_connect_Stub(zsock_connect_stub);
+	__cmock_zsock_close_Stub(zsock_close_stub);
+	__cmock_zsock_poll_Stub(zsock_poll_stub);
+	__cmock_http_client_req_Stub(http_client_req_stub);
+
+	/* Start every test without pooled connections or cached addresses */
+	rest_client_pool_flush();
+
+	sockets_opened = 0;
+	sockets_closed = 0;
+	last_closed_sock = -1;
+	http_req_count = 0;
+	memset(http_reqs, 0, sizeof(http_reqs));
+	memset(http_req_results, 0, sizeof(http_req_results));
+}
+
+static int request_send(struct rest_client_resp_context *resp_ctx)
+{
+	struct rest_client_req_context req_ctx;
+
+	rest_client_request_defaults_set(&req_ctx);
+	req_ctx.host = TEST_HOST;
+	req_ctx.port = TEST_PORT;
+	req_ctx.url = TEST_URL;
+	req_ctx.timeout_ms = TEST_TIMEOUT_MS;
+	req_ctx.resp_buff = resp_buf;
+	req_ctx.resp_buff_len = sizeof(resp_buf);
+
+	return rest_client_request(&req_ctx, resp_ctx);
+}
+
+/* A request on a pooled connection that the server has reset is retried once on a new
+ * connection, within the time left of the request timeout.
+ */
+void test_rest_client_stale_pooled_socket_retry(void)
+{
+	struct rest_client_resp_context resp_ctx;
+	struct rest_client_pool_stats before;
+	struct rest_client_pool_stats after;
+
+	http_req_results[1] = -ECONNRESET;
+
+	TEST_ASSERT_EQUAL(0, request_send(&resp_ctx));
+	TEST_ASSERT_EQUAL(1, sockets_opened);
+	TEST_ASSERT_EQUAL(0, sockets_closed);
+
+	rest_client_pool_stats_get(&before);
+
+	/* The connection of the first request is reused, reset and replaced */
+	TEST_ASSERT_EQUAL(0, request_send(&resp_ctx));
+	TEST_ASSERT_EQUAL(REST_CLIENT_HTTP_STATUS_OK, resp_ctx.http_status_code);
+	TEST_ASSERT_EQUAL_STRING(TEST_BODY, resp_ctx.response);
+
+	rest_client_pool_stats_get(&after);
+
+	TEST_ASSERT_EQUAL(1, after.reuses - before.reuses);
+	TEST_ASSERT_EQUAL(1, after.stale_retries - before.stale_retries);
+	TEST_ASSERT_EQUAL(1, after.connects - before.connects);
+	TEST_ASSERT_EQUAL(0, after.dns_queries - before.dns_queries);
+
+	TEST_ASSERT_EQUAL(3, http_req_count);
+	TEST_ASSERT_EQUAL(TEST_SOCK_FIRST, http_reqs[1].sock);
+	TEST_ASSERT_EQUAL(TEST_SOCK_FIRST + 1, http_reqs[2].sock);
+	TEST_ASSERT_EQUAL(1, sockets_closed);
+	TEST_ASSERT_EQUAL(TEST_SOCK_FIRST, last_closed_sock);
+
+	/* The retry only gets the time left of the request timeout */
+	TEST_ASSERT_EQUAL(TEST_TIMEOUT_MS, http_reqs[1].timeout);
+	TEST_ASSERT_LESS_OR_EQUAL(TEST_TIMEOUT_MS - TEST_FAIL_DELAY_MS, http_reqs[2].timeout);
+	TEST_ASSERT_GREATER_THAN(0, http_reqs[2].timeout);
+}
+
+/* A request that times out on a pooled connection is not retried, the server may have
+ * processed it.
+ */
+void test_rest_client_pooled_socket_timeout_no_retry(void)
+{
+	struct rest_client_resp_context resp_ctx;
+	struct rest_client_pool_stats before;
+	struct rest_client_pool_stats after;
+
+	http_req_results[1] = -ETIMEDOUT;
+
+	TEST_ASSERT_EQUAL(0, request_send(&resp_ctx));
+
+	rest_client_pool_stats_get(&before);
+
+	TEST_ASSERT_EQUAL(-ETIMEDOUT, request_send(&resp_ctx));
+
+	rest_client_pool_stats_get(&after);
+
+	TEST_ASSERT_EQUAL(1, after.reuses - before.reuses);
+	TEST_ASSERT_EQUAL(0, after.stale_retries - before.stale_retries);
+	TEST_ASSERT_EQUAL(0, after.connects - before.connects);
+
+	/* No new connection, the timed out one is closed and not pooled */
+	TEST_ASSERT_EQUAL(2, http_req_count);
+	TEST_ASSERT_EQUAL(1, sockets_opened);
+	TEST_ASSERT_EQUAL(1, sockets_closed);
+	TEST_ASSERT_EQUAL(TEST_SOCK_FIRST, last_closed_sock);
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Event records stored by the RAM backend of the Nordic nrf_profiler.
+ *
+ * Each record consists of the 16-bit event type ID, the 32-bit timestamp and the event data.
+ * It takes 4 bytes of the record header and the record length rounded up to a multiple of
+ * 4 bytes in the ring buffer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <nrf_profiler.h>
+
+#define EVENT_COUNT     CONFIG_NRF_PROFILER_MAX_NUMBER_OF_APP_EVENTS
+#define RECORD_LEN      (sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint32_t))
+#define RECORD_RING_LEN (sizeof(uint32_t) + ROUND_UP(RECORD_LEN, sizeof(uint32_t)))
+#define RING_RECORDS    (CONFIG_NRF_PROFILER_NORDIC_RING_BUFFER_SIZE / RECORD_RING_LEN)
+
+static const char dropped_event_name[] = "_nrf_profiler_dropped_events_";
+
+static uint16_t event_ids[EVENT_COUNT];
+static uint8_t read_buf[CONFIG_NRF_PROFILER_NORDIC_RING_BUFFER_SIZE];
+
+static void event_log(uint16_t event_id, uint32_t value)
+{
+	struct log_event_buf buf;
+
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint32(&buf, value);
+	nrf_profiler_log_send(&buf, event_id);
+}
+
+static void record_check(const uint8_t *record, uint16_t event_id, uint32_t value)
+{
+	zassert_equal(sys_get_le16(record), event_id);
+	zassert_equal(sys_get_le32(&record[sizeof(uint16_t) + sizeof(uint32_t)]), value);
+}
+
+static void *nrf_profiler_ram_setup(void)
+{
+	static const char * const names[] = {"value"};
+	static const enum nrf_profiler_arg types[] = {NRF_PROFILER_ARG_U32};
+	char name[16];
+
+	zassert_ok(nrf_profiler_init());
+
+	for (int i = 0; i < EVENT_COUNT; i++) {
+		snprintf(name, sizeof(name), "event %d", i);
+		event_ids[i] = nrf_profiler_register_event_type(name, names, types, 1);
+	}
+
+	return NULL;
+}
+
+static void nrf_profiler_ram_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	while (nrf_profiler_ram_read(read_buf, sizeof(read_buf)) > 0) {
+	}
+}
+
+ZTEST_SUITE(nrf_profiler_ram, NULL, nrf_profiler_ram_setup, nrf_profiler_ram_before, NULL,
+	    NULL);
+
+ZTEST(nrf_profiler_ram, test_wide_event_id)
+{
+	uint16_t last_id = event_ids[EVENT_COUNT - 1];
+
+	zassert_true(last_id > UINT8_MAX);
+
+	event_log(event_ids[0], 1);
+	event_log(last_id, 2);
+
+	zassert_equal(nrf_profiler_ram_read(read_buf, sizeof(read_buf)), 2 * RECORD_LEN);
+	record_check(read_buf, event_ids[0], 1);
+	record_check(&read_buf[RECORD_LEN], last_id, 2);
+}
+
+ZTEST(nrf_profiler_ram, test_whole_records)
+{
+	for (uint32_t i = 0; i < 3; i++) {
+		event_log(event_ids[i], i);
+	}
+
+	/* Records are not split between reads */
+	zassert_equal(nrf_profiler_ram_read(read_buf, RECORD_LEN - 1), 0);
+	zassert_equal(nrf_profiler_ram_read(read_buf, 2 * RECORD_LEN - 1), RECORD_LEN);
+	record_check(read_buf, event_ids[0], 0);
+
+	zassert_equal(nrf_profiler_ram_read(read_buf, sizeof(read_buf)), 2 * RECORD_LEN);
+	record_check(read_buf, event_ids[1], 1);
+	record_check(&read_buf[RECORD_LEN], event_ids[2], 2);
+}
+
+ZTEST(nrf_profiler_ram, test_dropped_events)
+{
+	const uint32_t extra = 5;
+	uint32_t dropped = nrf_profiler_dropped_count_get();
+	size_t len;
+	uint16_t dropped_id;
+
+	/* The events that do not fit are dropped, the profiler keeps running */
+	for (uint32_t i = 0; i < RING_RECORDS + extra; i++) {
+		event_log(event_ids[i], i);
+	}
+
+	zassert_equal(nrf_profiler_dropped_count_get() - dropped, extra);
+
+	len = nrf_profiler_ram_read(read_buf, sizeof(read_buf));
+	zassert_equal(len, RING_RECORDS * RECORD_LEN);
+	for (uint32_t i = 0; i < RING_RECORDS; i++) {
+		record_check(&read_buf[i * RECORD_LEN], event_ids[i], i);
+	}
+
+	/* The number of dropped events is reported once there is space */
+	len = nrf_profiler_ram_read(read_buf, sizeof(read_buf));
+	zassert_equal(len, RECORD_LEN);
+
+	dropped_id = sys_get_le16(read_buf);
+	zassert_ok(strncmp(nrf_profiler_get_event_descr(dropped_id), dropped_event_name,
+			   strlen(dropped_event_name)));
+	record_check(read_buf, dropped_id, extra);
+
+	/* Events are logged again */
+	event_log(event_ids[0], 10);
+	zassert_equal(nrf_profiler_ram_read(read_buf, sizeof(read_buf)), RECORD_LEN);
+	record_check(read_buf, event_ids[0], 10);
+}
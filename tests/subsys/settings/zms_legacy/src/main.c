@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Name lookups, subtree loads and batched saves of the ZMS legacy settings backend.
+ *
+ * The ZMS functions are wrapped at link time to count the flash reads and writes issued by
+ * the backend, see CMakeLists.txt.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kvss/zms.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "settings/settings_zms_legacy.h"
+
+#define NAME_COUNT 32
+#define NAME_LEN   16
+#define VALUE_LEN  16
+
+#define SUBTREE_COUNT	  20
+#define SUBTREE_KEY_COUNT 50
+
+/* Number of names hashed to find two names with the same hash */
+#define COLLISION_SEARCH_COUNT (1 << 18)
+
+static uint32_t zms_reads;
+static uint32_t zms_writes;
+
+/* Hash of a name in the upper and index of the name in the lower 32 bits */
+static uint64_t name_hashes[COLLISION_SEARCH_COUNT];
+
+ssize_t __real_zms_read(struct zms_fs *fs, uint32_t id, void *data, size_t len);
+ssize_t __real_zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len);
+int __real_zms_delete(struct zms_fs *fs, uint32_t id);
+
+ssize_t __wrap_zms_read(struct zms_fs *fs, uint32_t id, void *data, size_t len)
+{
+	zms_reads++;
+
+	return __real_zms_read(fs, id, data, len);
+}
+
+ssize_t __wrap_zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
+{
+	zms_writes++;
+
+	return __real_zms_write(fs, id, data, len);
+}
+
+int __wrap_zms_delete(struct zms_fs *fs, uint32_t id)
+{
+	zms_writes++;
+
+	return __real_zms_delete(fs, id);
+}
+
+struct value_read {
+	const char *name;
+	char value[VALUE_LEN];
+	ssize_t len;
+};
+
+static int value_read_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			 void *param)
+{
+	struct value_read *read = param;
+
+	if (strcmp(key, read->name)) {
+		return 0;
+	}
+
+	read->len = read_cb(cb_arg, read->value, sizeof(read->value));
+
+	return 0;
+}
+
+/* Returns the length of the stored value, or 0 if the setting is not stored. */
+static ssize_t value_read(const char *name, char *value)
+{
+	struct value_read read = {
+		.name = name,
+	};
+
+	zassert_ok(settings_load_subtree_direct(NULL, value_read_cb, &read));
+
+	if (read.len > 0) {
+		memcpy(value, read.value, read.len);
+	}
+
+	return read.len;
+}
+
+static int value_count_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			  void *param)
+{
+	uint32_t *count = param;
+	uint32_t value;
+
+	zassert_equal(read_cb(cb_arg, &value, sizeof(value)), sizeof(value));
+	(*count)++;
+
+	return 0;
+}
+
+static void name_get(char *name, int i)
+{
+	snprintf(name, NAME_LEN, "tst/%d", i);
+}
+
+static int name_hash_cmp(const void *a, const void *b)
+{
+	uint64_t ha = *(const uint64_t *)a;
+	uint64_t hb = *(const uint64_t *)b;
+
+	return (ha > hb) - (ha < hb);
+}
+
+/* Find two names in the "col" subtree with the same hash */
+static void collision_find(char *name_a, char *name_b)
+{
+	char name[NAME_LEN];
+
+	for (uint32_t i = 0; i < COLLISION_SEARCH_COUNT; i++) {
+		snprintf(name, NAME_LEN, "col/%u", i);
+		name_hashes[i] = ((uint64_t)sys_hash32(name, strlen(name)) << 32) | i;
+	}
+
+	qsort(name_hashes, COLLISION_SEARCH_COUNT, sizeof(name_hashes[0]), name_hash_cmp);
+
+	for (uint32_t i = 1; i < COLLISION_SEARCH_COUNT; i++) {
+		if ((name_hashes[i] >> 32) == (name_hashes[i - 1] >> 32)) {
+			snprintf(name_a, NAME_LEN, "col/%u", (uint32_t)name_hashes[i - 1]);
+			snprintf(name_b, NAME_LEN, "col/%u", (uint32_t)name_hashes[i]);
+			return;
+		}
+	}
+
+	zassert_unreachable("No hash collision found");
+}
+
+static void counters_reset(void)
+{
+	zms_reads = 0;
+	zms_writes = 0;
+}
+
+static void *settings_zms_setup(void)
+{
+	zassert_ok(settings_subsys_init());
+
+	return NULL;
+}
+
+static void settings_zms_before(void *fixture)
+{
+	char name[NAME_LEN];
+
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NAME_COUNT; i++) {
+		name_get(name, i);
+		zassert_ok(settings_delete(name));
+	}
+
+	zassert_ok(settings_load());
+
+	counters_reset();
+}
+
+ZTEST_SUITE(settings_zms, NULL, settings_zms_setup, settings_zms_before, NULL, NULL);
+
+ZTEST(settings_zms, test_lookup_without_scan)
+{
+	char name[NAME_LEN];
+	uint32_t value;
+
+	for (int i = 0; i < NAME_COUNT; i++) {
+		name_get(name, i);
+		value = i;
+		zassert_ok(settings_save_one(name, &value, sizeof(value)));
+	}
+
+	/* Only the name with a matching hash is read, regardless of the number of names */
+	counters_reset();
+	value = 0;
+	zassert_ok(settings_save_one("tst/0", &value, sizeof(value)));
+	zassert_equal(zms_reads, 1);
+	zassert_equal(zms_writes, 1);
+
+	/* The delete reads the name, the new name is stored without reading ZMS */
+	counters_reset();
+	zassert_ok(settings_delete("tst/1"));
+	zassert_ok(settings_save_one("tst/1", &value, sizeof(value)));
+	zassert_equal(zms_reads, 1);
+}
+
+ZTEST(settings_zms, test_subtree_load)
+{
+	char name[NAME_LEN];
+	uint32_t full_reads;
+	uint32_t count = 0;
+	uint32_t v;
+
+	for (int s = 0; s < SUBTREE_COUNT; s++) {
+		for (v = 0; v < SUBTREE_KEY_COUNT; v++) {
+			snprintf(name, NAME_LEN, "sub%d/%u", s, v);
+			zassert_ok(settings_save_one(name, &v, sizeof(v)));
+		}
+	}
+
+	counters_reset();
+	zassert_ok(settings_load_subtree_direct(NULL, value_count_cb, &count));
+	zassert_equal(count, SUBTREE_COUNT * SUBTREE_KEY_COUNT);
+	full_reads = zms_reads;
+
+	/* "sub1" does not include "sub10" to "sub19" */
+	count = 0;
+	counters_reset();
+	zassert_ok(settings_load_subtree_direct("sub1", value_count_cb, &count));
+	zassert_equal(count, SUBTREE_KEY_COUNT);
+
+	TC_PRINT("%d settings in %d subtrees: %u ZMS reads to load all, %u to load a subtree\n",
+		 SUBTREE_COUNT * SUBTREE_KEY_COUNT, SUBTREE_COUNT, full_reads, zms_reads);
+
+	if (IS_ENABLED(CONFIG_SETTINGS_ZMS_SUBTREE_INDEX)) {
+		/* Only the name and the value of the settings in the subtree are read */
+		zassert_equal(zms_reads, 2 * SUBTREE_KEY_COUNT);
+	} else {
+		zassert_true(zms_reads >= SUBTREE_COUNT * SUBTREE_KEY_COUNT);
+	}
+
+	/* A single setting is found without reading other names */
+	count = 0;
+	counters_reset();
+	zassert_ok(settings_load_subtree_direct("sub7/42", value_count_cb, &count));
+	zassert_equal(count, 1);
+
+	if (IS_ENABLED(CONFIG_SETTINGS_ZMS_SUBTREE_INDEX)) {
+		zassert_equal(zms_reads, 2);
+	}
+
+	/* A deleted setting is not loaded */
+	zassert_ok(settings_delete("sub7/42"));
+	count = 0;
+	zassert_ok(settings_load_subtree_direct("sub7", value_count_cb, &count));
+	zassert_equal(count, SUBTREE_KEY_COUNT - 1);
+
+	for (int s = 0; s < SUBTREE_COUNT; s++) {
+		for (v = 0; v < SUBTREE_KEY_COUNT; v++) {
+			snprintf(name, NAME_LEN, "sub%d/%u", s, v);
+			zassert_ok(settings_delete(name));
+		}
+	}
+}
+
+ZTEST(settings_zms, test_subtree_load_hash_collision)
+{
+	char name_a[NAME_LEN];
+	char name_b[NAME_LEN];
+	uint32_t count;
+	uint32_t v;
+
+	collision_find(name_a, name_b);
+	TC_PRINT("%s and %s have the same hash\n", name_a, name_b);
+
+	v = 1;
+	zassert_ok(settings_save_one(name_a, &v, sizeof(v)));
+	v = 2;
+	zassert_ok(settings_save_one(name_b, &v, sizeof(v)));
+
+	/* Both settings are loaded before and after the index is rebuilt by a full load */
+	for (int i = 0; i < 2; i++) {
+		struct value_read read_a = {
+			.name = name_a,
+		};
+		struct value_read read_b = {
+			.name = name_b,
+		};
+
+		count = 0;
+		zassert_ok(settings_load_subtree_direct("col", value_count_cb, &count));
+		zassert_equal(count, 2);
+
+		zassert_ok(settings_load_subtree_direct(name_a, value_read_cb, &read_a));
+		zassert_equal(read_a.len, sizeof(v));
+		zassert_equal(*(uint32_t *)read_a.value, 1);
+
+		zassert_ok(settings_load_subtree_direct(name_b, value_read_cb, &read_b));
+		zassert_equal(read_b.len, sizeof(v));
+		zassert_equal(*(uint32_t *)read_b.value, 2);
+
+		zassert_ok(settings_load());
+	}
+
+	zassert_ok(settings_delete(name_a));
+	zassert_ok(settings_delete(name_b));
+}
+
+#if CONFIG_SETTINGS_ZMS_SUBTREE_INDEX
+ZTEST(settings_zms, test_subtree_index_delete)
+{
+	char name[NAME_LEN];
+	uint32_t count = 0;
+	uint32_t v;
+
+	/* The nodes of deleted settings are freed, so more settings than nodes in the index
+	 * can be stored and deleted in turn.
+	 */
+	for (v = 0; v < CONFIG_SETTINGS_ZMS_SUBTREE_INDEX_SIZE; v++) {
+		snprintf(name, NAME_LEN, "del/%u", v);
+		zassert_ok(settings_save_one(name, &v, sizeof(v)));
+		zassert_ok(settings_delete(name));
+	}
+
+	zassert_ok(settings_save_one("del/x", &v, sizeof(v)));
+
+	/* The subtree is still loaded through the index */
+	counters_reset();
+	zassert_ok(settings_load_subtree_direct("del", value_count_cb, &count));
+	zassert_equal(count, 1);
+	zassert_equal(zms_reads, 2);
+
+	zassert_ok(settings_delete("del/x"));
+}
+#endif
+
+ZTEST(settings_zms, test_batch_api)
+{
+	zassert_equal(settings_zms_batch_commit(), -EINVAL);
+	zassert_ok(settings_zms_batch_begin());
+	zassert_equal(settings_zms_batch_begin(), -EALREADY);
+	zassert_ok(settings_zms_batch_commit());
+	zassert_equal(zms_writes, 0);
+}
+
+ZTEST(settings_zms, test_batch_writes)
+{
+	const int names = 4;
+	const int overwrites = 10;
+	uint32_t unbatched_writes = 0;
+	char name[NAME_LEN];
+	char value[VALUE_LEN];
+	uint32_t v;
+
+	/* The same saves without and with a batch */
+	for (int batch = 0; batch < 2; batch++) {
+		for (int i = 0; i < names; i++) {
+			name_get(name, i);
+			zassert_ok(settings_delete(name));
+		}
+
+		counters_reset();
+
+		if (batch) {
+			zassert_ok(settings_zms_batch_begin());
+		}
+
+		for (v = 0; v < overwrites; v++) {
+			zassert_ok(settings_save_one("tst/0", &v, sizeof(v)));
+		}
+
+		for (int i = 1; i < names; i++) {
+			name_get(name, i);
+			zassert_ok(settings_save_one(name, &v, sizeof(v)));
+		}
+
+		if (batch) {
+			/* Nothing is written before the commit */
+			zassert_equal(zms_writes, 0);
+			zassert_ok(settings_zms_batch_commit());
+		} else {
+			unbatched_writes = zms_writes;
+		}
+	}
+
+	TC_PRINT("%d names, %d overwrites: %u ZMS writes, %u ZMS writes in a batch\n", names,
+		 overwrites, unbatched_writes, zms_writes);
+
+	/* One write of the largest name ID in use, and one name and value per setting */
+	zassert_equal(zms_writes, 1 + 2 * names);
+	zassert_true(zms_writes < unbatched_writes);
+
+	zassert_equal(value_read("tst/0", value), sizeof(v));
+	zassert_equal(*(uint32_t *)value, overwrites - 1);
+	zassert_equal(value_read("tst/3", value), sizeof(v));
+	zassert_equal(*(uint32_t *)value, overwrites);
+}
+
+ZTEST(settings_zms, test_batch_delete)
+{
+	char value[VALUE_LEN];
+	uint32_t v = 1;
+
+	zassert_ok(settings_save_one("tst/0", &v, sizeof(v)));
+	zassert_ok(settings_save_one("tst/1", &v, sizeof(v)));
+
+	zassert_ok(settings_zms_batch_begin());
+	v = 2;
+	/* Saved and deleted in the batch */
+	zassert_ok(settings_save_one("tst/0", &v, sizeof(v)));
+	zassert_ok(settings_delete("tst/0"));
+	/* Deleted and saved again in the batch */
+	zassert_ok(settings_delete("tst/1"));
+	zassert_ok(settings_save_one("tst/1", &v, sizeof(v)));
+	/* Not stored */
+	zassert_ok(settings_delete("tst/2"));
+
+	counters_reset();
+	zassert_ok(settings_zms_batch_commit());
+
+	/* Delete of the name and value of tst/0, value of tst/1 */
+	zassert_equal(zms_writes, 3);
+
+	zassert_equal(value_read("tst/0", value), 0);
+	zassert_equal(value_read("tst/1", value), sizeof(v));
+	zassert_equal(*(uint32_t *)value, v);
+	zassert_equal(value_read("tst/2", value), 0);
+}
+
+ZTEST(settings_zms, test_batch_full)
+{
+	char name[NAME_LEN];
+	char value[VALUE_LEN];
+	uint32_t v;
+
+	/* More settings than fit in a batch */
+	zassert_ok(settings_zms_batch_begin());
+
+	for (v = 0; v < NAME_COUNT; v++) {
+		name_get(name, v);
+		zassert_ok(settings_save_one(name, &v, sizeof(v)));
+	}
+
+	zassert_true(zms_writes > 0);
+	zassert_ok(settings_zms_batch_commit());
+
+	for (v = 0; v < NAME_COUNT; v++) {
+		name_get(name, v);
+		zassert_equal(value_read(name, value), sizeof(v));
+		zassert_equal(*(uint32_t *)value, v);
+	}
+}
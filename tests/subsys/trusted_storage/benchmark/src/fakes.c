@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Fakes for the AEAD, key and nonce providers of the trusted storage backends.
+ *
+ * The AEAD is not a real cipher: it XORs the data with a keystream derived from the key and
+ * nonce, and computes a keyed checksum as tag. It processes every byte like a real AEAD and
+ * detects modified data, which is what the backends rely on.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <mbedtls/platform_util.h>
+
+#include "aead_crypt.h"
+#include "aead_key.h"
+#include "aead_nonce.h"
+#include "fakes.h"
+
+#define TAG_SIZE 16
+
+struct fake_crypto_stats fake_crypto_stats;
+
+void mbedtls_platform_zeroize(void *buf, size_t len)
+{
+	volatile uint8_t *p = buf;
+
+	while (len--) {
+		*p++ = 0;
+	}
+}
+
+psa_status_t trusted_storage_get_key(psa_storage_uid_t uid, uint8_t *key_buf, size_t key_length)
+{
+	if (key_length < AEAD_KEY_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	for (size_t i = 0; i < AEAD_KEY_SIZE; i++) {
+		key_buf[i] = ((const uint8_t *)&uid)[i % sizeof(uid)] ^ (uint8_t)(i * 31);
+	}
+
+	fake_crypto_stats.key_derivations++;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t trusted_storage_get_nonce(uint8_t *nonce, size_t nonce_len)
+{
+	static uint64_t counter;
+
+	if (nonce == NULL || nonce_len < sizeof(counter)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	counter++;
+	memset(nonce, 0, nonce_len);
+	memcpy(nonce, &counter, sizeof(counter));
+
+	return PSA_SUCCESS;
+}
+
+static uint32_t fake_mix(uint32_t state, uint8_t byte)
+{
+	/* FNV-1a step */
+	return (state ^ byte) * 16777619U;
+}
+
+static uint32_t fake_seed(const uint8_t *key, size_t key_len, const uint8_t *nonce,
+			  size_t nonce_len)
+{
+	uint32_t state = 2166136261U;
+
+	for (size_t i = 0; i < key_len; i++) {
+		state = fake_mix(state, key[i]);
+	}
+
+	for (size_t i = 0; i < nonce_len; i++) {
+		state = fake_mix(state, nonce[i]);
+	}
+
+	return state;
+}
+
+static void fake_tag(uint32_t seed, const uint8_t *add, size_t add_len, const uint8_t *data,
+		     size_t data_len, uint8_t *tag)
+{
+	uint32_t state = seed;
+
+	for (size_t i = 0; i < add_len; i++) {
+		state = fake_mix(state, add[i]);
+	}
+
+	for (size_t i = 0; i < data_len; i++) {
+		state = fake_mix(state, data[i]);
+	}
+
+	for (size_t i = 0; i < TAG_SIZE; i++) {
+		state = fake_mix(state, (uint8_t)i);
+		tag[i] = (uint8_t)(state >> 24);
+	}
+}
+
+static void fake_xor(uint32_t seed, const uint8_t *in, uint8_t *out, size_t len)
+{
+	uint32_t state = seed ^ 0x5a5a5a5aU;
+
+	for (size_t i = 0; i < len; i++) {
+		state = fake_mix(state, (uint8_t)i);
+		out[i] = in[i] ^ (uint8_t)(state >> 16);
+	}
+}
+
+psa_status_t trusted_storage_aead_init(void)
+{
+	return PSA_SUCCESS;
+}
+
+size_t trusted_storage_aead_get_encrypted_size(size_t data_size)
+{
+	return data_size + TAG_SIZE;
+}
+
+psa_status_t trusted_storage_aead_encrypt(const void *key_buf, size_t key_len,
+					  const void *nonce_buf, size_t nonce_len,
+					  const void *add_buf, size_t add_len,
+					  const void *input_buf, size_t input_len, void *output_buf,
+					  size_t output_size, size_t *output_len)
+{
+	uint32_t seed = fake_seed(key_buf, key_len, nonce_buf, nonce_len);
+
+	if (output_size < input_len + TAG_SIZE) {
+		return PSA_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	fake_xor(seed, input_buf, output_buf, input_len);
+	fake_tag(seed, add_buf, add_len, output_buf, input_len, (uint8_t *)output_buf + input_len);
+	*output_len = input_len + TAG_SIZE;
+
+	fake_crypto_stats.aead_ops++;
+	fake_crypto_stats.aead_bytes += input_len;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t trusted_storage_aead_decrypt(const void *key_buf, size_t key_len,
+					  const void *nonce_buf, size_t nonce_len,
+					  const void *add_buf, size_t add_len,
+					  const void *input_buf, size_t input_len, void *output_buf,
+					  size_t output_size, size_t *output_len)
+{
+	uint32_t seed = fake_seed(key_buf, key_len, nonce_buf, nonce_len);
+	uint8_t tag[TAG_SIZE];
+	size_t data_len;
+
+	if (input_len < TAG_SIZE) {
+		return PSA_ERROR_INVALID_SIGNATURE;
+	}
+
+	data_len = input_len - TAG_SIZE;
+
+	if (output_size < data_len) {
+		return PSA_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	fake_crypto_stats.aead_ops++;
+	fake_crypto_stats.aead_bytes += input_len;
+
+	fake_tag(seed, add_buf, add_len, input_buf, data_len, tag);
+	if (memcmp(tag, (const uint8_t *)input_buf + data_len, TAG_SIZE) != 0) {
+		return PSA_ERROR_INVALID_SIGNATURE;
+	}
+
+	fake_xor(seed, input_buf, output_buf, data_len);
+	*output_len = data_len;
+
+	return PSA_SUCCESS;
+}
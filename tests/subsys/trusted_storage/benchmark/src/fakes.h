@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FAKES_H__
+#define FAKES_H__
+
+#include <stdint.h>
+
+/* Work done by the crypto fakes since the last reset */
+struct fake_crypto_stats {
+	/* Number of key derivations */
+	uint32_t key_derivations;
+	/* Number of AEAD operations */
+	uint32_t aead_ops;
+	/* Bytes passed through the AEAD, excluding additional data */
+	uint32_t aead_bytes;
+};
+
+extern struct fake_crypto_stats fake_crypto_stats;
+
+#endif /* FAKES_H__ */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Functional checks and get/set cost of the trusted storage AEAD backends.
+ *
+ * The variant selects the whole-object or chunked AEAD format and the settings or ZMS
+ * storage backend, see testcase.yaml. Simulated time does not advance while code runs on
+ * native_sim, so the cost of each operation is reported as the work done by the crypto fakes:
+ * AEAD operations, bytes through the AEAD and key derivations.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <psa/protected_storage.h>
+#include <string.h>
+
+#include "fakes.h"
+
+#define MAX_SIZE    1024
+#define WINDOW_SIZE 16
+#define TAG_SIZE    16
+
+#define UID_DATA       0x1000
+#define UID_WRITE_ONCE 0x2000
+#define UID_BENCH      0x3000
+
+static const size_t sizes[] = {16, 64, 256, 1024};
+
+static uint8_t data[MAX_SIZE];
+static uint8_t out[MAX_SIZE];
+
+static void pattern_fill(uint8_t *buf, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)(seed + i * 7);
+	}
+}
+
+static void *trusted_storage_setup(void)
+{
+#if defined(CONFIG_SETTINGS)
+	zassert_equal(settings_subsys_init(), 0);
+#endif
+
+	return NULL;
+}
+
+static void trusted_storage_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)psa_ps_remove(UID_DATA);
+	(void)psa_ps_remove(UID_BENCH);
+
+	memset(&fake_crypto_stats, 0, sizeof(fake_crypto_stats));
+}
+
+ZTEST_SUITE(trusted_storage, NULL, trusted_storage_setup, trusted_storage_before, NULL, NULL);
+
+ZTEST(trusted_storage, test_set_get)
+{
+	struct psa_storage_info_t info;
+	size_t out_len;
+
+	ARRAY_FOR_EACH(sizes, i) {
+		pattern_fill(data, sizes[i], i);
+
+		zassert_equal(psa_ps_set(UID_DATA, sizes[i], data, PSA_STORAGE_FLAG_NONE),
+			      PSA_SUCCESS);
+
+		zassert_equal(psa_ps_get_info(UID_DATA, &info), PSA_SUCCESS);
+		zassert_equal(info.size, sizes[i]);
+
+		memset(out, 0, sizeof(out));
+		zassert_equal(psa_ps_get(UID_DATA, 0, sizes[i], out, &out_len), PSA_SUCCESS);
+		zassert_equal(out_len, sizes[i]);
+		zassert_mem_equal(out, data, sizes[i]);
+
+		/* Window from the middle, clamped to the asset size */
+		memset(out, 0, sizeof(out));
+		zassert_equal(psa_ps_get(UID_DATA, sizes[i] / 2, MAX_SIZE - sizes[i] / 2, out,
+					 &out_len), PSA_SUCCESS);
+		zassert_equal(out_len, sizes[i] - sizes[i] / 2);
+		zassert_mem_equal(out, data + sizes[i] / 2, out_len);
+	}
+}
+
+ZTEST(trusted_storage, test_replace_smaller)
+{
+	size_t out_len;
+
+	pattern_fill(data, MAX_SIZE, 1);
+	zassert_equal(psa_ps_set(UID_DATA, MAX_SIZE, data, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS);
+
+	pattern_fill(data, 10, 2);
+	zassert_equal(psa_ps_set(UID_DATA, 10, data, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS);
+
+	zassert_equal(psa_ps_get(UID_DATA, 0, MAX_SIZE, out, &out_len), PSA_SUCCESS);
+	zassert_equal(out_len, 10);
+	zassert_mem_equal(out, data, 10);
+
+	zassert_equal(psa_ps_get(UID_DATA, 11, 1, out, &out_len), PSA_ERROR_INVALID_ARGUMENT);
+}
+
+ZTEST(trusted_storage, test_write_once)
+{
+	pattern_fill(data, 32, 3);
+
+	zassert_equal(psa_ps_set(UID_WRITE_ONCE, 32, data, PSA_STORAGE_FLAG_WRITE_ONCE),
+		      PSA_SUCCESS);
+	zassert_equal(psa_ps_set(UID_WRITE_ONCE, 32, data, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_NOT_PERMITTED);
+	zassert_equal(psa_ps_remove(UID_WRITE_ONCE), PSA_ERROR_NOT_PERMITTED);
+}
+
+ZTEST(trusted_storage, test_remove)
+{
+	struct psa_storage_info_t info;
+
+	pattern_fill(data, MAX_SIZE, 4);
+	zassert_equal(psa_ps_set(UID_DATA, MAX_SIZE, data, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS);
+	zassert_equal(psa_ps_remove(UID_DATA), PSA_SUCCESS);
+	zassert_equal(psa_ps_get_info(UID_DATA, &info), PSA_ERROR_DOES_NOT_EXIST);
+}
+
+ZTEST(trusted_storage, test_set_extended)
+{
+	struct psa_storage_info_t info;
+	size_t out_len;
+
+	if (!(psa_ps_get_support() & PSA_STORAGE_SUPPORT_SET_EXTENDED)) {
+		ztest_test_skip();
+	}
+
+	pattern_fill(data, 300, 5);
+
+	zassert_equal(psa_ps_create(UID_DATA, 300, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS);
+	zassert_equal(psa_ps_create(UID_DATA, 300, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_ALREADY_EXISTS);
+
+	zassert_equal(psa_ps_get_info(UID_DATA, &info), PSA_SUCCESS);
+	zassert_equal(info.capacity, 300);
+	zassert_equal(info.size, 0);
+
+	/* Fill in unaligned pieces, then overwrite the middle */
+	zassert_equal(psa_ps_set_extended(UID_DATA, 0, 100, data), PSA_SUCCESS);
+	zassert_equal(psa_ps_set_extended(UID_DATA, 100, 200, data + 100), PSA_SUCCESS);
+	data[150] ^= 0xff;
+	zassert_equal(psa_ps_set_extended(UID_DATA, 150, 1, data + 150), PSA_SUCCESS);
+
+	zassert_equal(psa_ps_get(UID_DATA, 0, 300, out, &out_len), PSA_SUCCESS);
+	zassert_equal(out_len, 300);
+	zassert_mem_equal(out, data, 300);
+
+	/* No gaps and no writes beyond the capacity */
+	zassert_equal(psa_ps_remove(UID_DATA), PSA_SUCCESS);
+	zassert_equal(psa_ps_create(UID_DATA, 300, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS);
+	zassert_equal(psa_ps_set_extended(UID_DATA, 1, 1, data), PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(psa_ps_set_extended(UID_DATA, 0, 301, data), PSA_ERROR_INVALID_ARGUMENT);
+}
+
+static void stats_print(const char *op, size_t size)
+{
+	TC_PRINT("%-14s %5zu B: %3u AEAD ops, %5u AEAD bytes, %u key derivations\n", op, size,
+		 fake_crypto_stats.aead_ops, fake_crypto_stats.aead_bytes,
+		 fake_crypto_stats.key_derivations);
+
+	memset(&fake_crypto_stats, 0, sizeof(fake_crypto_stats));
+}
+
+ZTEST(trusted_storage, test_benchmark)
+{
+	bool set_extended = psa_ps_get_support() & PSA_STORAGE_SUPPORT_SET_EXTENDED;
+	size_t out_len;
+
+	ARRAY_FOR_EACH(sizes, i) {
+		size_t size = sizes[i];
+
+		pattern_fill(data, size, i);
+
+		memset(&fake_crypto_stats, 0, sizeof(fake_crypto_stats));
+		zassert_equal(psa_ps_set(UID_BENCH, size, data, PSA_STORAGE_FLAG_NONE),
+			      PSA_SUCCESS);
+		stats_print("set", size);
+
+		zassert_equal(psa_ps_get(UID_BENCH, 0, size, out, &out_len), PSA_SUCCESS);
+		stats_print("get", size);
+
+		zassert_equal(psa_ps_get(UID_BENCH, size - WINDOW_SIZE, WINDOW_SIZE, out,
+					 &out_len), PSA_SUCCESS);
+		zassert_mem_equal(out, data + size - WINDOW_SIZE, WINDOW_SIZE);
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+		/* The header tag and the one chunk holding the window */
+		zassert_true(fake_crypto_stats.aead_bytes <=
+			     TAG_SIZE + CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE + TAG_SIZE);
+		zassert_equal(fake_crypto_stats.key_derivations, 0);
+#endif
+		stats_print("get window", size);
+
+		if (set_extended) {
+			zassert_equal(psa_ps_set_extended(UID_BENCH, size / 2, WINDOW_SIZE / 2,
+							  data), PSA_SUCCESS);
+			stats_print("set_extended", size);
+		}
+	}
+}